@@ -61,6 +61,15 @@
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
+
+    /*Cache the small allocations of each thread to take them without locking the heap.
+     *The blocks are taken from and returned to the heap in batches.
+     *Requires a compiler supporting thread local variables if `LV_USE_OS` is enabled.*/
+    #define LV_USE_MEM_THREAD_CACHE 0
+    #if LV_USE_MEM_THREAD_CACHE
+        /*Max. size of the blocks cached by a thread*/
+        #define LV_MEM_THREAD_CACHE_SIZE (4 * 1024U)          /*[bytes]*/
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -134,6 +143,12 @@
 /*The target buffer size for simple layer chunks.*/
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (24 * 1024)   /*[bytes]*/
 
+/* Size of a memory area per display from which the draw tasks and their descriptors
+ * are allocated during a refresh. The whole area is freed at once after the refresh,
+ * so there is almost no `lv_malloc`/`lv_free` for drawing. If it's full the heap is used.
+ * 0: disable and always use the heap*/
+#define LV_DRAW_FRAME_ARENA_SIZE    0   /*[bytes]*/
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -177,11 +192,11 @@
         *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
         #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
-        /* Set number of maximally cached circle data.
+        /* Size of the cache of the circle data in bytes.
         * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+        * radius * 6 + 6 bytes are used per circle (the most recently used radiuses are kept between the frames)
         * 0: to disable caching */
-        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE (4 * 1024)
     #endif
 
     #if !defined(LV_USE_DRAW_SW_ASM) && defined(RTE_Acceleration_Arm_2D)
@@ -666,6 +681,8 @@
 
 #define LV_USE_TILEVIEW   1
 
+#define LV_USE_VLIST      1
+
 #define LV_USE_WIN        1
 
 /*==================
@@ -0,0 +1,53 @@
+#include "../../lv_examples.h"
+#if LV_USE_VLIST && LV_BUILD_EXAMPLES
+
+#define ROW_CNT 100000
+
+static const char * text_cb(lv_obj_t * vlist, uint32_t row, uint32_t col)
+{
+    LV_UNUSED(vlist);
+
+    /*The texts are generated on demand, so it can be a temporary buffer*/
+    static char buf[32];
+    if(col == 0) lv_snprintf(buf, sizeof(buf), "#%" LV_PRIu32, row + 1);
+    else lv_snprintf(buf, sizeof(buf), "%" LV_PRIu32 ".%02" LV_PRIu32 " V", (row * 7) % 5, (row * 13) % 100);
+
+    return buf;
+}
+
+static void bind_cb(lv_obj_t * vlist, lv_obj_t * row_obj, uint32_t row)
+{
+    LV_UNUSED(vlist);
+
+    /*Stripe the rows. The row Widgets are reused so set the style in both cases.*/
+    lv_obj_set_style_bg_color(row_obj, lv_palette_main(LV_PALETTE_GREY), 0);
+    lv_obj_set_style_bg_opa(row_obj, row % 2 ? LV_OPA_10 : LV_OPA_TRANSP, 0);
+}
+
+static void click_event_cb(lv_event_t * e)
+{
+    lv_obj_t * vlist = lv_event_get_current_target(e);
+    uint32_t row = lv_vlist_get_row_index(vlist, lv_event_get_target(e));
+    if(row != LV_VLIST_ROW_NONE) LV_LOG_USER("Row %" LV_PRIu32 " was clicked", row);
+}
+
+/**
+ * A table with many rows. Only the visible rows have Widgets.
+ */
+void lv_example_vlist_1(void)
+{
+    lv_obj_t * vlist = lv_vlist_create(lv_screen_active());
+    lv_obj_set_size(vlist, 240, 300);
+    lv_obj_center(vlist);
+
+    lv_vlist_set_column_count(vlist, 2);
+    lv_vlist_set_column_width(vlist, 0, 100);
+    lv_vlist_set_row_height(vlist, 32);
+    lv_vlist_set_text_cb(vlist, text_cb);
+    lv_vlist_set_bind_cb(vlist, bind_cb);
+    lv_vlist_set_row_count(vlist, ROW_CNT);
+
+    lv_obj_add_event_cb(vlist, click_event_cb, LV_EVENT_CLICKED, NULL);
+}
+
+#endif
@@ -200,11 +200,11 @@
          *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
         #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
-        /** Set number of maximally-cached circle data.
+        /** Size of the cache of the circle data in bytes.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
-         *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
+         *  `radius * 6 + 6` bytes are used per circle (the most recently used radiuses are kept between the frames).
          *  - 0: disables caching */
-        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE (4 * 1024)
     #endif
 
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
@@ -65,6 +65,15 @@
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
+
+    /*Cache the small allocations of each thread to take them without locking the heap.
+     *The blocks are taken from and returned to the heap in batches.
+     *Requires a compiler supporting thread local variables if `LV_USE_OS` is enabled.*/
+    #define LV_USE_MEM_THREAD_CACHE 0
+    #if LV_USE_MEM_THREAD_CACHE
+        /*Max. size of the blocks cached by a thread*/
+        #define LV_MEM_THREAD_CACHE_SIZE (4 * 1024U)          /*[bytes]*/
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -128,6 +137,12 @@
 /*The target buffer size for simple layer chunks.*/
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (24 * 1024)   /*[bytes]*/
 
+/* Size of a memory area per display from which the draw tasks and their descriptors
+ * are allocated during a refresh. The whole area is freed at once after the refresh,
+ * so there is almost no `lv_malloc`/`lv_free` for drawing. If it's full the heap is used.
+ * 0: disable and always use the heap*/
+#define LV_DRAW_FRAME_ARENA_SIZE    0   /*[bytes]*/
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -171,14 +186,14 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /*Allow buffering some shadow calculation.
         *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
+        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost which is shared by the most recently used corners*/
         #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
-        /* Set number of maximally cached circle data.
+        /* Size of the cache of the circle data in bytes.
         * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+        * radius * 6 + 6 bytes are used per circle (the most recently used radiuses are kept between the frames)
         * 0: to disable caching */
-        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE (4 * 1024)
     #endif
 
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
@@ -369,6 +384,21 @@
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/*Default size of the compressed image cache in bytes. Requires `LV_USE_LZ4`.
+ *Frequently used images evicted from the image cache are kept here compressed with LZ4
+ *and decompressed when they are opened again instead of decoding them again.
+ *0: to disable it*/
+#define LV_CACHE_COMPRESSED_DEF_SIZE 0
+
+/*1: Enable asynchronous image decoding. Requires `LV_USE_OS` and the image cache.
+ *Once enabled with `lv_image_decoder_async_enable(true)` images missing from the image cache
+ *are decoded by worker threads while a placeholder is drawn in their place.*/
+#define LV_USE_IMAGE_DECODER_ASYNC 0
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /*Number of decoding worker threads. Their stack size is `LV_DRAW_THREAD_STACK_SIZE`*/
+    #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT 1
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS   2
@@ -380,6 +410,12 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* Number of resolved style property values cached in each lv_obj_t (0: disable).
+ * Speeds up getting style properties during drawing. Requires about 16 bytes per entry and object.
+ * Must be a power of 2. Styles changed after adding them to objects need to be reported by
+ * `lv_obj_report_style_change()`.*/
+#define LV_OBJ_STYLE_RES_CACHE_CNT  0
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -529,6 +565,14 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Size of the cache of decompressed glyph bitmaps of compressed fonts in bytes. 0: no caching.
+ *Cached glyphs are only copied instead of being decompressed again on every draw.*/
+#define LV_FONT_COMPRESSED_CACHE_SIZE 0
+
+/*Enable `lv_font_fmt_txt_lookup_create()` to find the glyphs and kerning values of large fonts
+ *(e.g. CJK fonts) in constant time instead of binary searches. BIN fonts get the tables when loaded.*/
+#define LV_FONT_FMT_TXT_LOOKUP 0
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -626,6 +670,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LAYOUT_CACHE 1   /*Store the line breaks and letter widths to not measure the text on every redraw*/
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /*The count of wait chart*/
 #endif
 
@@ -670,6 +715,8 @@
 
 #define LV_USE_TILEVIEW   1
 
+#define LV_USE_VLIST      1   /*Requires: lv_label, lv_flex*/
+
 #define LV_USE_WIN        1
 
 /*==================
@@ -886,6 +933,10 @@
 
 #endif /*LV_USE_SYSMON*/
 
+/*1: Enable the frame telemetry. Measures the phases of the display refreshes (layout, rendering, flushing, etc.)
+ *   and reports them via a callback or a shared memory area without drawing anything.*/
+#define LV_USE_TELEMETRY 0
+
 /*1: Enable the runtime performance profiler*/
 #define LV_USE_PROFILER 0
 #if LV_USE_PROFILER
@@ -77,10 +77,12 @@ extern "C" {
 #include "src/widgets/tabview/lv_tabview.h"
 #include "src/widgets/textarea/lv_textarea.h"
 #include "src/widgets/tileview/lv_tileview.h"
+#include "src/widgets/vlist/lv_vlist.h"
 #include "src/widgets/win/lv_win.h"
 
 #include "src/others/snapshot/lv_snapshot.h"
 #include "src/others/sysmon/lv_sysmon.h"
+#include "src/others/telemetry/lv_telemetry.h"
 #include "src/others/monkey/lv_monkey.h"
 #include "src/others/gridnav/lv_gridnav.h"
 #include "src/others/fragment/lv_fragment.h"
@@ -456,30 +456,54 @@ class LVGLCompressData:
     def __init__(self,
                  cf: ColorFormat,
                  method: CompressMethod,
-                 raw_data: bytes = b''):
+                 raw_data: bytes = b'',
+                 stride: int = 0,
+                 band_height: int = 0):
         self.blk_size = (cf.bpp + 7) // 8
         self.compress = method
         self.raw_data = raw_data
         self.raw_data_len = len(raw_data)
+        self.stride = stride
+        self.band_height = band_height
         self.compressed = self._compress(raw_data)
 
-    def _compress(self, raw_data: bytes) -> bytearray:
-        if self.compress == CompressMethod.NONE:
-            return raw_data
-
+    def _compress_block(self, raw_data: bytes) -> bytes:
         if self.compress == CompressMethod.RLE:
             # RLE compression performs on pixel unit, pad data to pixel unit
-            pad = b'\x00' * (self.blk_size - self.raw_data_len % self.blk_size)
-            compressed = RLEImage().rle_compress(raw_data + pad, self.blk_size)
+            pad = b'\x00' * (self.blk_size - len(raw_data) % self.blk_size)
+            return RLEImage().rle_compress(raw_data + pad, self.blk_size)
         elif self.compress == CompressMethod.LZ4:
-            compressed = lz4.block.compress(raw_data, store_size=False)
+            return lz4.block.compress(raw_data, store_size=False)
         else:
             raise ParameterError(f"Invalid compress method: {self.compress}")
 
+    def _compress(self, raw_data: bytes) -> bytearray:
+        if self.compress == CompressMethod.NONE:
+            return raw_data
+
+        if not 0 <= self.band_height <= 0xFFFF:
+            raise ParameterError(f"Invalid band height: {self.band_height}")
+
+        if self.band_height:
+            # Compress every `band_height` rows independently and prepend
+            # the offsets of the bands so that they can be decompressed alone
+            band_size = self.band_height * self.stride
+            bands = [
+                self._compress_block(raw_data[i:i + band_size])
+                for i in range(0, self.raw_data_len, band_size)
+            ]
+            offsets = [0]
+            for band in bands:
+                offsets.append(offsets[-1] + len(band))
+            compressed = b"".join(uint32_t(o) for o in offsets)
+            compressed += b"".join(bands)
+        else:
+            compressed = self._compress_block(raw_data)
+
         self.compressed_len = len(compressed)
 
         bin = bytearray()
-        bin += uint32_t(self.compress.value)
+        bin += uint32_t(self.compress.value | (self.band_height << 4))
         bin += uint32_t(self.compressed_len)
         bin += uint32_t(self.raw_data_len)
         bin += compressed
@@ -741,7 +765,8 @@ class LVGLImage:
 
     def to_bin(self,
                filename: str,
-               compress: CompressMethod = CompressMethod.NONE):
+               compress: CompressMethod = CompressMethod.NONE,
+               band_height: int = 0):
         """
         Write this image to file, filename should be ended with '.bin'
         """
@@ -760,7 +785,8 @@ class LVGLImage:
                                      self.stride,
                                      flags=flags)
             bin += header.binary
-            compressed = LVGLCompressData(self.cf, compress, self.data)
+            compressed = LVGLCompressData(self.cf, compress, self.data,
+                                          self.stride, band_height)
             bin += compressed.compressed
 
             f.write(bin)
@@ -769,12 +795,14 @@ class LVGLImage:
 
     def to_c_array(self,
                    filename: str,
-                   compress: CompressMethod = CompressMethod.NONE):
+                   compress: CompressMethod = CompressMethod.NONE,
+                   band_height: int = 0):
         self._check_ext(filename, ".c")
         self._check_dir(filename)
 
         if compress != CompressMethod.NONE:
-            data = LVGLCompressData(self.cf, compress, self.data).compressed
+            data = LVGLCompressData(self.cf, compress, self.data, self.stride,
+                                    band_height).compressed
         else:
             data = self.data
         write_c_array_file(self.w, self.h, self.stride, self.cf, filename,
@@ -1200,6 +1228,7 @@ class PNGConverter:
                  align: int = 1,
                  premultiply: bool = False,
                  compress: CompressMethod = CompressMethod.NONE,
+                 band_height: int = 0,
                  keep_folder=True) -> None:
         self.files = files
         self.cf = cf
@@ -1210,6 +1239,7 @@ class PNGConverter:
         self.align = align
         self.premultiply = premultiply
         self.compress = compress
+        self.band_height = band_height
         self.background = background
 
     def _replace_ext(self, input, ext):
@@ -1236,10 +1266,12 @@ class PNGConverter:
                 output.append((f, img))
                 if self.ofmt == OutputFormat.BIN_FILE:
                     img.to_bin(self._replace_ext(f, ".bin"),
-                               compress=self.compress)
+                               compress=self.compress,
+                               band_height=self.band_height)
                 elif self.ofmt == OutputFormat.C_ARRAY:
                     img.to_c_array(self._replace_ext(f, ".c"),
-                                   compress=self.compress)
+                                   compress=self.compress,
+                                   band_height=self.band_height)
                 elif self.ofmt == OutputFormat.PNG_FILE:
                     img.to_png(self._replace_ext(f, ".png"))
 
@@ -1271,6 +1303,14 @@ def main():
                         default="NONE",
                         choices=["NONE", "RLE", "LZ4"])
 
+    parser.add_argument('--compress-band-height',
+                        help=("compress every N rows independently so that "
+                              "partially drawn images are decompressed only "
+                              "in part, 0 to compress the whole image at once"),
+                        default=0,
+                        type=int,
+                        metavar='rows')
+
     parser.add_argument('--align',
                         help="stride alignment in bytes for bin image",
                         default=1,
@@ -1322,6 +1362,7 @@ def main():
                              align=args.align,
                              premultiply=args.premultiply,
                              compress=compress,
+                             band_height=args.compress_band_height,
                              keep_folder=False)
     output = converter.convert()
     for f, img in output:
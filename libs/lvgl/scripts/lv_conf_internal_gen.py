@@ -212,6 +212,10 @@ LV_EXPORT_CONST_INT(LV_DRAW_BUF_ALIGN);
         #warning "LV_DRAW_THREAD_STACKSIZE was renamed to LV_DRAW_THREAD_STACK_SIZE. Please update lv_conf.h or run menuconfig again."
         #define LV_DRAW_THREAD_STACK_SIZE LV_DRAW_THREAD_STACKSIZE
     #endif
+#else
+    /*Asynchronous image decoding needs worker threads*/
+    #undef LV_USE_IMAGE_DECODER_ASYNC
+    #define LV_USE_IMAGE_DECODER_ASYNC 0
 #endif
 
 /*If running without lv_conf.h add typedefs with default value*/
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+
+import argparse
+import json
+import struct
+from pathlib import Path
+
+HEADER = struct.Struct('<4sHHI')
+RECORD = struct.Struct('<BBHiI')
+
+
+def get_arg():
+    parser = argparse.ArgumentParser(description='Convert a binary trace of the built-in profiler '
+                                                 'to a Chrome trace JSON file (viewable in Perfetto).')
+    parser.add_argument('bin_file', metavar='bin_file', type=str,
+                        help='The binary trace file written by `flush_bin_cb`.')
+    parser.add_argument('json_file', metavar='json_file', type=str, nargs='?',
+                        help='The output JSON file. If not provided, defaults to \'<bin_file>.json\'.')
+
+    args = parser.parse_args()
+    return args
+
+
+def convert(data):
+    magic, version, _, tick_per_sec = HEADER.unpack_from(data, 0)
+    if magic != b'LVPF' or version != 1:
+        raise ValueError('not an LVGL profiler trace (magic: %s, version: %d)' % (magic, version))
+
+    names = {}
+    events = []
+    offset = HEADER.size
+    while offset < len(data):
+        rec_type = chr(data[offset])
+        if rec_type == 'S':
+            length = data[offset + 1]
+            str_id = data[offset + 2] | (data[offset + 3] << 8)
+            names[str_id] = data[offset + 4:offset + 4 + length].decode('utf-8', 'replace')
+            offset += 4 + length
+            continue
+
+        _, cpu, str_id, tid, value = RECORD.unpack_from(data, offset)
+        offset += RECORD.size
+        if rec_type in ('B', 'E'):
+            events.append({'name': names.get(str_id, '?'), 'ph': rec_type,
+                           'ts': value * 1000000 / tick_per_sec,
+                           'pid': 1, 'tid': tid, 'args': {'cpu': cpu}})
+        elif rec_type == 'D':
+            print('warning: %d events of thread %d were dropped' % (value, tid))
+        else:
+            raise ValueError('unknown record type %r at offset %d' % (rec_type, offset - RECORD.size))
+
+    # The threads are drained one after the other so sort the events by time
+    events.sort(key=lambda e: e['ts'])
+    return {'traceEvents': events, 'displayTimeUnit': 'ms'}
+
+
+if __name__ == '__main__':
+    args = get_arg()
+
+    if not args.json_file:
+        args.json_file = Path(args.bin_file).with_suffix('.json').as_posix()
+
+    print('bin_file :', args.bin_file)
+    print('json_file:', args.json_file)
+
+    with open(args.bin_file, 'rb') as f:
+        trace = convert(f.read())
+
+    with open(args.json_file, 'w') as f:
+        json.dump(trace, f)
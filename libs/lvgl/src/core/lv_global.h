@@ -22,6 +22,7 @@ extern "C" {
 #endif
 #include "../misc/lv_anim.h"
 #include "../misc/lv_area.h"
+#include "../misc/lv_array.h"
 #include "../misc/lv_color_op.h"
 #include "../misc/lv_ll.h"
 #include "../misc/lv_log.h"
@@ -31,7 +32,7 @@ extern "C" {
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
 
-#if LV_USE_FONT_COMPRESSED
+#if LV_USE_FONT_COMPRESSED || LV_FONT_FMT_TXT_LOOKUP
 #include "../font/lv_font_fmt_txt_private.h"
 #endif
 
@@ -86,6 +87,8 @@ typedef struct lv_global_t {
 
     lv_ll_t style_trans_ll;
     bool style_refresh;
+    bool style_refr_flushing;
+    lv_array_t style_refr_pending;  /**< Style refreshes deferred while the animations are running*/
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
@@ -97,6 +100,8 @@ typedef struct lv_global_t {
     lv_indev_t * indev_active;
     lv_obj_t * indev_obj_active;
 
+    uint32_t bitmap_cache_obj_cnt;  /**< Number of objects with `LV_OBJ_FLAG_CACHE_AS_BITMAP`*/
+
     uint32_t layout_count;
     lv_layout_dsc_t * layout_list;
     bool layout_update_mutex;
@@ -120,13 +125,22 @@ typedef struct lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+#if LV_USE_LZ4
+    lv_cache_t * img_compressed_cache;
+    lv_ll_t img_compress_pending_ll;        /**< Evicted images waiting to be compressed*/
+    lv_mutex_t img_compress_pending_lock;
+    uint32_t img_compress_pending_size;     /**< Decoded size of the waiting images*/
+#endif
+#if LV_USE_IMAGE_DECODER_ASYNC
+    void * img_decoder_async;
+#endif
 
     lv_draw_global_info_t draw_info;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    lv_draw_sw_shadow_cache_t sw_shadow_cache;
+    lv_cache_t * sw_shadow_cache;
 #endif
 #if LV_DRAW_SW_COMPLEX
-    lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+    lv_cache_t * sw_circle_cache;
 #endif
 
 #if LV_USE_LOG
@@ -187,6 +201,13 @@ typedef struct lv_global_t {
 
 #if LV_USE_FONT_COMPRESSED
     lv_font_fmt_rle_t font_fmt_rle;
+#if LV_FONT_COMPRESSED_CACHE_SIZE > 0
+    lv_font_fmt_txt_glyph_cache_t font_fmt_txt_glyph_cache;
+#endif
+#endif
+
+#if LV_FONT_FMT_TXT_LOOKUP
+    lv_font_fmt_txt_lookup_list_t font_fmt_txt_lookups;
 #endif
 
 #if LV_USE_SPAN != 0
@@ -205,6 +226,10 @@ typedef struct lv_global_t {
     lv_sysmon_backend_data_t sysmon_mem;
 #endif
 
+#if LV_USE_TELEMETRY
+    void * telemetry_context;
+#endif
+
 #if LV_USE_IME_PINYIN != 0
     size_t ime_cand_len;
 #endif
@@ -26,6 +26,7 @@
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_string.h"
 #include "lv_obj_draw_private.h"
+#include "lv_global.h"
 
 /*********************
  *      DEFINES
@@ -34,6 +35,7 @@
 #define LV_OBJ_DEF_WIDTH    (LV_DPX(100))
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
 #define STYLE_TRANSITION_MAX 32
+#define bitmap_cache_obj_cnt LV_GLOBAL_DEFAULT()->bitmap_cache_obj_cnt
 
 /**********************
  *      TYPEDEFS
@@ -237,6 +239,8 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
     /* We must invalidate the area occupied by the object before we hide it as calls to invalidate hidden objects are ignored */
     if(f & LV_OBJ_FLAG_HIDDEN) lv_obj_invalidate(obj);
 
+    if((f & LV_OBJ_FLAG_CACHE_AS_BITMAP) && !(obj->flags & LV_OBJ_FLAG_CACHE_AS_BITMAP)) bitmap_cache_obj_cnt++;
+
     obj->flags |= f;
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
@@ -277,6 +281,8 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_invalidate_area(obj, &ver_area);
     }
 
+    if((f & LV_OBJ_FLAG_CACHE_AS_BITMAP) && (obj->flags & LV_OBJ_FLAG_CACHE_AS_BITMAP)) bitmap_cache_obj_cnt--;
+
     obj->flags &= (~f);
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
@@ -291,6 +297,9 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
     }
 
+    if(f & LV_OBJ_FLAG_CACHE_AS_BITMAP) {
+        lv_obj_free_bitmap_cache(obj);
+    }
 }
 
 void lv_obj_update_flag(lv_obj_t * obj, lv_obj_flag_t f, bool v)
@@ -481,6 +490,11 @@ static void lv_obj_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_UNUSED(class_p);
     LV_TRACE_OBJ_CREATE("begin");
 
+#if LV_OBJ_STYLE_RES_CACHE_CNT
+    /*Allocate it together with the object instead of while drawing to avoid fragmenting the heap*/
+    obj->style_res_cache = lv_malloc_zeroed(sizeof(lv_obj_style_res_cache_t));
+#endif
+
     lv_obj_t * parent = obj->parent;
     if(parent) {
         int32_t sl = lv_obj_get_scroll_left(parent);
@@ -529,6 +543,8 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
 
+    if(obj->flags & LV_OBJ_FLAG_CACHE_AS_BITMAP) bitmap_cache_obj_cnt--;
+
     if(obj->spec_attr) {
         if(obj->spec_attr->children) {
             lv_free(obj->spec_attr->children);
@@ -536,6 +552,7 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         }
 
         lv_event_remove_all(&obj->spec_attr->event_list);
+        lv_obj_free_bitmap_cache(obj);
 
         lv_free(obj->spec_attr);
         obj->spec_attr = NULL;
@@ -544,6 +561,11 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 #if LV_OBJ_ID_AUTO_ASSIGN
     lv_obj_free_id(obj);
 #endif
+
+#if LV_OBJ_STYLE_RES_CACHE_CNT
+    lv_free(obj->style_res_cache);
+    obj->style_res_cache = NULL;
+#endif
 }
 
 static void lv_obj_draw(lv_event_t * e)
@@ -848,7 +870,7 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
         uint32_t child_cnt = lv_obj_get_child_count(obj);
         for(i = 0; i < child_cnt; i++) {
             lv_obj_t * child = obj->spec_attr->children[i];
-            lv_obj_mark_layout_as_dirty(child);
+            lv_obj_mark_geometry_as_dirty(child);
         }
     }
     else if(code == LV_EVENT_CHILD_CHANGED) {
@@ -904,6 +926,9 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
         return;
     }
 
+    /*The children might inherit different values in the new state*/
+    lv_obj_style_invalidate_res_cache(obj, LV_STYLE_PROP_ANY);
+
     /*Invalidate the object in their current state*/
     lv_obj_invalidate(obj);
 
@@ -13,6 +13,7 @@
 #include "../indev/lv_indev.h"
 #include "../stdlib/lv_string.h"
 #include "../draw/lv_draw_arc.h"
+#include "../misc/cache/lv_image_cache.h"
 
 /*********************
  *      DEFINES
@@ -321,6 +322,17 @@ lv_layer_type_t lv_obj_get_layer_type(const lv_obj_t * obj)
     else return LV_LAYER_TYPE_NONE;
 }
 
+void lv_obj_free_bitmap_cache(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->bitmap_cache == NULL) return;
+
+    /*It was drawn as an image so it might be in the image cache too*/
+    lv_image_cache_drop(obj->spec_attr->bitmap_cache);
+    lv_draw_buf_destroy(obj->spec_attr->bitmap_cache);
+    obj->spec_attr->bitmap_cache = NULL;
+    obj->spec_attr->bitmap_cache_valid = 0;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
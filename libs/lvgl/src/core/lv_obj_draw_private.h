@@ -37,6 +37,12 @@ int32_t lv_obj_get_ext_draw_size(const lv_obj_t * obj);
 
 lv_layer_type_t lv_obj_get_layer_type(const lv_obj_t * obj);
 
+/**
+ * Free the bitmap cache of an object created because of `LV_OBJ_FLAG_CACHE_AS_BITMAP`
+ * @param obj       pointer to an object
+ */
+void lv_obj_free_bitmap_cache(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
@@ -11,6 +11,7 @@
 #include "lv_obj_event_private.h"
 #include "lv_obj_draw_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_style_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "lv_refr_private.h"
@@ -21,6 +22,7 @@
  *********************/
 #define MY_CLASS (&lv_obj_class)
 #define update_layout_mutex LV_GLOBAL_DEFAULT()->layout_update_mutex
+#define bitmap_cache_obj_cnt LV_GLOBAL_DEFAULT()->bitmap_cache_obj_cnt
 
 /**********************
  *      TYPEDEFS
@@ -32,7 +34,9 @@
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void mark_ancestors_as_dirty(lv_obj_t * obj);
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
+static void bitmap_cache_invalidate(const lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -197,6 +201,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    mark_ancestors_as_dirty(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -280,6 +285,8 @@ bool lv_obj_is_layout_positioned(const lv_obj_t * obj)
 void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
+    obj->layout_geom_only = 0;
+    mark_ancestors_as_dirty(obj);
 
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
     lv_obj_t * scr = lv_obj_get_screen(obj);
@@ -290,6 +297,15 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+void lv_obj_mark_geometry_as_dirty(lv_obj_t * obj)
+{
+    /*Don't weaken a normal layout update*/
+    if(obj->layout_inv) return;
+
+    lv_obj_mark_layout_as_dirty(obj);
+    obj->layout_geom_only = 1;
+}
+
 void lv_obj_update_layout(const lv_obj_t * obj)
 {
     if(update_layout_mutex) {
@@ -299,6 +315,9 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     LV_PROFILER_BEGIN;
     update_layout_mutex = true;
 
+    /*The deferred style refreshes might invalidate the layout*/
+    lv_obj_style_flush_refresh();
+
     lv_obj_t * scr = lv_obj_get_screen(obj);
     /*Repeat until there are no more layout invalidations*/
     while(scr->scr_layout_inv) {
@@ -713,8 +732,8 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
      *occur without position change*/
     if(diff.x == 0 && diff.y == 0) return;
 
-    /*Invalidate the original area*/
-    lv_obj_invalidate(obj);
+    /*Invalidate the original area. Moving doesn't change the content*/
+    lv_obj_invalidate_keep_bitmap_cache(obj);
 
     /*Save the original coordinates*/
     lv_area_t ori;
@@ -743,7 +762,7 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
     if(parent) lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, obj);
 
     /*Invalidate the new area*/
-    lv_obj_invalidate(obj);
+    lv_obj_invalidate_keep_bitmap_cache(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -814,6 +833,9 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The content of the object and its parents has changed even if it's not visible now*/
+    bitmap_cache_invalidate(obj);
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
@@ -854,6 +876,13 @@ void lv_obj_invalidate(const lv_obj_t * obj)
     lv_obj_invalidate_area(obj, &obj_coords);
 }
 
+void lv_obj_invalidate_keep_bitmap_cache(const lv_obj_t * obj)
+{
+    bool valid = obj->spec_attr && obj->spec_attr->bitmap_cache_valid;
+    lv_obj_invalidate(obj);
+    if(valid) obj->spec_attr->bitmap_cache_valid = 1;
+}
+
 bool lv_obj_area_is_visible(const lv_obj_t * obj, lv_area_t * area)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
@@ -1125,19 +1154,40 @@ static int32_t calc_content_height(lv_obj_t * obj)
 
 static void layout_update_core(lv_obj_t * obj)
 {
-    uint32_t i;
-    uint32_t child_cnt = lv_obj_get_child_count(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+    /*Visit only the children which are dirty or have dirty descendants*/
+    if(obj->layout_child_inv) {
+        obj->layout_child_inv = 0;
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_count(obj);
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->layout_child_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
+        bool geom_only = obj->layout_geom_only;
         obj->layout_inv = 0;
+        obj->layout_geom_only = 0;
+
+        int32_t w_ori = lv_obj_get_width(obj);
+        int32_t h_ori = lv_obj_get_height(obj);
         lv_obj_refr_size(obj);
         lv_obj_refr_pos(obj);
 
-        if(child_cnt > 0) {
+        /*If only the size of the parent has changed and the size is the same,
+         *the children are still at the right place relative to the object.
+         *If it was marked again (e.g. on LV_EVENT_SIZE_CHANGED) the next pass will update it anyway,
+         *but keep the full update if it was requested.*/
+        bool apply = !geom_only || w_ori != lv_obj_get_width(obj) || h_ori != lv_obj_get_height(obj);
+        if(obj->layout_inv) {
+            if(apply) obj->layout_geom_only = 0;
+            apply = false;
+        }
+
+        if(apply && lv_obj_get_child_count(obj) > 0) {
             lv_layout_apply(obj);
         }
     }
@@ -1148,6 +1198,20 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+/**
+ * Mark the ancestors to let `layout_update_core` find `obj` without visiting the clean subtrees.
+ * The ancestors of an already marked object are marked too, or the object will be visited
+ * by the ongoing layout update.
+ */
+static void mark_ancestors_as_dirty(lv_obj_t * obj)
+{
+    lv_obj_t * parent = obj->parent;
+    while(parent && !parent->layout_child_inv) {
+        parent->layout_child_inv = 1;
+        parent = parent->parent;
+    }
+}
+
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv)
 {
     int32_t angle = lv_obj_get_style_transform_rotation(obj, 0);
@@ -1181,3 +1245,14 @@ static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p
 
     lv_point_array_transform(p, p_count, angle, scale_x, scale_y, &pivot, !inv);
 }
+
+static void bitmap_cache_invalidate(const lv_obj_t * obj)
+{
+    /*Most often there are no cached objects, so no need to check the parents*/
+    if(bitmap_cache_obj_cnt == 0) return;
+
+    while(obj) {
+        if(obj->spec_attr) obj->spec_attr->bitmap_cache_valid = 0;
+        obj = obj->parent;
+    }
+}
@@ -38,12 +38,15 @@ struct lv_obj_spec_attr_t {
     int32_t ext_click_pad;          /**< Extra click padding in all direction*/
     int32_t ext_draw_size;          /**< EXTend the size in every direction for drawing.*/
 
+    lv_draw_buf_t * bitmap_cache;   /**< The rendered object if `LV_OBJ_FLAG_CACHE_AS_BITMAP` is set*/
+
     uint16_t child_cnt;             /**< Number of children*/
     uint16_t scrollbar_mode : 2;    /**< How to display scrollbars, see `lv_scrollbar_mode_t`*/
     uint16_t scroll_snap_x : 2;     /**< Where to align the snappable children horizontally, see `lv_scroll_snap_t`*/
     uint16_t scroll_snap_y : 2;     /**< Where to align the snappable children vertically*/
     uint16_t scroll_dir : 4;        /**< The allowed scroll direction(s), see `lv_dir_t`*/
     uint16_t layer_type : 2;        /**< Cache the layer type here. Element of lv_intermediate_layer_type_t */
+    uint16_t bitmap_cache_valid : 1; /**< `bitmap_cache` has the current content of the object*/
 };
 
 struct lv_obj_t {
@@ -54,6 +57,9 @@ struct lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_RES_CACHE_CNT
+    lv_obj_style_res_cache_t * style_res_cache;   /**< Resolved style values*/
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -63,6 +69,8 @@ struct lv_obj_t {
     lv_obj_flag_t flags;
     lv_state_t state;
     uint16_t layout_inv : 1;
+    uint16_t layout_child_inv : 1;      /**< A descendant needs layout update*/
+    uint16_t layout_geom_only : 1;      /**< Only the size and position needs to be checked*/
     uint16_t readjust_scroll_after_layout : 1;
     uint16_t scr_layout_inv : 1;
     uint16_t skip_trans : 1;
@@ -70,6 +78,7 @@ struct lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t is_deleting : 1;
+    uint16_t style_refr_pending : 1;    /**< It has a deferred style refresh*/
 };
 
 
@@ -77,6 +86,21 @@ struct lv_obj_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Mark an object for layout update because the size of its parent has changed.
+ * Its children are repositioned only if its size changes.
+ * @param obj      pointer to an object
+ */
+void lv_obj_mark_geometry_as_dirty(lv_obj_t * obj);
+
+/**
+ * Invalidate the area of an object but keep its bitmap cache.
+ * Used when the object is only moved or blended differently and its content is not changed.
+ * The bitmap caches of the parents are still dropped.
+ * @param obj      pointer to an object
+ */
+void lv_obj_invalidate_keep_bitmap_cache(const lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
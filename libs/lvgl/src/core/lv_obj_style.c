@@ -23,11 +23,28 @@
 #define style_trans_ll_p &(LV_GLOBAL_DEFAULT()->style_trans_ll)
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
+#define style_refr_pending_p &(LV_GLOBAL_DEFAULT()->style_refr_pending)
+#define style_refr_flushing LV_GLOBAL_DEFAULT()->style_refr_flushing
+
+/*Internal `prop_flags` bit of the refreshes: the property might change the content of the object*/
+#define STYLE_REFR_FLAG_CONTENT (1 << 7)
+
+#if LV_OBJ_STYLE_RES_CACHE_CNT & (LV_OBJ_STYLE_RES_CACHE_CNT - 1)
+    #error "LV_OBJ_STYLE_RES_CACHE_CNT must be a power of 2"
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/** A deferred style refresh of an object's part*/
+typedef struct {
+    lv_obj_t * obj;             /**< `NULL` if the object was deleted meanwhile*/
+    lv_part_t part;
+    uint8_t prop_flags;         /**< ORed flags of the changed properties*/
+    bool prop_any;
+} style_refr_pending_t;
+
 typedef struct {
     lv_obj_t * obj;
     lv_style_prop_t prop;
@@ -58,6 +75,10 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t se
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
+static void refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop, bool defer);
+static void refresh_style_core(lv_obj_t * obj, lv_part_t part, uint8_t prop_flags, bool prop_any);
+static bool refresh_style_defer(lv_obj_t * obj, lv_part_t part, uint8_t prop_flags, bool prop_any);
+static bool style_prop_keeps_content(lv_style_prop_t prop);
 static void trans_anim_cb(void * _tr, int32_t v);
 static void trans_anim_start_cb(lv_anim_t * a);
 static void trans_anim_completed_cb(lv_anim_t * a);
@@ -68,6 +89,9 @@ static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+#if LV_OBJ_STYLE_RES_CACHE_CNT
+    static lv_obj_style_res_t * get_res_cache_entry(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -84,11 +108,13 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 void lv_obj_style_init(void)
 {
     lv_ll_init(style_trans_ll_p, sizeof(trans_t));
+    lv_array_init(style_refr_pending_p, LV_ARRAY_DEFAULT_CAPACITY, sizeof(style_refr_pending_t));
 }
 
 void lv_obj_style_deinit(void)
 {
     lv_ll_clear(style_trans_ll_p);
+    lv_array_deinit(style_refr_pending_p);
     if(_style_custom_prop_flag_lookup_table != NULL) {
         lv_free(_style_custom_prop_flag_lookup_table);
         _style_custom_prop_flag_lookup_table = NULL;
@@ -260,7 +286,10 @@ void lv_obj_remove_style_all(lv_obj_t * obj)
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+#if LV_OBJ_STYLE_RES_CACHE_CNT == 0
+    /*Without the resolved value cache there is nothing to do if refreshing is disabled*/
     if(!style_refr) return;
+#endif
     lv_display_t * d = lv_display_get_next(NULL);
 
     while(d) {
@@ -276,45 +305,40 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    if(!style_refr) return;
-
-    lv_obj_invalidate(obj);
-
-    lv_part_t part = lv_obj_style_get_selector_part(selector);
+    refresh_style(obj, selector, prop, false);
+}
 
-    bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
-    bool is_ext_draw = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_EXT_DRAW_UPDATE);
-    bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
-    bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYER_UPDATE);
+void lv_obj_style_flush_refresh(void)
+{
+    /*Refreshing can trigger events which might want to flush again*/
+    if(style_refr_flushing) return;
+    style_refr_flushing = true;
 
-    if(is_layout_refr) {
-        if(part == LV_PART_ANY ||
-           part == LV_PART_MAIN ||
-           lv_obj_get_style_height(obj, 0) == LV_SIZE_CONTENT ||
-           lv_obj_get_style_width(obj, 0) == LV_SIZE_CONTENT) {
-            lv_obj_send_event(obj, LV_EVENT_STYLE_CHANGED, NULL);
-            lv_obj_mark_layout_as_dirty(obj);
-        }
-    }
-    if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY || is_layout_refr)) {
-        lv_obj_t * parent = lv_obj_get_parent(obj);
-        if(parent) lv_obj_mark_layout_as_dirty(parent);
+    lv_array_t * pending = style_refr_pending_p;
+    uint32_t i;
+    /*The size is read in each iteration as new objects can be added meanwhile*/
+    for(i = 0; i < lv_array_size(pending); i++) {
+        style_refr_pending_t p = *(style_refr_pending_t *)lv_array_at(pending, i);
+        if(p.obj == NULL) continue;
+        p.obj->style_refr_pending = 0;
+        refresh_style_core(p.obj, p.part, p.prop_flags, p.prop_any);
     }
+    lv_array_clear(pending);
 
-    /*Cache the layer type*/
-    if((part == LV_PART_ANY || part == LV_PART_MAIN) && is_layer_refr) {
-        lv_obj_update_layer_type(obj);
-    }
+    style_refr_flushing = false;
+}
 
-    if(prop == LV_STYLE_PROP_ANY || is_ext_draw) {
-        lv_obj_refresh_ext_draw_size(obj);
-    }
-    lv_obj_invalidate(obj);
+void lv_obj_style_cancel_refresh(lv_obj_t * obj)
+{
+    if(obj->style_refr_pending == 0) return;
+    obj->style_refr_pending = 0;
 
-    if(prop == LV_STYLE_PROP_ANY || (is_inheritable && (is_ext_draw || is_layout_refr))) {
-        if(part != LV_PART_SCROLLBAR) {
-            refresh_children_style(obj);
-        }
+    lv_array_t * pending = style_refr_pending_p;
+    uint32_t i;
+    for(i = 0; i < lv_array_size(pending); i++) {
+        /*Don't remove the item as `lv_obj_style_flush_refresh` might iterate the array now*/
+        style_refr_pending_t * p = lv_array_at(pending, i);
+        if(p->obj == obj) p->obj = NULL;
     }
 }
 
@@ -331,10 +355,30 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
+#if LV_OBJ_STYLE_RES_CACHE_CNT
+    /*Transitions are skipped only temporarily so don't use the cache then*/
+    lv_obj_style_res_t * res = NULL;
+    if(!obj->skip_trans) {
+        res = get_res_cache_entry(obj, selector, prop);
+        if(res && res->version == obj->style_res_cache->version && res->prop == prop && res->selector == selector) {
+            return res->value;
+        }
+    }
+#endif
+
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
+
+#if LV_OBJ_STYLE_RES_CACHE_CNT
+    if(res) {
+        res->value = value_act;
+        res->version = obj->style_res_cache->version;
+        res->selector = selector;
+        res->prop = prop;
+    }
+#endif
 
-    return lv_style_prop_get_default(prop);
+    return value_act;
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -415,6 +459,25 @@ bool lv_obj_remove_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_sty
     return res;
 }
 
+void lv_obj_style_invalidate_res_cache(lv_obj_t * obj, lv_style_prop_t prop)
+{
+#if LV_OBJ_STYLE_RES_CACHE_CNT
+    if(obj->style_res_cache) obj->style_res_cache->version++;
+
+    /*The children might inherit the property*/
+    if((lv_style_prop_lookup_flags(prop) & LV_STYLE_PROP_FLAG_INHERITABLE) == 0) return;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_style_invalidate_res_cache(obj->spec_attr->children[i], prop);
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(prop);
+#endif
+}
+
 void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t prev_state, lv_state_t new_state,
                                     const lv_obj_style_transition_dsc_t * tr_dsc)
 {
@@ -819,6 +882,7 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
                     lv_style_remove_prop((lv_style_t *)obj->styles[i].style, tr->prop);
                 }
             }
+            lv_obj_style_invalidate_res_cache(obj, tr->prop);
 
             /*Free the transition descriptor too*/
             lv_anim_delete(tr, NULL);
@@ -832,6 +896,143 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
     return removed;
 }
 
+/**
+ * Notify an object about a style change
+ * @param obj           pointer to an object
+ * @param selector      the changed part
+ * @param prop          the changed property or `LV_STYLE_PROP_ANY`
+ * @param defer         true: a style animation changed the property. If the animation timer is running,
+ *                      refresh the object only once with all the changed properties when the timer finishes.
+ */
+static void refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop, bool defer)
+{
+    lv_obj_style_invalidate_res_cache(obj, prop);
+
+    if(!style_refr) return;
+
+    lv_part_t part = lv_obj_style_get_selector_part(selector);
+    uint8_t prop_flags = lv_style_prop_lookup_flags(prop);
+    bool prop_any = prop == LV_STYLE_PROP_ANY;
+    if(!style_prop_keeps_content(prop)) prop_flags |= STYLE_REFR_FLAG_CONTENT;
+
+    if(defer && lv_anim_is_timer_running() && refresh_style_defer(obj, part, prop_flags, prop_any)) return;
+
+    refresh_style_core(obj, part, prop_flags, prop_any);
+}
+
+/**
+ * Refresh an object after the style of one of its parts has changed
+ * @param obj           pointer to an object
+ * @param part          the changed part or `LV_PART_ANY`
+ * @param prop_flags    ORed `LV_STYLE_PROP_FLAG_...` flags of the changed properties
+ * @param prop_any      true: any property might have changed
+ */
+static void refresh_style_core(lv_obj_t * obj, lv_part_t part, uint8_t prop_flags, bool prop_any)
+{
+    /*E.g. moving the object or changing `opa_layered` doesn't change the content itself*/
+    bool keep_bitmap_cache = !prop_any && part == LV_PART_MAIN && !(prop_flags & STYLE_REFR_FLAG_CONTENT);
+    if(keep_bitmap_cache) lv_obj_invalidate_keep_bitmap_cache(obj);
+    else lv_obj_invalidate(obj);
+
+    bool is_layout_refr = prop_flags & LV_STYLE_PROP_FLAG_LAYOUT_UPDATE;
+    bool is_ext_draw = prop_flags & LV_STYLE_PROP_FLAG_EXT_DRAW_UPDATE;
+    bool is_inheritable = prop_flags & LV_STYLE_PROP_FLAG_INHERITABLE;
+    bool is_layer_refr = prop_flags & LV_STYLE_PROP_FLAG_LAYER_UPDATE;
+
+    if(is_layout_refr) {
+        if(part == LV_PART_ANY ||
+           part == LV_PART_MAIN ||
+           lv_obj_get_style_height(obj, 0) == LV_SIZE_CONTENT ||
+           lv_obj_get_style_width(obj, 0) == LV_SIZE_CONTENT) {
+            lv_obj_send_event(obj, LV_EVENT_STYLE_CHANGED, NULL);
+            lv_obj_mark_layout_as_dirty(obj);
+        }
+    }
+    if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop_any || is_layout_refr)) {
+        lv_obj_t * parent = lv_obj_get_parent(obj);
+        if(parent) lv_obj_mark_layout_as_dirty(parent);
+    }
+
+    /*Cache the layer type*/
+    if((part == LV_PART_ANY || part == LV_PART_MAIN) && is_layer_refr) {
+        lv_obj_update_layer_type(obj);
+    }
+
+    if(prop_any || is_ext_draw) {
+        lv_obj_refresh_ext_draw_size(obj);
+    }
+    if(keep_bitmap_cache) lv_obj_invalidate_keep_bitmap_cache(obj);
+    else lv_obj_invalidate(obj);
+
+    if(prop_any || (is_inheritable && (is_ext_draw || is_layout_refr))) {
+        if(part != LV_PART_SCROLLBAR) {
+            refresh_children_style(obj);
+        }
+    }
+}
+
+
+/**
+ * Check if a property changes only where and how the object is blended.
+ * The size is handled by the layout, which invalidates the content if it really changes.
+ * @param prop      a style property
+ * @return          true: the rendered content of the object is not affected
+ */
+static bool style_prop_keeps_content(lv_style_prop_t prop)
+{
+    switch(prop) {
+        case LV_STYLE_X:
+        case LV_STYLE_Y:
+        case LV_STYLE_ALIGN:
+        case LV_STYLE_TRANSLATE_X:
+        case LV_STYLE_TRANSLATE_Y:
+        case LV_STYLE_OPA_LAYERED:
+        case LV_STYLE_BLEND_MODE:
+        case LV_STYLE_BITMAP_MASK_SRC:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Save a style refresh to do it later in `lv_obj_style_flush_refresh`.
+ * The refreshes of the same part of an object are merged.
+ * @param obj           pointer to an object
+ * @param part          the changed part or `LV_PART_ANY`
+ * @param prop_flags    ORed `LV_STYLE_PROP_FLAG_...` flags of the changed properties
+ * @param prop_any      true: any property might have changed
+ * @return              true: saved; false: it couldn't be saved, refresh now
+ */
+static bool refresh_style_defer(lv_obj_t * obj, lv_part_t part, uint8_t prop_flags, bool prop_any)
+{
+    lv_array_t * pending = style_refr_pending_p;
+
+    if(obj->style_refr_pending) {
+        /*Typically it was added recently so search from the end*/
+        uint32_t i = lv_array_size(pending);
+        while(i > 0) {
+            i--;
+            style_refr_pending_t * p = lv_array_at(pending, i);
+            if(p->obj == obj && p->part == part) {
+                p->prop_flags |= prop_flags;
+                p->prop_any |= prop_any;
+                return true;
+            }
+        }
+    }
+
+    style_refr_pending_t p;
+    p.obj = obj;
+    p.part = part;
+    p.prop_flags = prop_flags;
+    p.prop_any = prop_any;
+    if(lv_array_push_back(pending, &p) != LV_RESULT_OK) return false;
+
+    obj->style_refr_pending = 1;
+    return true;
+}
+
 static void trans_anim_cb(void * _tr, int32_t v)
 {
     trans_t * tr = _tr;
@@ -889,7 +1090,8 @@ static void trans_anim_cb(void * _tr, int32_t v)
             }
         }
         lv_style_set_prop((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
-        if(refr) lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
+        /*The transitions typically change a few properties of the same object in every frame*/
+        if(refr) refresh_style(tr->obj, tr->selector, tr->prop, true);
         break;
 
     }
@@ -946,6 +1148,7 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+                lv_obj_style_invalidate_res_cache(obj, prop);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1124,3 +1327,22 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_RES_CACHE_CNT
+/**
+ * Get the slot of the resolved style value cache of an object where a property can be stored.
+ * @param obj       pointer to an object
+ * @param selector  the part and state of the object
+ * @param prop      the style property
+ * @return          pointer to the slot or `NULL` if the object has no cache
+ */
+static lv_obj_style_res_t * get_res_cache_entry(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
+{
+    if(obj->style_res_cache == NULL) return NULL;
+
+    /*The parts are stored on the upper bits so mix them with the property ID*/
+    uint32_t part_id = lv_obj_style_get_selector_part(selector) >> 16;
+    uint32_t idx = (prop + part_id * 7) & (LV_OBJ_STYLE_RES_CACHE_CNT - 1);
+    return &obj->style_res_cache->entries[idx];
+}
+#endif
@@ -31,6 +31,22 @@ struct lv_obj_style_t {
     uint32_t is_trans : 1;
 };
 
+#if LV_OBJ_STYLE_RES_CACHE_CNT
+/** A resolved style property value cached in an object*/
+struct lv_obj_style_res_t {
+    lv_style_value_t value;
+    uint32_t version;               /**< The version of the cache when the value was resolved*/
+    uint32_t selector : 24;         /**< The part and state of the object when the value was resolved*/
+    uint32_t prop : 8;
+};
+
+/** The resolved style property values cached in an object*/
+struct lv_obj_style_res_cache_t {
+    uint32_t version;               /**< Incremented to mark all entries as outdated*/
+    lv_obj_style_res_t entries[LV_OBJ_STYLE_RES_CACHE_CNT];
+};
+#endif
+
 struct lv_obj_style_transition_dsc_t {
     uint16_t time;
     uint16_t delay;
@@ -45,6 +61,20 @@ struct lv_obj_style_transition_dsc_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Do the style refreshes which were deferred while the style transitions were running.
+ * Each object is refreshed only once with all the changed properties.
+ * Called when the animation timer finishes and before the layout is updated.
+ */
+void lv_obj_style_flush_refresh(void);
+
+/**
+ * Drop the deferred style refreshes of an object.
+ * Called when the object is deleted.
+ * @param obj   pointer to an object
+ */
+void lv_obj_style_cancel_refresh(lv_obj_t * obj);
+
 /**
  * Initialize the object related style manager module.
  * Called by LVGL in `lv_init()`
@@ -57,6 +87,17 @@ void lv_obj_style_init(void);
  */
 void lv_obj_style_deinit(void);
 
+/**
+ * Mark the resolved style values cached in an object as outdated.
+ * Called by `lv_obj_refresh_style()`. Needs to be called directly when the result of
+ * resolving the style properties changes without refreshing the style,
+ * e.g. the state or parent of an object changes.
+ * @param obj       pointer to an object
+ * @param prop      the changed property or `LV_STYLE_PROP_ANY`.
+ *                  If it's inheritable the children are invalidated too.
+ */
+void lv_obj_style_invalidate_res_cache(lv_obj_t * obj, lv_style_prop_t prop);
+
 /**
  * Used internally to create a style transition
  * @param obj
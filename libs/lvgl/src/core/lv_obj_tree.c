@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj_private.h"
 #include "lv_obj_class_private.h"
+#include "lv_obj_style_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
 #include "../display/lv_display.h"
@@ -187,6 +188,9 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     obj->parent = parent;
 
+    /*The inherited style properties are coming from an other parent now*/
+    lv_obj_style_invalidate_res_cache(obj, LV_STYLE_PROP_ANY);
+
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
     lv_obj_send_event(old_parent, LV_EVENT_CHILD_CHANGED, obj);
@@ -558,6 +562,8 @@ static void obj_delete_core(lv_obj_t * obj)
     /*All children deleted. Now clean up the object specific data*/
     lv_obj_destruct(obj);
 
+    lv_obj_style_cancel_refresh(obj);
+
     /*Remove the screen for the screen list*/
     if(obj->parent == NULL) {
         lv_display_t * disp = lv_obj_get_display(obj);
@@ -9,9 +9,9 @@
 #include "lv_refr_private.h"
 #include "lv_obj_draw_private.h"
 #include "../misc/lv_area_private.h"
-#include "../draw/sw/lv_draw_sw_mask_private.h"
 #include "../draw/lv_draw_mask_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_style_private.h"
 #include "lv_obj_event_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
@@ -19,10 +19,13 @@
 #include "../misc/lv_timer_private.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_profiler.h"
+#include "../others/telemetry/lv_telemetry_private.h"
 #include "../misc/lv_types.h"
 #include "../draw/lv_draw_private.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_image_cache.h"
+#include "../draw/lv_image_decoder_private.h"
 #include "lv_global.h"
 
 /*********************
@@ -40,13 +43,26 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static int32_t get_join_cost(const lv_area_t * a1, const lv_area_t * a2);
+static void inv_area_remove(lv_display_t * disp, uint32_t idx);
+static void inv_area_remove_covered(lv_display_t * disp, const lv_area_t * area_p, uint32_t skip_idx);
+static bool inv_area_make_room(lv_display_t * disp, const lv_area_t * area_p);
 static void refr_invalid_areas(void);
+static void refr_tiles(void);
+static uint32_t tile_get_slot_cnt(uint32_t slot_size);
+static bool tile_slots_alloc(uint32_t cnt);
+static lv_layer_t * tile_get_layer(uint32_t idx);
+static void tile_render(uint32_t idx, const lv_area_t * tile_area, uint32_t slot_size);
+static void tile_flush(uint32_t cnt, bool last_batch);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_layer_t * layer);
+static void refr_layer_objs(lv_layer_t * layer);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
+static lv_result_t refr_obj_bitmap_cache(lv_layer_t * layer, lv_obj_t * obj, lv_opa_t opa);
+static lv_layer_t * bitmap_cache_render(lv_layer_t * parent_layer, lv_obj_t * obj, const lv_area_t * cache_area);
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
@@ -310,18 +326,25 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     if(res != LV_RESULT_OK) return;
 
     /*Save only if this area is not in one of the saved areas*/
-    uint16_t i;
+    uint32_t i;
     for(i = 0; i < disp->inv_p; i++) {
         if(lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
 
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    /*The saved areas covered by the new one are not required anymore*/
+    inv_area_remove_covered(disp, &com_area, LV_INV_BUF_SIZE);
+
+    /*If there is no free place join the areas with the least extra pixels to redraw
+     *instead of invalidating the whole screen*/
+    if(disp->inv_p >= LV_INV_BUF_SIZE) {
+        if(inv_area_make_room(disp, &com_area)) {
+            lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+            return;
+        }
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
+
+    /*Save the area*/
+    lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
     disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
@@ -345,6 +368,20 @@ void lv_refr_set_disp_refreshing(lv_display_t * disp)
     disp_refr = disp;
 }
 
+void lv_refr_tiles_deinit(lv_display_t * disp)
+{
+    uint32_t i;
+    for(i = 0; i + 1 < disp->tile_slot_cnt; i++) {
+        if(disp->layer_deinit) disp->layer_deinit(disp, &disp->tile_layers[i]);
+    }
+
+    lv_free(disp->tile_bufs);
+    lv_free(disp->tile_layers);
+    disp->tile_bufs = NULL;
+    disp->tile_layers = NULL;
+    disp->tile_slot_cnt = 0;
+}
+
 void lv_display_refr_timer(lv_timer_t * tmr)
 {
     LV_PROFILER_BEGIN;
@@ -374,28 +411,42 @@ void lv_display_refr_timer(lv_timer_t * tmr)
         return;
     }
 
+    /*Do the style refreshes collected while the animations were running*/
+    lv_obj_style_flush_refresh();
+
+    /*Allocate the draw tasks of this refresh from the display's arena*/
+    lv_draw_frame_arena_begin(disp_refr);
+
     lv_display_send_event(disp_refr, LV_EVENT_REFR_START, NULL);
+    LV_TELEMETRY_FRAME_BEGIN(disp_refr);
 
     /*Refresh the screen's layout if required*/
     LV_PROFILER_BEGIN_TAG("layout");
+    LV_TELEMETRY_PHASE_BEGIN(LV_TELEMETRY_PHASE_LAYOUT);
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
 
     lv_obj_update_layout(disp_refr->bottom_layer);
     lv_obj_update_layout(disp_refr->top_layer);
     lv_obj_update_layout(disp_refr->sys_layer);
+    LV_TELEMETRY_PHASE_END(LV_TELEMETRY_PHASE_LAYOUT);
     LV_PROFILER_END_TAG("layout");
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+        disp_refr->refr_px_cnt = 0;
         LV_LOG_WARN("there is no active screen");
         goto refr_finish;
     }
 
+    LV_TELEMETRY_PHASE_BEGIN(LV_TELEMETRY_PHASE_JOIN);
     lv_refr_join_area();
     refr_sync_areas();
+    LV_TELEMETRY_PHASE_END(LV_TELEMETRY_PHASE_JOIN);
+
     refr_invalid_areas();
+    LV_TELEMETRY_FRAME_RENDERED(disp_refr);
 
     if(disp_refr->inv_p == 0) goto refr_finish;
 
@@ -420,11 +471,14 @@ void lv_display_refr_timer(lv_timer_t * tmr)
     disp_refr->inv_p = 0;
 
 refr_finish:
+    lv_draw_frame_arena_end(disp_refr);
 
-#if LV_DRAW_SW_COMPLEX == 1
-    lv_draw_sw_mask_cleanup();
+#if LV_USE_LZ4
+    /*Compress the images evicted while rendering, outside of the image cache lock*/
+    lv_image_cache_compress_pending();
 #endif
 
+    LV_TELEMETRY_FRAME_END(disp_refr);
     lv_display_send_event(disp_refr, LV_EVENT_REFR_READY, NULL);
 
     LV_TRACE_REFR("finished");
@@ -444,34 +498,150 @@ static void lv_refr_join_area(void)
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
+    bool joined = true;
+
+    /*A joined area might overlap with areas which were checked before it was enlarged
+     *so repeat until there is nothing to join*/
+    while(joined) {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas and ignore itself*/
+                if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+                    continue;
+                }
 
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
+                /*Check if the areas are on each other*/
+                if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
+                    continue;
+                }
 
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+                lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+
+                /*Join two area only if the joined area size is smaller*/
+                if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
+                                                     lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
+                    lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    disp_refr->inv_area_joined[join_from] = 1;
+                    joined = true;
+                }
             }
+        }
+    }
 
-            lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+    /*Count the pixels to redraw*/
+    disp_refr->refr_px_cnt = 0;
+    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+        if(disp_refr->inv_area_joined[join_in] == 0) {
+            disp_refr->refr_px_cnt += lv_area_get_size(&disp_refr->inv_areas[join_in]);
+        }
+    }
+    LV_PROFILER_END;
+}
+
+/**
+ * Get how many extra pixels needs to be redrawn if two areas are joined
+ * @param a1    pointer to an area
+ * @param a2    pointer to an other area
+ * @return      the number of extra pixels. Negative if the joined area is smaller than the two areas together.
+ */
+static int32_t get_join_cost(const lv_area_t * a1, const lv_area_t * a2)
+{
+    lv_area_t joined_area;
+    lv_area_join(&joined_area, a1, a2);
+    return (int32_t)lv_area_get_size(&joined_area) - (int32_t)lv_area_get_size(a1) - (int32_t)lv_area_get_size(a2);
+}
+
+/**
+ * Remove a saved invalidated area
+ * @param disp      pointer to a display
+ * @param idx       index of the area to remove
+ */
+static void inv_area_remove(lv_display_t * disp, uint32_t idx)
+{
+    uint32_t i;
+    for(i = idx; i + 1 < disp->inv_p; i++) {
+        disp->inv_areas[i] = disp->inv_areas[i + 1];
+        disp->inv_area_joined[i] = disp->inv_area_joined[i + 1];
+    }
+    disp->inv_p--;
+}
+
+/**
+ * Remove the saved invalidated areas which are fully covered by an area
+ * @param disp      pointer to a display
+ * @param area_p    the covering area
+ * @param skip_idx  don't remove the area with this index (as it's `area_p` itself).
+ *                  Use `LV_INV_BUF_SIZE` to check all areas.
+ */
+static void inv_area_remove_covered(lv_display_t * disp, const lv_area_t * area_p, uint32_t skip_idx)
+{
+    uint32_t i = disp->inv_p;
+    while(i > 0) {
+        i--;
+        if(i == skip_idx) continue;
+        if(lv_area_is_in(&disp->inv_areas[i], area_p, 0)) {
+            inv_area_remove(disp, i);
+        }
+    }
+}
+
+/**
+ * Join two areas when the buffer of the invalidated areas is full.
+ * Either the new area is joined into a saved area, or two saved areas are joined to make room for the new one.
+ * The option which requires redrawing the least extra pixels is selected.
+ * @param disp      pointer to a display
+ * @param area_p    the new area to save
+ * @return          true: `area_p` is covered by a saved area; false: there is room to save `area_p`
+ */
+static bool inv_area_make_room(lv_display_t * disp, const lv_area_t * area_p)
+{
+    LV_PROFILER_BEGIN;
+    uint32_t i;
+    uint32_t j;
+    uint32_t best_i = 0;
+    uint32_t best_j = 0;
+    int32_t best_cost = INT32_MAX;
+    bool join_new = false;
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+    for(i = 0; i < disp->inv_p; i++) {
+        int32_t cost = get_join_cost(&disp->inv_areas[i], area_p);
+        if(cost < best_cost) {
+            best_cost = cost;
+            best_i = i;
+            join_new = true;
+        }
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+        for(j = i + 1; j < disp->inv_p; j++) {
+            cost = get_join_cost(&disp->inv_areas[i], &disp->inv_areas[j]);
+            if(cost < best_cost) {
+                best_cost = cost;
+                best_i = i;
+                best_j = j;
+                join_new = false;
             }
         }
     }
+
+    if(join_new) {
+        lv_area_join(&disp->inv_areas[best_i], &disp->inv_areas[best_i], area_p);
+    }
+    else {
+        lv_area_join(&disp->inv_areas[best_i], &disp->inv_areas[best_i], &disp->inv_areas[best_j]);
+        inv_area_remove(disp, best_j);
+    }
+
+    /*The enlarged area might cover other areas too*/
+    lv_area_t joined_area = disp->inv_areas[best_i];
+    inv_area_remove_covered(disp, &joined_area, best_i);
+
     LV_PROFILER_END;
+    return join_new || lv_area_is_in(area_p, &joined_area, 0);
 }
 
 /**
@@ -577,6 +747,13 @@ static void refr_invalid_areas(void)
     disp_refr->last_part = 0;
     disp_refr->rendering_in_progress = true;
 
+    if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        refr_tiles();
+        disp_refr->rendering_in_progress = false;
+        LV_PROFILER_END;
+        return;
+    }
+
     for(i = 0; i < (int32_t)disp_refr->inv_p; i++) {
         /*Refresh the unjoined areas*/
         if(disp_refr->inv_area_joined[i] == 0) {
@@ -591,6 +768,282 @@ static void refr_invalid_areas(void)
     LV_PROFILER_END;
 }
 
+/**
+ * Mark the tiles touched by the invalidated areas as dirty and redraw them.
+ * As many tiles are rendered at the same time as fit into the draw buffer. Each tile has its own
+ * part of the buffer and its own layer, so the draw units can work on all of them in parallel.
+ * The objects are culled per tile as only the ones on the tile's clip area are drawn.
+ */
+static void refr_tiles(void)
+{
+    LV_PROFILER_BEGIN;
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp_refr);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp_refr);
+
+    int32_t tile_w = disp_refr->tile_w > 0 ? disp_refr->tile_w : LV_DISPLAY_TILE_SIZE_DEF;
+    int32_t tile_h = disp_refr->tile_h > 0 ? disp_refr->tile_h : LV_DISPLAY_TILE_SIZE_DEF;
+    if(tile_w > hor_res) tile_w = hor_res;
+    if(tile_h > ver_res) tile_h = ver_res;
+
+    /*Round the tiles the same way as the invalidated areas, e.g. to the alignment required by the display*/
+    lv_area_t tile_round = {0, 0, tile_w - 1, tile_h - 1};
+    lv_display_send_event(disp_refr, LV_EVENT_INVALIDATE_AREA, &tile_round);
+    tile_w = lv_area_get_width(&tile_round);
+    tile_h = lv_area_get_height(&tile_round);
+
+    /*Make the tiles fit into the draw buffer*/
+    tile_h = get_max_row(disp_refr, tile_w, tile_h);
+    if(tile_h == 0) {
+        LV_PROFILER_END;
+        return;
+    }
+
+    uint32_t col_cnt = (hor_res + tile_w - 1) / tile_w;
+    uint32_t row_cnt = (ver_res + tile_h - 1) / tile_h;
+    uint32_t bitmap_size = (col_cnt * row_cnt + 7) >> 3;
+    if(bitmap_size > disp_refr->tile_dirty_size) {
+        uint8_t * new_bitmap = lv_realloc(disp_refr->tile_dirty, bitmap_size);
+        LV_ASSERT_MALLOC(new_bitmap);
+        if(new_bitmap == NULL) {
+            LV_PROFILER_END;
+            return;
+        }
+        disp_refr->tile_dirty = new_bitmap;
+        disp_refr->tile_dirty_size = bitmap_size;
+    }
+    uint8_t * bitmap = disp_refr->tile_dirty;
+    lv_memzero(bitmap, bitmap_size);
+
+    /*Mark the dirty tiles*/
+    uint32_t i;
+    uint32_t last_tile = 0;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i]) continue;
+        const lv_area_t * a = &disp_refr->inv_areas[i];
+        uint32_t row;
+        uint32_t col;
+        for(row = a->y1 / tile_h; row <= (uint32_t)(a->y2 / tile_h) && row < row_cnt; row++) {
+            for(col = a->x1 / tile_w; col <= (uint32_t)(a->x2 / tile_w) && col < col_cnt; col++) {
+                uint32_t t = row * col_cnt + col;
+                bitmap[t >> 3] |= 1 << (t & 0x7);
+                if(t > last_tile) last_tile = t;
+            }
+        }
+    }
+
+    /*Use as many parts of the draw buffer as possible to render the tiles in parallel*/
+    uint32_t slot_size = LV_COLOR_INDEXED_PALETTE_SIZE(disp_refr->color_format) * sizeof(lv_color32_t) +
+                         lv_draw_buf_width_to_stride(tile_w, disp_refr->color_format) * tile_h;
+    uint32_t slot_cnt = tile_get_slot_cnt(slot_size);
+    if(!tile_slots_alloc(slot_cnt)) {
+        LV_PROFILER_END;
+        return;
+    }
+
+    /*Redraw the dirty tiles. Each of them fits into its slot so it's rendered in one part.*/
+    disp_refr->refr_px_cnt = 0;
+    uint32_t batch_cnt = 0;
+    for(i = 0; i <= last_tile; i++) {
+        if((bitmap[i >> 3] & (1 << (i & 0x7))) == 0) continue;
+
+        lv_area_t tile_area;
+        tile_area.x1 = (i % col_cnt) * tile_w;
+        tile_area.y1 = (i / col_cnt) * tile_h;
+        tile_area.x2 = LV_MIN(tile_area.x1 + tile_w - 1, hor_res - 1);
+        tile_area.y2 = LV_MIN(tile_area.y1 + tile_h - 1, ver_res - 1);
+
+        /*The tiles on the right and bottom edges might be smaller, round them too*/
+        lv_area_t tile_area_round = tile_area;
+        lv_display_send_event(disp_refr, LV_EVENT_INVALIDATE_AREA, &tile_area_round);
+        if(lv_area_get_width(&tile_area_round) <= tile_w && lv_area_get_height(&tile_area_round) <= tile_h) {
+            tile_area = tile_area_round;
+        }
+
+        disp_refr->refr_px_cnt += lv_area_get_size(&tile_area);
+        tile_render(batch_cnt, &tile_area, slot_size);
+        batch_cnt++;
+
+        if(batch_cnt == slot_cnt || i == last_tile) {
+            tile_flush(batch_cnt, i == last_tile);
+            batch_cnt = 0;
+        }
+    }
+
+    LV_PROFILER_END;
+}
+
+/**
+ * Get how many tiles fit into the draw buffer
+ * @param slot_size     the size of a tile's buffer in bytes
+ * @return              number of tiles which can be rendered at the same time
+ */
+static uint32_t tile_get_slot_cnt(uint32_t slot_size)
+{
+    lv_draw_buf_t * buf = disp_refr->buf_act;
+    uintptr_t data_end = (uintptr_t)buf->data + buf->data_size;
+    uint8_t * data = buf->data;
+    uint32_t cnt = 0;
+    while(1) {
+        data = lv_draw_buf_align(data, disp_refr->color_format);
+        if((uintptr_t)data + slot_size > data_end) break;
+        data += slot_size;
+        cnt++;
+    }
+
+    return LV_MAX(cnt, 1);
+}
+
+/**
+ * Allocate the draw buffer descriptors and layers of the tiles rendered at the same time
+ * @param cnt   number of tiles
+ * @return      true: the descriptors and layers are available
+ */
+static bool tile_slots_alloc(uint32_t cnt)
+{
+    if(cnt <= disp_refr->tile_slot_cnt) return true;
+
+    lv_refr_tiles_deinit(disp_refr);
+
+    /*The first tile is rendered on the display's layer*/
+    disp_refr->tile_bufs = lv_malloc_zeroed(cnt * sizeof(lv_draw_buf_t));
+    LV_ASSERT_MALLOC(disp_refr->tile_bufs);
+    if(cnt > 1) {
+        disp_refr->tile_layers = lv_malloc_zeroed((cnt - 1) * sizeof(lv_layer_t));
+        LV_ASSERT_MALLOC(disp_refr->tile_layers);
+    }
+
+    if(disp_refr->tile_bufs == NULL || (cnt > 1 && disp_refr->tile_layers == NULL)) {
+        lv_free(disp_refr->tile_bufs);
+        lv_free(disp_refr->tile_layers);
+        disp_refr->tile_bufs = NULL;
+        disp_refr->tile_layers = NULL;
+        return false;
+    }
+
+    disp_refr->tile_slot_cnt = cnt;
+    uint32_t i;
+    for(i = 0; i < cnt - 1; i++) {
+        if(disp_refr->layer_init) disp_refr->layer_init(disp_refr, &disp_refr->tile_layers[i]);
+    }
+
+    return true;
+}
+
+static lv_layer_t * tile_get_layer(uint32_t idx)
+{
+    return idx == 0 ? disp_refr->layer_head : &disp_refr->tile_layers[idx - 1];
+}
+
+/**
+ * Set up the layer of a tile and add the draw tasks of the objects on the tile.
+ * The draw tasks are dispatched immediately, so the tiles added earlier are being rendered meanwhile.
+ * @param idx           index of the tile in the current batch
+ * @param tile_area     the area of the tile
+ * @param slot_size     the size of a tile's buffer in bytes
+ */
+static void tile_render(uint32_t idx, const lv_area_t * tile_area, uint32_t slot_size)
+{
+    LV_PROFILER_BEGIN;
+    /*In single buffered mode wait until the tiles of the previous batch are flushed*/
+    if(idx == 0 && !lv_display_is_double_buffered(disp_refr)) {
+        wait_for_flushing(disp_refr);
+    }
+
+    /*Find the part of the buffer for this tile*/
+    lv_color_format_t cf = disp_refr->color_format;
+    uint8_t * data = disp_refr->buf_act->data;
+    uint32_t i;
+    for(i = 0; i < idx; i++) {
+        data = (uint8_t *)lv_draw_buf_align(data, cf) + slot_size;
+    }
+    data = lv_draw_buf_align(data, cf);
+
+    lv_draw_buf_t * buf = &disp_refr->tile_bufs[idx];
+    lv_draw_buf_init(buf, lv_area_get_width(tile_area), lv_area_get_height(tile_area), cf, LV_STRIDE_AUTO,
+                     data, slot_size);
+
+    lv_layer_t * layer = tile_get_layer(idx);
+    layer->draw_buf = buf;
+    layer->buf_area = *tile_area;
+    layer->_clip_area = *tile_area;
+    layer->phy_clip_area = *tile_area;
+    layer->color_format = cf;
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+    lv_matrix_identity(&layer->matrix);
+#endif
+
+    /*Let the dispatcher see this layer too*/
+    if(idx > 0) {
+        lv_layer_t * layer_prev = tile_get_layer(idx - 1);
+        layer->next = layer_prev->next;
+        layer_prev->next = layer;
+    }
+
+    disp_refr->refreshed_area = *tile_area;
+    if(lv_color_format_has_alpha(cf)) {
+        lv_draw_buf_clear(buf, NULL);
+    }
+
+    refr_layer_objs(layer);
+    LV_PROFILER_END;
+}
+
+/**
+ * Wait until the tiles of a batch are rendered and flush them one by one
+ * @param cnt           number of tiles in the batch
+ * @param last_batch    true: these are the last tiles of the refresh
+ */
+static void tile_flush(uint32_t cnt, bool last_batch)
+{
+    LV_PROFILER_BEGIN;
+    LV_TELEMETRY_PHASE_BEGIN(LV_TELEMETRY_PHASE_RENDER);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_layer_t * layer = tile_get_layer(i);
+        while(layer->draw_task_head) {
+            lv_draw_dispatch_wait_for_request();
+            lv_draw_dispatch();
+        }
+    }
+    LV_TELEMETRY_PHASE_END(LV_TELEMETRY_PHASE_RENDER);
+
+    /*The layers of the tiles are not dispatched anymore*/
+    lv_layer_t * layer = disp_refr->layer_head;
+    while(layer->next) {
+        if(disp_refr->tile_layers && layer->next >= disp_refr->tile_layers &&
+           layer->next < disp_refr->tile_layers + disp_refr->tile_slot_cnt - 1) {
+            layer->next = layer->next->next;
+        }
+        else {
+            layer = layer->next;
+        }
+    }
+
+    for(i = 0; i < cnt; i++) {
+        /*Each tile needs to be flushed before flushing the next one.
+         *In double buffered mode the last tile of the previous batch might still be being flushed.*/
+        if(i > 0 || lv_display_is_double_buffered(disp_refr)) {
+            wait_for_flushing(disp_refr);
+        }
+
+        layer = tile_get_layer(i);
+        disp_refr->refreshed_area = layer->buf_area;
+        disp_refr->last_area = last_batch && i == cnt - 1 ? 1 : 0;
+        disp_refr->last_part = 1;
+        disp_refr->flushing = 1;
+        disp_refr->flushing_last = disp_refr->last_area;
+        if(disp_refr->flush_cb) {
+            call_flush_cb(disp_refr, &layer->buf_area, layer->draw_buf->data);
+        }
+    }
+
+    /*Render the next batch into the other buffer while these tiles are being flushed*/
+    if(lv_display_is_double_buffered(disp_refr)) {
+        disp_refr->buf_act = disp_refr->buf_act == disp_refr->buf_1 ? disp_refr->buf_2 : disp_refr->buf_1;
+    }
+    LV_PROFILER_END;
+}
+
 /**
  * Reshape the draw buffer if required
  * @param layer  pointer to a layer which will be drawn
@@ -718,6 +1171,20 @@ static void refr_area_part(lv_layer_t * layer)
         lv_draw_buf_clear(layer->draw_buf, &a);
     }
 
+    refr_layer_objs(layer);
+
+    draw_buf_flush(disp_refr);
+    LV_PROFILER_END;
+}
+
+/**
+ * Add the draw tasks of the screens and the display's layers to a layer
+ * @param layer     the layer to draw on. Only its clip area is redrawn.
+ */
+static void refr_layer_objs(lv_layer_t * layer)
+{
+    LV_TELEMETRY_PHASE_BEGIN(LV_TELEMETRY_PHASE_DRAW_CREATE);
+
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
@@ -757,8 +1224,7 @@ static void refr_area_part(lv_layer_t * layer)
     refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
     refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
 
-    draw_buf_flush(disp_refr);
-    LV_PROFILER_END;
+    LV_TELEMETRY_PHASE_END(LV_TELEMETRY_PHASE_DRAW_CREATE);
 }
 
 /**
@@ -1019,6 +1485,12 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     lv_opa_t opa = lv_obj_get_style_opa_layered(obj, 0);
     if(opa < LV_OPA_MIN) return;
 
+    /*Blend the cached image if possible. Else fall back to the normal rendering*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_AS_BITMAP) &&
+       refr_obj_bitmap_cache(layer, obj, opa) == LV_RESULT_OK) {
+        return;
+    }
+
 #if LV_DRAW_TRANSFORM_USE_MATRIX
     /*If the layer opa is full then use the matrix transform*/
     if(opa >= LV_OPA_MAX && !refr_check_obj_clip_overflow(layer, obj)) {
@@ -1106,6 +1578,120 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     }
 }
 
+/**
+ * Draw an object from its bitmap cache. Render the cache first if the object has changed.
+ * @param layer     pointer to the layer to draw to
+ * @param obj       pointer to an object with `LV_OBJ_FLAG_CACHE_AS_BITMAP`
+ * @param opa       the `opa_layered` of the object
+ * @return          LV_RESULT_OK: drawn; LV_RESULT_INVALID: the cache couldn't be created
+ */
+static lv_result_t refr_obj_bitmap_cache(lv_layer_t * layer, lv_obj_t * obj, lv_opa_t opa)
+{
+    /*The children can be drawn anywhere, outside of the cached area too*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        lv_obj_free_bitmap_cache(obj);
+        return LV_RESULT_INVALID;
+    }
+
+    lv_area_t cache_area;
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &cache_area);
+    lv_area_increase(&cache_area, ext_draw_size, ext_draw_size);
+
+    /*Don't render the cache if the object is not visible yet*/
+    lv_area_t tranf_area = cache_area;
+    lv_obj_get_transformed_area(obj, &tranf_area, LV_OBJ_POINT_TRANSFORM_FLAG_NONE);
+    lv_area_t clip_area;
+    if(!lv_area_intersect(&clip_area, &layer->_clip_area, &tranf_area)) return LV_RESULT_OK;
+
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr == NULL) return LV_RESULT_INVALID;
+
+    int32_t w = lv_area_get_width(&cache_area);
+    int32_t h = lv_area_get_height(&cache_area);
+    lv_draw_buf_t * cache = obj->spec_attr->bitmap_cache;
+    if(cache == NULL || cache->header.w != w || cache->header.h != h) {
+        lv_obj_free_bitmap_cache(obj);
+        cache = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+        if(cache == NULL) {
+            LV_LOG_WARN("Couldn't allocate the bitmap cache (%" LV_PRId32 "x%" LV_PRId32 ")", w, h);
+            return LV_RESULT_INVALID;
+        }
+        obj->spec_attr->bitmap_cache = cache;
+    }
+
+    lv_layer_t * cache_layer = NULL;
+    if(!obj->spec_attr->bitmap_cache_valid) {
+        cache_layer = bitmap_cache_render(layer, obj, &cache_area);
+        if(cache_layer == NULL) return LV_RESULT_INVALID;
+        obj->spec_attr->bitmap_cache_valid = 1;
+    }
+
+    lv_point_t pivot = {
+        .x = lv_obj_get_style_transform_pivot_x(obj, 0),
+        .y = lv_obj_get_style_transform_pivot_y(obj, 0)
+    };
+    pivot.x = lv_pct_to_px(pivot.x, lv_area_get_width(&obj->coords));
+    pivot.y = lv_pct_to_px(pivot.y, lv_area_get_height(&obj->coords));
+
+    lv_draw_image_dsc_t draw_dsc;
+    lv_draw_image_dsc_init(&draw_dsc);
+    draw_dsc.pivot.x = obj->coords.x1 + pivot.x - cache_area.x1;
+    draw_dsc.pivot.y = obj->coords.y1 + pivot.y - cache_area.y1;
+    draw_dsc.opa = opa;
+    draw_dsc.rotation = lv_obj_get_style_transform_rotation(obj, 0);
+    while(draw_dsc.rotation > 3600) draw_dsc.rotation -= 3600;
+    while(draw_dsc.rotation < 0) draw_dsc.rotation += 3600;
+    draw_dsc.scale_x = lv_obj_get_style_transform_scale_x(obj, 0);
+    draw_dsc.scale_y = lv_obj_get_style_transform_scale_y(obj, 0);
+    draw_dsc.skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
+    draw_dsc.skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
+    draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+    draw_dsc.antialias = disp_refr->antialiasing;
+    draw_dsc.bitmap_mask_src = lv_obj_get_style_bitmap_mask_src(obj, 0);
+
+    if(cache_layer) {
+        /*Blended when all the tasks of the cache layer are ready like any other layer*/
+        draw_dsc.src = cache_layer;
+        lv_draw_layer(layer, &draw_dsc, &cache_area);
+    }
+    else {
+        draw_dsc.src = cache;
+        lv_draw_image(layer, &draw_dsc, &cache_area);
+    }
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Create a layer which renders an object and its children into its bitmap cache.
+ * @param parent_layer  the layer where the cache will be blended
+ * @param obj           pointer to an object with a bitmap cache
+ * @param cache_area    the area of the object to render in absolute coordinates
+ * @return              the new layer or NULL on error
+ */
+static lv_layer_t * bitmap_cache_render(lv_layer_t * parent_layer, lv_obj_t * obj, const lv_area_t * cache_area)
+{
+    lv_draw_buf_t * cache = obj->spec_attr->bitmap_cache;
+
+    lv_layer_t * cache_layer = lv_draw_layer_create(parent_layer, LV_COLOR_FORMAT_ARGB8888, cache_area);
+    if(cache_layer == NULL) return NULL;
+
+    /*The previous content might be in the image cache*/
+    lv_image_cache_drop(cache);
+    lv_draw_buf_clear(cache, NULL);
+
+    /*Render directly into the cache and keep it after blending*/
+    cache_layer->draw_buf = cache;
+    cache_layer->keep_draw_buf = true;
+
+    LV_PROFILER_BEGIN_TAG("refr_bitmap_cache_render");
+    lv_obj_redraw(cache_layer, obj);
+    LV_PROFILER_END_TAG("refr_bitmap_cache_render");
+
+    return cache_layer;
+}
+
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 {
     lv_color_format_t cf = disp->color_format;
@@ -1154,10 +1740,12 @@ static void draw_buf_flush(lv_display_t * disp)
     /*Flush the rendered content to the display*/
     lv_layer_t * layer = disp->layer_head;
 
+    LV_TELEMETRY_PHASE_BEGIN(LV_TELEMETRY_PHASE_RENDER);
     while(layer->draw_task_head) {
         lv_draw_dispatch_wait_for_request();
         lv_draw_dispatch();
     }
+    LV_TELEMETRY_PHASE_END(LV_TELEMETRY_PHASE_RENDER);
 
     /* In double buffered mode wait until the other buffer is freed
      * and driver is ready to receive the new buffer.
@@ -1202,6 +1790,7 @@ static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t *
     };
 
     lv_display_send_event(disp, LV_EVENT_FLUSH_START, &offset_area);
+    LV_TELEMETRY_PHASE_BEGIN(LV_TELEMETRY_PHASE_FLUSH);
 
     /*For backward compatibility support LV_COLOR_16_SWAP (from v8)*/
 #if defined(LV_COLOR_16_SWAP) && LV_COLOR_16_SWAP
@@ -1209,6 +1798,7 @@ static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t *
 #endif
 
     disp->flush_cb(disp, &offset_area, px_map);
+    LV_TELEMETRY_PHASE_END(LV_TELEMETRY_PHASE_FLUSH);
     lv_display_send_event(disp, LV_EVENT_FLUSH_FINISH, &offset_area);
 
     LV_PROFILER_END;
@@ -1220,6 +1810,7 @@ static void wait_for_flushing(lv_display_t * disp)
     LV_LOG_TRACE("begin");
 
     lv_display_send_event(disp, LV_EVENT_FLUSH_WAIT_START, NULL);
+    LV_TELEMETRY_PHASE_BEGIN(LV_TELEMETRY_PHASE_FLUSH);
 
     if(disp->flush_wait_cb) {
         if(disp->flushing) {
@@ -1232,6 +1823,7 @@ static void wait_for_flushing(lv_display_t * disp)
     }
     disp->flushing_last = 0;
 
+    LV_TELEMETRY_PHASE_END(LV_TELEMETRY_PHASE_FLUSH);
     lv_display_send_event(disp, LV_EVENT_FLUSH_WAIT_FINISH, NULL);
 
     LV_LOG_TRACE("end");
@@ -58,6 +58,13 @@ lv_display_t * lv_refr_get_disp_refreshing(void);
  */
 void lv_refr_set_disp_refreshing(lv_display_t * disp);
 
+/**
+ * Free the draw buffer descriptors and layers used to render the tiles of a display
+ * in `LV_DISPLAY_RENDER_MODE_TILED`
+ * @param disp pointer to a display
+ */
+void lv_refr_tiles_deinit(lv_display_t * disp);
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
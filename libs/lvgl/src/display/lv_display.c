@@ -198,11 +198,16 @@ void lv_display_delete(lv_display_t * disp)
     }
 
     lv_ll_clear(&disp->sync_areas);
+    lv_free(disp->tile_dirty);
+    lv_refr_tiles_deinit(disp);
     lv_ll_remove(disp_ll_p, disp);
     if(disp->refr_timer) lv_timer_delete(disp->refr_timer);
 
     if(disp->layer_deinit) disp->layer_deinit(disp, disp->layer_head);
     lv_free(disp->layer_head);
+#if LV_DRAW_FRAME_ARENA_SIZE
+    lv_free(disp->frame_arena);
+#endif
 
     lv_free(disp);
 
@@ -428,8 +433,8 @@ void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint3
     LV_ASSERT_FORMAT_MSG(buf2 == NULL || buf2 == lv_draw_buf_align(buf2, cf), "buf2 is not aligned: %p", buf2);
 
     uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
-    if(render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        /* for partial mode, we calculate the height based on the buf_size and stride */
+    if(render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL || render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        /* for partial and tiled mode, we calculate the height based on the buf_size and stride */
         h = buf_size / stride;
         LV_ASSERT_MSG(h != 0, "the buffer is too small");
     }
@@ -451,6 +456,19 @@ void lv_display_set_render_mode(lv_display_t * disp, lv_display_render_mode_t re
     disp->render_mode = render_mode;
 }
 
+void lv_display_set_tile_size(lv_display_t * disp, int32_t w, int32_t h)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->tile_w = w;
+    disp->tile_h = h;
+
+    if(disp->render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        lv_obj_invalidate(disp->sys_layer);
+    }
+}
+
 void lv_display_set_flush_cb(lv_display_t * disp, lv_display_flush_cb_t flush_cb)
 {
     if(disp == NULL) disp = lv_display_get_default();
@@ -885,6 +903,17 @@ bool lv_display_is_invalidation_enabled(lv_display_t * disp)
     return (disp->inv_en_cnt > 0);
 }
 
+uint32_t lv_display_get_refr_px_count(lv_display_t * disp)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) {
+        LV_LOG_WARN("no display registered");
+        return 0;
+    }
+
+    return disp->refr_px_cnt;
+}
+
 lv_timer_t * lv_display_get_refr_timer(lv_display_t * disp)
 {
     if(!disp) disp = lv_display_get_default();
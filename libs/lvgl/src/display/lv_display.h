@@ -57,6 +57,14 @@ typedef enum {
      * With 2 buffers in flush_cb only and address change is required.
      */
     LV_DISPLAY_RENDER_MODE_FULL,
+
+    /**
+     * Divide the screen into fixed size tiles and redraw only the tiles with changed pixels.
+     * The buffer(s) needs to hold only one tile so a small, cache friendly buffer can be used.
+     * If the buffer can hold more tiles they are rendered in parallel.
+     * The tile size can be set by `lv_display_set_tile_size`.
+     */
+    LV_DISPLAY_RENDER_MODE_TILED,
 } lv_display_render_mode_t;
 
 typedef enum {
@@ -234,7 +242,7 @@ int32_t lv_display_get_dpi(const lv_display_t * disp);
  * @param buf1              first buffer
  * @param buf2              second buffer (can be `NULL`)
  * @param buf_size          buffer size in byte
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint32_t buf_size,
                             lv_display_render_mode_t render_mode);
@@ -252,10 +260,19 @@ void lv_display_set_draw_buffers(lv_display_t * disp, lv_draw_buf_t * buf1, lv_d
 /**
  * Set display render mode
  * @param disp              pointer to a display
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_render_mode(lv_display_t * disp, lv_display_render_mode_t render_mode);
 
+/**
+ * Set the size of the tiles in `LV_DISPLAY_RENDER_MODE_TILED`.
+ * The height of the tiles is reduced if a tile doesn't fit into the draw buffer.
+ * @param disp              pointer to a display
+ * @param w                 width of the tiles or 0 to use `LV_DISPLAY_TILE_SIZE_DEF`
+ * @param h                 height of the tiles or 0 to use `LV_DISPLAY_TILE_SIZE_DEF`
+ */
+void lv_display_set_tile_size(lv_display_t * disp, int32_t w, int32_t h);
+
 /**
  * Set the flush callback which will be called to copy the rendered image to the display.
  * @param disp      pointer to a display
@@ -506,6 +523,14 @@ void lv_display_enable_invalidation(lv_display_t * disp, bool en);
  */
 bool lv_display_is_invalidation_enabled(lv_display_t * disp);
 
+/**
+ * Get the number of pixels redrawn in the last refresh.
+ * It's the total size of the invalidated areas after joining them.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          number of redrawn pixels
+ */
+uint32_t lv_display_get_refr_px_count(lv_display_t * disp);
+
 /**
  * Get a pointer to the screen refresher timer to
  * modify its parameters with `lv_timer_...` functions.
@@ -29,6 +29,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
 #endif
 
+#ifndef LV_DISPLAY_TILE_SIZE_DEF
+#define LV_DISPLAY_TILE_SIZE_DEF 64 /**< Default tile width and height in `LV_DISPLAY_RENDER_MODE_TILED` */
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -103,9 +107,26 @@ struct lv_display_t {
     uint32_t inv_p;
     int32_t inv_en_cnt;
 
+    /** Number of pixels redrawn in the last refresh (the total size of the joined invalidated areas)*/
+    uint32_t refr_px_cnt;
+
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
 
+    /** Tile size in `LV_DISPLAY_RENDER_MODE_TILED`. 0: use `LV_DISPLAY_TILE_SIZE_DEF`*/
+    int32_t tile_w;
+    int32_t tile_h;
+
+    /** Bitmap of the tiles to redraw in `LV_DISPLAY_RENDER_MODE_TILED` (1 bit per tile, row by row)*/
+    uint8_t * tile_dirty;
+    uint32_t tile_dirty_size;
+
+    /** The draw buffers and layers of the tiles rendered at the same time in `LV_DISPLAY_RENDER_MODE_TILED`.
+     * The draw buffers point into the active buffer. The first tile uses `layer_head` as its layer.*/
+    lv_draw_buf_t * tile_bufs;
+    lv_layer_t * tile_layers;
+    uint32_t tile_slot_cnt;
+
     lv_draw_buf_t _static_buf1; /**< Used when user pass in a raw buffer as display draw buffer */
     lv_draw_buf_t _static_buf2;
     /*---------------------
@@ -115,6 +136,14 @@ struct lv_display_t {
     void (*layer_init)(lv_display_t * disp, lv_layer_t * layer);
     void (*layer_deinit)(lv_display_t * disp, lv_layer_t * layer);
 
+#if LV_DRAW_FRAME_ARENA_SIZE
+    /** `LV_DRAW_FRAME_ARENA_SIZE` bytes for the draw tasks of a refresh. Allocated on the first refresh.*/
+    uint8_t * frame_arena;
+    uint32_t frame_arena_used;          /**< Bytes allocated since the last reset*/
+    uint32_t frame_arena_alloc_cnt;     /**< Allocations in the arena not freed yet, by any layer*/
+    uint32_t frame_arena_active : 1;    /**< Allocate from the arena. Set only while refreshing.*/
+#endif
+
     /*---------------------
      * Screens
      *--------------------*/
@@ -16,6 +16,7 @@
 #include "../display/lv_display_private.h"
 #include "../core/lv_global.h"
 #include "../core/lv_refr_private.h"
+#include "../others/telemetry/lv_telemetry_private.h"
 #include "../stdlib/lv_string.h"
 
 /*********************
@@ -23,6 +24,12 @@
  *********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+/*Alignment of the allocations in the frame arena*/
+#define FRAME_ARENA_ALIGN 8
+
+#define LV_DRAW_TASK_INDEX_HASH(cx, cy) \
+    ((((uint32_t)(cx) * 73856093U) ^ ((uint32_t)(cy) * 19349663U)) & (LV_DRAW_TASK_INDEX_BUCKET_CNT - 1))
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,7 +37,17 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
+static void task_link(lv_layer_t * layer, lv_draw_task_t * t);
+static void task_unlink(lv_layer_t * layer, lv_draw_task_t * t);
+static void task_finish_unsupported(lv_layer_t * layer, lv_draw_task_t * t);
+static bool index_get_cells(const lv_area_t * area, lv_area_t * cells);
+static void index_add(lv_draw_task_t * t);
+static void index_remove(lv_draw_task_t * t);
+static void bucket_remove(lv_array_t * bucket, lv_draw_task_t * t);
+static void index_check_bucket(lv_array_t * bucket, lv_layer_t * layer, lv_draw_task_t * t_check);
+static void ready_queue_push(lv_layer_t * layer, lv_draw_task_t * t);
+static void ready_queue_remove(lv_layer_t * layer, lv_draw_task_t * t_prev, lv_draw_task_t * t);
+static void ready_queue_purge(lv_layer_t * layer);
 
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
 {
@@ -65,6 +82,12 @@ void lv_draw_deinit(void)
     lv_thread_sync_delete(&_draw_info.sync);
 #endif
 
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TASK_INDEX_BUCKET_CNT; i++) {
+        lv_array_deinit(&_draw_info.task_index[i]);
+    }
+    lv_array_deinit(&_draw_info.task_index_large);
+
     lv_draw_unit_t * u = _draw_info.unit_head;
     while(u) {
         lv_draw_unit_t * cur_unit = u;
@@ -87,10 +110,86 @@ void * lv_draw_create_unit(size_t size)
     return new_unit;
 }
 
+void * lv_draw_frame_malloc(size_t size)
+{
+#if LV_DRAW_FRAME_ARENA_SIZE
+    lv_display_t * disp = lv_refr_get_disp_refreshing();
+    if(disp && disp->frame_arena_active && disp->frame_arena) {
+        size_t size_aligned = LV_ALIGN_UP(size, FRAME_ARENA_ALIGN);
+        if(size_aligned <= LV_DRAW_FRAME_ARENA_SIZE - disp->frame_arena_used) {
+            void * data = disp->frame_arena + disp->frame_arena_used;
+            disp->frame_arena_used += size_aligned;
+            disp->frame_arena_alloc_cnt++;
+            return data;
+        }
+    }
+#endif
+
+    /*Not refreshing or the arena is full*/
+    return lv_malloc(size);
+}
+
+void lv_draw_frame_free(void * data)
+{
+    if(data == NULL) return;
+
+#if LV_DRAW_FRAME_ARENA_SIZE
+    /*The arena is reset at once later, when nothing is left in it*/
+    lv_display_t * disp = lv_display_get_next(NULL);
+    while(disp) {
+        if(disp->frame_arena &&
+           (uint8_t *)data >= disp->frame_arena &&
+           (uint8_t *)data < disp->frame_arena + LV_DRAW_FRAME_ARENA_SIZE) {
+            LV_ASSERT(disp->frame_arena_alloc_cnt > 0);
+            disp->frame_arena_alloc_cnt--;
+            return;
+        }
+        disp = lv_display_get_next(disp);
+    }
+#endif
+
+    lv_free(data);
+}
+
+void lv_draw_frame_arena_begin(lv_display_t * disp)
+{
+#if LV_DRAW_FRAME_ARENA_SIZE
+    if(disp->frame_arena == NULL) {
+        disp->frame_arena = lv_malloc(LV_DRAW_FRAME_ARENA_SIZE);
+        if(disp->frame_arena == NULL) {
+            LV_LOG_WARN("Couldn't allocate the frame arena, using the heap");
+        }
+        disp->frame_arena_used = 0;
+        disp->frame_arena_alloc_cnt = 0;
+    }
+    disp->frame_arena_active = 1;
+#else
+    LV_UNUSED(disp);
+#endif
+}
+
+void lv_draw_frame_arena_end(lv_display_t * disp)
+{
+#if LV_DRAW_FRAME_ARENA_SIZE
+    disp->frame_arena_active = 0;
+
+    /*Normally all the draw tasks and layers are freed by now. If not (e.g. a canvas layer
+     *initialized while refreshing is finished later), keep their memory;
+     *the arena will be reset after a later refresh.*/
+    if(disp->frame_arena_alloc_cnt) return;
+
+    disp->frame_arena_used = 0;
+#else
+    LV_UNUSED(disp);
+#endif
+}
+
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 {
     LV_PROFILER_BEGIN;
-    lv_draw_task_t * new_task = lv_malloc_zeroed(sizeof(lv_draw_task_t));
+    lv_draw_task_t * new_task = lv_draw_frame_malloc(sizeof(lv_draw_task_t));
+    LV_ASSERT_MALLOC(new_task);
+    lv_memzero(new_task, sizeof(lv_draw_task_t));
 
     new_task->area = *coords;
     new_task->_real_area = *coords;
@@ -99,6 +198,7 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
     new_task->matrix = layer->matrix;
 #endif
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
+    LV_TELEMETRY_DRAW_TASK_ADDED();
 
     /*Find the tail*/
     if(layer->draw_task_head == NULL) {
@@ -123,6 +223,10 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
 
     lv_draw_global_info_t * info = &_draw_info;
 
+    /*Resolve the dependencies now, so that the tasks added in LV_EVENT_DRAW_TASK_ADDED
+     *will depend on this task and not the other way around*/
+    task_link(layer, t);
+
     /*Send LV_EVENT_DRAW_TASK_ADDED and dispatch only on the "main" draw_task
      *and not on the draw tasks added in the event.
      *Sending LV_EVENT_DRAW_TASK_ADDED events might cause recursive event sends and besides
@@ -195,6 +299,10 @@ void lv_draw_dispatch(void)
 bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
 {
     LV_PROFILER_BEGIN;
+    /*Drop the tasks already taken by the draw units from the ready queue
+     *to not leave dangling pointers there when they are freed*/
+    ready_queue_purge(layer);
+
     /*Remove the finished tasks first*/
     lv_draw_task_t * t_prev = NULL;
     lv_draw_task_t * t = layer->draw_task_head;
@@ -204,12 +312,15 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
             if(t_prev) t_prev->next = t->next;      /*Remove it by assigning the next task to the previous*/
             else layer->draw_task_head = t_next;    /*If it was the head, set the next as head*/
 
+            /*Let the dependent tasks know that this task is finished*/
+            task_unlink(layer, t);
+
             /*If it was layer drawing free the layer too*/
             if(t->type == LV_DRAW_TASK_TYPE_LAYER) {
                 lv_draw_image_dsc_t * draw_image_dsc = t->draw_dsc;
                 lv_layer_t * layer_drawn = (lv_layer_t *)draw_image_dsc->src;
 
-                if(layer_drawn->draw_buf) {
+                if(layer_drawn->draw_buf && !layer_drawn->keep_draw_buf) {
                     int32_t h = lv_area_get_height(&layer_drawn->buf_area);
                     uint32_t layer_size_byte = h * layer_drawn->draw_buf->header.stride;
 
@@ -231,7 +342,7 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
                     }
 
                     if(disp->layer_deinit) disp->layer_deinit(disp, layer_drawn);
-                    lv_free(layer_drawn);
+                    lv_draw_frame_free(layer_drawn);
                 }
             }
             lv_draw_label_dsc_t * draw_label_dsc = lv_draw_task_get_label_dsc(t);
@@ -240,8 +351,8 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
                 draw_label_dsc->text = NULL;
             }
 
-            lv_free(t->draw_dsc);
-            lv_free(t);
+            lv_draw_frame_free(t->draw_dsc);
+            lv_draw_frame_free(t);
         }
         else {
             t_prev = t;
@@ -260,6 +371,7 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
                 lv_draw_image_dsc_t * draw_dsc = t_src->draw_dsc;
                 if(draw_dsc->src == layer) {
                     t_src->state = LV_DRAW_TASK_STATE_QUEUED;
+                    if(t_src->linked && t_src->dep_cnt == 0) ready_queue_push(layer->parent, t_src);
                     lv_draw_dispatch_request();
                     break;
                 }
@@ -311,63 +423,42 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
 {
     LV_PROFILER_BEGIN;
 
-    /* If there is only 1 draw unit the task can be consumed linearly as
-     * they are added in the correct order. However, it can happen that
-     * there is a `LV_DRAW_TASK_TYPE_LAYER` which can be blended only when
-     * all its tasks are ready. As other areas might be on top of that
-     * layer-to-blend don't skip it. Instead stop there, so that the
-     * draw tasks of that layer can be consumed and can be finished.
-     * After that this layer-to-blenf will have `LV_DRAW_TASK_STATE_QUEUED`
-     * so it can be blended normally.*/
-    if(_draw_info.unit_cnt <= 1) {
-        lv_draw_task_t * t = layer->draw_task_head;
-        while(t) {
-            /*Mark unsupported draw tasks as ready as no one else will consume them*/
-            if(t->state == LV_DRAW_TASK_STATE_QUEUED &&
-               t->preferred_draw_unit_id != LV_DRAW_UNIT_NONE &&
-               t->preferred_draw_unit_id != draw_unit_id) {
-                t->state = LV_DRAW_TASK_STATE_READY;
-            }
-            /*Not queued yet, leave this layer while the first task will be queued*/
-            else if(t->state != LV_DRAW_TASK_STATE_QUEUED) {
-                t = NULL;
-                break;
-            }
-            /*It's a supported and queued task, process it*/
-            else {
-                break;
-            }
-            t = t->next;
-        }
-        LV_PROFILER_END;
-        return t;
-    }
+    /* Only the tasks whose overlapping older tasks are all finished are in the ready queue,
+     * so any queued task found there is independent of the others.
+     * If there is only 1 draw unit mark the unsupported draw tasks as ready
+     * as no one else will consume them.*/
+    bool single_unit = _draw_info.unit_cnt <= 1;
 
-    /*Handle the case of multiply draw units*/
+    /*Continue after `t_prev` only if it's still in the queue*/
+    bool skip = t_prev && t_prev->linked && t_prev->dep_cnt == 0 && t_prev->state == LV_DRAW_TASK_STATE_QUEUED;
 
-    /*If the first task is screen sized, there cannot be independent areas*/
-    if(layer->draw_task_head) {
-        int32_t hor_res = lv_display_get_horizontal_resolution(lv_refr_get_disp_refreshing());
-        int32_t ver_res = lv_display_get_vertical_resolution(lv_refr_get_disp_refreshing());
-        lv_draw_task_t * t = layer->draw_task_head;
-        if(t->state != LV_DRAW_TASK_STATE_QUEUED &&
-           t->area.x1 <= 0 && t->area.x2 >= hor_res - 1 &&
-           t->area.y1 <= 0 && t->area.y2 >= ver_res - 1) {
-            LV_PROFILER_END;
-            return NULL;
-        }
-    }
-
-    lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
+    lv_draw_task_t * t_ready_prev = NULL;
+    lv_draw_task_t * t = layer->draw_task_ready_head;
     while(t) {
-        /*Find a queued and independent task*/
-        if(t->state == LV_DRAW_TASK_STATE_QUEUED &&
-           (t->preferred_draw_unit_id == LV_DRAW_UNIT_NONE || t->preferred_draw_unit_id == draw_unit_id) &&
-           is_independent(layer, t)) {
+        lv_draw_task_t * t_next = t->ready_next;
+        if(t->state != LV_DRAW_TASK_STATE_QUEUED) {
+            /*Already taken by a draw unit*/
+            ready_queue_remove(layer, t_ready_prev, t);
+        }
+        else if(skip) {
+            if(t == t_prev) skip = false;
+            t_ready_prev = t;
+        }
+        else if(t->preferred_draw_unit_id == LV_DRAW_UNIT_NONE || t->preferred_draw_unit_id == draw_unit_id) {
             LV_PROFILER_END;
             return t;
         }
-        t = t->next;
+        else if(single_unit) {
+            ready_queue_remove(layer, t_ready_prev, t);
+            task_finish_unsupported(layer, t);
+
+            /*The released tasks were added to the end of the queue, don't miss them*/
+            t_next = t_ready_prev ? t_ready_prev->ready_next : layer->draw_task_ready_head;
+        }
+        else {
+            t_ready_prev = t;
+        }
+        t = t_next;
     }
 
     LV_PROFILER_END;
@@ -377,19 +468,16 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
 {
     if(t_check == NULL) return 0;
-    if(t_check->next == NULL) return 0;
 
     LV_PROFILER_BEGIN;
     uint32_t cnt = 0;
-
-    lv_draw_task_t * t = t_check->next;
-    while(t) {
-        if((t->state == LV_DRAW_TASK_STATE_QUEUED || t->state == LV_DRAW_TASK_STATE_WAITING) &&
-           lv_area_is_on(&t_check->area, &t->area)) {
+    uint32_t dep_num = lv_array_size(&t_check->dependents);
+    uint32_t i;
+    for(i = 0; i < dep_num; i++) {
+        lv_draw_task_t * t = *(lv_draw_task_t **)lv_array_at(&t_check->dependents, i);
+        if(t->state == LV_DRAW_TASK_STATE_QUEUED || t->state == LV_DRAW_TASK_STATE_WAITING) {
             cnt++;
         }
-
-        t = t->next;
     }
     LV_PROFILER_END;
     return cnt;
@@ -398,9 +486,10 @@ uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
 lv_layer_t * lv_draw_layer_create(lv_layer_t * parent_layer, lv_color_format_t color_format, const lv_area_t * area)
 {
     lv_display_t * disp = lv_refr_get_disp_refreshing();
-    lv_layer_t * new_layer = lv_malloc_zeroed(sizeof(lv_layer_t));
+    lv_layer_t * new_layer = lv_draw_frame_malloc(sizeof(lv_layer_t));
     LV_ASSERT_MALLOC(new_layer);
     if(new_layer == NULL) return NULL;
+    lv_memzero(new_layer, sizeof(lv_layer_t));
 
     new_layer->parent = parent_layer;
     new_layer->_clip_area = *area;
@@ -478,28 +567,243 @@ void lv_draw_task_get_area(const lv_draw_task_t * t, lv_area_t * area)
  **********************/
 
 /**
- * Check if there are older draw task overlapping the area of `t_check`
- * @param layer      the draw ctx to search in
- * @param t_check       check this task if it overlaps with the older ones
- * @return              true: `t_check` is not overlapping with older tasks so it's independent
+ * Add a draw task to the dependency graph: find the older and not finished draw tasks
+ * overlapping with it and store it in the spatial hash to be found by the newer tasks.
+ * If it doesn't depend on any other tasks it's added to the ready queue immediately.
+ * @param layer     the layer of the draw task
+ * @param t         the draw task to add
  */
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
+static void task_link(lv_layer_t * layer, lv_draw_task_t * t)
 {
-    LV_PROFILER_BEGIN;
-    lv_draw_task_t * t = layer->draw_task_head;
+    if(t->linked) return;
 
-    /*If t_check is outside of the older tasks then it's independent*/
-    while(t && t != t_check) {
-        if(t->state != LV_DRAW_TASK_STATE_READY) {
-            lv_area_t a;
-            if(lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
-                LV_PROFILER_END;
-                return false;
+    LV_PROFILER_BEGIN;
+    lv_draw_global_info_t * info = &_draw_info;
+    info->task_index_visit_id++;
+    t->index_visit_id = info->task_index_visit_id;
+
+    lv_area_t cells;
+    if(index_get_cells(&t->_real_area, &cells)) {
+        index_check_bucket(&info->task_index_large, layer, t);
+
+        uint32_t cell_cnt = lv_area_get_size(&cells);
+        if(cell_cnt > LV_DRAW_TASK_INDEX_BUCKET_CNT) {
+            /*It would cover most of the buckets anyway, so simply check all*/
+            uint32_t i;
+            for(i = 0; i < LV_DRAW_TASK_INDEX_BUCKET_CNT; i++) {
+                index_check_bucket(&info->task_index[i], layer, t);
+            }
+        }
+        else {
+            int32_t cx;
+            int32_t cy;
+            for(cy = cells.y1; cy <= cells.y2; cy++) {
+                for(cx = cells.x1; cx <= cells.x2; cx++) {
+                    index_check_bucket(&info->task_index[LV_DRAW_TASK_INDEX_HASH(cx, cy)], layer, t);
+                }
             }
         }
-        t = t->next;
+
+        t->index_cells = cells;
+        t->index_large = cell_cnt > LV_DRAW_TASK_INDEX_LARGE_CELL_CNT;
+        index_add(t);
+    }
+    else {
+        /*Doesn't overlap with anything*/
+        t->index_cells.x1 = 0;
+        t->index_cells.x2 = -1;
     }
+
+    t->linked = 1;
+    if(t->dep_cnt == 0 && t->state == LV_DRAW_TASK_STATE_QUEUED) {
+        ready_queue_push(layer, t);
+    }
+
     LV_PROFILER_END;
+}
 
+/**
+ * Remove a finished draw task from the dependency graph and
+ * move its dependent tasks to the ready queue if they are not waiting for other tasks.
+ * @param layer     the layer of the draw task
+ * @param t         the finished draw task
+ */
+static void task_unlink(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    if(!t->linked) return;
+
+    LV_PROFILER_BEGIN;
+    uint32_t dep_num = lv_array_size(&t->dependents);
+    uint32_t i;
+    for(i = 0; i < dep_num; i++) {
+        lv_draw_task_t * t_dep = *(lv_draw_task_t **)lv_array_at(&t->dependents, i);
+        LV_ASSERT(t_dep->dep_cnt > 0);
+        t_dep->dep_cnt--;
+        if(t_dep->dep_cnt == 0 && t_dep->state == LV_DRAW_TASK_STATE_QUEUED) {
+            ready_queue_push(layer, t_dep);
+        }
+    }
+    lv_array_deinit(&t->dependents);
+
+    index_remove(t);
+    t->linked = 0;
+    LV_PROFILER_END;
+}
+
+/**
+ * Finish a draw task which can't be drawn by any draw units the same way as the draw units
+ * finish the tasks: mark it as ready, release the tasks waiting for it and request a new dispatch.
+ * @param layer     the layer of the draw task
+ * @param t         the unsupported draw task
+ */
+static void task_finish_unsupported(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    t->state = LV_DRAW_TASK_STATE_READY;
+    task_unlink(layer, t);
+    lv_draw_dispatch_request();
+}
+
+/**
+ * Get the cells of the spatial hash covered by an area
+ * @param area      the area to check
+ * @param cells     store the first and last cell indices here
+ * @return          false: the area is invalid and doesn't cover any cells
+ */
+static bool index_get_cells(const lv_area_t * area, lv_area_t * cells)
+{
+    if(area->x1 > area->x2 || area->y1 > area->y2) return false;
+
+    cells->x1 = area->x1 >> LV_DRAW_TASK_INDEX_CELL_SHIFT;
+    cells->y1 = area->y1 >> LV_DRAW_TASK_INDEX_CELL_SHIFT;
+    cells->x2 = area->x2 >> LV_DRAW_TASK_INDEX_CELL_SHIFT;
+    cells->y2 = area->y2 >> LV_DRAW_TASK_INDEX_CELL_SHIFT;
     return true;
 }
+
+static void index_add(lv_draw_task_t * t)
+{
+    lv_draw_global_info_t * info = &_draw_info;
+    if(t->index_large) {
+        if(info->task_index_large.data == NULL) {
+            lv_array_init(&info->task_index_large, LV_ARRAY_DEFAULT_CAPACITY, sizeof(lv_draw_task_t *));
+        }
+        lv_array_push_back(&info->task_index_large, &t);
+        return;
+    }
+
+    int32_t cx;
+    int32_t cy;
+    for(cy = t->index_cells.y1; cy <= t->index_cells.y2; cy++) {
+        for(cx = t->index_cells.x1; cx <= t->index_cells.x2; cx++) {
+            lv_array_t * bucket = &info->task_index[LV_DRAW_TASK_INDEX_HASH(cx, cy)];
+            if(bucket->data == NULL) {
+                lv_array_init(bucket, LV_ARRAY_DEFAULT_CAPACITY, sizeof(lv_draw_task_t *));
+            }
+            lv_array_push_back(bucket, &t);
+        }
+    }
+}
+
+/**
+ * Remove a task from a bucket. The order of the tasks in the buckets doesn't matter,
+ * so just replace it with the last one.
+ * @param bucket    the bucket to remove from
+ * @param t         the task to remove
+ */
+static void bucket_remove(lv_array_t * bucket, lv_draw_task_t * t)
+{
+    uint32_t size = lv_array_size(bucket);
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(*(lv_draw_task_t **)lv_array_at(bucket, i) == t) {
+            if(i != size - 1) lv_array_assign(bucket, i, lv_array_back(bucket));
+            lv_array_remove(bucket, size - 1);
+            return;
+        }
+    }
+}
+
+static void index_remove(lv_draw_task_t * t)
+{
+    if(t->index_cells.x1 > t->index_cells.x2) return;
+
+    lv_draw_global_info_t * info = &_draw_info;
+    if(t->index_large) {
+        bucket_remove(&info->task_index_large, t);
+        return;
+    }
+
+    /*A task is added once for each covered cell, even if some cells have the same hash*/
+    int32_t cx;
+    int32_t cy;
+    for(cy = t->index_cells.y1; cy <= t->index_cells.y2; cy++) {
+        for(cx = t->index_cells.x1; cx <= t->index_cells.x2; cx++) {
+            bucket_remove(&info->task_index[LV_DRAW_TASK_INDEX_HASH(cx, cy)], t);
+        }
+    }
+}
+
+/**
+ * Make `t_check` depend on the not yet finished draw tasks of a bucket
+ * which are on the same layer and overlap with it.
+ * @param bucket    the bucket to check
+ * @param layer     the layer of `t_check`
+ * @param t_check   the newly added task
+ */
+static void index_check_bucket(lv_array_t * bucket, lv_layer_t * layer, lv_draw_task_t * t_check)
+{
+    uint32_t size = lv_array_size(bucket);
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        lv_draw_task_t * t = *(lv_draw_task_t **)lv_array_at(bucket, i);
+
+        /*Tasks covering more cells with the same hash can be found many times*/
+        if(t->index_visit_id == t_check->index_visit_id) continue;
+        t->index_visit_id = t_check->index_visit_id;
+
+        if(t->state == LV_DRAW_TASK_STATE_READY) continue;
+        if(((lv_draw_dsc_base_t *)t->draw_dsc)->layer != layer) continue;
+
+        lv_area_t a;
+        if(!lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) continue;
+
+        if(t->dependents.data == NULL) {
+            lv_array_init(&t->dependents, LV_ARRAY_DEFAULT_CAPACITY, sizeof(lv_draw_task_t *));
+        }
+        lv_array_push_back(&t->dependents, &t_check);
+        t_check->dep_cnt++;
+    }
+}
+
+static void ready_queue_push(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    t->ready_next = NULL;
+    if(layer->draw_task_ready_tail) layer->draw_task_ready_tail->ready_next = t;
+    else layer->draw_task_ready_head = t;
+    layer->draw_task_ready_tail = t;
+}
+
+static void ready_queue_remove(lv_layer_t * layer, lv_draw_task_t * t_prev, lv_draw_task_t * t)
+{
+    if(t_prev) t_prev->ready_next = t->ready_next;
+    else layer->draw_task_ready_head = t->ready_next;
+
+    if(layer->draw_task_ready_tail == t) layer->draw_task_ready_tail = t_prev;
+    t->ready_next = NULL;
+}
+
+/**
+ * Remove the tasks from the ready queue which were already taken by a draw unit
+ * @param layer     the layer whose queue should be cleaned
+ */
+static void ready_queue_purge(lv_layer_t * layer)
+{
+    lv_draw_task_t * t_prev = NULL;
+    lv_draw_task_t * t = layer->draw_task_ready_head;
+    while(t) {
+        lv_draw_task_t * t_next = t->ready_next;
+        if(t->state != LV_DRAW_TASK_STATE_QUEUED) ready_queue_remove(layer, t_prev, t);
+        else t_prev = t;
+        t = t_next;
+    }
+}
@@ -101,9 +101,16 @@ struct lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /** Queue of draw tasks whose overlapping older tasks are all finished. Managed by the draw module. */
+    lv_draw_task_t * draw_task_ready_head;
+    lv_draw_task_t * draw_task_ready_tail;
+
     lv_layer_t * parent;
     lv_layer_t * next;
     bool all_tasks_added;
+
+    /** `draw_buf` is owned by the creator of the layer and it's not freed when the layer is blended */
+    bool keep_draw_buf;
     void * user_data;
 };
 
@@ -138,6 +145,22 @@ void lv_draw_deinit(void);
  */
 void * lv_draw_create_unit(size_t size);
 
+/**
+ * Allocate memory which is needed only while the current frame is rendered, e.g. for draw descriptors.
+ * During a refresh it's allocated from the frame arena of the display, else from the heap.
+ * @param size      the size to allocate in bytes
+ * @return          pointer to the allocated memory or NULL on error
+ * @note            it needs to be freed by `lv_draw_frame_free()`
+ */
+void * lv_draw_frame_malloc(size_t size);
+
+/**
+ * Free memory allocated by `lv_draw_frame_malloc()`.
+ * The memory from the frame arena is reused only when the arena is reset after the refresh.
+ * @param data      pointer to the memory to free. Can be NULL.
+ */
+void lv_draw_frame_free(void * data);
+
 /**
  * Add an empty draw task to the draw task list of a layer.
  * @param layer     pointer to a layer
@@ -33,6 +33,13 @@ static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_
                                 lv_image_decoder_dsc_t * decoder_dsc, lv_area_t * relative_decoded_area,
                                 const lv_area_t * img_area, const lv_area_t * clipped_img_area,
                                 lv_draw_image_core_cb draw_core_cb);
+static lv_result_t img_decode_and_draw_transformed(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
+                                                   lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
+                                                   const lv_area_t * img_area, const lv_area_t * clipped_img_area,
+                                                   lv_draw_image_core_cb draw_core_cb);
+static void img_get_transformed_src_area(const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * img_area,
+                                         const lv_area_t * clipped_img_area, lv_area_t * src_area);
+static lv_draw_buf_t * img_decode_area(lv_image_decoder_dsc_t * decoder_dsc, const lv_area_t * area);
 
 /**********************
  *  STATIC VARIABLES
@@ -72,7 +79,7 @@ void lv_draw_layer(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
 
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_frame_malloc(sizeof(*dsc));
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_LAYER;
     t->state = LV_DRAW_TASK_STATE_WAITING;
@@ -102,12 +109,20 @@ void lv_draw_image(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
 
     LV_PROFILER_BEGIN;
 
-    lv_draw_image_dsc_t * new_image_dsc = lv_malloc(sizeof(*dsc));
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /*Don't wait for slow decoders, draw a placeholder until the image is decoded*/
+    if(lv_image_decoder_async_defer(layer, dsc, coords)) {
+        LV_PROFILER_END;
+        return;
+    }
+#endif
+
+    lv_draw_image_dsc_t * new_image_dsc = lv_draw_frame_malloc(sizeof(*dsc));
     lv_memcpy(new_image_dsc, dsc, sizeof(*dsc));
     lv_result_t res = lv_image_decoder_get_info(new_image_dsc->src, &new_image_dsc->header);
     if(res != LV_RESULT_OK) {
         LV_LOG_WARN("Couldn't get info about the image");
-        lv_free(new_image_dsc);
+        lv_draw_frame_free(new_image_dsc);
         return;
     }
 
@@ -283,32 +298,166 @@ static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_
     /*The whole image is available, just draw it*/
     if(decoder_dsc->decoded && (relative_decoded_area == NULL || relative_decoded_area->x1 == LV_COORD_MIN)) {
         draw_core_cb(draw_unit, draw_dsc, decoder_dsc, &sup, img_area, clipped_img_area);
+        return;
+    }
+
+    /*Transformations sample the neighbors too, so collect the decoded pieces*/
+    if(draw_dsc->rotation || draw_dsc->scale_x != LV_SCALE_NONE || draw_dsc->scale_y != LV_SCALE_NONE ||
+       draw_dsc->skew_x || draw_dsc->skew_y) {
+        if(img_decode_and_draw_transformed(draw_unit, draw_dsc, decoder_dsc, &sup, img_area, clipped_img_area,
+                                           draw_core_cb) == LV_RESULT_OK) {
+            return;
+        }
+        /*Otherwise transform the pieces one by one*/
     }
+
     /*Draw in smaller pieces*/
-    else {
-        lv_area_t relative_full_area_to_decode = *clipped_img_area;
-        lv_area_move(&relative_full_area_to_decode, -img_area->x1, -img_area->y1);
-        lv_area_t tmp;
-        if(relative_decoded_area == NULL) relative_decoded_area = &tmp;
-        relative_decoded_area->x1 = LV_COORD_MIN;
-        relative_decoded_area->y1 = LV_COORD_MIN;
-        relative_decoded_area->x2 = LV_COORD_MIN;
-        relative_decoded_area->y2 = LV_COORD_MIN;
-        lv_result_t res = LV_RESULT_OK;
-
-        while(res == LV_RESULT_OK) {
-            res = lv_image_decoder_get_area(decoder_dsc, &relative_full_area_to_decode, relative_decoded_area);
-
-            lv_area_t absolute_decoded_area = *relative_decoded_area;
-            lv_area_move(&absolute_decoded_area, img_area->x1, img_area->y1);
-            if(res == LV_RESULT_OK) {
-                /*Limit draw area to the current decoded area and draw the image*/
-                lv_area_t clipped_img_area_sub;
-                if(lv_area_intersect(&clipped_img_area_sub, clipped_img_area, &absolute_decoded_area)) {
-                    draw_core_cb(draw_unit, draw_dsc, decoder_dsc, &sup,
-                                 &absolute_decoded_area, &clipped_img_area_sub);
-                }
+    lv_area_t relative_full_area_to_decode = *clipped_img_area;
+    lv_area_move(&relative_full_area_to_decode, -img_area->x1, -img_area->y1);
+    lv_area_t tmp;
+    if(relative_decoded_area == NULL) relative_decoded_area = &tmp;
+    relative_decoded_area->x1 = LV_COORD_MIN;
+    relative_decoded_area->y1 = LV_COORD_MIN;
+    relative_decoded_area->x2 = LV_COORD_MIN;
+    relative_decoded_area->y2 = LV_COORD_MIN;
+    lv_result_t res = LV_RESULT_OK;
+
+    while(res == LV_RESULT_OK) {
+        res = lv_image_decoder_get_area(decoder_dsc, &relative_full_area_to_decode, relative_decoded_area);
+
+        lv_area_t absolute_decoded_area = *relative_decoded_area;
+        lv_area_move(&absolute_decoded_area, img_area->x1, img_area->y1);
+        if(res == LV_RESULT_OK) {
+            /*Limit draw area to the current decoded area and draw the image*/
+            lv_area_t clipped_img_area_sub;
+            if(lv_area_intersect(&clipped_img_area_sub, clipped_img_area, &absolute_decoded_area)) {
+                draw_core_cb(draw_unit, draw_dsc, decoder_dsc, &sup,
+                             &absolute_decoded_area, &clipped_img_area_sub);
+            }
+        }
+    }
+}
+
+/**
+ * Collect the part of a partially decoded image which is transformed into `clipped_img_area`
+ * and draw it as if it was the whole image.
+ * @return LV_RESULT_OK: drawn or nothing to draw, LV_RESULT_INVALID: the pieces can't be collected
+ */
+static lv_result_t img_decode_and_draw_transformed(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
+                                                   lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
+                                                   const lv_area_t * img_area, const lv_area_t * clipped_img_area,
+                                                   lv_draw_image_core_cb draw_core_cb)
+{
+    /*The planes of RGB565A8 can't be copied row by row*/
+    if(decoder_dsc->header.cf == LV_COLOR_FORMAT_RGB565A8) return LV_RESULT_INVALID;
+
+    lv_area_t src_area;
+    img_get_transformed_src_area(draw_dsc, img_area, clipped_img_area, &src_area);
+    lv_area_t full_area = {0, 0, lv_area_get_width(img_area) - 1, lv_area_get_height(img_area) - 1};
+    if(!lv_area_intersect(&src_area, &src_area, &full_area)) return LV_RESULT_OK;
+
+    lv_draw_buf_t * part = img_decode_area(decoder_dsc, &src_area);
+    if(part == NULL) return LV_RESULT_INVALID;
+
+    /*Move the pivot to keep the transformation of the part the same*/
+    lv_draw_image_dsc_t part_dsc = *draw_dsc;
+    part_dsc.pivot.x -= src_area.x1;
+    part_dsc.pivot.y -= src_area.y1;
+    lv_area_t part_area = src_area;
+    lv_area_move(&part_area, img_area->x1, img_area->y1);
+
+    decoder_dsc->decoded = part;
+    draw_core_cb(draw_unit, &part_dsc, decoder_dsc, sup, &part_area, clipped_img_area);
+    decoder_dsc->decoded = NULL;
+    lv_draw_buf_destroy(part);
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Get the area of the image whose pixels are used to draw a part of the transformed image.
+ * @param draw_dsc          the draw descriptor with the transformation
+ * @param img_area          the area of the image without the transformation
+ * @param clipped_img_area  the area to draw
+ * @param src_area          store the result here, relative to `img_area`. Might be out of the image.
+ */
+static void img_get_transformed_src_area(const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * img_area,
+                                         const lv_area_t * clipped_img_area, lv_area_t * src_area)
+{
+    /*Skew can't be inverted with `lv_point_array_transform`, use the whole image*/
+    if(draw_dsc->skew_x || draw_dsc->skew_y || draw_dsc->scale_x <= 0 || draw_dsc->scale_y <= 0) {
+        lv_area_set(src_area, 0, 0, lv_area_get_width(img_area) - 1, lv_area_get_height(img_area) - 1);
+        return;
+    }
+
+    lv_area_t area = *clipped_img_area;
+    lv_area_move(&area, -img_area->x1, -img_area->y1);
+    lv_point_t p[4] = {
+        {area.x1, area.y1},
+        {area.x2 + 1, area.y1},
+        {area.x1, area.y2 + 1},
+        {area.x2 + 1, area.y2 + 1},
+    };
+
+    /*Undo the rotation and then the scaling like the transformation of the pixels does.
+     *Scale with 64 bit as the inverted scale can be very large.*/
+    lv_point_array_transform(p, 4, -draw_dsc->rotation, LV_SCALE_NONE, LV_SCALE_NONE, &draw_dsc->pivot, false);
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        p[i].x = (int32_t)((int64_t)(p[i].x - draw_dsc->pivot.x) * LV_SCALE_NONE / draw_dsc->scale_x) + draw_dsc->pivot.x;
+        p[i].y = (int32_t)((int64_t)(p[i].y - draw_dsc->pivot.y) * LV_SCALE_NONE / draw_dsc->scale_y) + draw_dsc->pivot.y;
+    }
+
+    /*Add the neighbors used by the interpolation and the rounding error of the rotation*/
+    int32_t ext_x = 2 + LV_SCALE_NONE / draw_dsc->scale_x;
+    int32_t ext_y = 2 + LV_SCALE_NONE / draw_dsc->scale_y;
+    src_area->x1 = LV_MIN4(p[0].x, p[1].x, p[2].x, p[3].x) - ext_x;
+    src_area->y1 = LV_MIN4(p[0].y, p[1].y, p[2].y, p[3].y) - ext_y;
+    src_area->x2 = LV_MAX4(p[0].x, p[1].x, p[2].x, p[3].x) + ext_x;
+    src_area->y2 = LV_MAX4(p[0].y, p[1].y, p[2].y, p[3].y) + ext_y;
+}
+
+/**
+ * Collect an area of a partially decoded image into a new draw buffer.
+ * @param decoder_dsc   the opened image
+ * @param area          the area to collect, relative to the image
+ * @return              the new draw buffer with the size of `area` or NULL on error
+ */
+static lv_draw_buf_t * img_decode_area(lv_image_decoder_dsc_t * decoder_dsc, const lv_area_t * area)
+{
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    lv_draw_buf_t * buf = NULL;
+
+    while(lv_image_decoder_get_area(decoder_dsc, area, &decoded_area) == LV_RESULT_OK) {
+        const lv_draw_buf_t * piece = decoder_dsc->decoded;
+        /*The planes of RGB565A8 can't be copied row by row*/
+        if(piece->header.cf == LV_COLOR_FORMAT_RGB565A8) {
+            if(buf) lv_draw_buf_destroy(buf);
+            return NULL;
+        }
+
+        if(buf == NULL) {
+            buf = lv_draw_buf_create(lv_area_get_width(area), lv_area_get_height(area), piece->header.cf, LV_STRIDE_AUTO);
+            if(buf == NULL) {
+                LV_LOG_WARN("No memory to collect the decoded image");
+                return NULL;
             }
+            lv_draw_buf_clear(buf, NULL);
+        }
+
+        /*The pieces start at `decoded_area`'s top left corner*/
+        lv_area_t common;
+        if(!lv_area_intersect(&common, &decoded_area, area)) continue;
+        uint32_t px_size = lv_color_format_get_size(piece->header.cf);
+        uint32_t len = lv_area_get_width(&common) * px_size;
+        int32_t y;
+        for(y = common.y1; y <= common.y2; y++) {
+            const uint8_t * src = piece->data + (y - decoded_area.y1) * piece->header.stride +
+                                  (common.x1 - decoded_area.x1) * px_size;
+            uint8_t * dest = buf->data + (y - area->y1) * buf->header.stride + (common.x1 - area->x1) * px_size;
+            lv_memcpy(dest, src, len);
         }
     }
+
+    return buf;
 }
@@ -74,6 +74,19 @@ void lv_draw_image_tiled_helper(lv_draw_unit_t * draw_unit, const lv_draw_image_
 void lv_image_buf_get_transformed_area(lv_area_t * res, int32_t w, int32_t h, int32_t angle,
                                        uint16_t scale_x, uint16_t scale_y, const lv_point_t * pivot);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Queue the image of a draw descriptor for asynchronous decoding if it's not cached yet
+ * and draw a placeholder instead of it.
+ * @param layer     the layer to draw to
+ * @param dsc       the image draw descriptor
+ * @param coords    the coordinates of the image
+ * @return          true: the image is being decoded and the placeholder was drawn;
+ *                  false: the image should be drawn normally
+ */
+bool lv_image_decoder_async_defer(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -37,7 +37,13 @@
  *  STATIC PROTOTYPES
  **********************/
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
-                        const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb);
+                        const lv_font_t * font, uint32_t letter, const lv_font_glyph_dsc_t * g_cached,
+                        lv_draw_glyph_cb_t cb);
+static inline int32_t layout_max_w(int32_t max_w, lv_text_flag_t flag);
+static inline uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                    uint32_t line_idx, uint32_t line_start, int32_t w);
+static inline int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                     uint32_t line_idx, uint32_t line_start, uint32_t line_end);
 
 /**********************
  *  STATIC VARIABLES
@@ -92,7 +98,7 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_layer_t * layer, const lv_draw_label
     LV_PROFILER_BEGIN;
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_frame_malloc(sizeof(*dsc));
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_LABEL;
 
@@ -162,8 +168,16 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     lv_bidi_calculate_align(&align, &base_dir, dsc->text);
 
-    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
-        /*Normally use the label's width as width*/
+    /*Use the pre-calculated lines if they were created for the same parameters*/
+    const lv_draw_label_layout_t * layout = dsc->layout;
+    if(layout && !lv_draw_label_layout_is_valid(layout, dsc->text, font, dsc->letter_space, lv_area_get_width(coords),
+                                                dsc->flag)) {
+        layout = NULL;
+    }
+
+    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0 || layout) {
+        /*Normally use the label's width as width.
+         *With a layout the width is not used to break the lines*/
         w = lv_area_get_width(coords);
     }
     else {
@@ -190,9 +204,10 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
+    uint32_t line_idx       = 0;
 
-    /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+    /*Check the hint to use the cached info. Not required if the lines are known from the layout*/
+    if(dsc->hint && layout == NULL && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             dsc->hint->line_start = -1;
@@ -206,14 +221,14 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
         pos.y += dsc->hint->y;
     }
 
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL,
-                                                           dsc->flag);
+    uint32_t line_end = get_line_end(dsc, layout, line_idx, line_start, w);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_unit->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_idx++;
+        line_end = get_line_end(dsc, layout, line_idx, line_start, w);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -228,14 +243,14 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -269,6 +284,8 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
         /*Write all letter of a line*/
         i = 0;
+        const lv_draw_label_layout_glyph_t * glyphs = NULL;
+        if(layout && layout->glyphs) glyphs = &layout->glyphs[layout->lines[line_idx].glyph_start];
 #if LV_USE_BIDI
         char * bidi_txt = lv_malloc(line_end - line_start + 1);
         LV_ASSERT_MALLOC(bidi_txt);
@@ -293,7 +310,15 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
             uint32_t letter_next;
             lv_text_encoded_letter_next_2(bidi_txt, &letter, &letter_next, &i);
 
-            letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+            const lv_font_glyph_dsc_t * g_cached = NULL;
+            if(glyphs) {
+                letter_w = glyphs->advance;
+                g_cached = &glyphs->dsc;
+                glyphs++;
+            }
+            else {
+                letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+            }
 
             /*Always set the bg_coordinates for placeholder drawing*/
             bg_coords.x1 = pos.x;
@@ -333,7 +358,7 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
                 draw_letter_dsc.color = dsc->color;
             }
 
-            draw_letter(draw_unit, &draw_letter_dsc, &pos, font, letter, cb);
+            draw_letter(draw_unit, &draw_letter_dsc, &pos, font, letter, g_cached, cb);
 
             if(letter_w > 0) {
                 pos.x += letter_w + dsc->letter_space;
@@ -346,20 +371,19 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_idx++;
+        line_end = get_line_end(dsc, layout, line_idx, line_start, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -374,12 +398,154 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+void lv_draw_label_layout_init(lv_draw_label_layout_t * layout)
+{
+    lv_memzero(layout, sizeof(lv_draw_label_layout_t));
+}
+
+void lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                 int32_t letter_space, int32_t max_w, lv_text_flag_t flag)
+{
+    if(text == NULL || font == NULL) {
+        layout->valid = 0;
+        return;
+    }
+
+    if(lv_draw_label_layout_is_valid(layout, text, font, letter_space, max_w, flag)) return;
+
+    LV_PROFILER_BEGIN;
+
+    layout->valid = 0;
+    layout->text = text;
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->max_w = layout_max_w(max_w, flag);
+    layout->flag = flag & ~(LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT);
+    layout->line_cnt = 0;
+
+    uint32_t glyph_cnt = 0;
+    uint32_t line_start = 0;
+    while(1) {
+        /*Keep space for the sentinel line too*/
+        if(layout->line_cnt + 1 >= layout->line_cap) {
+            uint32_t new_cap = layout->line_cap ? layout->line_cap * 2 : 4;
+            lv_draw_label_layout_line_t * lines = lv_realloc(layout->lines, new_cap * sizeof(lv_draw_label_layout_line_t));
+            if(lines == NULL) {
+                LV_PROFILER_END;
+                return;
+            }
+            layout->lines = lines;
+            layout->line_cap = new_cap;
+        }
+
+        lv_draw_label_layout_line_t * line = &layout->lines[layout->line_cnt];
+        line->byte_start = line_start;
+        line->glyph_start = glyph_cnt;
+        line->width = 0;
+
+        if(text[line_start] == '\0') break;
+
+        uint32_t line_end = line_start + lv_text_get_next_line(&text[line_start], font, letter_space, layout->max_w, NULL,
+                                                               flag);
+
+        /*Measure the line the same way as `lv_text_get_width` but save the letter widths and glyphs too*/
+        uint32_t i = line_start;
+        while(i < line_end) {
+            uint32_t letter;
+            uint32_t letter_next;
+            lv_text_encoded_letter_next_2(text, &letter, &letter_next, &i);
+            uint16_t letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+            if(letter_w > 0) line->width += letter_w + letter_space;
+
+#if LV_USE_BIDI == 0
+            /*With BiDi the letters are drawn in a different order so don't store them*/
+            if(glyph_cnt >= layout->glyph_cap) {
+                uint32_t new_cap = layout->glyph_cap ? layout->glyph_cap * 2 : 16;
+                lv_draw_label_layout_glyph_t * glyphs = lv_realloc(layout->glyphs,
+                                                                   new_cap * sizeof(lv_draw_label_layout_glyph_t));
+                if(glyphs == NULL) {
+                    LV_PROFILER_END;
+                    return;
+                }
+                layout->glyphs = glyphs;
+                layout->glyph_cap = new_cap;
+            }
+
+            /*Look up the glyph the same way as `draw_letter` does*/
+            lv_draw_label_layout_glyph_t * glyph = &layout->glyphs[glyph_cnt];
+            if(!lv_font_get_glyph_dsc(font, &glyph->dsc, letter, '\0')) {
+                LV_LOG_WARN("glyph dsc. not found for U+%" LV_PRIX32, letter);
+            }
+            glyph->dsc.entry = NULL;
+            glyph->advance = letter_w;
+#endif
+            glyph_cnt++;
+        }
+
+        if(line->width > 0) line->width -= letter_space;
+
+        layout->line_cnt++;
+        line_start = line_end;
+    }
+
+    layout->valid = 1;
+    LV_PROFILER_END;
+}
+
+void lv_draw_label_layout_invalidate(lv_draw_label_layout_t * layout)
+{
+    layout->valid = 0;
+}
+
+bool lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                   int32_t letter_space, int32_t max_w, lv_text_flag_t flag)
+{
+    /*`LV_TEXT_FLAG_EXPAND` and `LV_TEXT_FLAG_FIT` only remove the width limit which is in `max_w` already*/
+    return layout->valid &&
+           layout->text == text &&
+           layout->font == font &&
+           layout->letter_space == letter_space &&
+           layout->flag == (flag & ~(LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) &&
+           layout->max_w == layout_max_w(max_w, flag);
+}
+
+void lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, int32_t line_space, lv_point_t * size_res)
+{
+    const char * text = layout->text;
+    int32_t letter_height = lv_font_get_line_height(layout->font);
+    size_res->x = 0;
+    size_res->y = 0;
+
+    uint32_t i;
+    for(i = 0; i < layout->line_cnt; i++) {
+        size_res->x = LV_MAX(size_res->x, layout->lines[i].width);
+        size_res->y += letter_height + line_space;
+    }
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    uint32_t text_end = layout->lines[layout->line_cnt].byte_start;
+    if(text_end != 0 && (text[text_end - 1] == '\n' || text[text_end - 1] == '\r')) {
+        size_res->y += letter_height + line_space;
+    }
+
+    if(size_res->y == 0) size_res->y = letter_height;
+    else size_res->y -= line_space;
+}
+
+void lv_draw_label_layout_free(lv_draw_label_layout_t * layout)
+{
+    lv_free(layout->lines);
+    lv_free(layout->glyphs);
+    lv_draw_label_layout_init(layout);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
-                        const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb)
+                        const lv_font_t * font, uint32_t letter, const lv_font_glyph_dsc_t * g_cached,
+                        lv_draw_glyph_cb_t cb)
 {
     lv_font_glyph_dsc_t g;
 
@@ -387,10 +553,16 @@ static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,
         return;
 
     LV_PROFILER_BEGIN;
-    bool g_ret = lv_font_get_glyph_dsc(font, &g, letter, '\0');
-    if(g_ret == false) {
-        /*Add warning if the dsc is not found*/
-        LV_LOG_WARN("lv_draw_letter: glyph dsc. not found for U+%" LV_PRIX32, letter);
+    if(g_cached) {
+        /*Already looked up by the label's layout*/
+        g = *g_cached;
+    }
+    else {
+        bool g_ret = lv_font_get_glyph_dsc(font, &g, letter, '\0');
+        if(g_ret == false) {
+            /*Add warning if the dsc is not found*/
+            LV_LOG_WARN("lv_draw_letter: glyph dsc. not found for U+%" LV_PRIX32, letter);
+        }
     }
 
     /*Don't draw anything if the character is empty. E.g. space*/
@@ -444,3 +616,33 @@ static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,
 
     LV_PROFILER_END;
 }
+
+static inline int32_t layout_max_w(int32_t max_w, lv_text_flag_t flag)
+{
+    /*The lines are broken only at new line characters in these cases*/
+    if(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) return LV_COORD_MAX;
+    else return max_w;
+}
+
+static inline uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                    uint32_t line_idx, uint32_t line_start, int32_t w)
+{
+    if(layout) {
+        /*After the last line stay at the end of the text*/
+        if(line_idx >= layout->line_cnt) return line_start;
+        else return layout->lines[line_idx + 1].byte_start;
+    }
+
+    return line_start + lv_text_get_next_line(&dsc->text[line_start], dsc->font, dsc->letter_space, w, NULL, dsc->flag);
+}
+
+static inline int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_layout_t * layout,
+                                     uint32_t line_idx, uint32_t line_start, uint32_t line_end)
+{
+    if(layout) {
+        if(line_idx >= layout->line_cnt) return 0;
+        else return layout->lines[line_idx].width;
+    }
+
+    return lv_text_get_width(&dsc->text[line_start], line_end - line_start, dsc->font, dsc->letter_space);
+}
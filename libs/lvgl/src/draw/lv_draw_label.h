@@ -54,6 +54,9 @@ typedef struct {
      * 0: `text` is const and it's pointer will be valid during rendering.*/
     uint8_t text_local : 1;
     lv_draw_label_hint_t * hint;
+    /** Pre-calculated line breaks and letter widths of `text`.
+     * Used only if it was created with the same font, letter space, width and flags. Can be NULL.*/
+    const lv_draw_label_layout_t * layout;
 } lv_draw_label_dsc_t;
 
 /**
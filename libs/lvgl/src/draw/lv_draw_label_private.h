@@ -41,6 +41,41 @@ struct lv_draw_label_hint_t {
     int32_t coord_y;
 };
 
+/** A line of a `lv_draw_label_layout_t`*/
+typedef struct {
+    uint32_t byte_start;    /**< Byte index of the line's first letter in the text*/
+    uint32_t glyph_start;   /**< Index of the line's first letter in `glyphs`*/
+    int32_t width;          /**< Width of the line as `lv_text_get_width` would return it*/
+} lv_draw_label_layout_line_t;
+
+/** A letter of a `lv_draw_label_layout_t`*/
+typedef struct {
+    lv_font_glyph_dsc_t dsc;    /**< The glyph descriptor of the letter as `lv_font_get_glyph_dsc` returns it*/
+    int32_t advance;            /**< Width of the letter including kerning*/
+} lv_draw_label_layout_glyph_t;
+
+/** Store the line breaks, letter widths and glyphs of a text to avoid measuring it again on every redraw.
+ * The text's pointer, font, letter space, width and flags are compared on update, so their changes are detected
+ * automatically. If the text is modified in place, the layout needs to be invalidated with
+ * `lv_draw_label_layout_invalidate`.*/
+struct lv_draw_label_layout_t {
+    /** `line_cnt + 1` lines. The last one is a sentinel pointing to the end of the text*/
+    lv_draw_label_layout_line_t * lines;
+
+    /** Glyph descriptor and width of each letter. NULL if not stored (e.g. with `LV_USE_BIDI`)*/
+    lv_draw_label_layout_glyph_t * glyphs;
+
+    const char * text;
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_w;          /**< `LV_COORD_MAX` if the width doesn't matter due to `flag`*/
+    uint32_t line_cnt;
+    uint32_t line_cap;
+    uint32_t glyph_cap;
+    lv_text_flag_t flag;
+    uint8_t valid : 1;
+};
+
 struct lv_draw_glyph_dsc_t {
     void * glyph_data;  /**< Depends on `format` field, it could be image source or draw buf of bitmap or vector data. */
     lv_font_glyph_format_t format;
@@ -57,6 +92,58 @@ struct lv_draw_glyph_dsc_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Initialize a label layout
+ * @param layout        pointer to a layout
+ */
+void lv_draw_label_layout_init(lv_draw_label_layout_t * layout);
+
+/**
+ * Calculate the line breaks, letter widths and glyphs of a text if the parameters differ from the
+ * stored ones or the layout was invalidated. Otherwise do nothing.
+ * @param layout        pointer to a layout
+ * @param text          the text to measure
+ * @param font          font of the text
+ * @param letter_space  letter space of the text
+ * @param max_w         max width of the lines
+ * @param flag          settings for the text from `lv_text_flag_t`
+ */
+void lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                 int32_t letter_space, int32_t max_w, lv_text_flag_t flag);
+
+/**
+ * Mark a layout as outdated, e.g. because its text has changed
+ * @param layout        pointer to a layout
+ */
+void lv_draw_label_layout_invalidate(lv_draw_label_layout_t * layout);
+
+/**
+ * Check if a layout is up to date with the given parameters
+ * @param layout        pointer to a layout
+ * @param text          the text to draw or measure
+ * @param font          font of the text
+ * @param letter_space  letter space of the text
+ * @param max_w         max width of the lines
+ * @param flag          settings for the text from `lv_text_flag_t`
+ * @return              true: the layout can be used
+ */
+bool lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * text, const lv_font_t * font,
+                                   int32_t letter_space, int32_t max_w, lv_text_flag_t flag);
+
+/**
+ * Get the size of a text from its layout. The result is the same as `lv_text_get_size`'s.
+ * @param layout        pointer to a valid layout
+ * @param line_space    line space of the text
+ * @param size_res      store the result here
+ */
+void lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, int32_t line_space, lv_point_t * size_res);
+
+/**
+ * Free the memory allocated by a layout
+ * @param layout        pointer to a layout
+ */
+void lv_draw_label_layout_free(lv_draw_label_layout_t * layout);
+
 /**********************
  *      MACROS
  **********************/
@@ -19,11 +19,21 @@ extern "C" {
  *********************/
 
 #include "lv_draw.h"
+#include "../misc/lv_array.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/** Number of buckets in the spatial hash used to find the overlapping draw tasks. Must be a power of 2.*/
+#define LV_DRAW_TASK_INDEX_BUCKET_CNT   32
+
+/** The draw tasks are hashed into cells of `(1 << LV_DRAW_TASK_INDEX_CELL_SHIFT)` pixels*/
+#define LV_DRAW_TASK_INDEX_CELL_SHIFT   6
+
+/** Draw tasks covering more cells than this are stored in a separate list instead of the buckets*/
+#define LV_DRAW_TASK_INDEX_LARGE_CELL_CNT   16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -75,6 +85,29 @@ struct lv_draw_task_t {
      */
     uint8_t preference_score;
 
+    /**
+     * Number of older and not yet finished draw tasks overlapping with this one.
+     * The task can be dispatched only when it becomes 0.
+     */
+    uint32_t dep_cnt;
+
+    /** Newer draw tasks waiting for this one to be finished (`lv_draw_task_t *` elements)*/
+    lv_array_t dependents;
+
+    /** Next task in the layer's queue of draw tasks which can be dispatched*/
+    lv_draw_task_t * ready_next;
+
+    /** Cells of the spatial hash the task was added to. Invalid if the task is not in the index.*/
+    lv_area_t index_cells;
+
+    /** Used to visit a task only once when searching the spatial hash*/
+    uint32_t index_visit_id;
+
+    /** 1: the dependencies of the task are already resolved and it's stored in the spatial hash*/
+    uint8_t linked : 1;
+
+    /** 1: the task is stored in the list of large tasks instead of the buckets*/
+    uint8_t index_large : 1;
 };
 
 struct lv_draw_mask_t {
@@ -166,6 +199,15 @@ struct lv_draw_unit_t {
      * @return
      */
     int32_t (*delete_cb)(lv_draw_unit_t * draw_unit);
+
+#if LV_USE_TELEMETRY
+    /**
+     * Total time spent with executing draw tasks and the start of the current one.
+     * Updated by `LV_TELEMETRY_DRAW_UNIT_BEGIN/END` in the thread of the draw unit.
+     */
+    uint32_t telemetry_busy_time;
+    uint32_t telemetry_busy_start;
+#endif
 };
 
 typedef struct {
@@ -177,14 +219,31 @@ typedef struct {
 #else
     int dispatch_req;
 #endif
-    lv_mutex_t circle_cache_mutex;
     bool task_running;
+
+    /** Spatial hash of the not yet removed draw tasks to quickly find the overlapping ones*/
+    lv_array_t task_index[LV_DRAW_TASK_INDEX_BUCKET_CNT];
+    lv_array_t task_index_large;
+    uint32_t task_index_visit_id;
 } lv_draw_global_info_t;
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Start allocating from the frame arena of a display. Called when the refresh of the display starts.
+ * @param disp      pointer to a display
+ */
+void lv_draw_frame_arena_begin(lv_display_t * disp);
+
+/**
+ * Stop allocating from the frame arena of a display and reset it if nothing allocated from it is left.
+ * Called when the refresh of the display has finished.
+ * @param disp      pointer to a display
+ */
+void lv_draw_frame_arena_end(lv_display_t * disp);
+
 /**********************
  *      MACROS
  **********************/
@@ -63,6 +63,9 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
     /*Initialize the cache*/
     lv_image_cache_init(image_cache_size);
     lv_image_header_cache_init(image_header_count);
+#if LV_USE_LZ4
+    lv_image_cache_compressed_init(LV_CACHE_COMPRESSED_DEF_SIZE);
+#endif
 }
 
 /**
@@ -70,6 +73,14 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void)
 {
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /*Stop the workers before the cache they decode to is destroyed*/
+    lv_image_decoder_async_deinit();
+#endif
+#if LV_USE_LZ4
+    /*Destroy it first to not compress the images of the image cache*/
+    lv_image_cache_compressed_deinit();
+#endif
     lv_cache_destroy(img_cache_p, NULL);
     lv_cache_destroy(img_header_cache_p, NULL);
 
@@ -233,6 +244,7 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
     }
     cached_data->user_data = user_data; /*Need to free data on cache invalidate instead of decoder_close*/
     cached_data->decoder = decoder;
+    cached_data->access_cnt = 1;
 
     return cache_entry;
 }
@@ -403,8 +415,17 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
 
     lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
 
+#if LV_USE_LZ4
+    /*Decompress it if it's in the compressed image cache*/
+    if(entry == NULL) entry = lv_image_cache_promote(dsc->src, dsc->src_type);
+#endif
+
     if(entry) {
         lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+        /*Read by the eviction which can happen on other threads*/
+        lv_mutex_lock(&cache->lock);
+        cached_data->access_cnt++;
+        lv_mutex_unlock(&cache->lock);
         dsc->decoded = cached_data->decoded;
         dsc->decoder = (lv_image_decoder_t *)cached_data->decoder;
         dsc->cache_entry = entry;     /*Save the cache to release it in decoder_close*/
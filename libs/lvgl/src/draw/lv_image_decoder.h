@@ -183,6 +183,40 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
  */
 lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t * decoded);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+/**
+ * Enable or disable asynchronous image decoding.
+ * If enabled, images which are not in the image cache are decoded by worker threads
+ * and a placeholder is drawn instead of them until they are ready.
+ * When an image is decoded the Widgets which tried to draw it are invalidated.
+ * Requires the image cache to be enabled, else the images are decoded synchronously.
+ * @param en    true: enable, false: disable and wait for the running decodings to finish
+ */
+void lv_image_decoder_async_enable(bool en);
+
+/**
+ * Check if asynchronous image decoding is enabled.
+ * @return      true: enabled, false: disabled
+ */
+bool lv_image_decoder_async_is_enabled(void);
+
+/**
+ * Set the placeholder which is drawn while an image is being decoded.
+ * @param color color of the placeholder rectangle
+ * @param opa   opacity of the placeholder rectangle. `LV_OPA_TRANSP` to draw nothing.
+ */
+void lv_image_decoder_async_set_placeholder(lv_color_t color, lv_opa_t opa);
+
+/**
+ * Check if an image is waiting for or being decoded asynchronously.
+ * @param src   pointer to an image source
+ * @return      true: the image is being decoded, false: it's not queued for decoding
+ */
+bool lv_image_decoder_async_is_pending(const void * src);
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
 /**********************
  *      MACROS
  **********************/
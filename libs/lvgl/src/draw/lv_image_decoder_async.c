@@ -0,0 +1,476 @@
+/**
+ * @file lv_image_decoder_async.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_image_decoder_private.h"
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+#include "lv_draw_image_private.h"
+#include "lv_draw_rect.h"
+#include "../core/lv_global.h"
+#include "../core/lv_obj.h"
+#include "../core/lv_refr_private.h"
+#include "../display/lv_display.h"
+#include "../misc/cache/lv_image_cache.h"
+#include "../misc/lv_array.h"
+#include "../misc/lv_ll.h"
+#include "../misc/lv_rb_private.h"
+#include "../misc/lv_timer.h"
+#include "../osal/lv_os.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define async_p ((lv_image_decoder_async_t *)LV_GLOBAL_DEFAULT()->img_decoder_async)
+
+/*Check the finished decodings this often*/
+#define POLL_PERIOD 10
+
+/*Remember this many images which couldn't be cached to draw them synchronously*/
+#define FAILED_JOB_CNT_MAX  8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    JOB_STATE_QUEUED,
+    JOB_STATE_RUNNING,
+    JOB_STATE_READY,    /*Decoded and added to the image cache*/
+    JOB_STATE_SYNC,     /*Couldn't be cached or decoded, draw it synchronously*/
+} job_state_t;
+
+typedef struct {
+    const void * src;       /*File names are duplicated*/
+    lv_image_src_t src_type;
+    job_state_t state;
+    lv_array_t objs;        /*Widgets to invalidate when the job is finished*/
+    lv_display_t * disp;    /*Invalidate its screen if there are no Widgets*/
+    lv_rb_node_t * node;    /*The node of the job in `jobs`*/
+} decode_job_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;
+    void * ctx;
+} decode_worker_t;
+
+typedef struct {
+    lv_mutex_t lock;
+    lv_rb_t jobs;           /*All the `decode_job_t`s ordered by source*/
+    lv_ll_t queue;          /*`decode_job_t *` waiting for a worker in the order they were queued*/
+    lv_ll_t done;           /*`decode_job_t *` finished by the workers*/
+    lv_ll_t failed;         /*`decode_job_t *` drawn synchronously, the oldest first*/
+    uint32_t active_cnt;    /*Number of the queued, running and done jobs*/
+    decode_worker_t workers[LV_IMAGE_DECODER_ASYNC_THREAD_CNT];
+    lv_timer_t * timer;
+    lv_color_t placeholder_color;
+    lv_opa_t placeholder_opa;
+    bool enabled;
+    volatile bool exit_status;
+} lv_image_decoder_async_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_image_decoder_async_t * get_ctx(void);
+static bool needs_decoding(const void * src, lv_image_src_t src_type);
+static lv_rb_compare_res_t job_compare_cb(const decode_job_t * lhs, const decode_job_t * rhs);
+static decode_job_t * find_job(const void * src, lv_image_src_t src_type);
+static decode_job_t * queue_job(const void * src, lv_image_src_t src_type);
+static void job_add_obj(decode_job_t * job, lv_obj_t * obj);
+static void job_invalidate(decode_job_t * job);
+static void job_remove(decode_job_t * job);
+static void jobs_remove_all(lv_ll_t * ll);
+static decode_job_t * take_next_job(lv_image_decoder_async_t * ctx);
+static void worker_thread_cb(void * user_data);
+static void poll_timer_cb(lv_timer_t * t);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_image_decoder_async_enable(bool en)
+{
+    lv_image_decoder_async_t * ctx = get_ctx();
+    if(ctx->enabled == en) return;
+
+    uint32_t i;
+    if(en) {
+        ctx->exit_status = false;
+        for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+            decode_worker_t * w = &ctx->workers[i];
+            w->ctx = ctx;
+            lv_thread_sync_init(&w->sync);
+            lv_thread_init(&w->thread, LV_THREAD_PRIO_LOW, worker_thread_cb, LV_DRAW_THREAD_STACK_SIZE, w);
+        }
+
+        ctx->timer = lv_timer_create(poll_timer_cb, POLL_PERIOD, NULL);
+        lv_timer_pause(ctx->timer);
+        ctx->enabled = true;
+        return;
+    }
+
+    ctx->enabled = false;
+    ctx->exit_status = true;
+    for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+        decode_worker_t * w = &ctx->workers[i];
+        lv_thread_sync_signal(&w->sync);
+        lv_thread_delete(&w->thread);
+        lv_thread_sync_delete(&w->sync);
+    }
+
+    lv_timer_delete(ctx->timer);
+    ctx->timer = NULL;
+
+    /*The workers are stopped so the jobs can be freed without locking.
+     *The finished images are in the cache or can be drawn synchronously, let the Widgets draw them.*/
+    decode_job_t ** job_p;
+    LV_LL_READ(&ctx->done, job_p) {
+        job_invalidate(*job_p);
+    }
+
+    jobs_remove_all(&ctx->queue);
+    jobs_remove_all(&ctx->done);
+    jobs_remove_all(&ctx->failed);
+    ctx->active_cnt = 0;
+}
+
+bool lv_image_decoder_async_is_enabled(void)
+{
+    return async_p && async_p->enabled;
+}
+
+void lv_image_decoder_async_set_placeholder(lv_color_t color, lv_opa_t opa)
+{
+    lv_image_decoder_async_t * ctx = get_ctx();
+    ctx->placeholder_color = color;
+    ctx->placeholder_opa = opa;
+}
+
+bool lv_image_decoder_async_is_pending(const void * src)
+{
+    lv_image_decoder_async_t * ctx = async_p;
+    if(ctx == NULL || !ctx->enabled || src == NULL) return false;
+
+    lv_mutex_lock(&ctx->lock);
+    decode_job_t * job = find_job(src, lv_image_src_get_type(src));
+    bool pending = job && (job->state == JOB_STATE_QUEUED || job->state == JOB_STATE_RUNNING);
+    lv_mutex_unlock(&ctx->lock);
+
+    return pending;
+}
+
+void lv_image_decoder_async_deinit(void)
+{
+    lv_image_decoder_async_t * ctx = async_p;
+    if(ctx == NULL) return;
+
+    lv_image_decoder_async_enable(false);
+    lv_mutex_delete(&ctx->lock);
+    lv_free(ctx);
+    LV_GLOBAL_DEFAULT()->img_decoder_async = NULL;
+}
+
+bool lv_image_decoder_async_defer(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_image_decoder_async_t * ctx = async_p;
+    if(ctx == NULL || !ctx->enabled) return false;
+
+    /*Without cache the decoded image would be lost*/
+    if(!lv_image_cache_is_enabled()) return false;
+
+    lv_image_src_t src_type = lv_image_src_get_type(dsc->src);
+    if(!needs_decoding(dsc->src, src_type)) return false;
+    if(lv_image_cache_contains(dsc->src)) return false;
+
+    lv_mutex_lock(&ctx->lock);
+    decode_job_t * job = find_job(dsc->src, src_type);
+    if(job == NULL) {
+        job = queue_job(dsc->src, src_type);
+    }
+    else if(job->state == JOB_STATE_READY || job->state == JOB_STATE_SYNC) {
+        /*Evicted since it was decoded or can't be cached at all*/
+        lv_mutex_unlock(&ctx->lock);
+        return false;
+    }
+
+    job_add_obj(job, dsc->base.obj);
+    if(job->disp == NULL) job->disp = lv_refr_get_disp_refreshing();
+    lv_mutex_unlock(&ctx->lock);
+
+    if(ctx->placeholder_opa > LV_OPA_MIN) {
+        lv_draw_rect_dsc_t rect_dsc;
+        lv_draw_rect_dsc_init(&rect_dsc);
+        rect_dsc.base = dsc->base;
+        rect_dsc.base.dsc_size = sizeof(lv_draw_rect_dsc_t);
+        rect_dsc.bg_color = ctx->placeholder_color;
+        rect_dsc.bg_opa = LV_OPA_MIX2(ctx->placeholder_opa, dsc->opa);
+        rect_dsc.radius = dsc->clip_radius;
+        lv_draw_rect(layer, &rect_dsc, coords);
+    }
+
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_image_decoder_async_t * get_ctx(void)
+{
+    if(async_p) return async_p;
+
+    lv_image_decoder_async_t * ctx = lv_malloc_zeroed(sizeof(lv_image_decoder_async_t));
+    LV_ASSERT_MALLOC(ctx);
+    lv_mutex_init(&ctx->lock);
+    lv_rb_init(&ctx->jobs, (lv_rb_compare_t)job_compare_cb, sizeof(decode_job_t));
+    lv_ll_init(&ctx->queue, sizeof(decode_job_t *));
+    lv_ll_init(&ctx->done, sizeof(decode_job_t *));
+    lv_ll_init(&ctx->failed, sizeof(decode_job_t *));
+    ctx->placeholder_color = lv_color_hex(0x808080);
+    ctx->placeholder_opa = LV_OPA_20;
+    LV_GLOBAL_DEFAULT()->img_decoder_async = ctx;
+    return ctx;
+}
+
+/**
+ * Plain images in C arrays are used directly, only files and
+ * encoded or compressed C arrays are slow to open.
+ */
+static bool needs_decoding(const void * src, lv_image_src_t src_type)
+{
+    if(src_type == LV_IMAGE_SRC_FILE) return true;
+    if(src_type != LV_IMAGE_SRC_VARIABLE) return false;
+
+    const lv_image_dsc_t * img_dsc = src;
+    if(img_dsc->header.cf == LV_COLOR_FORMAT_RAW || img_dsc->header.cf == LV_COLOR_FORMAT_RAW_ALPHA) return true;
+    return img_dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED;
+}
+
+static lv_rb_compare_res_t job_compare_cb(const decode_job_t * lhs, const decode_job_t * rhs)
+{
+    if(lhs->src_type != rhs->src_type) return lhs->src_type > rhs->src_type ? 1 : -1;
+
+    if(lhs->src_type == LV_IMAGE_SRC_FILE) {
+        int32_t cmp_res = lv_strcmp(lhs->src, rhs->src);
+        if(cmp_res != 0) return cmp_res > 0 ? 1 : -1;
+    }
+    else if(lhs->src != rhs->src) {
+        return lhs->src > rhs->src ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static decode_job_t * find_job(const void * src, lv_image_src_t src_type)
+{
+    decode_job_t key = {
+        .src = src,
+        .src_type = src_type,
+    };
+
+    lv_rb_node_t * node = lv_rb_find(&async_p->jobs, &key);
+    return node ? node->data : NULL;
+}
+
+static decode_job_t * queue_job(const void * src, lv_image_src_t src_type)
+{
+    lv_image_decoder_async_t * ctx = async_p;
+    decode_job_t key = {
+        .src = src,
+        .src_type = src_type,
+    };
+
+    lv_rb_node_t * node = lv_rb_insert(&ctx->jobs, &key);
+    LV_ASSERT_MALLOC(node);
+    decode_job_t * job = node->data;
+    job->src = src_type == LV_IMAGE_SRC_FILE ? lv_strdup(src) : src;
+    job->src_type = src_type;
+    job->state = JOB_STATE_QUEUED;
+    job->node = node;
+    lv_array_init(&job->objs, 1, sizeof(lv_obj_t *));
+
+    decode_job_t ** job_p = lv_ll_ins_tail(&ctx->queue);
+    LV_ASSERT_MALLOC(job_p);
+    *job_p = job;
+    ctx->active_cnt++;
+
+    lv_timer_resume(ctx->timer);
+
+    uint32_t i;
+    for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+        lv_thread_sync_signal(&ctx->workers[i].sync);
+    }
+
+    return job;
+}
+
+static void job_add_obj(decode_job_t * job, lv_obj_t * obj)
+{
+    if(obj == NULL) return;
+
+    uint32_t i;
+    uint32_t cnt = lv_array_size(&job->objs);
+    for(i = 0; i < cnt; i++) {
+        if(*(lv_obj_t **)lv_array_at(&job->objs, i) == obj) return;
+    }
+
+    lv_array_push_back(&job->objs, &obj);
+}
+
+static void job_invalidate(decode_job_t * job)
+{
+    uint32_t cnt = lv_array_size(&job->objs);
+    if(cnt == 0) {
+        /*Drawn without a Widget, refresh the whole screen*/
+        lv_display_t * disp = lv_display_get_next(NULL);
+        while(disp) {
+            if(disp == job->disp) {
+                lv_obj_invalidate(lv_display_get_screen_active(disp));
+                break;
+            }
+            disp = lv_display_get_next(disp);
+        }
+        return;
+    }
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * obj = *(lv_obj_t **)lv_array_at(&job->objs, i);
+        /*The Widget might have been deleted in the meantime*/
+        if(lv_obj_is_valid(obj)) lv_obj_invalidate(obj);
+    }
+
+    lv_array_clear(&job->objs);
+}
+
+/**
+ * Remove a job from `jobs` and free it. The caller removes it from the lists.
+ */
+static void job_remove(decode_job_t * job)
+{
+    const void * src = job->src;
+    lv_image_src_t src_type = job->src_type;
+    lv_array_deinit(&job->objs);
+    lv_rb_drop_node(&async_p->jobs, job->node);
+
+    if(src_type == LV_IMAGE_SRC_FILE) lv_free((void *)src);
+}
+
+static void jobs_remove_all(lv_ll_t * ll)
+{
+    decode_job_t ** job_p;
+    LV_LL_READ(ll, job_p) {
+        job_remove(*job_p);
+    }
+    lv_ll_clear(ll);
+}
+
+static decode_job_t * take_next_job(lv_image_decoder_async_t * ctx)
+{
+    decode_job_t * job = NULL;
+    lv_mutex_lock(&ctx->lock);
+    decode_job_t ** job_p = lv_ll_get_head(&ctx->queue);
+    if(job_p) {
+        job = *job_p;
+        job->state = JOB_STATE_RUNNING;
+        lv_ll_remove(&ctx->queue, job_p);
+        lv_free(job_p);
+    }
+    lv_mutex_unlock(&ctx->lock);
+
+    return job;
+}
+
+static void worker_thread_cb(void * user_data)
+{
+    decode_worker_t * w = user_data;
+    lv_image_decoder_async_t * ctx = w->ctx;
+
+    while(1) {
+        lv_thread_sync_wait(&w->sync);
+        if(ctx->exit_status) break;
+
+        decode_job_t * job;
+        while(!ctx->exit_status && (job = take_next_job(ctx)) != NULL) {
+            LV_PROFILER_BEGIN_TAG("async_decode");
+
+            /*The decoder adds the image to the cache, closing it only releases the entry*/
+            lv_image_decoder_dsc_t decoder_dsc;
+            lv_result_t res = lv_image_decoder_open(&decoder_dsc, job->src, NULL);
+            if(res == LV_RESULT_OK) lv_image_decoder_close(&decoder_dsc);
+
+            bool cached = res == LV_RESULT_OK && lv_image_cache_contains(job->src);
+            if(!cached) LV_LOG_INFO("couldn't cache the image, it will be decoded synchronously");
+
+            lv_mutex_lock(&ctx->lock);
+            job->state = cached ? JOB_STATE_READY : JOB_STATE_SYNC;
+            decode_job_t ** job_p = lv_ll_ins_tail(&ctx->done);
+            LV_ASSERT_MALLOC(job_p);
+            *job_p = job;
+            lv_mutex_unlock(&ctx->lock);
+
+            LV_PROFILER_END_TAG("async_decode");
+        }
+    }
+
+    lv_mem_thread_cache_flush();
+    LV_LOG_INFO("exit image decoding thread");
+}
+
+static void poll_timer_cb(lv_timer_t * t)
+{
+    lv_image_decoder_async_t * ctx = async_p;
+
+    lv_mutex_lock(&ctx->lock);
+    decode_job_t ** job_p;
+    while((job_p = lv_ll_get_head(&ctx->done)) != NULL) {
+        decode_job_t * job = *job_p;
+        lv_ll_remove(&ctx->done, job_p);
+        lv_free(job_p);
+        ctx->active_cnt--;
+
+        /*The ready images are drawn from the cache, the others synchronously*/
+        job_invalidate(job);
+
+        if(job->state == JOB_STATE_READY) {
+            job_remove(job);
+            continue;
+        }
+
+        /*Keep the last few failed ones to not queue them again on every redraw*/
+        job_p = lv_ll_ins_tail(&ctx->failed);
+        LV_ASSERT_MALLOC(job_p);
+        *job_p = job;
+        if(lv_ll_get_len(&ctx->failed) > FAILED_JOB_CNT_MAX) {
+            job_p = lv_ll_get_head(&ctx->failed);
+            job_remove(*job_p);
+            lv_ll_remove(&ctx->failed, job_p);
+            lv_free(job_p);
+        }
+    }
+    bool pending = ctx->active_cnt > 0;
+    lv_mutex_unlock(&ctx->lock);
+
+    if(!pending) lv_timer_pause(t);
+}
+
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
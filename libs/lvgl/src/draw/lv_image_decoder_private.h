@@ -61,8 +61,28 @@ struct lv_image_cache_data_t {
     const lv_draw_buf_t * decoded;
     const lv_image_decoder_t * decoder;
     void * user_data;
+
+    /** How many times the image was opened from the cache. Only frequently used images
+     *  are moved to the compressed image cache when evicted.*/
+    uint32_t access_cnt;
 };
 
+#if LV_USE_LZ4
+/** An image in the compressed image cache. `slot.size` is the size of the compressed data.*/
+struct lv_image_cache_compressed_data_t {
+    lv_cache_slot_size_t slot;
+
+    const void * src;
+    lv_image_src_t src_type;
+
+    lv_image_header_t header;       /**< Header of the decoded draw buffer*/
+    uint32_t data_size;             /**< Size of the decoded data*/
+    const lv_image_decoder_t * decoder;
+    uint32_t access_cnt;
+    uint8_t * data;                 /**< The decoded data compressed with LZ4*/
+};
+#endif
+
 struct lv_image_header_cache_data_t {
     const void * src;
     lv_image_src_t src_type;
@@ -131,6 +151,30 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void);
 
+#if LV_USE_LZ4
+/**
+ * Find an image in the compressed image cache, decompress it and add it to the image cache.
+ * @param src       the image source
+ * @param src_type  type of the image source
+ * @return          the acquired image cache entry or NULL if the image is not in the compressed cache
+ */
+lv_cache_entry_t * lv_image_cache_promote(const void * src, lv_image_src_t src_type);
+
+/**
+ * Compress the images evicted from the image cache since the last call and add them to the
+ * compressed image cache. Evicted images are only queued as eviction happens with the image
+ * cache locked. Called at the end of each refresh.
+ */
+void lv_image_cache_compress_pending(void);
+#endif
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Stop the asynchronous image decoding workers and free the pending decodings
+ */
+void lv_image_decoder_async_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -14,6 +14,7 @@
 #include "../../display/lv_display_private.h"
 #include "../../stdlib/lv_string.h"
 #include "../../core/lv_global.h"
+#include "../../others/telemetry/lv_telemetry_private.h"
 
 #if LV_USE_VECTOR_GRAPHIC && LV_USE_THORVG
     #if LV_USE_THORVG_EXTERNAL
@@ -166,6 +167,9 @@ void lv_draw_sw_init(void)
 
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_init();
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    lv_draw_sw_shadow_cache_init();
+#endif
 #endif
 
     uint32_t i;
@@ -174,7 +178,7 @@ void lv_draw_sw_init(void)
         draw_sw_unit->base_unit.dispatch_cb = dispatch;
         draw_sw_unit->base_unit.evaluate_cb = evaluate;
         draw_sw_unit->idx = i;
-        draw_sw_unit->base_unit.delete_cb = LV_USE_OS ? lv_draw_sw_delete : NULL;
+        draw_sw_unit->base_unit.delete_cb = lv_draw_sw_delete;
 
 #if LV_USE_OS
         lv_thread_init(&draw_sw_unit->thread, LV_THREAD_PRIO_HIGH, render_thread_cb, LV_DRAW_THREAD_STACK_SIZE, draw_sw_unit);
@@ -194,14 +198,18 @@ void lv_draw_sw_deinit(void)
 
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    lv_draw_sw_shadow_cache_deinit();
+#endif
 #endif
 }
 
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
 {
-#if LV_USE_OS
     lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *) draw_unit;
+    int32_t res = 0;
 
+#if LV_USE_OS
     LV_LOG_INFO("cancel software rendering thread");
     draw_sw_unit->exit_status = true;
 
@@ -209,11 +217,14 @@ static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
         lv_thread_sync_signal(&draw_sw_unit->sync);
     }
 
-    return lv_thread_delete(&draw_sw_unit->thread);
-#else
-    LV_UNUSED(draw_unit);
-    return 0;
+    res = lv_thread_delete(&draw_sw_unit->thread);
 #endif
+
+    lv_free(draw_sw_unit->transform_buf);
+    draw_sw_unit->transform_buf = NULL;
+    draw_sw_unit->transform_buf_size = 0;
+
+    return res;
 }
 
 void lv_draw_sw_rgb565_swap(void * buf, uint32_t buf_size_px)
@@ -380,7 +391,9 @@ void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t
  **********************/
 static inline void execute_drawing_unit(lv_draw_sw_unit_t * u)
 {
+    LV_TELEMETRY_DRAW_UNIT_BEGIN(&u->base_unit);
     execute_drawing(u);
+    LV_TELEMETRY_DRAW_UNIT_END(&u->base_unit);
 
     u->task_act->state = LV_DRAW_TASK_STATE_READY;
     u->task_act = NULL;
@@ -492,6 +505,7 @@ static void render_thread_cb(void * ptr)
 
     u->inited = false;
     lv_thread_sync_delete(&u->sync);
+    lv_mem_thread_cache_flush();
     LV_LOG_INFO("exit software rendering thread");
 }
 #endif
@@ -9,7 +9,7 @@
 #include "../../misc/lv_area_private.h"
 #include "lv_draw_sw_mask_private.h"
 #include "../lv_draw_private.h"
-#include "lv_draw_sw.h"
+#include "lv_draw_sw_private.h"
 #if LV_USE_DRAW_SW
 
 #if LV_DRAW_SW_COMPLEX
@@ -30,6 +30,7 @@
 
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
     #define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
+    #define SHADOW_CACHE_NAME "SW_SHADOW"
 #endif
 
 /**********************
@@ -42,6 +43,13 @@
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    static lv_opa_t * shadow_cache_get_corner(const lv_area_t * coords, int32_t sw, int32_t r);
+    static bool shadow_cache_create_cb(lv_draw_sw_shadow_cache_data_t * node, const lv_opa_t * sh_buf);
+    static void shadow_cache_free_cb(lv_draw_sw_shadow_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t shadow_cache_compare_cb(const lv_draw_sw_shadow_cache_data_t * lhs,
+                                                          const lv_draw_sw_shadow_cache_data_t * rhs);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -100,24 +108,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     lv_opa_t * sh_buf;
 
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
-    }
+    sh_buf = shadow_cache_get_corner(&core_area, dsc->width, r_sh);
 #else
     sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
     shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
@@ -184,7 +175,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -227,7 +218,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -466,7 +457,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -510,7 +501,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -556,10 +547,127 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     lv_free(mask_buf);
 }
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+
+void lv_draw_sw_shadow_cache_init(void)
+{
+    /*Keep as many corners as fit into the RAM of a single `LV_DRAW_SW_SHADOW_CACHE_SIZE` sized corner*/
+    shadow_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(lv_draw_sw_shadow_cache_data_t),
+    LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) shadow_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) shadow_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) shadow_cache_free_cb,
+    });
+    if(shadow_cache) lv_cache_set_name(shadow_cache, SHADOW_CACHE_NAME);
+}
+
+void lv_draw_sw_shadow_cache_deinit(void)
+{
+    if(shadow_cache) {
+        lv_cache_destroy(shadow_cache, NULL);
+        shadow_cache = NULL;
+    }
+}
+
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+
+/**
+ * Get a blurred corner from the shadow cache. Calculate and add it to the cache if it's not there yet.
+ * @param coords    coordinates of the shadow's core area
+ * @param sw        shadow width
+ * @param r         clamped radius
+ * @return          a new buffer with the corner's `(sw + r)^2` opacity values. Free it with `lv_free`.
+ */
+static lv_opa_t * shadow_cache_get_corner(const lv_area_t * coords, int32_t sw, int32_t r)
+{
+    int32_t size = sw + r;
+
+    /*Only the part of the core area which is closer than `size` to the corner affects the result*/
+    lv_draw_sw_shadow_cache_data_t search_key = {
+        .slot.size = (size_t)size * size,
+        .sw = sw,
+        .r = r,
+        .w = LV_MIN(lv_area_get_width(coords), 2 * size),
+        .h = LV_MIN(lv_area_get_height(coords), 2 * size),
+    };
+
+    lv_cache_entry_t * entry = NULL;
+    bool cacheable = shadow_cache &&
+                     search_key.slot.size <= LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE;
+    if(cacheable) entry = lv_cache_acquire(shadow_cache, &search_key, NULL);
+
+    /*The cached corners are never modified so they can be copied without keeping the cache locked*/
+    if(entry) {
+        lv_draw_sw_shadow_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+        lv_opa_t * sh_buf = lv_malloc(search_key.slot.size);
+        LV_ASSERT_MALLOC(sh_buf);
+        lv_memcpy(sh_buf, cached_data->buf, search_key.slot.size);
+        lv_cache_release(shadow_cache, entry, NULL);
+        return sh_buf;
+    }
+
+    /*A larger buffer is required for calculation*/
+    lv_opa_t * sh_buf = lv_malloc(search_key.slot.size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(sh_buf);
+    shadow_draw_corner_buf(coords, (uint16_t *)sh_buf, sw, r);
+
+    /*If an other draw unit has added the same corner meanwhile it's returned and nothing is created*/
+    if(cacheable) {
+        entry = lv_cache_acquire_or_create(shadow_cache, &search_key, sh_buf);
+        if(entry) lv_cache_release(shadow_cache, entry, NULL);
+    }
+
+    return sh_buf;
+}
+
+static bool shadow_cache_create_cb(lv_draw_sw_shadow_cache_data_t * node, const lv_opa_t * sh_buf)
+{
+    node->buf = lv_malloc(node->slot.size);
+    LV_ASSERT_MALLOC(node->buf);
+    if(node->buf == NULL) return false;
+
+    lv_memcpy(node->buf, sh_buf, node->slot.size);
+    return true;
+}
+
+static void shadow_cache_free_cb(lv_draw_sw_shadow_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(node->buf);
+    node->buf = NULL;
+}
+
+static lv_cache_compare_res_t shadow_cache_compare_cb(const lv_draw_sw_shadow_cache_data_t * lhs,
+                                                      const lv_draw_sw_shadow_cache_data_t * rhs)
+{
+    if(lhs->sw != rhs->sw) {
+        return lhs->sw > rhs->sw ? 1 : -1;
+    }
+
+    if(lhs->r != rhs->r) {
+        return lhs->r > rhs->r ? 1 : -1;
+    }
+
+    if(lhs->w != rhs->w) {
+        return lhs->w > rhs->w ? 1 : -1;
+    }
+
+    if(lhs->h != rhs->h) {
+        return lhs->h > rhs->h ? 1 : -1;
+    }
+
+    return 0;
+}
+
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 /**
  * Calculate a blurred corner
  * @param coords Coordinates of the shadow
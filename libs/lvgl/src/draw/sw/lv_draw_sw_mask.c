@@ -21,10 +21,16 @@
 /*********************
  *      DEFINES
  *********************/
-#define CIRCLE_CACHE_LIFE_MAX           1000
-#define CIRCLE_CACHE_AGING(life, r)     life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
-#define circle_cache_mutex              LV_GLOBAL_DEFAULT()->draw_info.circle_cache_mutex
-#define _circle_cache                   LV_GLOBAL_DEFAULT()->sw_circle_cache
+#define circle_cache                    LV_GLOBAL_DEFAULT()->sw_circle_cache
+#define CIRCLE_CACHE_NAME               "SW_CIRCLE"
+
+/*The opacities, `opa_start_on_y` and `x_start_on_y` of a circle*/
+#define CIRCLE_BUF_SIZE(radius)         ((size_t)(radius) * 6 + 6)
+
+/*It used to be the number of circles, so catch such small values*/
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0 && LV_DRAW_SW_CIRCLE_CACHE_SIZE < 64
+    #warning "LV_DRAW_SW_CIRCLE_CACHE_SIZE is the size of the circle cache in bytes. It's too small to be useful."
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -65,6 +71,10 @@ static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radiu
 static lv_opa_t * get_next_line(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t y, int32_t * len,
                                 int32_t * x_start);
 static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
+static bool circle_cache_create_cb(lv_draw_sw_mask_radius_circle_dsc_t * node, void * user_data);
+static void circle_cache_free_cb(lv_draw_sw_mask_radius_circle_dsc_t * node, void * user_data);
+static lv_cache_compare_res_t circle_cache_compare_cb(const lv_draw_sw_mask_radius_circle_dsc_t * lhs,
+                                                      const lv_draw_sw_mask_radius_circle_dsc_t * rhs);
 
 /**********************
  *  STATIC VARIABLES
@@ -80,12 +90,23 @@ static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, l
 
 void lv_draw_sw_mask_init(void)
 {
-    lv_mutex_init(&circle_cache_mutex);
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    circle_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(lv_draw_sw_mask_radius_circle_dsc_t),
+    LV_DRAW_SW_CIRCLE_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) circle_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) circle_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) circle_cache_free_cb,
+    });
+    if(circle_cache) lv_cache_set_name(circle_cache, CIRCLE_CACHE_NAME);
+#endif
 }
 
 void lv_draw_sw_mask_deinit(void)
 {
-    lv_mutex_delete(&circle_cache_mutex);
+    if(circle_cache) {
+        lv_cache_destroy(circle_cache, NULL);
+        circle_cache = NULL;
+    }
 }
 
 lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[], lv_opa_t * mask_buf, int32_t abs_x,
@@ -109,32 +130,19 @@ lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[]
 
 void lv_draw_sw_mask_free_param(void * p)
 {
-    lv_mutex_lock(&circle_cache_mutex);
     lv_draw_sw_mask_common_dsc_t * pdsc = p;
     if(pdsc->type == LV_DRAW_SW_MASK_TYPE_RADIUS) {
         lv_draw_sw_mask_radius_param_t * radius_p = (lv_draw_sw_mask_radius_param_t *) p;
-        if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
-                lv_free(radius_p->circle->cir_opa);
-                lv_free(radius_p->circle);
-            }
-            else {
-                radius_p->circle->used_cnt--;
-            }
+        if(radius_p->circle_entry) {
+            lv_cache_release(circle_cache, radius_p->circle_entry, NULL);
         }
-    }
-
-    lv_mutex_unlock(&circle_cache_mutex);
-}
-
-void lv_draw_sw_mask_cleanup(void)
-{
-    uint8_t i;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].buf) {
-            lv_free(_circle_cache[i].buf);
+        else if(radius_p->circle) {
+            circle_cache_free_cb(radius_p->circle, NULL);
+            lv_free(radius_p->circle);
         }
-        lv_memzero(&(_circle_cache[i]), sizeof(_circle_cache[i]));
+
+        radius_p->circle = NULL;
+        radius_p->circle_entry = NULL;
     }
 }
 
@@ -306,52 +314,28 @@ void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const l
     param->dsc.cb = (lv_draw_sw_mask_xcb_t)lv_draw_mask_radius;
     param->dsc.type = LV_DRAW_SW_MASK_TYPE_RADIUS;
 
-    if(radius == 0) {
-        param->circle = NULL;
-        return;
-    }
-
-    lv_mutex_lock(&circle_cache_mutex);
-
-    uint32_t i;
+    param->circle = NULL;
+    param->circle_entry = NULL;
+    if(radius == 0) return;
 
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].radius == radius) {
-            _circle_cache[i].used_cnt++;
-            CIRCLE_CACHE_AGING(_circle_cache[i].life, radius);
-            param->circle = &(_circle_cache[i]);
-            lv_mutex_unlock(&circle_cache_mutex);
+    /*The cached circles are never modified so they can be used by all draw units in parallel
+     *while the entries are acquired*/
+    if(circle_cache && CIRCLE_BUF_SIZE(radius) <= LV_DRAW_SW_CIRCLE_CACHE_SIZE) {
+        lv_draw_sw_mask_radius_circle_dsc_t search_key = {
+            .slot.size = CIRCLE_BUF_SIZE(radius),
+            .radius = radius,
+        };
+        param->circle_entry = lv_cache_acquire_or_create(circle_cache, &search_key, NULL);
+        if(param->circle_entry) {
+            param->circle = lv_cache_entry_get_data(param->circle_entry);
             return;
         }
     }
 
-    /*If not cached use the free entry with lowest life*/
-    lv_draw_sw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].used_cnt == 0) {
-            if(!entry) entry = &(_circle_cache[i]);
-            else if(_circle_cache[i].life < entry->life) entry = &(_circle_cache[i]);
-        }
-    }
-
-    /*There is no unused entry. Allocate one temporarily*/
-    if(!entry) {
-        entry = lv_malloc_zeroed(sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        entry->life = -1;
-    }
-    else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
-    }
-
-    param->circle = entry;
-
+    /*The cache is disabled, the circle is too large or the whole cache is in use. Allocate one temporarily*/
+    param->circle = lv_malloc_zeroed(sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
+    LV_ASSERT_MALLOC(param->circle);
     circ_calc_aa4(param->circle, radius);
-    lv_mutex_unlock(&circle_cache_mutex);
-
 }
 
 void lv_draw_sw_mask_fade_init(lv_draw_sw_mask_fade_param_t * param, const lv_area_t * coords, lv_opa_t opa_top,
@@ -1076,7 +1060,7 @@ static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radiu
     /*Allocate buffers*/
     if(c->buf) lv_free(c->buf);
 
-    c->buf = lv_malloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
+    c->buf = lv_malloc(CIRCLE_BUF_SIZE(radius));  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
     LV_ASSERT_MALLOC(c->buf);
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
@@ -1233,4 +1217,30 @@ static inline lv_opa_t LV_ATTRIBUTE_FAST_MEM mask_mix(lv_opa_t mask_act, lv_opa_
     return LV_UDIV255(mask_act * mask_new);
 }
 
+static bool circle_cache_create_cb(lv_draw_sw_mask_radius_circle_dsc_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    circ_calc_aa4(node, node->radius);
+    return node->buf != NULL;
+}
+
+static void circle_cache_free_cb(lv_draw_sw_mask_radius_circle_dsc_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(node->buf);
+    node->buf = NULL;
+}
+
+static lv_cache_compare_res_t circle_cache_compare_cb(const lv_draw_sw_mask_radius_circle_dsc_t * lhs,
+                                                      const lv_draw_sw_mask_radius_circle_dsc_t * rhs)
+{
+    if(lhs->radius != rhs->radius) {
+        return lhs->radius > rhs->radius ? 1 : -1;
+    }
+
+    return 0;
+}
+
 #endif /*LV_DRAW_SW_COMPLEX*/
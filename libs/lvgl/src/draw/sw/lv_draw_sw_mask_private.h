@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_draw_sw_mask.h"
+#include "../../misc/cache/lv_cache_private.h"
 
 #if LV_DRAW_SW_COMPLEX
 
@@ -27,12 +28,11 @@ extern "C" {
  **********************/
 
 typedef struct  {
+    lv_cache_slot_size_t slot;  /**< Size of `buf`. Used to limit the size of the circle cache*/
     uint8_t * buf;
     lv_opa_t * cir_opa;         /**< Opacity of values on the circumference of an 1/4 circle */
     uint16_t * x_start_on_y;    /**< The x coordinate of the circle for each y value */
     uint16_t * opa_start_on_y;  /**< The index of `cir_opa` for each y value */
-    int32_t life;               /**< How many times the entry way used */
-    uint32_t used_cnt;          /**< Like a semaphore to count the referencing masks */
     int32_t radius;             /**< The radius of the entry */
 } lv_draw_sw_mask_radius_circle_dsc_t;
 
@@ -106,6 +106,7 @@ struct lv_draw_sw_mask_radius_param_t {
     } cfg;
 
     lv_draw_sw_mask_radius_circle_dsc_t * circle;
+    lv_cache_entry_t * circle_entry;    /**< The cache entry of `circle` or NULL if it was allocated temporarily*/
 };
 
 struct lv_draw_sw_mask_fade_param_t {
@@ -132,18 +133,10 @@ struct lv_draw_sw_mask_map_param_t {
     } cfg;
 };
 
-typedef lv_draw_sw_mask_radius_circle_dsc_t lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
-
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
-/**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
- */
-void lv_draw_sw_mask_cleanup(void);
-
 /**********************
  *      MACROS
  **********************/
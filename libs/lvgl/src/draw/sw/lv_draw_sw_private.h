@@ -16,6 +16,7 @@ extern "C" {
 
 #include "lv_draw_sw.h"
 #include "../lv_draw_private.h"
+#include "../../misc/cache/lv_cache_private.h"
 
 #if LV_USE_DRAW_SW
 
@@ -41,20 +42,50 @@ struct lv_draw_sw_unit_t {
     volatile bool exit_status;
 #endif
     uint32_t idx;
+    void * transform_buf;           /**< Reused by `lv_draw_sw_transform` for the per line tables*/
+    uint32_t transform_buf_size;
 };
 
+/**
+ * A source coordinate of a destination pixel in one direction
+ */
+typedef struct {
+    int32_t int_part;   /**< Integer part of the coordinate*/
+    int32_t fract;      /**< Weight of the neighbor in 0x00..0x7F range*/
+    int32_t next;       /**< Direction of the neighbor: -1 or 1*/
+    int32_t col;        /**< Index of `int_part` among the filtered source columns of the line*/
+    bool out;           /**< The coordinate is out of the image*/
+    bool edge;          /**< The neighbor is out of the image*/
+} lv_draw_sw_transform_coord_t;
+
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
+/** A blurred shadow corner stored in the shadow cache*/
 typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
-} lv_draw_sw_shadow_cache_t;
+    lv_cache_slot_size_t slot;
+    int32_t sw;         /**< Width of the shadow*/
+    int32_t r;          /**< Clamped radius of the shadow*/
+    int32_t w;          /**< Width of the blurred area clamped to `2 * (sw + r)`*/
+    int32_t h;          /**< Height of the blurred area clamped to `2 * (sw + r)`*/
+    lv_opa_t * buf;     /**< The corner's opacity map, `(sw + r)^2` bytes*/
+} lv_draw_sw_shadow_cache_data_t;
 #endif
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+/**
+ * Create the cache of the blurred shadow corners. Called by `lv_draw_sw_init`.
+ */
+void lv_draw_sw_shadow_cache_init(void);
+
+/**
+ * Free the cache of the blurred shadow corners. Called by `lv_draw_sw_deinit`.
+ */
+void lv_draw_sw_shadow_cache_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -6,7 +6,7 @@
 /*********************
  *      INCLUDES
  *********************/
-#include "lv_draw_sw.h"
+#include "lv_draw_sw_private.h"
 #if LV_USE_DRAW_SW
 
 #include "../../misc/lv_assert.h"
@@ -14,11 +14,32 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_color.h"
 #include "../../stdlib/lv_string.h"
+#include "../../stdlib/lv_mem.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON
+    #include "neon/lv_draw_sw_transform_neon.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+    #include "arm2d/lv_draw_sw_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
+    #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
+#endif
 
 /*********************
  *      DEFINES
  *********************/
 
+#ifndef LV_DRAW_SW_TRANSFORM
+    #define LV_DRAW_SW_TRANSFORM(...)   LV_RESULT_INVALID
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888_VER
+    #define LV_DRAW_SW_TRANSFORM_ARGB8888_VER(...)   LV_RESULT_INVALID
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888_HOR
+    #define LV_DRAW_SW_TRANSFORM_ARGB8888_HOR(...)   LV_RESULT_INVALID
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -37,6 +58,18 @@ typedef struct {
     lv_point_t pivot;
 } point_transform_dsc_t;
 
+typedef lv_draw_sw_transform_coord_t transform_coord_t;
+
+/**
+ * Tables of a scale only transformation. They are the same in every line.
+ */
+typedef struct {
+    transform_coord_t * xcs;    /**< Source X coordinate of each destination pixel*/
+    int32_t * cols;             /**< The distinct source columns used by `xcs` in increasing order*/
+    int32_t col_cnt;            /**< Number of elements in `cols`*/
+    lv_color32_t * ver;         /**< `cols` of the current line filtered vertically*/
+} transform_scale_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -51,28 +84,46 @@ typedef struct {
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout);
 
-#if LV_DRAW_SW_SUPPORT_RGB888
+static inline void transform_coord_init(transform_coord_t * c, int32_t ups, int32_t size);
+
+static bool transform_scale_dsc_init(transform_scale_dsc_t * dsc, lv_draw_unit_t * draw_unit, int32_t dest_w,
+                                     int32_t xs_ups, int32_t xs_step, int32_t src_w);
+
+#if LV_DRAW_SW_SUPPORT_RGB888 || LV_DRAW_SW_SUPPORT_XRGB8888
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                              int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
+
+static void transform_rgb888_scale(const uint8_t * src, int32_t src_stride, const transform_scale_dsc_t * scale_dsc,
+                                   const transform_coord_t * yc, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_ARGB8888
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                                int32_t x_end, uint8_t * dest_buf, bool aa);
+
+static void transform_argb8888_scale(const uint8_t * src, int32_t src_stride, const transform_scale_dsc_t * scale_dsc,
+                                     const transform_coord_t * yc, int32_t x_end, uint8_t * dest_buf, bool aa);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_RGB565A8
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                                int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
+
+static void transform_rgb565a8_scale(const uint8_t * src, int32_t src_h, int32_t src_stride,
+                                     const transform_coord_t * xcs, const transform_coord_t * yc,
+                                     int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_A8
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                          int32_t x_end, uint8_t * abuf, bool aa);
+
+static void transform_a8_scale(const uint8_t * src, int32_t src_stride, const transform_coord_t * xcs,
+                               const transform_coord_t * yc, int32_t x_end, uint8_t * abuf, bool aa);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_L8
@@ -101,9 +152,13 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
                           int32_t src_w, int32_t src_h, int32_t src_stride,
                           const lv_draw_image_dsc_t * draw_dsc, const lv_draw_image_sup_t * sup, lv_color_format_t src_cf, void * dest_buf)
 {
-    LV_UNUSED(draw_unit);
     LV_UNUSED(sup);
 
+    /*Let an accelerated (e.g. SIMD) implementation do the transformation if there is any*/
+    if(LV_RESULT_OK == LV_DRAW_SW_TRANSFORM(dest_area, src_buf, src_w, src_h, src_stride, draw_dsc, src_cf, dest_buf)) {
+        return;
+    }
+
     point_transform_dsc_t tr_dsc;
     tr_dsc.angle = -draw_dsc->rotation;
     tr_dsc.scale_x = draw_dsc->scale_x;
@@ -207,11 +262,22 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
         ys_ups_start = ys1_ups + 0x80;
     }
 
+    /*In case of scale only the source X coordinates are the same in every line,
+     *so calculate them only once. Without memory just use the generic per pixel path.*/
+    transform_scale_dsc_t scale_dsc;
+    transform_coord_t yc;
+    const transform_coord_t * xcs = NULL;
+    if(is_rotated == false && src_cf != LV_COLOR_FORMAT_L8 &&
+       transform_scale_dsc_init(&scale_dsc, draw_unit, dest_w, xs_ups, xs_step_256, src_w)) {
+        xcs = scale_dsc.xcs;
+    }
+
     int32_t y;
     for(y = 0; y < dest_h; y++) {
         if(is_rotated == false) {
             ys_ups = ys_ups_start + ((ys_step_256_original * y) >> 8);
             ys_step_256 = 0;
+            if(xcs) transform_coord_init(&yc, ys_ups, src_h);
         }
         else {
             int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
@@ -234,38 +300,44 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
         switch(src_cf) {
 #if LV_DRAW_SW_SUPPORT_XRGB8888
             case LV_COLOR_FORMAT_XRGB8888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 4);
+                if(xcs) transform_rgb888_scale(src_buf, src_stride, &scale_dsc, &yc, dest_w, dest_buf, aa, 4);
+                else transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
+                                          aa, 4);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_RGB888
             case LV_COLOR_FORMAT_RGB888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 3);
+                if(xcs) transform_rgb888_scale(src_buf, src_stride, &scale_dsc, &yc, dest_w, dest_buf, aa, 3);
+                else transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
+                                          aa, 3);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_A8
             case LV_COLOR_FORMAT_A8:
-                transform_a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa);
+                if(xcs) transform_a8_scale(src_buf, src_stride, xcs, &yc, dest_w, dest_buf, aa);
+                else transform_a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_ARGB8888
             case LV_COLOR_FORMAT_ARGB8888:
-                transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   aa);
+                if(xcs) transform_argb8888_scale(src_buf, src_stride, &scale_dsc, &yc, dest_w, dest_buf, aa);
+                else transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
+                                            aa);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_RGB565 && LV_DRAW_SW_SUPPORT_RGB565A8
             case LV_COLOR_FORMAT_RGB565:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   alpha_buf, false, aa);
+                if(xcs) transform_rgb565a8_scale(src_buf, src_h, src_stride, xcs, &yc, dest_w, dest_buf, alpha_buf, false, aa);
+                else transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
+                                            alpha_buf, false, aa);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_RGB565A8
             case LV_COLOR_FORMAT_RGB565A8:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
-                                   (uint16_t *)dest_buf,
-                                   alpha_buf, true, aa);
+                if(xcs) transform_rgb565a8_scale(src_buf, src_h, src_stride, xcs, &yc, dest_w, dest_buf, alpha_buf, true, aa);
+                else transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
+                                            (uint16_t *)dest_buf,
+                                            alpha_buf, true, aa);
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_L8
@@ -290,7 +362,91 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
  *   STATIC FUNCTIONS
  **********************/
 
-#if LV_DRAW_SW_SUPPORT_RGB888
+static inline void transform_coord_init(transform_coord_t * c, int32_t ups, int32_t size)
+{
+    c->int_part = ups >> 8;
+    c->out = c->int_part < 0 || c->int_part >= size;
+
+    /*Get the direction the neighbor
+     *`fract` will be in range of 0x00..0x7F and `next` (+/-1) indicates the direction*/
+    int32_t fract = ups & 0xFF;
+    if(fract < 0x80) {
+        c->next = -1;
+        c->fract = 0x7F - fract;
+    }
+    else {
+        c->next = 1;
+        c->fract = fract - 0x80;
+    }
+
+    c->edge = (c->int_part == 0 && c->next < 0) || (c->int_part == size - 1 && c->next > 0);
+}
+
+static bool transform_scale_dsc_init(transform_scale_dsc_t * dsc, lv_draw_unit_t * draw_unit, int32_t dest_w,
+                                     int32_t xs_ups, int32_t xs_step, int32_t src_w)
+{
+    lv_draw_sw_unit_t * u = (lv_draw_sw_unit_t *)draw_unit;
+    if(u == NULL) return false;
+
+    /*Keep the tables in the buffer of the draw unit to not allocate them for every image*/
+    uint32_t size = dest_w * (sizeof(transform_coord_t) + sizeof(int32_t) + sizeof(lv_color32_t));
+    if(u->transform_buf_size < size) {
+        lv_free(u->transform_buf);
+        u->transform_buf = lv_malloc(size);
+        u->transform_buf_size = u->transform_buf ? size : 0;
+        if(u->transform_buf == NULL) return false;
+    }
+
+    dsc->xcs = u->transform_buf;
+    dsc->cols = (int32_t *)(dsc->xcs + dest_w);
+    dsc->ver = (lv_color32_t *)(dsc->cols + dest_w);
+    dsc->col_cnt = 0;
+
+    int32_t x;
+    for(x = 0; x < dest_w; x++) {
+        transform_coord_t * xc = &dsc->xcs[x];
+        transform_coord_init(xc, xs_ups + ((xs_step * x) >> 8), src_w);
+        xc->col = -1;
+        if(xc->out) continue;
+
+        /*The coordinates are increasing so it's enough to check the last column*/
+        if(dsc->col_cnt == 0 || dsc->cols[dsc->col_cnt - 1] != xc->int_part) {
+            dsc->cols[dsc->col_cnt] = xc->int_part;
+            dsc->col_cnt++;
+        }
+        xc->col = dsc->col_cnt - 1;
+    }
+
+    return true;
+}
+
+#if LV_DRAW_SW_SUPPORT_RGB888 || LV_DRAW_SW_SUPPORT_XRGB8888
+
+static inline lv_color32_t rgb888_read(const uint8_t * src_u8)
+{
+    lv_color32_t c;
+    c.red = src_u8[2];
+    c.green = src_u8[1];
+    c.blue = src_u8[0];
+    c.alpha = 0xff;
+    return c;
+}
+
+static inline lv_color32_t rgb888_mix_neighbor(lv_color32_t c, lv_color32_t px, int32_t fract)
+{
+    if(!lv_color32_eq(c, px)) {
+        px.alpha = fract;
+        c = lv_color_mix32(px, c);
+    }
+    return c;
+}
+
+static inline void rgb888_fade_edge(lv_color32_t * c, const transform_coord_t * xc, const transform_coord_t * yc)
+{
+    lv_opa_t a = 0xff;
+    if(xc->edge) c->alpha = (a * (0xFF - xc->fract)) >> 8;
+    else if(yc->edge) c->alpha = (a * (0xFF - yc->fract)) >> 8;
+}
 
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
@@ -388,10 +544,77 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
     }
 }
 
+static void transform_rgb888_scale(const uint8_t * src, int32_t src_stride, const transform_scale_dsc_t * scale_dsc,
+                                   const transform_coord_t * yc, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
+{
+    lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
+    const transform_coord_t * xcs = scale_dsc->xcs;
+
+    int32_t x;
+    if(yc->out) {
+        for(x = 0; x < x_end; x++) dest_c32[x].alpha = 0x00;
+        return;
+    }
+
+    const uint8_t * src_row = &src[yc->int_part * src_stride];
+    bool aa_ver = aa && !yc->edge;
+
+    /*Filter the used source columns vertically first*/
+    lv_color32_t * ver = scale_dsc->ver;
+    if(aa_ver) {
+        const uint8_t * src_row_next = src_row + yc->next * src_stride;
+        int32_t i;
+        for(i = 0; i < scale_dsc->col_cnt; i++) {
+            int32_t ofs = scale_dsc->cols[i] * px_size;
+            ver[i] = rgb888_mix_neighbor(rgb888_read(&src_row[ofs]), rgb888_read(&src_row_next[ofs]), yc->fract);
+        }
+    }
+
+    /*Mix the vertically filtered pixels with their horizontal neighbor*/
+    for(x = 0; x < x_end; x++) {
+        const transform_coord_t * xc = &xcs[x];
+
+        /*Fully out of the image*/
+        if(xc->out) {
+            dest_c32[x].alpha = 0x00;
+            continue;
+        }
+
+        const uint8_t * src_u8 = &src_row[xc->int_part * px_size];
+        if(aa_ver && !xc->edge) {
+            lv_color32_t px_hor = rgb888_read(src_u8 + (int32_t)(xc->next * px_size));
+            dest_c32[x] = rgb888_mix_neighbor(ver[xc->col], px_hor, xc->fract);
+        }
+        else {
+            dest_c32[x] = rgb888_read(src_u8);
+            rgb888_fade_edge(&dest_c32[x], xc, yc);
+        }
+    }
+}
+
 #endif
 
 #if LV_DRAW_SW_SUPPORT_ARGB8888
 
+static inline lv_color32_t argb8888_mix_neighbor(lv_color32_t c, lv_color32_t px, int32_t fract)
+{
+    if(px.alpha == 0) {
+        c.alpha = (c.alpha * (0xFF - fract)) >> 8;
+    }
+    else if(!lv_color32_eq(c, px)) {
+        if(c.alpha) c.alpha = ((px.alpha * fract) + (c.alpha * (0xFF - fract))) >> 8;
+        px.alpha = fract;
+        c = lv_color_mix32(px, c);
+    }
+    return c;
+}
+
+static inline void argb8888_fade_edge(lv_color32_t * c, const transform_coord_t * xc, const transform_coord_t * yc)
+{
+    if(xc->edge) c->alpha = (c->alpha * (0x7F - xc->fract)) >> 7;
+    else if(yc->edge) c->alpha = (c->alpha * (0x7F - yc->fract)) >> 7;
+}
+
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                                int32_t x_end, uint8_t * dest_buf, bool aa)
@@ -481,10 +704,138 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
     }
 }
 
+static void transform_argb8888_scale(const uint8_t * src, int32_t src_stride, const transform_scale_dsc_t * scale_dsc,
+                                     const transform_coord_t * yc, int32_t x_end, uint8_t * dest_buf, bool aa)
+{
+    lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
+    const transform_coord_t * xcs = scale_dsc->xcs;
+
+    if(yc->out) {
+        lv_memzero(dest_buf, x_end * sizeof(lv_color32_t));
+        return;
+    }
+
+    const lv_color32_t * src_row = (const lv_color32_t *)(src + yc->int_part * src_stride);
+    bool aa_ver = aa && !yc->edge;
+
+    /*Filter the used source columns vertically first. Adjacent columns are handled together.*/
+    lv_color32_t * ver = scale_dsc->ver;
+    int32_t i;
+    int32_t run;
+    if(aa_ver) {
+        const lv_color32_t * src_row_next = (const lv_color32_t *)((const uint8_t *)src_row + yc->next * src_stride);
+        const int32_t * cols = scale_dsc->cols;
+        for(i = 0; i < scale_dsc->col_cnt; i += run) {
+            run = 1;
+            while(i + run < scale_dsc->col_cnt && cols[i + run] == cols[i] + run) run++;
+
+            const lv_color32_t * src_c32 = &src_row[cols[i]];
+            const lv_color32_t * src_next_c32 = &src_row_next[cols[i]];
+            if(LV_RESULT_OK == LV_DRAW_SW_TRANSFORM_ARGB8888_VER(&ver[i], src_c32, src_next_c32, yc->fract, run)) continue;
+
+            int32_t j;
+            for(j = 0; j < run; j++) {
+                ver[i + j] = argb8888_mix_neighbor(src_c32[j], src_next_c32[j], yc->fract);
+            }
+        }
+    }
+
+    /*Mix the vertically filtered pixels with their horizontal neighbor*/
+    int32_t x;
+    for(x = 0; x < x_end; x += run) {
+        const transform_coord_t * xc = &xcs[x];
+        run = 1;
+
+        /*Fully out of the image*/
+        if(xc->out) {
+            ((uint32_t *)dest_buf)[x] = 0x00000000;
+            continue;
+        }
+
+        /*Partially out of the image*/
+        if(!aa_ver || xc->edge) {
+            dest_c32[x] = src_row[xc->int_part];
+            argb8888_fade_edge(&dest_c32[x], xc, yc);
+            continue;
+        }
+
+        while(x + run < x_end && !xcs[x + run].out && !xcs[x + run].edge) run++;
+        if(LV_RESULT_OK == LV_DRAW_SW_TRANSFORM_ARGB8888_HOR(&dest_c32[x], ver, src_row, xc, run)) continue;
+
+        for(i = 0; i < run; i++) {
+            dest_c32[x + i] = argb8888_mix_neighbor(ver[xc[i].col], src_row[xc[i].int_part + xc[i].next], xc[i].fract);
+        }
+    }
+}
+
 #endif
 
 #if LV_DRAW_SW_SUPPORT_RGB565A8
 
+static inline void rgb565a8_pixel(const uint8_t * src, const lv_opa_t * src_alpha, int32_t src_stride,
+                                  const transform_coord_t * xc, const transform_coord_t * yc,
+                                  uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
+{
+    /*Must be signed type, because we would use negative array index calculated from stride*/
+    int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
+    int32_t xs_fract = xc->fract * 2;
+    int32_t ys_fract = yc->fract * 2;
+
+    const uint16_t * src_tmp_u16 = (const uint16_t *)(src + (yc->int_part * src_stride) + xc->int_part * 2);
+    *cbuf = src_tmp_u16[0];
+
+    if(aa && !xc->edge && !yc->edge) {
+        uint16_t px_hor = src_tmp_u16[xc->next];
+        uint16_t px_ver = *(const uint16_t *)((uint8_t *)src_tmp_u16 + (yc->next * src_stride));
+
+        if(src_has_a8) {
+            const lv_opa_t * src_alpha_tmp = src_alpha;
+            src_alpha_tmp += (yc->int_part * alpha_stride) + xc->int_part;
+            *abuf = src_alpha_tmp[0];
+
+            lv_opa_t a_hor = src_alpha_tmp[xc->next];
+            lv_opa_t a_ver = src_alpha_tmp[yc->next * alpha_stride];
+
+            if(a_ver != *abuf) a_ver = ((a_ver * ys_fract) + (*abuf * (0x100 - ys_fract))) >> 8;
+            if(a_hor != *abuf) a_hor = ((a_hor * xs_fract) + (*abuf * (0x100 - xs_fract))) >> 8;
+            *abuf = (a_ver + a_hor) >> 1;
+
+            if(*abuf == 0x00) return;
+        }
+        else {
+            *abuf = 0xff;
+        }
+
+        if(*cbuf != px_ver || *cbuf != px_hor) {
+            uint16_t v = lv_color_16_16_mix(px_ver, *cbuf, ys_fract);
+            uint16_t h = lv_color_16_16_mix(px_hor, *cbuf, xs_fract);
+            *cbuf = lv_color_16_16_mix(h, v, LV_OPA_50);
+        }
+    }
+    /*Partially out of the image*/
+    else {
+        lv_opa_t a;
+        if(src_has_a8) {
+            const lv_opa_t * src_alpha_tmp = src_alpha;
+            src_alpha_tmp += (yc->int_part * alpha_stride) + xc->int_part;
+            a = src_alpha_tmp[0];
+        }
+        else {
+            a = 0xff;
+        }
+
+        if(xc->edge) {
+            *abuf = (a * (0xFF - xs_fract)) >> 8;
+        }
+        else if(yc->edge) {
+            *abuf = (a * (0xFF - ys_fract)) >> 8;
+        }
+        else {
+            *abuf = a;
+        }
+    }
+}
+
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                                int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
@@ -596,10 +947,64 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
     }
 }
 
+static void transform_rgb565a8_scale(const uint8_t * src, int32_t src_h, int32_t src_stride,
+                                     const transform_coord_t * xcs, const transform_coord_t * yc,
+                                     int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
+{
+    if(yc->out) {
+        lv_memzero(abuf, x_end);
+        return;
+    }
+
+    const lv_opa_t * src_alpha = src + src_stride * src_h;
+
+    int32_t x;
+    for(x = 0; x < x_end; x++) {
+        /*Fully out of the image*/
+        if(xcs[x].out) {
+            abuf[x] = 0x00;
+            continue;
+        }
+
+        rgb565a8_pixel(src, src_alpha, src_stride, &xcs[x], yc, &cbuf[x], &abuf[x], src_has_a8, aa);
+    }
+}
+
 #endif
 
 #if LV_DRAW_SW_SUPPORT_A8
 
+static inline lv_opa_t a8_pixel(const uint8_t * src, int32_t src_stride,
+                                const transform_coord_t * xc, const transform_coord_t * yc, bool aa)
+{
+    int32_t xs_fract = xc->fract * 2;
+    int32_t ys_fract = yc->fract * 2;
+
+    const uint8_t * src_tmp = src;
+    src_tmp += yc->int_part * src_stride + xc->int_part;
+    lv_opa_t a = src_tmp[0];
+
+    if(aa && !xc->edge && !yc->edge) {
+        lv_opa_t a_ver = src_tmp[xc->next];
+        lv_opa_t a_hor = src_tmp[yc->next * src_stride];
+
+        if(a_ver != a) a_ver = ((a_ver * ys_fract) + (a * (0x100 - ys_fract))) >> 8;
+        if(a_hor != a) a_hor = ((a_hor * xs_fract) + (a * (0x100 - xs_fract))) >> 8;
+        a = (a_ver + a_hor) >> 1;
+    }
+    else {
+        /*Partially out of the image*/
+        if(xc->edge) {
+            a = (src_tmp[0] * (0xFF - xs_fract)) >> 8;
+        }
+        else if(yc->edge) {
+            a = (src_tmp[0] * (0xFF - ys_fract)) >> 8;
+        }
+    }
+
+    return a;
+}
+
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                          int32_t x_end, uint8_t * abuf, bool aa)
@@ -674,6 +1079,26 @@ static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int3
     }
 }
 
+static void transform_a8_scale(const uint8_t * src, int32_t src_stride, const transform_coord_t * xcs,
+                               const transform_coord_t * yc, int32_t x_end, uint8_t * abuf, bool aa)
+{
+    if(yc->out) {
+        lv_memzero(abuf, x_end);
+        return;
+    }
+
+    int32_t x;
+    for(x = 0; x < x_end; x++) {
+        /*Fully out of the image*/
+        if(xcs[x].out) {
+            abuf[x] = 0x00;
+            continue;
+        }
+
+        abuf[x] = a8_pixel(src, src_stride, &xcs[x], yc, aa);
+    }
+}
+
 #endif
 
 #if LV_DRAW_SW_SUPPORT_L8
@@ -0,0 +1,144 @@
+/**
+ * @file lv_draw_sw_transform_neon.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_TRANSFORM_NEON_H
+#define LV_DRAW_SW_TRANSFORM_NEON_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_draw_sw_private.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888_VER
+#define LV_DRAW_SW_TRANSFORM_ARGB8888_VER(dest, src, src_next, fract, px_cnt) \
+    lv_draw_sw_transform_argb8888_ver_neon(dest, src, src_next, fract, px_cnt)
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888_HOR
+#define LV_DRAW_SW_TRANSFORM_ARGB8888_HOR(dest, ver, src_row, xcs, px_cnt) \
+    lv_draw_sw_transform_argb8888_hor_neon(dest, ver, src_row, xcs, px_cnt)
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Mix 8 ARGB8888 pixels with their neighbors the same way as the software renderer does it:
+ * fade the pixel if the neighbor is transparent, keep it if it's the same and else mix the two.
+ * @param c         B, G, R, A channels of the pixels
+ * @param px        B, G, R, A channels of the neighbors
+ * @param fract     weight of the neighbors in 0x00..0x7F range
+ * @return          the mixed pixels
+ */
+static inline uint8x8x4_t lv_draw_sw_transform_mix_neighbor_neon(uint8x8x4_t c, uint8x8x4_t px, uint8x8_t fract)
+{
+    uint8x8_t fract_inv = vmvn_u8(fract);
+    uint8x8_t zero = vdup_n_u8(0);
+
+    uint8x8_t px_transp = vceq_u8(px.val[3], zero);
+    uint8x8_t eq = vand_u8(vand_u8(vceq_u8(c.val[0], px.val[0]), vceq_u8(c.val[1], px.val[1])),
+                           vand_u8(vceq_u8(c.val[2], px.val[2]), vceq_u8(c.val[3], px.val[3])));
+
+    /*The sum of the products can be larger than 16 bit so halve it first: ((a + b) / 2) >> 7 == (a + b) >> 8*/
+    uint8x8_t a_fade = vshrn_n_u16(vmull_u8(c.val[3], fract_inv), 8);
+    uint8x8_t a_mix = vshrn_n_u16(vhaddq_u16(vmull_u8(px.val[3], fract), vmull_u8(c.val[3], fract_inv)), 7);
+    a_mix = vbic_u8(a_mix, vceq_u8(c.val[3], zero));
+
+    uint8x8x4_t res;
+    res.val[3] = vbsl_u8(px_transp, a_fade, vbsl_u8(eq, c.val[3], a_mix));
+
+    /*Keep the color if the neighbor is transparent, the same or has too low weight*/
+    uint8x8_t keep = vorr_u8(vorr_u8(px_transp, eq), vcle_u8(fract, vdup_n_u8(LV_OPA_MIN)));
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        uint8x8_t mix = vshrn_n_u16(vhaddq_u16(vmull_u8(px.val[i], fract), vmull_u8(c.val[i], fract_inv)), 7);
+        res.val[i] = vbsl_u8(keep, c.val[i], mix);
+    }
+
+    return res;
+}
+
+static inline lv_result_t lv_draw_sw_transform_argb8888_ver_neon(lv_color32_t * dest, const lv_color32_t * src,
+                                                                 const lv_color32_t * src_next, int32_t fract, int32_t px_cnt)
+{
+    uint8x8_t fract_v = vdup_n_u8((uint8_t)fract);
+    int32_t i;
+    for(i = 0; i + 8 <= px_cnt; i += 8) {
+        uint8x8x4_t c = vld4_u8((const uint8_t *)&src[i]);
+        uint8x8x4_t px = vld4_u8((const uint8_t *)&src_next[i]);
+        vst4_u8((uint8_t *)&dest[i], lv_draw_sw_transform_mix_neighbor_neon(c, px, fract_v));
+    }
+
+    if(i < px_cnt) {
+        lv_color32_t c_tmp[8] = {0};
+        lv_color32_t px_tmp[8] = {0};
+        lv_color32_t res_tmp[8];
+        int32_t rest = px_cnt - i;
+        int32_t j;
+        for(j = 0; j < rest; j++) {
+            c_tmp[j] = src[i + j];
+            px_tmp[j] = src_next[i + j];
+        }
+
+        uint8x8x4_t c = vld4_u8((const uint8_t *)c_tmp);
+        uint8x8x4_t px = vld4_u8((const uint8_t *)px_tmp);
+        vst4_u8((uint8_t *)res_tmp, lv_draw_sw_transform_mix_neighbor_neon(c, px, fract_v));
+        for(j = 0; j < rest; j++) dest[i + j] = res_tmp[j];
+    }
+
+    return LV_RESULT_OK;
+}
+
+static inline lv_result_t lv_draw_sw_transform_argb8888_hor_neon(lv_color32_t * dest, const lv_color32_t * ver,
+                                                                 const lv_color32_t * src_row,
+                                                                 const lv_draw_sw_transform_coord_t * xcs, int32_t px_cnt)
+{
+    /*The neighbors are scattered so collect them first*/
+    lv_color32_t c_tmp[8] = {0};
+    lv_color32_t px_tmp[8] = {0};
+    lv_color32_t res_tmp[8];
+    uint8_t fract_tmp[8] = {0};
+
+    int32_t i;
+    for(i = 0; i < px_cnt; i += 8) {
+        int32_t cnt = px_cnt - i < 8 ? px_cnt - i : 8;
+        int32_t j;
+        for(j = 0; j < cnt; j++) {
+            const lv_draw_sw_transform_coord_t * xc = &xcs[i + j];
+            c_tmp[j] = ver[xc->col];
+            px_tmp[j] = src_row[xc->int_part + xc->next];
+            fract_tmp[j] = (uint8_t)xc->fract;
+        }
+
+        uint8x8x4_t c = vld4_u8((const uint8_t *)c_tmp);
+        uint8x8x4_t px = vld4_u8((const uint8_t *)px_tmp);
+        vst4_u8((uint8_t *)res_tmp, lv_draw_sw_transform_mix_neighbor_neon(c, px, vld1_u8(fract_tmp)));
+        for(j = 0; j < cnt; j++) dest[i + j] = res_tmp[j];
+    }
+
+    return LV_RESULT_OK;
+}
+
+#endif /*defined(__ARM_NEON) || defined(__ARM_NEON__)*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_TRANSFORM_NEON_H*/
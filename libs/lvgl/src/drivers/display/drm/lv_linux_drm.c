@@ -22,6 +22,8 @@
 #include <xf86drmMode.h>
 #include <drm_fourcc.h>
 
+#include "../../../display/lv_display_private.h"
+
 /*********************
  *      DEFINES
  *********************/
@@ -66,6 +68,10 @@ typedef struct {
     drmModePropertyPtr crtc_props[128];
     drmModePropertyPtr conn_props[128];
     drm_buffer_t drm_bufs[2]; /*DUMB buffers*/
+    bool modeset_done;
+    struct drm_mode_rect damage[LV_INV_BUF_SIZE]; /*The areas flushed since the last page flip*/
+    uint32_t damage_cnt;
+    bool damage_full;
 } drm_dev_t;
 
 /**********************
@@ -83,6 +89,8 @@ static int drm_add_plane_property(drm_dev_t * drm_dev, const char * name, uint64
 static int drm_add_crtc_property(drm_dev_t * drm_dev, const char * name, uint64_t value);
 static int drm_add_conn_property(drm_dev_t * drm_dev, const char * name, uint64_t value);
 static int drm_dmabuf_set_plane(drm_dev_t * drm_dev, drm_buffer_t * buf);
+static uint32_t drm_damage_create_blob(drm_dev_t * drm_dev);
+static void drm_damage_add(drm_dev_t * drm_dev, const lv_area_t * area);
 static int find_plane(drm_dev_t * drm_dev, unsigned int fourcc, uint32_t * plane_id, uint32_t crtc_id,
                       uint32_t crtc_idx);
 static int drm_find_connector(drm_dev_t * drm_dev, int64_t connector_id);
@@ -360,13 +368,12 @@ static int drm_add_conn_property(drm_dev_t * drm_dev, const char * name, uint64_
 static int drm_dmabuf_set_plane(drm_dev_t * drm_dev, drm_buffer_t * buf)
 {
     int ret;
-    static int first = 1;
     uint32_t flags = DRM_MODE_PAGE_FLIP_EVENT | DRM_MODE_ATOMIC_NONBLOCK;
 
     drm_dev->req = drmModeAtomicAlloc();
 
     /* On first Atomic commit, do a modeset */
-    if(first) {
+    if(!drm_dev->modeset_done) {
         drm_add_conn_property(drm_dev, "CRTC_ID", drm_dev->crtc_id);
 
         drm_add_crtc_property(drm_dev, "MODE_ID", drm_dev->blob_id);
@@ -374,7 +381,8 @@ static int drm_dmabuf_set_plane(drm_dev_t * drm_dev, drm_buffer_t * buf)
 
         flags |= DRM_MODE_ATOMIC_ALLOW_MODESET;
 
-        first = 0;
+        drm_dev->modeset_done = true;
+        drm_dev->damage_full = true;
     }
 
     drm_add_plane_property(drm_dev, "FB_ID", buf->fb_handle);
@@ -388,16 +396,70 @@ static int drm_dmabuf_set_plane(drm_dev_t * drm_dev, drm_buffer_t * buf)
     drm_add_plane_property(drm_dev, "CRTC_W", drm_dev->width);
     drm_add_plane_property(drm_dev, "CRTC_H", drm_dev->height);
 
+    /* Tell the kernel which parts have changed so that drivers which upload or
+     * compress the frame (e.g. USB or SPI displays) don't need to process the whole buffer*/
+    uint32_t damage_blob_id = drm_damage_create_blob(drm_dev);
+    if(damage_blob_id) {
+        drm_add_plane_property(drm_dev, "FB_DAMAGE_CLIPS", damage_blob_id);
+    }
+
     ret = drmModeAtomicCommit(drm_dev->fd, drm_dev->req, flags, drm_dev);
+
+    /* The committed state keeps its own reference to the blob */
+    if(damage_blob_id) drmModeDestroyPropertyBlob(drm_dev->fd, damage_blob_id);
+    drm_dev->damage_cnt = 0;
+    drm_dev->damage_full = false;
+
     if(ret) {
         LV_LOG_ERROR("drmModeAtomicCommit failed: %s (%d)", strerror(errno), errno);
         drmModeAtomicFree(drm_dev->req);
+        drm_dev->req = NULL;
         return ret;
     }
 
     return 0;
 }
 
+/**
+ * Create a property blob from the collected damage rectangles.
+ * @param drm_dev   pointer to the DRM device
+ * @return          ID of the blob or 0 if the whole plane needs to be updated
+ */
+static uint32_t drm_damage_create_blob(drm_dev_t * drm_dev)
+{
+    if(drm_dev->damage_full || drm_dev->damage_cnt == 0) return 0;
+    if(get_plane_property_id(drm_dev, "FB_DAMAGE_CLIPS") == 0) return 0;
+
+    uint32_t blob_id = 0;
+    int ret = drmModeCreatePropertyBlob(drm_dev->fd, drm_dev->damage,
+                                        drm_dev->damage_cnt * sizeof(struct drm_mode_rect), &blob_id);
+    if(ret) {
+        LV_LOG_WARN("drmModeCreatePropertyBlob for the damage clips failed: %s (%d)", strerror(errno), errno);
+        return 0;
+    }
+
+    return blob_id;
+}
+
+static void drm_damage_add(drm_dev_t * drm_dev, const lv_area_t * area)
+{
+    if(drm_dev->damage_full) return;
+
+    /* Too many areas: updating the whole plane is simpler for the kernel too */
+    if(drm_dev->damage_cnt >= LV_INV_BUF_SIZE) {
+        drm_dev->damage_full = true;
+        return;
+    }
+
+    /* drm_mode_rect is exclusive on the bottom right corner */
+    struct drm_mode_rect * rect = &drm_dev->damage[drm_dev->damage_cnt];
+    rect->x1 = LV_MAX(area->x1, 0);
+    rect->y1 = LV_MAX(area->y1, 0);
+    rect->x2 = LV_MIN(area->x2 + 1, (int32_t)drm_dev->width);
+    rect->y2 = LV_MIN(area->y2 + 1, (int32_t)drm_dev->height);
+    if(rect->x1 < rect->x2 && rect->y1 < rect->y2) drm_dev->damage_cnt++;
+}
+
 static int find_plane(drm_dev_t * drm_dev, unsigned int fourcc, uint32_t * plane_id, uint32_t crtc_id,
                       uint32_t crtc_idx)
 {
@@ -822,12 +884,13 @@ static void drm_flush_wait(lv_display_t * disp)
 
 static void drm_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
 {
-    if(!lv_display_flush_is_last(disp)) return;
-
-    LV_UNUSED(area);
-    LV_UNUSED(px_map);
     drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
 
+    /* LVGL renders directly into the DUMB buffers so only the damage needs to be collected
+     * until the last area, when the buffer is flipped */
+    drm_damage_add(drm_dev, area);
+    if(!lv_display_flush_is_last(disp)) return;
+
     for(int idx = 0; idx < 2; idx++) {
         if(drm_dev->drm_bufs[idx].map == px_map) {
             /*Request buffer swap*/
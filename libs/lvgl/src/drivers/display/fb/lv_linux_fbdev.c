@@ -58,13 +58,18 @@ typedef struct {
 #else
     struct fb_var_screeninfo vinfo;
     struct fb_fix_screeninfo finfo;
+    struct fb_var_screeninfo orig_vinfo;    /*Restored on delete if `vinfo_changed`*/
+    bool vinfo_changed;
 #endif /* LV_LINUX_FBDEV_BSD */
     char * fbp;
+    uint8_t * draw_buf;
+    uint8_t * draw_buf_2;
     uint8_t * rotated_buf;
     size_t rotated_buf_size;
     long int screensize;
     int fbfd;
     bool force_refresh;
+    bool page_flip;         /*LVGL renders into the two halves of the virtual screen*/
 } lv_linux_fb_t;
 
 /**********************
@@ -72,6 +77,12 @@ typedef struct {
  **********************/
 
 static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * color_p);
+static void force_refresh(lv_linux_fb_t * dsc);
+static void display_release_cb(lv_event_t * e);
+#if !LV_LINUX_FBDEV_BSD
+    static bool page_flip_init(lv_linux_fb_t * dsc);
+    static void page_flip(lv_linux_fb_t * dsc, uint8_t * color_p);
+#endif
 static uint32_t tick_get_cb(void);
 
 /**********************
@@ -109,6 +120,7 @@ lv_display_t * lv_linux_fbdev_create(void)
     }
     dsc->fbfd = -1;
     lv_display_set_driver_data(disp, dsc);
+    lv_display_add_event_cb(disp, display_release_cb, LV_EVENT_DELETE, disp);
     lv_display_set_flush_cb(disp, flush_cb);
 
     return disp;
@@ -176,6 +188,11 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
         perror("Error reading variable information");
         return;
     }
+
+    /* With two full screen buffers render directly into the video memory and pan between them*/
+    if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_DIRECT && LV_LINUX_FBDEV_BUFFER_COUNT == 2) {
+        dsc->page_flip = page_flip_init(dsc);
+    }
 #endif /* LV_LINUX_FBDEV_BSD */
 
     LV_LOG_INFO("%dx%d, %dbpp", dsc->vinfo.xres, dsc->vinfo.yres, dsc->vinfo.bits_per_pixel);
@@ -213,24 +230,36 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
     int32_t hor_res = dsc->vinfo.xres;
     int32_t ver_res = dsc->vinfo.yres;
     int32_t width = dsc->vinfo.width;
-    uint32_t draw_buf_size = hor_res * (dsc->vinfo.bits_per_pixel >> 3);
-    if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        draw_buf_size *= LV_LINUX_FBDEV_BUFFER_SIZE;
+    lv_display_set_resolution(disp, hor_res, ver_res);
+
+    uint32_t fb_size = dsc->finfo.line_length * dsc->vinfo.yres;
+    uint8_t * fb_buf_2 = (uint8_t *)dsc->fbp + fb_size;
+    if(dsc->page_flip &&
+       dsc->finfo.line_length == lv_draw_buf_width_to_stride(hor_res, lv_display_get_color_format(disp)) &&
+       fb_buf_2 == lv_draw_buf_align(fb_buf_2, lv_display_get_color_format(disp))) {
+        /* The first frame is rendered into the hidden half*/
+        lv_display_set_buffers(disp, fb_buf_2, dsc->fbp, fb_size, LV_DISPLAY_RENDER_MODE_DIRECT);
+        LV_LOG_INFO("Page flipping in the video memory is used");
     }
     else {
-        draw_buf_size *= ver_res;
-    }
+        dsc->page_flip = false;
 
-    uint8_t * draw_buf = NULL;
-    uint8_t * draw_buf_2 = NULL;
-    draw_buf = malloc(draw_buf_size);
+        uint32_t draw_buf_size = hor_res * (dsc->vinfo.bits_per_pixel >> 3);
+        if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            draw_buf_size *= LV_LINUX_FBDEV_BUFFER_SIZE;
+        }
+        else {
+            draw_buf_size *= ver_res;
+        }
 
-    if(LV_LINUX_FBDEV_BUFFER_COUNT == 2) {
-        draw_buf_2 = malloc(draw_buf_size);
-    }
+        dsc->draw_buf = malloc(draw_buf_size);
 
-    lv_display_set_resolution(disp, hor_res, ver_res);
-    lv_display_set_buffers(disp, draw_buf, draw_buf_2, draw_buf_size, LV_LINUX_FBDEV_RENDER_MODE);
+        if(LV_LINUX_FBDEV_BUFFER_COUNT == 2) {
+            dsc->draw_buf_2 = malloc(draw_buf_size);
+        }
+
+        lv_display_set_buffers(disp, dsc->draw_buf, dsc->draw_buf_2, draw_buf_size, LV_LINUX_FBDEV_RENDER_MODE);
+    }
 
     if(width > 0) {
         lv_display_set_dpi(disp, DIV_ROUND_UP(hor_res * 254, width * 10));
@@ -259,6 +288,16 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
         return;
     }
 
+#if !LV_LINUX_FBDEV_BSD
+    /* The frame is already in the video memory, just show it when it's complete*/
+    if(dsc->page_flip) {
+        LV_UNUSED(area);
+        if(lv_display_flush_is_last(disp)) page_flip(dsc, color_p);
+        lv_display_flush_ready(disp);
+        return;
+    }
+#endif
+
     int32_t w = lv_area_get_width(area);
     int32_t h = lv_area_get_height(area);
     lv_color_format_t cf = lv_display_get_color_format(disp);
@@ -338,16 +377,115 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
         }
     }
 
-    if(dsc->force_refresh) {
-        dsc->vinfo.activate |= FB_ACTIVATE_NOW | FB_ACTIVATE_FORCE;
-        if(ioctl(dsc->fbfd, FBIOPUT_VSCREENINFO, &(dsc->vinfo)) == -1) {
-            perror("Error setting var screen info");
+    if(dsc->force_refresh) force_refresh(dsc);
+
+    lv_display_flush_ready(disp);
+}
+
+/**
+ * Make the driver update the display even if it doesn't refresh on its own
+ * @param dsc   pointer to the framebuffer descriptor
+ */
+static void force_refresh(lv_linux_fb_t * dsc)
+{
+    dsc->vinfo.activate |= FB_ACTIVATE_NOW | FB_ACTIVATE_FORCE;
+    if(ioctl(dsc->fbfd, FBIOPUT_VSCREENINFO, &(dsc->vinfo)) == -1) {
+        perror("Error setting var screen info");
+    }
+}
+
+static void display_release_cb(lv_event_t * e)
+{
+    lv_display_t * disp = (lv_display_t *) lv_event_get_user_data(e);
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+    if(dsc == NULL) return;
+
+    lv_display_set_driver_data(disp, NULL);
+    lv_display_set_flush_cb(disp, NULL);
+
+#if !LV_LINUX_FBDEV_BSD
+    /* Give back the original virtual screen, e.g. to the console*/
+    if(dsc->vinfo_changed && ioctl(dsc->fbfd, FBIOPUT_VSCREENINFO, &dsc->orig_vinfo) == -1) {
+        perror("Error restoring var screen info");
+    }
+#endif
+
+    if(dsc->fbp && (intptr_t)dsc->fbp != -1) munmap(dsc->fbp, dsc->screensize);
+    if(dsc->fbfd >= 0) close(dsc->fbfd);
+
+    free(dsc->draw_buf);
+    free(dsc->draw_buf_2);
+    free(dsc->rotated_buf);
+    lv_free((void *)dsc->devname);
+    lv_free(dsc);
+}
+
+#if !LV_LINUX_FBDEV_BSD
+
+/**
+ * Make the virtual screen twice as high as the visible one to have space for two frames.
+ * @param dsc   pointer to the framebuffer descriptor with the queried screen info
+ * @return      true: the visible area can be panned between the two frames
+ */
+static bool page_flip_init(lv_linux_fb_t * dsc)
+{
+    if(dsc->finfo.ypanstep == 0) return false;
+    if(dsc->finfo.smem_len < dsc->finfo.line_length * dsc->vinfo.yres * 2) return false;
+
+    /* Keep the original settings even if the virtual screen is large enough as it's panned*/
+    dsc->orig_vinfo = dsc->vinfo;
+    dsc->vinfo_changed = true;
+
+    if(dsc->vinfo.yres_virtual < dsc->vinfo.yres * 2) {
+        struct fb_var_screeninfo vinfo = dsc->vinfo;
+        vinfo.yres_virtual = vinfo.yres * 2;
+        vinfo.yoffset = 0;
+        if(ioctl(dsc->fbfd, FBIOPUT_VSCREENINFO, &vinfo) == -1) return false;
+
+        /* The driver might adjust the values */
+        if(ioctl(dsc->fbfd, FBIOGET_VSCREENINFO, &dsc->vinfo) == -1 ||
+           ioctl(dsc->fbfd, FBIOGET_FSCREENINFO, &dsc->finfo) == -1) {
+            perror("Error reading screen information");
+            return false;
         }
+
+        if(dsc->vinfo.yres_virtual < dsc->vinfo.yres * 2) return false;
     }
 
-    lv_display_flush_ready(disp);
+    /* Show the first half. The buffers are selected so that LVGL renders into the second one first*/
+    dsc->vinfo.xoffset = 0;
+    dsc->vinfo.yoffset = 0;
+    if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) return false;
+
+    return true;
 }
 
+/**
+ * Show the half of the virtual screen which contains `color_p`
+ * @param dsc       pointer to the framebuffer descriptor
+ * @param color_p   start of the buffer which was rendered
+ */
+static void page_flip(lv_linux_fb_t * dsc, uint8_t * color_p)
+{
+    dsc->vinfo.yoffset = color_p == (uint8_t *)dsc->fbp ? 0 : dsc->vinfo.yres;
+
+    /* Setting the var screen info pans too*/
+    if(dsc->force_refresh) {
+        force_refresh(dsc);
+    }
+    else if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) {
+        perror("ioctl(FBIOPAN_DISPLAY)");
+        return;
+    }
+
+    /* LVGL continues with the other buffer which is visible until the next vertical blank.
+     * Not all drivers support FBIO_WAITFORVSYNC, in this case it can tear but still works.*/
+    uint32_t crtc = 0;
+    ioctl(dsc->fbfd, FBIO_WAITFORVSYNC, &crtc);
+}
+
+#endif /* !LV_LINUX_FBDEV_BSD */
+
 static uint32_t tick_get_cb(void)
 {
     struct timespec t;
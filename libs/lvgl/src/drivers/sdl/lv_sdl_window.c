@@ -15,6 +15,7 @@
 #include "../../display/lv_display_private.h"
 #include "../../lv_init.h"
 #include "../../draw/lv_draw_buf.h"
+#include "../../misc/lv_area_private.h"
 
 /* for aligned_alloc */
 #ifndef __USE_ISOC11
@@ -37,7 +38,15 @@ typedef struct {
     SDL_Window * window;
     SDL_Renderer * renderer;
 #if LV_USE_DRAW_SDL == 0
-    SDL_Texture * texture;
+    SDL_Texture * textures[2];      /*Updated alternately to not wait for the texture being presented*/
+    bool texture_invalid[2];        /*The texture was (re)created so it needs to be updated fully*/
+    uint8_t texture_act;            /*Index of the texture shown in the window*/
+    lv_area_t flush_areas[LV_INV_BUF_SIZE]; /*Areas flushed in the current frame*/
+    lv_area_t prev_areas[LV_INV_BUF_SIZE];  /*Areas flushed in the previous frame*/
+    uint32_t flush_area_cnt;
+    uint32_t prev_area_cnt;
+    bool flush_full;                /*Too many areas in the current frame, update the whole texture*/
+    bool prev_full;
     uint8_t * fb1;
     uint8_t * fb2;
     uint8_t * fb_act;
@@ -59,6 +68,9 @@ static void window_create(lv_display_t * disp);
 static void window_update(lv_display_t * disp);
 #if LV_USE_DRAW_SDL == 0
     static void texture_resize(lv_display_t * disp);
+    static void texture_update(lv_display_t * disp);
+    static void texture_upload_area(lv_display_t * disp, SDL_Texture * texture, const lv_area_t * area);
+    static void flush_area_add(lv_sdl_window_t * dsc, const lv_area_t * area);
     static void * sdl_draw_buf_realloc_aligned(void * ptr, size_t new_size);
     static void sdl_draw_buf_free(void * ptr);
 #endif
@@ -254,7 +266,7 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_m
         uint32_t px_map_line_bytes = lv_area_get_width(area) * px_size;
 
         uint8_t * fb_tmp = dsc->fb_act;
-        uint32_t fb_stride = disp->hor_res * px_size;
+        uint32_t fb_stride = lv_draw_buf_width_to_stride(disp->hor_res, cf);
         fb_tmp += area->y1 * fb_stride;
         fb_tmp += area->x1 * px_size;
 
@@ -266,12 +278,16 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_m
         }
     }
 
+    /*Only the flushed areas will be uploaded to the texture*/
+    flush_area_add(dsc, area);
+
     /* TYPICALLY YOU DO NOT NEED THIS
      * If it was the last part to refresh update the texture of the window.*/
     if(lv_display_flush_is_last(disp)) {
         if(sdl_render_mode() != LV_DISPLAY_RENDER_MODE_PARTIAL) {
             dsc->fb_act = px_map;
         }
+        texture_update(disp);
         window_update(disp);
     }
 #else
@@ -376,14 +392,13 @@ static void window_update(lv_display_t * disp)
 {
     lv_sdl_window_t * dsc = lv_display_get_driver_data(disp);
 #if LV_USE_DRAW_SDL == 0
-    int32_t hor_res = disp->hor_res;
-    uint32_t stride = lv_draw_buf_width_to_stride(hor_res, lv_display_get_color_format(disp));
-    SDL_UpdateTexture(dsc->texture, NULL, dsc->fb_act, stride);
-
     SDL_RenderClear(dsc->renderer);
 
-    /*Update the renderer with the texture containing the rendered image*/
-    SDL_RenderCopy(dsc->renderer, dsc->texture, NULL, NULL);
+    /*Update the renderer with the texture containing the rendered image.
+     *Nothing was rendered yet if it's invalid.*/
+    if(!dsc->texture_invalid[dsc->texture_act]) {
+        SDL_RenderCopy(dsc->renderer, dsc->textures[dsc->texture_act], NULL, NULL);
+    }
 #endif
     SDL_RenderPresent(dsc->renderer);
 }
@@ -407,7 +422,8 @@ static void texture_resize(lv_display_t * disp)
 #endif
         lv_display_set_buffers(disp, dsc->fb1, dsc->fb2, stride * disp->ver_res, LV_SDL_RENDER_MODE);
     }
-    if(dsc->texture) SDL_DestroyTexture(dsc->texture);
+    if(dsc->textures[0]) SDL_DestroyTexture(dsc->textures[0]);
+    if(dsc->textures[1]) SDL_DestroyTexture(dsc->textures[1]);
 
 #if LV_COLOR_DEPTH == 32
     SDL_PixelFormatEnum px_format =
@@ -421,9 +437,130 @@ static void texture_resize(lv_display_t * disp)
 #endif
     //    px_format = SDL_PIXELFORMAT_BGR24;
 
-    dsc->texture = SDL_CreateTexture(dsc->renderer, px_format,
-                                     SDL_TEXTUREACCESS_STATIC, disp->hor_res, disp->ver_res);
-    SDL_SetTextureBlendMode(dsc->texture, SDL_BLENDMODE_BLEND);
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        dsc->textures[i] = SDL_CreateTexture(dsc->renderer, px_format,
+                                             SDL_TEXTUREACCESS_STREAMING, disp->hor_res, disp->ver_res);
+        SDL_SetTextureBlendMode(dsc->textures[i], SDL_BLENDMODE_BLEND);
+        dsc->texture_invalid[i] = true;
+    }
+
+    dsc->flush_area_cnt = 0;
+    dsc->prev_area_cnt = 0;
+    dsc->flush_full = false;
+    dsc->prev_full = false;
+}
+
+/**
+ * Upload the areas changed since the last update of the other texture and show it
+ * @param disp      pointer to a display
+ */
+static void texture_update(lv_display_t * disp)
+{
+    lv_sdl_window_t * dsc = lv_display_get_driver_data(disp);
+    uint8_t tex_id = dsc->texture_act ^ 1;
+    SDL_Texture * texture = dsc->textures[tex_id];
+
+    /*The texture was updated 2 frames ago so the areas of the previous frame are needed too*/
+    if(dsc->texture_invalid[tex_id] || dsc->flush_full || dsc->prev_full) {
+        lv_area_t full_area;
+        lv_area_set(&full_area, 0, 0, disp->hor_res - 1, disp->ver_res - 1);
+        texture_upload_area(disp, texture, &full_area);
+        dsc->texture_invalid[tex_id] = false;
+    }
+    else {
+        uint32_t i;
+        for(i = 0; i < dsc->prev_area_cnt; i++) {
+            /*Skip the areas which will be uploaded anyway*/
+            uint32_t j;
+            for(j = 0; j < dsc->flush_area_cnt; j++) {
+                if(lv_area_is_in(&dsc->prev_areas[i], &dsc->flush_areas[j], 0)) break;
+            }
+            if(j == dsc->flush_area_cnt) texture_upload_area(disp, texture, &dsc->prev_areas[i]);
+        }
+
+        for(i = 0; i < dsc->flush_area_cnt; i++) {
+            texture_upload_area(disp, texture, &dsc->flush_areas[i]);
+        }
+    }
+
+    lv_memcpy(dsc->prev_areas, dsc->flush_areas, dsc->flush_area_cnt * sizeof(lv_area_t));
+    dsc->prev_area_cnt = dsc->flush_area_cnt;
+    dsc->prev_full = dsc->flush_full;
+    dsc->flush_area_cnt = 0;
+    dsc->flush_full = false;
+
+    dsc->texture_act = tex_id;
+}
+
+/**
+ * Copy an area of the frame buffer to a streaming texture
+ * @param disp      pointer to a display
+ * @param texture   the texture to update
+ * @param area      the area to copy
+ */
+static void texture_upload_area(lv_display_t * disp, SDL_Texture * texture, const lv_area_t * area)
+{
+    lv_sdl_window_t * dsc = lv_display_get_driver_data(disp);
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+    uint32_t px_size = lv_color_format_get_size(cf);
+    uint32_t fb_stride = lv_draw_buf_width_to_stride(disp->hor_res, cf);
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+
+    SDL_Rect rect = {area->x1, area->y1, w, h};
+    void * pixels;
+    int pitch;
+    if(SDL_LockTexture(texture, &rect, &pixels, &pitch) != 0) {
+        LV_LOG_WARN("couldn't lock the texture: %s", SDL_GetError());
+        return;
+    }
+
+    const uint8_t * src = dsc->fb_act + area->y1 * fb_stride + area->x1 * px_size;
+    uint8_t * dest = pixels;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        lv_memcpy(dest, src, w * px_size);
+        src += fb_stride;
+        dest += pitch;
+    }
+
+    SDL_UnlockTexture(texture);
+}
+
+/**
+ * Store a flushed area to upload it later
+ * @param dsc       pointer to the window's descriptor
+ * @param area      the flushed area in frame buffer coordinates
+ */
+static void flush_area_add(lv_sdl_window_t * dsc, const lv_area_t * area)
+{
+    if(dsc->flush_full) return;
+
+    /*Join the stripes of an area flushed in multiple parts*/
+    if(dsc->flush_area_cnt > 0) {
+        lv_area_t * last = &dsc->flush_areas[dsc->flush_area_cnt - 1];
+        if(last->x1 == area->x1 && last->x2 == area->x2 &&
+           (last->y2 + 1 == area->y1 || area->y2 + 1 == last->y1)) {
+            last->y1 = LV_MIN(last->y1, area->y1);
+            last->y2 = LV_MAX(last->y2, area->y2);
+            return;
+        }
+        if(last->y1 == area->y1 && last->y2 == area->y2 &&
+           (last->x2 + 1 == area->x1 || area->x2 + 1 == last->x1)) {
+            last->x1 = LV_MIN(last->x1, area->x1);
+            last->x2 = LV_MAX(last->x2, area->x2);
+            return;
+        }
+    }
+
+    if(dsc->flush_area_cnt >= LV_INV_BUF_SIZE) {
+        dsc->flush_full = true;
+        return;
+    }
+
+    dsc->flush_areas[dsc->flush_area_cnt] = *area;
+    dsc->flush_area_cnt++;
 }
 
 static void * sdl_draw_buf_realloc_aligned(void * ptr, size_t new_size)
@@ -478,7 +615,8 @@ static void release_disp_cb(lv_event_t * e)
 
     lv_sdl_window_t * dsc = lv_display_get_driver_data(disp);
 #if LV_USE_DRAW_SDL == 0
-    SDL_DestroyTexture(dsc->texture);
+    SDL_DestroyTexture(dsc->textures[0]);
+    SDL_DestroyTexture(dsc->textures[1]);
 #endif
     SDL_DestroyRenderer(dsc->renderer);
     SDL_DestroyWindow(dsc->window);
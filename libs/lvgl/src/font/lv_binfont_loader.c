@@ -98,6 +98,11 @@ lv_font_t * lv_binfont_create(const char * path)
         lv_binfont_destroy(font);
         font = NULL;
     }
+#if LV_FONT_FMT_TXT_LOOKUP
+    else {
+        lv_font_fmt_txt_lookup_create(font);
+    }
+#endif
 
     lv_fs_close(&file);
 
@@ -121,6 +126,14 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+#if LV_FONT_FMT_TXT_LOOKUP
+    lv_font_fmt_txt_lookup_delete(font);
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+    if(dsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) lv_font_fmt_txt_glyph_cache_drop(font);
+#endif
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -14,6 +14,8 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_cache.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +24,18 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+    #define glyph_cache LV_GLOBAL_DEFAULT()->font_fmt_txt_glyph_cache
+    #define GLYPH_CACHE_NAME "FONT_GLYPH"
+#endif
+
+#if LV_FONT_FMT_TXT_LOOKUP
+    #define lookups LV_GLOBAL_DEFAULT()->font_fmt_txt_lookups
+    #define LOOKUP_PAGE_BITS    6
+    #define LOOKUP_PAGE_SIZE    (1 << LOOKUP_PAGE_BITS)
+    #define LOOKUP_PAGE_MASK    (LOOKUP_PAGE_SIZE - 1)
+#endif /*LV_FONT_FMT_TXT_LOOKUP*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -39,6 +53,28 @@ static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
 static int kern_pair_16_compare(const void * ref, const void * element);
 
+#if LV_FONT_FMT_TXT_LOOKUP
+    static lv_font_fmt_txt_lookup_t * lookup_find(const lv_font_fmt_txt_dsc_t * fdsc);
+    static uint32_t lookup_cmap_glyph_id(const lv_font_fmt_txt_cmap_t * cmap, uint32_t idx);
+    static void lookup_set(lv_font_fmt_txt_lookup_t * lookup, uint32_t letter, uint32_t gid);
+    static bool lookup_build_cmaps(lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_dsc_t * fdsc);
+    static bool lookup_build_kern(lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_dsc_t * fdsc);
+    static void lookup_free(lv_font_fmt_txt_lookup_t * lookup);
+    static void lookup_slots_fill(void);
+    static inline uint32_t lookup_hash(uint32_t key, uint32_t mask);
+#endif /*LV_FONT_FMT_TXT_LOOKUP*/
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+    static bool glyph_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint8_t * bitmap_out);
+    static bool glyph_cache_create_cb(lv_font_fmt_txt_glyph_cache_data_t * node, uint8_t ** bitmap_out);
+    static void copy_lines(uint8_t * dest, uint32_t dest_stride, const uint8_t * src, uint32_t src_stride,
+                           uint32_t w, int32_t h);
+    static void glyph_cache_free_cb(lv_font_fmt_txt_glyph_cache_data_t * node, void * user_data);
+    static uint32_t glyph_cache_get_max_gid(const lv_font_fmt_txt_dsc_t * fdsc);
+    static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_fmt_txt_glyph_cache_data_t * lhs,
+                                                         const lv_font_fmt_txt_glyph_cache_data_t * rhs);
+#endif
+
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter);
     static inline void decompress_line(uint8_t * out, int32_t w);
@@ -151,6 +187,9 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
+#if LV_FONT_COMPRESSED_CACHE_SIZE > 0
+        if(glyph_cache_get(fdsc, gid, bitmap_out)) return draw_buf;
+#endif
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
         decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
@@ -210,6 +249,159 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+void lv_font_fmt_txt_init(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+    lv_mutex_init(&glyph_cache.lock);
+#endif
+}
+
+void lv_font_fmt_txt_deinit(void)
+{
+#if LV_FONT_FMT_TXT_LOOKUP
+    while(lookups.head) {
+        lv_font_fmt_txt_lookup_t * next = lookups.head->next;
+        lookup_free(lookups.head);
+        lookups.head = next;
+    }
+    lv_free(lookups.slots);
+    lookups.slots = NULL;
+    lookups.slot_mask = 0;
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+    if(glyph_cache.cache) {
+        lv_cache_destroy(glyph_cache.cache, NULL);
+        glyph_cache.cache = NULL;
+    }
+    glyph_cache.hit_cnt = 0;
+    glyph_cache.miss_cnt = 0;
+    lv_mutex_delete(&glyph_cache.lock);
+#endif
+}
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+
+void lv_font_fmt_txt_glyph_cache_get_stats(lv_font_fmt_txt_glyph_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+
+    lv_mutex_lock(&glyph_cache.lock);
+    stats->hit_cnt = glyph_cache.hit_cnt;
+    stats->miss_cnt = glyph_cache.miss_cnt;
+    stats->size = glyph_cache.cache ? (uint32_t)lv_cache_get_size(glyph_cache.cache, NULL) : 0;
+    stats->max_size = LV_FONT_COMPRESSED_CACHE_SIZE;
+    lv_mutex_unlock(&glyph_cache.lock);
+}
+
+void lv_font_fmt_txt_glyph_cache_drop_all(void)
+{
+    lv_mutex_lock(&glyph_cache.lock);
+    if(glyph_cache.cache) lv_cache_drop_all(glyph_cache.cache, NULL);
+    glyph_cache.hit_cnt = 0;
+    glyph_cache.miss_cnt = 0;
+    lv_mutex_unlock(&glyph_cache.lock);
+}
+
+void lv_font_fmt_txt_glyph_cache_drop(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+
+    if(glyph_cache.cache == NULL) return;
+
+    LV_PROFILER_BEGIN;
+
+    /*The cache can't be iterated so drop all possible glyph ids of the font*/
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    lv_font_fmt_txt_glyph_cache_data_t search_key = {
+        .fdsc = fdsc,
+        .bpp = (uint8_t)fdsc->bpp,
+    };
+
+    uint32_t max_gid = glyph_cache_get_max_gid(fdsc);
+    for(search_key.gid = 1; search_key.gid <= max_gid; search_key.gid++) {
+        lv_cache_drop(glyph_cache.cache, &search_key, NULL);
+    }
+
+    LV_PROFILER_END;
+}
+
+#endif /*LV_FONT_COMPRESSED_CACHE_SIZE*/
+
+#if LV_FONT_FMT_TXT_LOOKUP
+
+lv_result_t lv_font_fmt_txt_lookup_create(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(lookup_find(fdsc)) return LV_RESULT_OK;
+
+    LV_PROFILER_BEGIN;
+
+    lv_font_fmt_txt_lookup_t * lookup = lv_malloc_zeroed(sizeof(lv_font_fmt_txt_lookup_t));
+    LV_ASSERT_MALLOC(lookup);
+    if(lookup == NULL) {
+        LV_PROFILER_END;
+        return LV_RESULT_INVALID;
+    }
+
+    lookup->dsc = fdsc;
+    if(!lookup_build_cmaps(lookup, fdsc) || !lookup_build_kern(lookup, fdsc)) {
+        LV_LOG_WARN("couldn't create the lookup tables");
+        lookup_free(lookup);
+        LV_PROFILER_END;
+        return LV_RESULT_INVALID;
+    }
+
+    /*Keep the hash table at most half full*/
+    uint32_t cnt = 1;
+    lv_font_fmt_txt_lookup_t * item;
+    for(item = lookups.head; item; item = item->next) cnt++;
+
+    if(lookups.slots == NULL || cnt * 2 > lookups.slot_mask + 1) {
+        uint32_t slot_cnt = 8;
+        while(slot_cnt < cnt * 2) slot_cnt *= 2;
+        lv_font_fmt_txt_lookup_t ** slots = lv_malloc(slot_cnt * sizeof(lv_font_fmt_txt_lookup_t *));
+        LV_ASSERT_MALLOC(slots);
+        if(slots == NULL) {
+            lookup_free(lookup);
+            LV_PROFILER_END;
+            return LV_RESULT_INVALID;
+        }
+        lv_free(lookups.slots);
+        lookups.slots = slots;
+        lookups.slot_mask = slot_cnt - 1;
+    }
+
+    lookup->next = lookups.head;
+    lookups.head = lookup;
+    lookup_slots_fill();
+
+    LV_PROFILER_END;
+    return LV_RESULT_OK;
+}
+
+void lv_font_fmt_txt_lookup_delete(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+
+    lv_font_fmt_txt_lookup_t ** prev_next = &lookups.head;
+    while(*prev_next) {
+        lv_font_fmt_txt_lookup_t * lookup = *prev_next;
+        if(lookup->dsc == font->dsc) {
+            *prev_next = lookup->next;
+            lookup_free(lookup);
+            /*Open addressing doesn't allow removing a single item so add the remaining ones again*/
+            lookup_slots_fill();
+            return;
+        }
+        prev_next = &lookup->next;
+    }
+}
+
+#endif /*LV_FONT_FMT_TXT_LOOKUP*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -220,6 +412,19 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+#if LV_FONT_FMT_TXT_LOOKUP
+    const lv_font_fmt_txt_lookup_t * lookup = lookup_find(fdsc);
+    if(lookup) {
+        /*If `letter < cp_start` it underflows and will be larger than `page_cnt`*/
+        uint32_t rcp = letter - lookup->cp_start;
+        uint32_t page = rcp >> LOOKUP_PAGE_BITS;
+        if(page >= lookup->page_cnt) return 0;
+        uint32_t page_id = lookup->page_ids[page];
+        if(page_id == 0) return 0;
+        return lookup->pages[(page_id << LOOKUP_PAGE_BITS) + (rcp & LOOKUP_PAGE_MASK)];
+    }
+#endif
+
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -269,6 +474,19 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 
     int8_t value = 0;
 
+#if LV_FONT_FMT_TXT_LOOKUP
+    const lv_font_fmt_txt_lookup_t * lookup = fdsc->kern_classes == 0 ? lookup_find(fdsc) : NULL;
+    if(lookup && lookup->kern_keys) {
+        uint32_t key = (gid_left << 16) | gid_right;
+        uint32_t slot = lookup_hash(key, lookup->kern_mask);
+        while(lookup->kern_keys[slot] != 0) {
+            if(lookup->kern_keys[slot] == key) return lookup->kern_values[slot];
+            slot = (slot + 1) & lookup->kern_mask;
+        }
+        return 0;
+    }
+#endif
+
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
         const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
@@ -339,6 +557,365 @@ static int kern_pair_16_compare(const void * ref, const void * element)
     else return ref16_p->gid_right - element16_p[1];
 }
 
+#if LV_FONT_FMT_TXT_LOOKUP
+
+static lv_font_fmt_txt_lookup_t * lookup_find(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(lookups.slots == NULL) return NULL;
+
+    uint32_t slot = lookup_hash((uint32_t)((lv_uintptr_t)fdsc >> 2), lookups.slot_mask);
+    while(lookups.slots[slot]) {
+        if(lookups.slots[slot]->dsc == fdsc) return lookups.slots[slot];
+        slot = (slot + 1) & lookups.slot_mask;
+    }
+
+    return NULL;
+}
+
+/**
+ * Add all items of the list to the hash table again
+ */
+static void lookup_slots_fill(void)
+{
+    if(lookups.slots == NULL) return;
+
+    lv_memzero(lookups.slots, (lookups.slot_mask + 1) * sizeof(lv_font_fmt_txt_lookup_t *));
+
+    lv_font_fmt_txt_lookup_t * lookup;
+    for(lookup = lookups.head; lookup; lookup = lookup->next) {
+        uint32_t slot = lookup_hash((uint32_t)((lv_uintptr_t)lookup->dsc >> 2), lookups.slot_mask);
+        while(lookups.slots[slot]) slot = (slot + 1) & lookups.slot_mask;
+        lookups.slots[slot] = lookup;
+    }
+}
+
+/**
+ * Get the glyph id of the `idx`th item of a cmap's list (or range in case of format 0)
+ * the same way as `get_glyph_dsc_id` does.
+ */
+static uint32_t lookup_cmap_glyph_id(const lv_font_fmt_txt_cmap_t * cmap, uint32_t idx)
+{
+    switch(cmap->type) {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+            return cmap->glyph_id_start + ((const uint8_t *)cmap->glyph_id_ofs_list)[idx];
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+            return cmap->glyph_id_start + ((const uint16_t *)cmap->glyph_id_ofs_list)[idx];
+        default:
+            return cmap->glyph_id_start + idx;
+    }
+}
+
+/**
+ * Store the glyph id of a code point in an already allocated page.
+ * `pages` can be NULL to only mark the pages which need to be allocated.
+ */
+static void lookup_set(lv_font_fmt_txt_lookup_t * lookup, uint32_t letter, uint32_t gid)
+{
+    uint32_t rcp = letter - lookup->cp_start;
+    uint32_t page = rcp >> LOOKUP_PAGE_BITS;
+
+    if(lookup->pages == NULL) {
+        if(gid) lookup->page_ids[page] = 1;
+        return;
+    }
+
+    uint32_t page_id = lookup->page_ids[page];
+    if(page_id) lookup->pages[(page_id << LOOKUP_PAGE_BITS) + (rcp & LOOKUP_PAGE_MASK)] = (uint16_t)gid;
+}
+
+static bool lookup_build_cmaps(lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(fdsc->cmap_num == 0) return true;
+
+    uint32_t cp_min = UINT32_MAX;
+    uint32_t cp_max = 0;
+    uint32_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->range_length == 0) continue;
+        cp_min = LV_MIN(cp_min, cmap->range_start);
+        cp_max = LV_MAX(cp_max, cmap->range_start + cmap->range_length - 1);
+    }
+
+    if(cp_min > cp_max) return true;
+
+    lookup->cp_start = cp_min & ~((uint32_t)LOOKUP_PAGE_MASK);
+    lookup->page_cnt = ((cp_max - lookup->cp_start) >> LOOKUP_PAGE_BITS) + 1;
+    lookup->page_ids = lv_malloc_zeroed(lookup->page_cnt * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(lookup->page_ids);
+    if(lookup->page_ids == NULL) return false;
+
+    /*In the first round mark the used pages, in the second round store the glyph ids.
+     *Go backward because `get_glyph_dsc_id` uses the first cmap whose range contains the letter,
+     *so the earlier cmaps need to overwrite the later ones*/
+    uint32_t round;
+    for(round = 0; round < 2; round++) {
+        if(round == 1) {
+            uint32_t used_cnt = 0;
+            for(i = 0; i < lookup->page_cnt; i++) {
+                if(lookup->page_ids[i] == 0) continue;
+                if(used_cnt + 1 > UINT16_MAX) return false;
+                used_cnt++;
+                lookup->page_ids[i] = (uint16_t)used_cnt;
+            }
+
+            /*+1 because the 0th page means "no page"*/
+            lookup->pages = lv_malloc_zeroed((used_cnt + 1) * LOOKUP_PAGE_SIZE * sizeof(uint16_t));
+            LV_ASSERT_MALLOC(lookup->pages);
+            if(lookup->pages == NULL) return false;
+        }
+
+        int32_t c;
+        for(c = fdsc->cmap_num - 1; c >= 0; c--) {
+            const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[c];
+            uint32_t j;
+            if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+                /*The letters of the range which are not in the list are not found even if a later cmap has them*/
+                if(round == 1) {
+                    for(j = 0; j < cmap->range_length; j++) lookup_set(lookup, cmap->range_start + j, 0);
+                }
+
+                for(j = 0; j < cmap->list_length; j++) {
+                    if(cmap->unicode_list[j] >= cmap->range_length) continue;
+                    uint32_t gid = lookup_cmap_glyph_id(cmap, j);
+                    if(gid > UINT16_MAX) return false;
+                    lookup_set(lookup, cmap->range_start + cmap->unicode_list[j], gid);
+                }
+            }
+            else {
+                for(j = 0; j < cmap->range_length; j++) {
+                    uint32_t gid = lookup_cmap_glyph_id(cmap, j);
+                    if(gid > UINT16_MAX) return false;
+                    lookup_set(lookup, cmap->range_start + j, gid);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool lookup_build_kern(lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    /*Kern classes are already looked up in constant time*/
+    if(fdsc->kern_dsc == NULL || fdsc->kern_classes != 0) return true;
+
+    const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+    if(kdsc->pair_cnt == 0 || kdsc->glyph_ids_size > 1) return true;
+
+    /*Keep the table at most half full*/
+    uint32_t size = 16;
+    while(size < kdsc->pair_cnt * 2) size <<= 1;
+
+    lookup->kern_keys = lv_malloc_zeroed(size * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(lookup->kern_keys);
+    lookup->kern_values = lv_malloc(size * sizeof(int8_t));
+    LV_ASSERT_MALLOC(lookup->kern_values);
+    if(lookup->kern_keys == NULL || lookup->kern_values == NULL) return false;
+    lookup->kern_mask = size - 1;
+
+    uint32_t i;
+    for(i = 0; i < kdsc->pair_cnt; i++) {
+        uint32_t gid_left;
+        uint32_t gid_right;
+        if(kdsc->glyph_ids_size == 0) {
+            const uint8_t * g_ids = kdsc->glyph_ids;
+            gid_left = g_ids[i * 2];
+            gid_right = g_ids[i * 2 + 1];
+        }
+        else {
+            const uint16_t * g_ids = kdsc->glyph_ids;
+            gid_left = g_ids[i * 2];
+            gid_right = g_ids[i * 2 + 1];
+        }
+
+        uint32_t key = (gid_left << 16) | gid_right;
+        if(key == 0) continue;  /*The 0 glyph id is never looked up*/
+
+        /*Keep the first value if there are duplicates as the binary search would find any of them*/
+        uint32_t slot = lookup_hash(key, lookup->kern_mask);
+        while(lookup->kern_keys[slot] != 0 && lookup->kern_keys[slot] != key) {
+            slot = (slot + 1) & lookup->kern_mask;
+        }
+        if(lookup->kern_keys[slot] == key) continue;
+
+        lookup->kern_keys[slot] = key;
+        lookup->kern_values[slot] = kdsc->values[i];
+    }
+
+    return true;
+}
+
+static void lookup_free(lv_font_fmt_txt_lookup_t * lookup)
+{
+    lv_free(lookup->page_ids);
+    lv_free(lookup->pages);
+    lv_free(lookup->kern_keys);
+    lv_free(lookup->kern_values);
+    lv_free(lookup);
+}
+
+static inline uint32_t lookup_hash(uint32_t key, uint32_t mask)
+{
+    /*Fibonacci hashing to spread the similar glyph ids and addresses*/
+    uint32_t h = key * 2654435761u;
+    return (h ^ (h >> 16)) & mask;
+}
+
+#endif /*LV_FONT_FMT_TXT_LOOKUP*/
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+
+/**
+ * Copy a decompressed glyph from the cache. Decompress and add it to the cache if it's not there yet.
+ * @param fdsc          the font's descriptor
+ * @param gid           the glyph's id
+ * @param bitmap_out    copy the A8 bitmap here
+ * @return              true: `bitmap_out` is filled; false: the glyph can't be cached
+ */
+static bool glyph_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint8_t * bitmap_out)
+{
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    /*The lines are stored without the stride's padding*/
+    size_t size = (size_t)gdsc->box_w * gdsc->box_h;
+    if(size > LV_FONT_COMPRESSED_CACHE_SIZE) return false;
+
+    lv_mutex_lock(&glyph_cache.lock);
+    if(glyph_cache.cache == NULL) {
+        glyph_cache.cache = lv_cache_create(&lv_cache_class_lru_rb_size,
+        sizeof(lv_font_fmt_txt_glyph_cache_data_t), LV_FONT_COMPRESSED_CACHE_SIZE, (lv_cache_ops_t) {
+            .compare_cb = (lv_cache_compare_cb_t) glyph_cache_compare_cb,
+            .create_cb = (lv_cache_create_cb_t) glyph_cache_create_cb,
+            .free_cb = (lv_cache_free_cb_t) glyph_cache_free_cb,
+        });
+        if(glyph_cache.cache) lv_cache_set_name(glyph_cache.cache, GLYPH_CACHE_NAME);
+    }
+    lv_mutex_unlock(&glyph_cache.lock);
+    if(glyph_cache.cache == NULL) return false;
+
+    lv_font_fmt_txt_glyph_cache_data_t search_key = {
+        .slot.size = size,
+        .fdsc = fdsc,
+        .gid = gid,
+        .bpp = (uint8_t)fdsc->bpp,
+    };
+
+    /*On a miss the create callback decompresses directly into `bitmap_out` and sets it to NULL*/
+    uint8_t * bitmap_to_fill = bitmap_out;
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(glyph_cache.cache, &search_key, &bitmap_to_fill);
+    if(entry == NULL) return false;
+
+    if(bitmap_to_fill) {
+        lv_font_fmt_txt_glyph_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+        copy_lines(bitmap_out, lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8),
+                   cached_data->bitmap, gdsc->box_w, gdsc->box_w, gdsc->box_h);
+    }
+
+    lv_mutex_lock(&glyph_cache.lock);
+    if(bitmap_to_fill) glyph_cache.hit_cnt++;
+    else glyph_cache.miss_cnt++;
+    lv_mutex_unlock(&glyph_cache.lock);
+
+    lv_cache_release(glyph_cache.cache, entry, NULL);
+
+    return true;
+}
+
+static bool glyph_cache_create_cb(lv_font_fmt_txt_glyph_cache_data_t * node, uint8_t ** bitmap_out)
+{
+    node->bitmap = lv_malloc(node->slot.size);
+    LV_ASSERT_MALLOC(node->bitmap);
+    if(node->bitmap == NULL) return false;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = node->fdsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[node->gid];
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], *bitmap_out, gdsc->box_w, gdsc->box_h,
+               (uint8_t)fdsc->bpp, prefilter);
+
+    copy_lines(node->bitmap, gdsc->box_w,
+               *bitmap_out, lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8), gdsc->box_w, gdsc->box_h);
+
+    /*Already decompressed to the output*/
+    *bitmap_out = NULL;
+
+    return true;
+}
+
+static void copy_lines(uint8_t * dest, uint32_t dest_stride, const uint8_t * src, uint32_t src_stride,
+                       uint32_t w, int32_t h)
+{
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        lv_memcpy(dest, src, w);
+        dest += dest_stride;
+        src += src_stride;
+    }
+}
+
+static void glyph_cache_free_cb(lv_font_fmt_txt_glyph_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(node->bitmap);
+    node->bitmap = NULL;
+}
+
+/**
+ * Get the largest glyph id of a font from its cmaps
+ */
+static uint32_t glyph_cache_get_max_gid(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    uint32_t max_gid = 0;
+    uint32_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        uint32_t gid_last = 0;
+        uint32_t j;
+        switch(cmap->type) {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                if(cmap->range_length) gid_last = cmap->glyph_id_start + cmap->range_length - 1;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                if(cmap->list_length) gid_last = cmap->glyph_id_start + cmap->list_length - 1;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+                for(j = 0; j < cmap->range_length; j++) {
+                    gid_last = LV_MAX(gid_last, cmap->glyph_id_start + ((const uint8_t *)cmap->glyph_id_ofs_list)[j]);
+                }
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+                for(j = 0; j < cmap->list_length; j++) {
+                    gid_last = LV_MAX(gid_last, cmap->glyph_id_start + ((const uint16_t *)cmap->glyph_id_ofs_list)[j]);
+                }
+                break;
+        }
+        max_gid = LV_MAX(max_gid, gid_last);
+    }
+
+    return max_gid;
+}
+
+static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_fmt_txt_glyph_cache_data_t * lhs,
+                                                     const lv_font_fmt_txt_glyph_cache_data_t * rhs)
+{
+    if(lhs->fdsc != rhs->fdsc) {
+        return lhs->fdsc > rhs->fdsc ? 1 : -1;
+    }
+
+    if(lhs->gid != rhs->gid) {
+        return lhs->gid > rhs->gid ? 1 : -1;
+    }
+
+    if(lhs->bpp != rhs->bpp) {
+        return lhs->bpp > rhs->bpp ? 1 : -1;
+    }
+
+    return 0;
+}
+
+#endif /*LV_FONT_COMPRESSED_CACHE_SIZE*/
+
 #if LV_USE_FONT_COMPRESSED
 
 /**
@@ -185,6 +185,16 @@ typedef struct {
     uint16_t bitmap_format  : 2;
 } lv_font_fmt_txt_dsc_t;
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+/** Statistics of the decompressed glyph cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of glyphs found in the cache*/
+    uint32_t miss_cnt;      /**< Number of glyphs decompressed and added to the cache*/
+    uint32_t size;          /**< Current size of the cached bitmaps in bytes*/
+    uint32_t max_size;      /**< `LV_FONT_COMPRESSED_CACHE_SIZE`*/
+} lv_font_fmt_txt_glyph_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -209,6 +219,49 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+
+/**
+ * Get the statistics of the decompressed glyph cache of the compressed fonts.
+ * @param stats     store the result here
+ */
+void lv_font_fmt_txt_glyph_cache_get_stats(lv_font_fmt_txt_glyph_cache_stats_t * stats);
+
+/**
+ * Remove all glyphs from the decompressed glyph cache and reset its statistics.
+ */
+void lv_font_fmt_txt_glyph_cache_drop_all(void);
+
+/**
+ * Remove the glyphs of a font from the decompressed glyph cache.
+ * Called automatically when a BIN font is destroyed, as a new font could be loaded to the same address.
+ * @param font      pointer to a font using `lv_font_fmt_txt_dsc_t`
+ */
+void lv_font_fmt_txt_glyph_cache_drop(const lv_font_t * font);
+
+#endif /*LV_FONT_COMPRESSED_CACHE_SIZE*/
+
+#if LV_FONT_FMT_TXT_LOOKUP
+
+/**
+ * Build lookup tables for a font to get its glyph ids and kerning values in constant time.
+ * Without them the sparse character maps and kerning pairs are searched with binary search
+ * for every letter, which is slow for fonts with a lot of characters, e.g. CJK fonts.
+ * The tables are used automatically by `lv_font_get_glyph_dsc_fmt_txt` once created.
+ * @param font      pointer to a font using `lv_font_fmt_txt_dsc_t`
+ * @return          LV_RESULT_OK: the tables were created (or already existed);
+ *                  LV_RESULT_INVALID: out of memory or the glyph ids can't be stored
+ */
+lv_result_t lv_font_fmt_txt_lookup_create(const lv_font_t * font);
+
+/**
+ * Free the lookup tables of a font. It needs to be called before the font is freed.
+ * @param font      pointer to a font using `lv_font_fmt_txt_dsc_t`
+ */
+void lv_font_fmt_txt_lookup_delete(const lv_font_t * font);
+
+#endif /*LV_FONT_FMT_TXT_LOOKUP*/
+
 /**********************
  *      MACROS
  **********************/
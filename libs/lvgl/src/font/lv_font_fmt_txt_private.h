@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_font_fmt_txt.h"
+#include "../misc/cache/lv_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -41,10 +42,67 @@ typedef struct {
 } lv_font_fmt_rle_t;
 #endif
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE > 0
+/** An entry of the decompressed glyph cache*/
+typedef struct {
+    lv_cache_slot_size_t slot;
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t gid;
+    uint8_t bpp;
+    uint8_t * bitmap;   /**< A8 bitmap, `box_w` bytes per line without padding*/
+} lv_font_fmt_txt_glyph_cache_data_t;
+
+typedef struct {
+    lv_cache_t * cache;
+    lv_mutex_t lock;        /**< Protects `cache`'s creation and the counters as glyphs are drawn in parallel*/
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+} lv_font_fmt_txt_glyph_cache_t;
+#endif
+
+#if LV_FONT_FMT_TXT_LOOKUP
+typedef struct lv_font_fmt_txt_lookup_t lv_font_fmt_txt_lookup_t;
+
+/** Lookup tables of a font. See `lv_font_fmt_txt_lookup_create`*/
+struct lv_font_fmt_txt_lookup_t {
+    lv_font_fmt_txt_lookup_t * next;    /**< Next item in `lv_font_fmt_txt_lookup_list_t`'s `head`*/
+    const lv_font_fmt_txt_dsc_t * dsc;  /**< The font descriptor these tables belong to*/
+
+    /*Code point to glyph id mapping*/
+    uint32_t cp_start;                  /**< First code point of the first page*/
+    uint32_t page_cnt;                  /**< Number of items in `page_ids`*/
+    uint16_t * page_ids;                /**< Index of the page in `pages` for each block of code points. 0: no glyphs*/
+    uint16_t * pages;                   /**< Glyph ids of the used pages. The 0th page is not used.*/
+
+    /*Kerning pairs hash table. NULL if the font has no kerning pairs*/
+    uint32_t * kern_keys;               /**< `gid_left << 16 | gid_right`. 0: empty slot*/
+    int8_t * kern_values;
+    uint32_t kern_mask;                 /**< Size of the table - 1*/
+};
+
+/** The lookup tables of all fonts. They can't be attached to the fonts as those are usually constant,
+ * so they are stored in a list and found by their font descriptor in a hash table*/
+typedef struct {
+    lv_font_fmt_txt_lookup_t * head;
+    lv_font_fmt_txt_lookup_t ** slots;  /**< Open addressing hash table of the items of `head`. NULL: empty slot*/
+    uint32_t slot_mask;                 /**< Size of `slots` - 1*/
+} lv_font_fmt_txt_lookup_list_t;
+#endif /*LV_FONT_FMT_TXT_LOOKUP*/
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Initialize the glyph cache of the fonts
+ */
+void lv_font_fmt_txt_init(void);
+
+/**
+ * Free the lookup tables and the glyph cache of the fonts
+ */
+void lv_font_fmt_txt_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -46,6 +46,7 @@ typedef struct {
     uint32_t item_cnt;
     grow_dsc_t * grow_dsc;
     uint32_t grow_item_cnt;
+    uint32_t grow_dsc_size;          /*Number of allocated elements in `grow_dsc`*/
     uint32_t grow_dsc_calc : 1;
 } track_t;
 
@@ -250,6 +251,7 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
     t->track_cross_size = 0;
     t->item_cnt = 0;
     t->grow_dsc = NULL;
+    t->grow_dsc_size = 0;
 
     int32_t item_id = item_start_id;
 
@@ -263,9 +265,18 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
                 t->grow_item_cnt++;
                 t->track_fix_main_size += item_gap;
                 if(t->grow_dsc_calc) {
-                    grow_dsc_t * new_dsc = lv_realloc(t->grow_dsc, sizeof(grow_dsc_t) * (t->grow_item_cnt));
-                    LV_ASSERT_MALLOC(new_dsc);
-                    if(new_dsc == NULL) return item_id;
+                    grow_dsc_t * new_dsc = t->grow_dsc;
+                    /*Grow the array geometrically to avoid reallocating it for every item*/
+                    if(t->grow_item_cnt > t->grow_dsc_size) {
+                        uint32_t new_size = t->grow_dsc_size ? t->grow_dsc_size * 2 : 4;
+                        new_dsc = lv_realloc(t->grow_dsc, sizeof(grow_dsc_t) * new_size);
+                        LV_ASSERT_MALLOC(new_dsc);
+                        if(new_dsc == NULL) {
+                            t->grow_item_cnt--;
+                            return item_id;
+                        }
+                        t->grow_dsc_size = new_size;
+                    }
 
                     new_dsc[t->grow_item_cnt - 1].item = item;
                     new_dsc[t->grow_item_cnt - 1].min_size = f->row ? lv_obj_get_style_min_width(item, LV_PART_MAIN)
@@ -370,6 +381,9 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
     place_content(f->main_place, max_main_size, t->track_main_size, t->item_cnt, &main_pos, &place_gap);
     if(f->row && rtl) main_pos += lv_obj_get_content_width(cont);
 
+    /*The grow items are in the same order in `grow_dsc` as in the track*/
+    uint32_t grow_id = 0;
+
     lv_obj_t * item = lv_obj_get_child(cont, item_first_id);
     /*Reposition the children*/
     while(item && item_first_id != item_last_id) {
@@ -380,11 +394,9 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
         int32_t grow_size = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
         if(grow_size) {
             int32_t s = 0;
-            for(i = 0; i < t->grow_item_cnt; i++) {
-                if(t->grow_dsc[i].item == item) {
-                    s = t->grow_dsc[i].final_size;
-                    break;
-                }
+            if(grow_id < t->grow_item_cnt && t->grow_dsc[grow_id].item == item) {
+                s = t->grow_dsc[grow_id].final_size;
+                grow_id++;
             }
 
             if(f->row) {
@@ -304,27 +304,28 @@ static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c)
 
     /*Set sizes for CONTENT cells*/
     uint32_t i;
+    bool has_content = false;
     for(i = 0; i < c->col_num; i++) {
-        int32_t size = LV_COORD_MIN;
         if(IS_CONTENT(col_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t col_span = get_col_span(item);
-                if(col_span != 1) continue;
-
-                uint32_t col_pos = get_col_pos(item);
-                if(col_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_width(item));
-            }
-            if(size >= 0) c->w[i] = size;
-            else c->w[i] = 0;
+            c->w[i] = 0;
+            has_content = true;
         }
     }
 
+    /*Check the children only once and update the size of their cell*/
+    uint32_t child_cnt = has_content ? lv_obj_get_child_count(cont) : 0;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+        uint32_t col_span = get_col_span(item);
+        if(col_span != 1) continue;
+
+        uint32_t col_pos = get_col_pos(item);
+        if(col_pos >= c->col_num || !IS_CONTENT(col_templ[col_pos])) continue;
+
+        c->w[col_pos] = LV_MAX(c->w[col_pos], lv_obj_get_width(item));
+    }
+
     uint32_t col_fr_cnt = 0;
     int32_t grid_w = 0;
 
@@ -393,27 +394,28 @@ static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
     c->h = lv_malloc(sizeof(int32_t) * c->row_num);
     /*Set sizes for CONTENT cells*/
     uint32_t i;
+    bool has_content = false;
     for(i = 0; i < c->row_num; i++) {
-        int32_t size = LV_COORD_MIN;
         if(IS_CONTENT(row_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t row_span = get_row_span(item);
-                if(row_span != 1) continue;
-
-                uint32_t row_pos = get_row_pos(item);
-                if(row_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_height(item));
-            }
-            if(size >= 0) c->h[i] = size;
-            else c->h[i] = 0;
+            c->h[i] = 0;
+            has_content = true;
         }
     }
 
+    /*Check the children only once and update the size of their cell*/
+    uint32_t child_cnt = has_content ? lv_obj_get_child_count(cont) : 0;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+        uint32_t row_span = get_row_span(item);
+        if(row_span != 1) continue;
+
+        uint32_t row_pos = get_row_pos(item);
+        if(row_pos >= c->row_num || !IS_CONTENT(row_templ[row_pos])) continue;
+
+        c->h[row_pos] = LV_MAX(c->h[row_pos], lv_obj_get_height(item));
+    }
+
     uint32_t row_fr_cnt = 0;
     int32_t grid_h = 0;
 
@@ -41,12 +41,19 @@
 
 typedef struct lv_image_compressed_t {
     uint32_t method: 4; /*Compression method, see `lv_image_compress_t`*/
-    uint32_t reserved : 28;  /*Reserved to be used later*/
+    uint32_t band_h: 16; /*If not 0, every `band_h` rows are compressed independently*/
+    uint32_t reserved : 12;  /*Reserved to be used later*/
     uint32_t compressed_size;  /*Compressed data size in byte*/
     uint32_t decompressed_size;  /*Decompressed data size in byte*/
     const uint8_t * data; /*Compressed data*/
 } lv_image_compressed_t;
 
+/*
+ * Banded images are followed by `band_cnt + 1` uint32_t offsets of the bands
+ * relative to the end of this offset table, and the independently compressed bands.
+ * `compressed_size` includes the offset table too.
+ */
+
 typedef struct {
     lv_fs_file_t * f;
     lv_color32_t * palette;
@@ -56,6 +63,9 @@ typedef struct {
     lv_draw_buf_t * decompressed;       /*Decompressed data could be used directly, thus must also be draw buf*/
     lv_draw_buf_t c_array;              /*An C-array image that need to be converted to a draw buf*/
     lv_draw_buf_t * decoded_partial;    /*A draw buf for decoded image via get_area_cb*/
+    uint32_t * band_offsets;            /*Offset table of banded compressed images*/
+    uint8_t * band_compressed;          /*Buffer to read a compressed band from file*/
+    int32_t band_loaded;                /*Index of the band decompressed to `decoded_partial`, -1 if none*/
 } decoder_data_t;
 
 /**********************
@@ -72,10 +82,16 @@ static lv_result_t decode_alpha_only(lv_image_decoder_t * decoder, lv_image_deco
 static lv_result_t decode_indexed_line(lv_color_format_t color_format, const lv_color32_t * palette, int32_t x,
                                        int32_t w_px, const uint8_t * in, lv_color32_t * out);
 static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static lv_result_t open_compressed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static lv_result_t open_banded(lv_image_decoder_dsc_t * dsc);
+static lv_result_t get_area_banded(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                   lv_area_t * decoded_area);
 
 static lv_fs_res_t fs_read_file_at(lv_fs_file_t * f, uint32_t pos, void * buff, uint32_t btr, uint32_t * br);
 
 static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed);
+static uint32_t decompress_data(lv_image_compress_t method, lv_color_format_t cf, const uint8_t * input,
+                                uint32_t input_len, uint8_t * output, uint32_t out_len);
 
 /**********************
  *  STATIC VARIABLES
@@ -216,7 +232,7 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         lv_color_format_t cf = dsc->header.cf;
 
         if(dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) {
-            res = decode_compressed(decoder, dsc);
+            res = open_compressed(decoder, dsc);
         }
         else if(LV_COLOR_FORMAT_IS_INDEXED(cf)) {
             if(dsc->args.use_indexed) {
@@ -256,7 +272,7 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 
         lv_color_format_t cf = image->header.cf;
         if(dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) {
-            res = decode_compressed(decoder, dsc);
+            res = open_compressed(decoder, dsc);
         }
         else if(LV_COLOR_FORMAT_IS_INDEXED(cf)) {
             /*Need decoder data to store converted image*/
@@ -380,6 +396,10 @@ lv_result_t lv_bin_decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
 {
     LV_UNUSED(decoder); /*Unused*/
 
+    /*Banded compressed images are decompressed band by band*/
+    const decoder_data_t * banded_data = dsc->user_data;
+    if(banded_data && banded_data->band_offsets) return get_area_banded(dsc, full_area, decoded_area);
+
     lv_color_format_t cf = dsc->header.cf;
     /*Check if cf is supported*/
 
@@ -547,6 +567,8 @@ static void free_decoder_data(lv_image_decoder_dsc_t * dsc)
     if(decoder_data->decoded) lv_draw_buf_destroy(decoder_data->decoded);
     if(decoder_data->decompressed) lv_draw_buf_destroy(decoder_data->decompressed);
     lv_free(decoder_data->palette);
+    lv_free(decoder_data->band_offsets);
+    lv_free(decoder_data->band_compressed);
     lv_free(decoder_data);
     dsc->user_data = NULL;
 }
@@ -1083,11 +1105,8 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
         return LV_RESULT_INVALID;
     }
 
-    uint8_t * img_data;
     uint32_t out_len = compressed->decompressed_size;
     uint32_t input_len = compressed->compressed_size;
-    LV_UNUSED(input_len);
-    LV_UNUSED(out_len);
 
     lv_draw_buf_t * decompressed = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w, dsc->header.h,
                                                          dsc->header.cf,
@@ -1103,55 +1122,234 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
         return LV_RESULT_INVALID;
     }
 
-    img_data = decompressed->data;
+    uint32_t len = decompress_data(compressed->method, dsc->header.cf, compressed->data, input_len,
+                                   decompressed->data, out_len);
+    if(len != out_len) {
+        LV_LOG_WARN("Decompress failed: %" LV_PRIu32 ", got: %" LV_PRIu32, out_len, len);
+        lv_draw_buf_destroy(decompressed);
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data->decompressed = decompressed; /*Free on decoder close*/
+    return LV_RESULT_OK;
+}
 
-    if(compressed->method == LV_IMAGE_COMPRESS_RLE) {
+/**
+ * Decompress RLE or LZ4 data
+ * @return the number of decompressed bytes or 0 on error
+ */
+static uint32_t decompress_data(lv_image_compress_t method, lv_color_format_t cf, const uint8_t * input,
+                                uint32_t input_len, uint8_t * output, uint32_t out_len)
+{
+    if(method == LV_IMAGE_COMPRESS_RLE) {
 #if LV_USE_RLE
         /*Compress always happen on byte*/
         uint32_t pixel_byte;
-        if(dsc->header.cf == LV_COLOR_FORMAT_RGB565A8)
+        if(cf == LV_COLOR_FORMAT_RGB565A8)
             pixel_byte = 2;
         else
-            pixel_byte = (lv_color_format_get_bpp(dsc->header.cf) + 7) >> 3;
-        const uint8_t * input = compressed->data;
-        uint8_t * output = img_data;
-        uint32_t len;
-        len = lv_rle_decompress(input, input_len, output, out_len, pixel_byte);
-        if(len != compressed->decompressed_size) {
-            LV_LOG_WARN("Decompress failed: %" LV_PRIu32 ", got: %" LV_PRIu32, out_len, len);
-            lv_draw_buf_destroy(decompressed);
-            return LV_RESULT_INVALID;
-        }
+            pixel_byte = (lv_color_format_get_bpp(cf) + 7) >> 3;
+        return lv_rle_decompress(input, input_len, output, out_len, pixel_byte);
 #else
+        LV_UNUSED(cf);
         LV_LOG_WARN("RLE decompress is not enabled");
-        lv_draw_buf_destroy(decompressed);
-        return LV_RESULT_INVALID;
+        return 0;
 #endif
     }
-    else if(compressed->method == LV_IMAGE_COMPRESS_LZ4) {
+    else if(method == LV_IMAGE_COMPRESS_LZ4) {
 #if LV_USE_LZ4
-        const char * input = (const char *)compressed->data;
-        char * output = (char *)img_data;
-        int len;
-        len = LZ4_decompress_safe(input, output, input_len, out_len);
-        if(len < 0 || (uint32_t)len != compressed->decompressed_size) {
-            LV_LOG_WARN("Decompress failed: %" LV_PRId32 ", got: %" LV_PRId32, out_len, len);
-            lv_draw_buf_destroy(decompressed);
-            return LV_RESULT_INVALID;
-        }
+        LV_UNUSED(cf);
+        int len = LZ4_decompress_safe((const char *)input, (char *)output, input_len, out_len);
+        return len < 0 ? 0 : (uint32_t)len;
 #else
+        LV_UNUSED(cf);
         LV_LOG_WARN("LZ4 decompress is not enabled");
-        lv_draw_buf_destroy(decompressed);
-        return LV_RESULT_INVALID;
+        return 0;
 #endif
     }
+
+    LV_UNUSED(cf);
+    LV_UNUSED(input);
+    LV_UNUSED(input_len);
+    LV_UNUSED(output);
+    LV_UNUSED(out_len);
+    LV_LOG_WARN("Unknown compression method: %d", method);
+    return 0;
+}
+
+static lv_result_t open_compressed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    /*Peek the compression header to see if the bands can be decompressed independently*/
+    lv_image_compressed_t compressed;
+    lv_memzero(&compressed, sizeof(compressed));
+    uint32_t len = 12;
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        decoder_data_t * decoder_data = dsc->user_data;
+        uint32_t rn;
+        lv_fs_res_t fs_res = fs_read_file_at(decoder_data->f, sizeof(lv_image_header_t), &compressed, len, &rn);
+        if(fs_res != LV_FS_RES_OK || rn != len) {
+            LV_LOG_WARN("Read compressed header failed: %d", fs_res);
+            return LV_RESULT_INVALID;
+        }
+    }
+    else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t * image = dsc->src;
+        if(image->data_size < len) {
+            LV_LOG_WARN("Compressed image is too small");
+            return LV_RESULT_INVALID;
+        }
+        lv_memcpy(&compressed, image->data, len);
+    }
+
+    if(compressed.band_h == 0) return decode_compressed(decoder, dsc);
+
+    decoder_data_t * decoder_data = get_decoder_data(dsc);
+    if(decoder_data == NULL) return LV_RESULT_INVALID;
+    decoder_data->compressed = compressed;
+    return open_banded(dsc);
+}
+
+/**
+ * Load the offset table of a banded image. The bands are decompressed one by one in `get_area_cb`
+ * so only a band needs to be in RAM instead of the whole image.
+ */
+static lv_result_t open_banded(lv_image_decoder_dsc_t * dsc)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    const lv_image_compressed_t * compressed = &decoder_data->compressed;
+    lv_color_format_t cf = dsc->header.cf;
+
+    /*The rows need to be stored continuously and used without conversion*/
+    if(LV_COLOR_FORMAT_IS_INDEXED(cf) || cf == LV_COLOR_FORMAT_RGB565A8 || lv_color_format_get_bpp(cf) < 8) {
+        LV_LOG_WARN("Banded compression is not supported for color format %d", cf);
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t band_h = compressed->band_h;
+    uint32_t band_cnt = (dsc->header.h + band_h - 1) / band_h;
+    uint32_t table_size = (band_cnt + 1) * sizeof(uint32_t);
+    if(compressed->compressed_size < table_size ||
+       compressed->decompressed_size != (uint32_t)dsc->header.h * dsc->header.stride) {
+        LV_LOG_WARN("Invalid banded compressed image");
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t * offsets = lv_malloc(table_size);
+    LV_ASSERT_MALLOC(offsets);
+    if(offsets == NULL) return LV_RESULT_INVALID;
+    decoder_data->band_offsets = offsets;   /*Now free_decoder_data will take care of it*/
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        uint32_t rn;
+        lv_fs_res_t fs_res = fs_read_file_at(decoder_data->f, sizeof(lv_image_header_t) + 12, offsets, table_size, &rn);
+        if(fs_res != LV_FS_RES_OK || rn != table_size) {
+            LV_LOG_WARN("Read band offsets failed: %d", fs_res);
+            return LV_RESULT_INVALID;
+        }
+    }
     else {
-        LV_UNUSED(img_data);
-        LV_LOG_WARN("Unknown compression method: %d", compressed->method);
-        lv_draw_buf_destroy(decompressed);
+        const lv_image_dsc_t * image = dsc->src;
+        if(image->data_size != 12 + compressed->compressed_size) {
+            LV_LOG_WARN("Compressed size mismatch: %" LV_PRIu32" != %" LV_PRIu32,
+                        compressed->compressed_size, image->data_size - 12);
+            return LV_RESULT_INVALID;
+        }
+        lv_memcpy(offsets, image->data + 12, table_size);
+    }
+
+    /*Find the largest band to allocate a buffer for reading the bands of files*/
+    uint32_t max_band_size = 0;
+    uint32_t i;
+    for(i = 0; i < band_cnt; i++) {
+        if(offsets[i + 1] < offsets[i]) {
+            LV_LOG_WARN("Invalid band offsets");
+            return LV_RESULT_INVALID;
+        }
+        max_band_size = LV_MAX(max_band_size, offsets[i + 1] - offsets[i]);
+    }
+
+    if(offsets[band_cnt] != compressed->compressed_size - table_size) {
+        LV_LOG_WARN("Compressed size mismatch: %" LV_PRIu32" != %" LV_PRIu32,
+                    offsets[band_cnt], compressed->compressed_size - table_size);
         return LV_RESULT_INVALID;
     }
 
-    decoder_data->decompressed = decompressed; /*Free on decoder close*/
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        decoder_data->band_compressed = lv_malloc(max_band_size);
+        LV_ASSERT_MALLOC(decoder_data->band_compressed);
+        if(decoder_data->band_compressed == NULL) return LV_RESULT_INVALID;
+    }
+
+    decoder_data->band_loaded = -1;
+    return LV_RESULT_OK;
+}
+
+static lv_result_t get_area_banded(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                   lv_area_t * decoded_area)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    const lv_image_compressed_t * compressed = &decoder_data->compressed;
+    lv_color_format_t cf = dsc->header.cf;
+    int32_t band_h = compressed->band_h;
+    int32_t img_h = dsc->header.h;
+    uint32_t stride = dsc->header.stride;
+
+    /*Continue below the previously returned band*/
+    int32_t y = decoded_area->y1 == LV_COORD_MIN ? full_area->y1 : decoded_area->y2 + 1;
+    if(y < 0) y = 0;
+    if(y > full_area->y2 || y >= img_h) return LV_RESULT_INVALID;
+
+    int32_t band = y / band_h;
+    int32_t band_y1 = band * band_h;
+    int32_t band_rows = LV_MIN(band_h, img_h - band_y1);
+
+    if(decoder_data->decoded_partial == NULL) {
+        decoder_data->decoded_partial = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w,
+                                                              LV_MIN(band_h, img_h), cf, stride);
+        if(decoder_data->decoded_partial == NULL) {
+            LV_LOG_WARN("No memory for a band");
+            return LV_RESULT_INVALID;
+        }
+    }
+
+    if(decoder_data->band_loaded != band) {
+        lv_draw_buf_t * decoded = lv_draw_buf_reshape(decoder_data->decoded_partial, cf, dsc->header.w, band_rows, stride);
+        if(decoded == NULL) return LV_RESULT_INVALID;
+
+        uint32_t band_cnt = (img_h + band_h - 1) / band_h;
+        uint32_t offset = 12 + (band_cnt + 1) * sizeof(uint32_t) + decoder_data->band_offsets[band];
+        uint32_t input_len = decoder_data->band_offsets[band + 1] - decoder_data->band_offsets[band];
+        const uint8_t * input;
+        if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+            uint32_t rn;
+            lv_fs_res_t res = fs_read_file_at(decoder_data->f, sizeof(lv_image_header_t) + offset,
+                                              decoder_data->band_compressed, input_len, &rn);
+            if(res != LV_FS_RES_OK || rn != input_len) {
+                LV_LOG_WARN("Read band %" LV_PRId32 " failed: %d", band, res);
+                return LV_RESULT_INVALID;
+            }
+            input = decoder_data->band_compressed;
+        }
+        else {
+            const lv_image_dsc_t * image = dsc->src;
+            input = image->data + offset;
+        }
+
+        uint32_t out_len = band_rows * stride;
+        uint32_t len = decompress_data(compressed->method, cf, input, input_len, decoded->data, out_len);
+        if(len != out_len) {
+            LV_LOG_WARN("Decompress band %" LV_PRId32 " failed: %" LV_PRIu32 ", got: %" LV_PRIu32, band, out_len, len);
+            decoder_data->band_loaded = -1;
+            return LV_RESULT_INVALID;
+        }
+        decoder_data->band_loaded = band;
+    }
+
+    decoded_area->x1 = 0;
+    decoded_area->x2 = dsc->header.w - 1;
+    decoded_area->y1 = band_y1;
+    decoded_area->y2 = band_y1 + band_rows - 1;
+    dsc->decoded = decoder_data->decoded_partial;
     return LV_RESULT_OK;
 }
@@ -212,6 +212,27 @@
             #endif
         #endif
     #endif
+
+    /*Cache the small allocations of each thread to take them without locking the heap.
+     *The blocks are taken from and returned to the heap in batches.
+     *Requires a compiler supporting thread local variables if `LV_USE_OS` is enabled.*/
+    #ifndef LV_USE_MEM_THREAD_CACHE
+        #ifdef CONFIG_LV_USE_MEM_THREAD_CACHE
+            #define LV_USE_MEM_THREAD_CACHE CONFIG_LV_USE_MEM_THREAD_CACHE
+        #else
+            #define LV_USE_MEM_THREAD_CACHE 0
+        #endif
+    #endif
+    #if LV_USE_MEM_THREAD_CACHE
+        /*Max. size of the blocks cached by a thread*/
+        #ifndef LV_MEM_THREAD_CACHE_SIZE
+            #ifdef CONFIG_LV_MEM_THREAD_CACHE_SIZE
+                #define LV_MEM_THREAD_CACHE_SIZE CONFIG_LV_MEM_THREAD_CACHE_SIZE
+            #else
+                #define LV_MEM_THREAD_CACHE_SIZE (4 * 1024U)          /*[bytes]*/
+            #endif
+        #endif
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -337,6 +358,18 @@
     #endif
 #endif
 
+/* Size of a memory area per display from which the draw tasks and their descriptors
+ * are allocated during a refresh. The whole area is freed at once after the refresh,
+ * so there is almost no `lv_malloc`/`lv_free` for drawing. If it's full the heap is used.
+ * 0: disable and always use the heap*/
+#ifndef LV_DRAW_FRAME_ARENA_SIZE
+    #ifdef CONFIG_LV_DRAW_FRAME_ARENA_SIZE
+        #define LV_DRAW_FRAME_ARENA_SIZE CONFIG_LV_DRAW_FRAME_ARENA_SIZE
+    #else
+        #define LV_DRAW_FRAME_ARENA_SIZE    0   /*[bytes]*/
+    #endif
+#endif
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -518,7 +551,7 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /*Allow buffering some shadow calculation.
         *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
+        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost which is shared by the most recently used corners*/
         #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
                 #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
@@ -527,15 +560,15 @@
             #endif
         #endif
 
-        /* Set number of maximally cached circle data.
+        /* Size of the cache of the circle data in bytes.
         * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+        * radius * 6 + 6 bytes are used per circle (the most recently used radiuses are kept between the frames)
         * 0: to disable caching */
         #ifndef LV_DRAW_SW_CIRCLE_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
                 #define LV_DRAW_SW_CIRCLE_CACHE_SIZE CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
             #else
-                #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+                #define LV_DRAW_SW_CIRCLE_CACHE_SIZE (4 * 1024)
             #endif
         #endif
     #endif
@@ -1096,6 +1129,43 @@
     #endif
 #endif
 
+/*Default size of the compressed image cache in bytes. Requires `LV_USE_LZ4`.
+ *Frequently used images evicted from the image cache are kept here compressed with LZ4
+ *and decompressed when they are opened again instead of decoding them again.
+ *0: to disable it*/
+#ifndef LV_CACHE_COMPRESSED_DEF_SIZE
+    #ifdef CONFIG_LV_CACHE_COMPRESSED_DEF_SIZE
+        #define LV_CACHE_COMPRESSED_DEF_SIZE CONFIG_LV_CACHE_COMPRESSED_DEF_SIZE
+    #else
+        #define LV_CACHE_COMPRESSED_DEF_SIZE 0
+    #endif
+#endif
+
+/*1: Enable asynchronous image decoding. Requires `LV_USE_OS` and the image cache.
+ *Once enabled with `lv_image_decoder_async_enable(true)` images missing from the image cache
+ *are decoded by worker threads while a placeholder is drawn in their place.*/
+#ifndef LV_USE_IMAGE_DECODER_ASYNC
+    #ifdef CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+        #define LV_USE_IMAGE_DECODER_ASYNC CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+    #else
+        #define LV_USE_IMAGE_DECODER_ASYNC 0
+    #endif
+#endif
+#if LV_USE_IMAGE_DECODER_ASYNC
+    /*Number of decoding worker threads. Their stack size is `LV_DRAW_THREAD_STACK_SIZE`*/
+    #ifndef LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+        #ifdef LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+                #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT CONFIG_LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+            #else
+                #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT 0
+            #endif
+        #else
+            #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT 1
+        #endif
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1125,6 +1195,18 @@
     #endif
 #endif
 
+/* Number of resolved style property values cached in each lv_obj_t (0: disable).
+ * Speeds up getting style properties during drawing. Requires about 16 bytes per entry and object.
+ * Must be a power of 2. Styles changed after adding them to objects need to be reported by
+ * `lv_obj_report_style_change()`.*/
+#ifndef LV_OBJ_STYLE_RES_CACHE_CNT
+    #ifdef CONFIG_LV_OBJ_STYLE_RES_CACHE_CNT
+        #define LV_OBJ_STYLE_RES_CACHE_CNT CONFIG_LV_OBJ_STYLE_RES_CACHE_CNT
+    #else
+        #define LV_OBJ_STYLE_RES_CACHE_CNT  0
+    #endif
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1636,6 +1718,26 @@
     #endif
 #endif
 
+/*Size of the cache of decompressed glyph bitmaps of compressed fonts in bytes. 0: no caching.
+ *Cached glyphs are only copied instead of being decompressed again on every draw.*/
+#ifndef LV_FONT_COMPRESSED_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_COMPRESSED_CACHE_SIZE
+        #define LV_FONT_COMPRESSED_CACHE_SIZE CONFIG_LV_FONT_COMPRESSED_CACHE_SIZE
+    #else
+        #define LV_FONT_COMPRESSED_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Enable `lv_font_fmt_txt_lookup_create()` to find the glyphs and kerning values of large fonts
+ *(e.g. CJK fonts) in constant time instead of binary searches. BIN fonts get the tables when loaded.*/
+#ifndef LV_FONT_FMT_TXT_LOOKUP
+    #ifdef CONFIG_LV_FONT_FMT_TXT_LOOKUP
+        #define LV_FONT_FMT_TXT_LOOKUP CONFIG_LV_FONT_FMT_TXT_LOOKUP
+    #else
+        #define LV_FONT_FMT_TXT_LOOKUP 0
+    #endif
+#endif
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef LV_KCONFIG_PRESENT
@@ -2011,6 +2113,17 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LAYOUT_CACHE
+        #ifdef LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LABEL_LAYOUT_CACHE
+                #define LV_LABEL_LAYOUT_CACHE CONFIG_LV_LABEL_LAYOUT_CACHE
+            #else
+                #define LV_LABEL_LAYOUT_CACHE 0
+            #endif
+        #else
+            #define LV_LABEL_LAYOUT_CACHE 1   /*Store the line breaks and letter widths to not measure the text on every redraw*/
+        #endif
+    #endif
     #ifndef LV_LABEL_WAIT_CHAR_COUNT
         #ifdef CONFIG_LV_LABEL_WAIT_CHAR_COUNT
             #define LV_LABEL_WAIT_CHAR_COUNT CONFIG_LV_LABEL_WAIT_CHAR_COUNT
@@ -2239,6 +2352,18 @@
     #endif
 #endif
 
+#ifndef LV_USE_VLIST
+    #ifdef LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_VLIST
+            #define LV_USE_VLIST CONFIG_LV_USE_VLIST
+        #else
+            #define LV_USE_VLIST 0
+        #endif
+    #else
+        #define LV_USE_VLIST      1   /*Requires: lv_label, lv_flex*/
+    #endif
+#endif
+
 #ifndef LV_USE_WIN
     #ifdef LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_WIN
@@ -2879,6 +3004,16 @@
 
 #endif /*LV_USE_SYSMON*/
 
+/*1: Enable the frame telemetry. Measures the phases of the display refreshes (layout, rendering, flushing, etc.)
+ *   and reports them via a callback or a shared memory area without drawing anything.*/
+#ifndef LV_USE_TELEMETRY
+    #ifdef CONFIG_LV_USE_TELEMETRY
+        #define LV_USE_TELEMETRY CONFIG_LV_USE_TELEMETRY
+    #else
+        #define LV_USE_TELEMETRY 0
+    #endif
+#endif
+
 /*1: Enable the runtime performance profiler*/
 #ifndef LV_USE_PROFILER
     #ifdef CONFIG_LV_USE_PROFILER
@@ -3728,6 +3863,10 @@ LV_EXPORT_CONST_INT(LV_DRAW_BUF_ALIGN);
         #warning "LV_DRAW_THREAD_STACKSIZE was renamed to LV_DRAW_THREAD_STACK_SIZE. Please update lv_conf.h or run menuconfig again."
         #define LV_DRAW_THREAD_STACK_SIZE LV_DRAW_THREAD_STACKSIZE
     #endif
+#else
+    /*Asynchronous image decoding needs worker threads*/
+    #undef LV_USE_IMAGE_DECODER_ASYNC
+    #define LV_USE_IMAGE_DECODER_ASYNC 0
 #endif
 
 /*If running without lv_conf.h add typedefs with default value*/
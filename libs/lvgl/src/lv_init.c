@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "others/sysmon/lv_sysmon_private.h"
+#include "others/telemetry/lv_telemetry_private.h"
 #include "misc/lv_timer_private.h"
 #include "misc/lv_profiler_builtin_private.h"
 #include "misc/lv_anim_private.h"
@@ -35,6 +36,7 @@
 #include "draw/lv_draw.h"
 #include "misc/lv_async.h"
 #include "misc/lv_fs_private.h"
+#include "font/lv_font_fmt_txt_private.h"
 #include "widgets/span/lv_span.h"
 #include "themes/simple/lv_theme_simple.h"
 #include "misc/lv_fs.h"
@@ -118,11 +120,6 @@ static inline void lv_global_init(lv_global_t * global)
     void LV_LOG_PRINT_CB(lv_log_level_t, const char * txt);
     global->custom_log_print_cb = LV_LOG_PRINT_CB;
 #endif
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void lv_cleanup_devices(lv_global_t * global)
@@ -186,6 +183,8 @@ void lv_init(void)
 
     lv_layout_init();
 
+    lv_font_fmt_txt_init();
+
     lv_anim_core_init();
 
     lv_group_init();
@@ -227,6 +226,10 @@ void lv_init(void)
     lv_sysmon_builtin_init();
 #endif
 
+#if LV_USE_TELEMETRY
+    lv_telemetry_init();
+#endif
+
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
@@ -355,6 +358,10 @@ void lv_deinit(void)
     lv_sysmon_builtin_deinit();
 #endif
 
+#if LV_USE_TELEMETRY
+    lv_telemetry_deinit();
+#endif
+
     lv_display_set_default(NULL);
 
     lv_cleanup_devices(LV_GLOBAL_DEFAULT());
@@ -371,6 +378,8 @@ void lv_deinit(void)
     lv_freetype_uninit();
 #endif
 
+    lv_font_fmt_txt_deinit();
+
 #if LV_USE_THEME_DEFAULT
     lv_theme_default_deinit();
 #endif
@@ -24,6 +24,7 @@ extern "C" {
 #include "stdlib/lv_mem_private.h"
 #include "others/file_explorer/lv_file_explorer_private.h"
 #include "others/sysmon/lv_sysmon_private.h"
+#include "others/telemetry/lv_telemetry_private.h"
 #include "others/monkey/lv_monkey_private.h"
 #include "others/ime/lv_ime_pinyin_private.h"
 #include "others/fragment/lv_fragment_private.h"
@@ -90,6 +91,7 @@ extern "C" {
 #include "widgets/led/lv_led_private.h"
 #include "widgets/arc/lv_arc_private.h"
 #include "widgets/tileview/lv_tileview_private.h"
+#include "widgets/vlist/lv_vlist_private.h"
 #include "widgets/spinbox/lv_spinbox_private.h"
 #include "widgets/span/lv_span_private.h"
 #include "widgets/label/lv_label_private.h"
@@ -14,13 +14,32 @@
 #include "lv_image_cache.h"
 #include "lv_image_header_cache.h"
 
+#if LV_USE_LZ4_EXTERNAL
+    #include <lz4.h>
+#endif
+
+#if LV_USE_LZ4_INTERNAL
+    #include "../../libs/lz4/lz4.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 
 #define CACHE_NAME  "IMAGE"
+#define COMPRESSED_CACHE_NAME  "IMAGE_COMPRESSED"
+
+/*Images opened less times than this are not worth compressing when evicted*/
+#define COMPRESS_MIN_ACCESS_CNT 2
+
+/*Passed as `user_data` when the images are invalidated to not move them to the compressed cache*/
+#define DROP_USER_DATA  ((void *)&img_cache_p)
 
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+#define img_compressed_cache_p (LV_GLOBAL_DEFAULT()->img_compressed_cache)
+#define pending_ll_p (&LV_GLOBAL_DEFAULT()->img_compress_pending_ll)
+#define pending_lock_p (&LV_GLOBAL_DEFAULT()->img_compress_pending_lock)
+#define pending_size (LV_GLOBAL_DEFAULT()->img_compress_pending_size)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
 /**********************
@@ -34,6 +53,16 @@
 static lv_cache_compare_res_t image_cache_compare_cb(const lv_image_cache_data_t * lhs,
                                                      const lv_image_cache_data_t * rhs);
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data);
+static void image_cache_data_free(lv_image_cache_data_t * entry);
+
+#if LV_USE_LZ4
+    static bool compress_pending_add(const lv_image_cache_data_t * entry);
+    static void compress_pending_drop(const void * src, lv_image_src_t src_type);
+    static void compressed_cache_add(const lv_image_cache_data_t * entry);
+    static lv_cache_compare_res_t compressed_cache_compare_cb(const lv_image_cache_compressed_data_t * lhs,
+                                                              const lv_image_cache_compressed_data_t * rhs);
+    static void compressed_cache_free_cb(lv_image_cache_compressed_data_t * entry, void * user_data);
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -82,7 +111,13 @@ void lv_image_cache_drop(const void * src)
     lv_image_header_cache_drop(src);
 
     if(src == NULL) {
-        lv_cache_drop_all(img_cache_p, NULL);
+        lv_cache_drop_all(img_cache_p, DROP_USER_DATA);
+#if LV_USE_LZ4
+        if(img_compressed_cache_p) {
+            compress_pending_drop(NULL, LV_IMAGE_SRC_UNKNOWN);
+            lv_cache_drop_all(img_compressed_cache_p, NULL);
+        }
+#endif
         return;
     }
 
@@ -91,7 +126,19 @@ void lv_image_cache_drop(const void * src)
         .src_type = lv_image_src_get_type(src),
     };
 
-    lv_cache_drop(img_cache_p, &search_key, NULL);
+    lv_cache_drop(img_cache_p, &search_key, DROP_USER_DATA);
+
+#if LV_USE_LZ4
+    if(img_compressed_cache_p) {
+        compress_pending_drop(src, search_key.src_type);
+
+        lv_image_cache_compressed_data_t compressed_search_key = {
+            .src = src,
+            .src_type = search_key.src_type,
+        };
+        lv_cache_drop(img_compressed_cache_p, &compressed_search_key, NULL);
+    }
+#endif
 }
 
 bool lv_image_cache_is_enabled(void)
@@ -99,6 +146,161 @@ bool lv_image_cache_is_enabled(void)
     return lv_cache_is_enabled(img_cache_p);
 }
 
+bool lv_image_cache_contains(const void * src)
+{
+    if(src == NULL || !lv_image_cache_is_enabled()) return false;
+
+    lv_image_cache_data_t search_key = {
+        .src = src,
+        .src_type = lv_image_src_get_type(src),
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire(img_cache_p, &search_key, NULL);
+    if(entry) {
+        lv_cache_release(img_cache_p, entry, NULL);
+        return true;
+    }
+
+#if LV_USE_LZ4
+    if(img_compressed_cache_p) {
+        lv_image_cache_compressed_data_t compressed_search_key = {
+            .src = src,
+            .src_type = search_key.src_type,
+        };
+        entry = lv_cache_acquire(img_compressed_cache_p, &compressed_search_key, NULL);
+        if(entry) {
+            lv_cache_release(img_compressed_cache_p, entry, NULL);
+            return true;
+        }
+    }
+#endif
+
+    return false;
+}
+
+#if LV_USE_LZ4
+
+lv_result_t lv_image_cache_compressed_init(uint32_t size)
+{
+    if(img_compressed_cache_p != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    img_compressed_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(lv_image_cache_compressed_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) compressed_cache_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) compressed_cache_free_cb,
+    });
+
+    lv_cache_set_name(img_compressed_cache_p, COMPRESSED_CACHE_NAME);
+
+    lv_ll_init(pending_ll_p, sizeof(lv_image_cache_data_t));
+    lv_mutex_init(pending_lock_p);
+    pending_size = 0;
+
+    return img_compressed_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lv_image_cache_compressed_deinit(void)
+{
+    if(img_compressed_cache_p == NULL) return;
+
+    compress_pending_drop(NULL, LV_IMAGE_SRC_UNKNOWN);
+    lv_mutex_delete(pending_lock_p);
+
+    lv_cache_destroy(img_compressed_cache_p, NULL);
+    img_compressed_cache_p = NULL;
+}
+
+void lv_image_cache_compressed_resize(uint32_t new_size, bool evict_now)
+{
+    lv_cache_set_max_size(img_compressed_cache_p, new_size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(img_compressed_cache_p, new_size, NULL);
+    }
+}
+
+bool lv_image_cache_compressed_is_enabled(void)
+{
+    return img_compressed_cache_p && lv_cache_is_enabled(img_compressed_cache_p);
+}
+
+lv_cache_entry_t * lv_image_cache_promote(const void * src, lv_image_src_t src_type)
+{
+    if(!lv_image_cache_compressed_is_enabled()) return NULL;
+
+    lv_image_cache_compressed_data_t compressed_search_key = {
+        .src = src,
+        .src_type = src_type,
+    };
+
+    lv_cache_entry_t * compressed_entry = lv_cache_acquire(img_compressed_cache_p, &compressed_search_key, NULL);
+    if(compressed_entry == NULL) return NULL;
+
+    lv_image_cache_compressed_data_t * compressed = lv_cache_entry_get_data(compressed_entry);
+    const lv_image_header_t * header = &compressed->header;
+    lv_draw_buf_t * decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, header->w, header->h, header->cf,
+                                                    header->stride);
+    lv_cache_entry_t * entry = NULL;
+    if(decoded && decoded->data_size == compressed->data_size) {
+        int res = LZ4_decompress_safe((const char *)compressed->data, (char *)decoded->data,
+                                      (int)compressed->slot.size, (int)decoded->data_size);
+        if(res == (int)compressed->data_size) {
+            decoded->header.flags = header->flags;
+
+            /*The compressed copy is kept so it's not required to compress the image again when evicted*/
+            lv_image_cache_data_t search_key = {
+                .slot.size = decoded->data_size,
+                .src = src,
+                .src_type = src_type,
+            };
+            entry = lv_image_decoder_add_to_cache((lv_image_decoder_t *)compressed->decoder, &search_key, decoded, NULL);
+            if(entry) {
+                lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+                lv_mutex_lock(&img_cache_p->lock);
+                cached_data->access_cnt = compressed->access_cnt + 1;
+                lv_mutex_unlock(&img_cache_p->lock);
+            }
+        }
+        else {
+            LV_LOG_WARN("Failed to decompress a cached image");
+        }
+    }
+
+    lv_cache_release(img_compressed_cache_p, compressed_entry, NULL);
+
+    if(entry == NULL && decoded) lv_draw_buf_destroy(decoded);
+
+    return entry;
+}
+
+void lv_image_cache_compress_pending(void)
+{
+    if(img_compressed_cache_p == NULL) return;
+
+    while(1) {
+        /*Take the images one by one to not block the evicting threads while compressing*/
+        lv_image_cache_data_t entry;
+        lv_mutex_lock(pending_lock_p);
+        lv_image_cache_data_t * head = lv_ll_get_head(pending_ll_p);
+        if(head) {
+            entry = *head;
+            pending_size -= entry.decoded->data_size;
+            lv_ll_remove(pending_ll_p, head);
+            lv_free(head);
+        }
+        lv_mutex_unlock(pending_lock_p);
+
+        if(head == NULL) break;
+
+        compressed_cache_add(&entry);
+        image_cache_data_free(&entry);
+    }
+}
+
+#endif /*LV_USE_LZ4*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -132,8 +334,23 @@ static lv_cache_compare_res_t image_cache_compare_cb(
 
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
 {
+#if LV_USE_LZ4
+    /*Keep the frequently used evicted images compressed. Dropped images are not kept as they are outdated.
+     *The cache is locked here so only queue them and compress them later.*/
+    if(user_data != DROP_USER_DATA && entry->access_cnt >= COMPRESS_MIN_ACCESS_CNT &&
+       !lv_cache_entry_is_invalid(lv_cache_entry_get_entry(entry, sizeof(lv_image_cache_data_t))) &&
+       compress_pending_add(entry)) {
+        return;
+    }
+#else
     LV_UNUSED(user_data);
+#endif
 
+    image_cache_data_free(entry);
+}
+
+static void image_cache_data_free(lv_image_cache_data_t * entry)
+{
     /* Destroy the decoded draw buffer if necessary. */
     lv_draw_buf_t * decoded = (lv_draw_buf_t *)entry->decoded;
     if(lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_ALLOCATED)) {
@@ -143,3 +360,138 @@ static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
     /*Free the duplicated file name*/
     if(entry->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)entry->src);
 }
+
+#if LV_USE_LZ4
+
+/**
+ * Queue an evicted image to compress it in `lv_image_cache_compress_pending()`.
+ * The queued copy takes the ownership of the decoded draw buffer and the source.
+ * At most as many bytes are queued as the compressed cache can hold.
+ * @param entry     the evicted image cache entry
+ * @return          true: queued, false: not worth compressing, free it now
+ */
+static bool compress_pending_add(const lv_image_cache_data_t * entry)
+{
+    const lv_draw_buf_t * decoded = entry->decoded;
+    if(!lv_image_cache_compressed_is_enabled() || decoded == NULL || decoded->data == NULL) return false;
+    if(!lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_ALLOCATED)) return false;
+    if(decoded->data_size > (uint32_t)LZ4_MAX_INPUT_SIZE) return false;
+
+    bool queued = false;
+    lv_mutex_lock(pending_lock_p);
+    if(pending_size + decoded->data_size <= lv_cache_get_max_size(img_compressed_cache_p, NULL)) {
+        lv_image_cache_data_t * pending = lv_ll_ins_tail(pending_ll_p);
+        if(pending) {
+            *pending = *entry;
+            pending_size += decoded->data_size;
+            queued = true;
+        }
+    }
+    lv_mutex_unlock(pending_lock_p);
+
+    return queued;
+}
+
+/**
+ * Free the queued images of a source without compressing them.
+ * @param src       the image source or NULL to free all of them
+ * @param src_type  type of the image source
+ */
+static void compress_pending_drop(const void * src, lv_image_src_t src_type)
+{
+    lv_mutex_lock(pending_lock_p);
+    lv_image_cache_data_t * pending = lv_ll_get_head(pending_ll_p);
+    while(pending) {
+        lv_image_cache_data_t * next = lv_ll_get_next(pending_ll_p, pending);
+        if(src == NULL || image_cache_common_compare(pending->src, pending->src_type, src, src_type) == 0) {
+            pending_size -= pending->decoded->data_size;
+            lv_ll_remove(pending_ll_p, pending);
+            image_cache_data_free(pending);
+            lv_free(pending);
+        }
+        pending = next;
+    }
+    lv_mutex_unlock(pending_lock_p);
+}
+
+/**
+ * Compress the decoded data of an evicted image and add it to the compressed cache.
+ * Images which are not allocated by the decoder or can't be compressed well are skipped.
+ * @param entry     the evicted image cache entry
+ */
+static void compressed_cache_add(const lv_image_cache_data_t * entry)
+{
+    const lv_draw_buf_t * decoded = entry->decoded;
+    if(!lv_image_cache_compressed_is_enabled() || decoded == NULL || decoded->data == NULL) return;
+    if(!lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_ALLOCATED)) return;
+    if(decoded->data_size > (uint32_t)LZ4_MAX_INPUT_SIZE) return;
+
+    lv_image_cache_compressed_data_t search_key = {
+        .src = entry->src,
+        .src_type = entry->src_type,
+    };
+
+    /*Still there if the image was promoted from the compressed cache*/
+    lv_cache_entry_t * compressed_entry = lv_cache_acquire(img_compressed_cache_p, &search_key, NULL);
+    if(compressed_entry) {
+        lv_cache_release(img_compressed_cache_p, compressed_entry, NULL);
+        return;
+    }
+
+    /*Allocate the state instead of using the stack as it's about 16 kB*/
+    int bound = LZ4_compressBound((int)decoded->data_size);
+    void * state = lv_malloc(LZ4_sizeofState());
+    char * buf = lv_malloc(bound);
+    int compressed_size = 0;
+    if(state && buf) {
+        compressed_size = LZ4_compress_fast_extState(state, (const char *)decoded->data, buf, (int)decoded->data_size,
+                                                     bound, 1);
+    }
+    lv_free(state);
+
+    /*Not worth keeping if it saves less than a quarter of the memory*/
+    if(compressed_size <= 0 || (uint32_t)compressed_size > decoded->data_size - decoded->data_size / 4) {
+        lv_free(buf);
+        return;
+    }
+
+    search_key.slot.size = compressed_size;
+    search_key.header = decoded->header;
+    search_key.data_size = decoded->data_size;
+    search_key.decoder = entry->decoder;
+    search_key.access_cnt = entry->access_cnt;
+    search_key.data = lv_realloc(buf, compressed_size);
+    if(search_key.data == NULL) {
+        lv_free(buf);
+        return;
+    }
+    if(search_key.src_type == LV_IMAGE_SRC_FILE) {
+        search_key.src = lv_strdup(search_key.src);
+    }
+
+    compressed_entry = lv_cache_add(img_compressed_cache_p, &search_key, NULL);
+    if(compressed_entry == NULL) {
+        compressed_cache_free_cb(&search_key, NULL);
+        return;
+    }
+
+    lv_cache_release(img_compressed_cache_p, compressed_entry, NULL);
+}
+
+static lv_cache_compare_res_t compressed_cache_compare_cb(const lv_image_cache_compressed_data_t * lhs,
+                                                          const lv_image_cache_compressed_data_t * rhs)
+{
+    return image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
+}
+
+static void compressed_cache_free_cb(lv_image_cache_compressed_data_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(entry->data);
+
+    /*Free the duplicated file name*/
+    if(entry->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)entry->src);
+}
+
+#endif /*LV_USE_LZ4*/
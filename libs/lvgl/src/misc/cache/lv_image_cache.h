@@ -56,6 +56,44 @@ void lv_image_cache_drop(const void * src);
  */
 bool lv_image_cache_is_enabled(void);
 
+/**
+ * Check if an image is in the image cache, or in the compressed image cache.
+ * @param src   pointer to an image source.
+ * @return      true: the image can be opened without decoding it again, false: it's not cached.
+ */
+bool lv_image_cache_contains(const void * src);
+
+#if LV_USE_LZ4
+
+/**
+ * Initialize the compressed image cache. Frequently used images evicted from the image cache
+ * are kept here compressed with LZ4 and decompressed when they are opened again.
+ * @param  size size of the compressed data in bytes.
+ * @return LV_RESULT_OK: initialization succeeded, LV_RESULT_INVALID: failed.
+ */
+lv_result_t lv_image_cache_compressed_init(uint32_t size);
+
+/**
+ * Free the compressed image cache and all the images in it.
+ */
+void lv_image_cache_compressed_deinit(void);
+
+/**
+ * Resize the compressed image cache.
+ * If set to 0, the compressed cache will be disabled.
+ * @param new_size  new size of the compressed data in bytes.
+ * @param evict_now true: evict the images should be removed by the eviction policy, false: wait for the next cache cleanup.
+ */
+void lv_image_cache_compressed_resize(uint32_t new_size, bool evict_now);
+
+/**
+ * Return true if the compressed image cache is enabled.
+ * @return true: enabled, false: disabled.
+ */
+bool lv_image_cache_compressed_is_enabled(void);
+
+#endif /*LV_USE_LZ4*/
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
@@ -9,6 +9,7 @@
 #include "lv_anim_private.h"
 
 #include "../core/lv_global.h"
+#include "../core/lv_obj_style_private.h"
 #include "../tick/lv_tick.h"
 #include "lv_assert.h"
 #include "lv_timer.h"
@@ -33,6 +34,7 @@
  **********************/
 static void anim_timer(lv_timer_t * param);
 static void anim_mark_list_change(void);
+static void anim_unlink(lv_anim_t * a);
 static void anim_completed_handler(lv_anim_t * a);
 static int32_t lv_anim_path_cubic_bezier(const lv_anim_t * a, int32_t x1,
                                          int32_t y1, int32_t x2, int32_t y2);
@@ -63,8 +65,6 @@ void lv_anim_core_init(void)
     lv_ll_init(anim_ll_p, sizeof(lv_anim_t));
     state.timer = lv_timer_create(anim_timer, LV_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
-    state.anim_list_changed = false;
-    state.anim_run_round = false;
 }
 
 void lv_anim_core_deinit(void)
@@ -95,7 +95,6 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     /*Initialize the animation descriptor*/
     lv_memcpy(new_anim, a, sizeof(lv_anim_t));
     if(a->var == a) new_anim->var = new_anim;
-    new_anim->run_round = state.anim_run_round;
     new_anim->last_timer_run = lv_tick_get();
 
     /*Set the start value*/
@@ -120,8 +119,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         }
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
+    /*Resume the animation timer if it was paused*/
     anim_mark_list_change();
 
     LV_TRACE_ANIM("finished");
@@ -151,8 +149,7 @@ bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
         bool del = false;
         if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             remove_anim(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
+            anim_mark_list_change();
             del_any = true;
             del = true;
         }
@@ -188,6 +185,11 @@ lv_timer_t * lv_anim_get_timer(void)
     return state.timer;
 }
 
+bool lv_anim_is_timer_running(void)
+{
+    return state.run != NULL;
+}
+
 uint16_t lv_anim_count_running(void)
 {
     uint16_t cnt = 0;
@@ -494,72 +496,73 @@ static void anim_timer(lv_timer_t * param)
 {
     LV_UNUSED(param);
 
-    /*Flip the run round*/
-    state.anim_run_round = state.anim_run_round ? false : true;
+    /*Can be called recursively from a callback via `lv_anim_refr_now()`.
+     *The animations processed in the outer pass won't change as no time elapsed since then.*/
+    lv_anim_run_t run;
+    run.parent = state.run;
+    run.anim_exec = NULL;
+    run.anim_next = NULL;
+    run.anim_deleted = false;
+    state.run = &run;
 
-    lv_anim_t * a = lv_ll_get_head(anim_ll_p);
+    uint32_t tick_act = lv_tick_get();
 
+    /* Animations deleted or created in the callbacks don't require restarting from the head:
+     * `anim_next` is moved forward if the next animation is deleted and new animations are added to the head.*/
+    lv_anim_t * a = lv_ll_get_head(anim_ll_p);
     while(a != NULL) {
-        uint32_t elaps = lv_tick_elaps(a->last_timer_run);
+        run.anim_next = lv_ll_get_next(anim_ll_p, a);
+        run.anim_exec = a;
+        run.anim_deleted = false;
+
+        uint32_t elaps = tick_act - a->last_timer_run;
         a->act_time += elaps;
+        a->last_timer_run = tick_act;
 
-        a->last_timer_run = lv_tick_get();
+        /*The animation will run now for the first time. Call `start_cb`*/
+        if(!a->start_cb_called && a->act_time >= 0) {
 
-        /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_completed_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        state.anim_list_changed = false;
+            if(a->early_apply == 0 && a->get_value_cb) {
+                int32_t v_ofs = a->get_value_cb(a);
+                a->start_value += v_ofs;
+                a->end_value += v_ofs;
+            }
 
-        if(a->run_round != state.anim_run_round) {
-            a->run_round = state.anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
+            resolve_time(a);
 
-            /*The animation will run now for the first time. Call `start_cb`*/
-            if(!a->start_cb_called && a->act_time >= 0) {
+            if(a->start_cb) a->start_cb(a);
+            a->start_cb_called = 1;
 
-                if(a->early_apply == 0 && a->get_value_cb) {
-                    int32_t v_ofs = a->get_value_cb(a);
-                    a->start_value += v_ofs;
-                    a->end_value += v_ofs;
-                }
+            /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
+            if(!run.anim_deleted) remove_concurrent_anims(a);
+        }
 
-                resolve_time(a);
+        if(!run.anim_deleted && a->act_time >= 0) {
+            if(a->act_time > a->duration) a->act_time = a->duration;
 
-                if(a->start_cb) a->start_cb(a);
-                a->start_cb_called = 1;
+            int32_t new_value;
+            new_value = a->path_cb(a);
 
-                /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
-                remove_concurrent_anims(a);
+            if(new_value != a->current_value) {
+                a->current_value = new_value;
+                /*Apply the calculated value*/
+                if(a->exec_cb) a->exec_cb(a->var, new_value);
+                if(!run.anim_deleted && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
             }
 
-            if(a->act_time >= 0) {
-                if(a->act_time > a->duration) a->act_time = a->duration;
-
-                int32_t new_value;
-                new_value = a->path_cb(a);
-
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                    if(!state.anim_list_changed && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
-                }
-
-                /*If the time is elapsed the animation is ready*/
-                if(!state.anim_list_changed && a->act_time >= a->duration) {
-                    anim_completed_handler(a);
-                }
+            /*If the time is elapsed the animation is ready*/
+            if(!run.anim_deleted && a->act_time >= a->duration) {
+                anim_completed_handler(a);
             }
         }
 
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(state.anim_list_changed)
-            a = lv_ll_get_head(anim_ll_p);
-        else
-            a = lv_ll_get_next(anim_ll_p, a);
+        a = run.anim_next;
     }
 
+    state.run = run.parent;
+
+    /*Apply the style changes of the style animations*/
+    lv_obj_style_flush_refresh();
 }
 
 /**
@@ -581,8 +584,7 @@ static void anim_completed_handler(lv_anim_t * a)
 
         /*Delete the animation from the list.
          * This way the `completed_cb` will see the animations like it's animation is already deleted*/
-        lv_ll_remove(anim_ll_p, a);
-        /*Flag that the list has changed*/
+        anim_unlink(a);
         anim_mark_list_change();
 
         /*Call the callback function at the end*/
@@ -614,7 +616,6 @@ static void anim_completed_handler(lv_anim_t * a)
 
 static void anim_mark_list_change(void)
 {
-    state.anim_list_changed = true;
     if(lv_ll_get_head(anim_ll_p) == NULL)
         lv_timer_pause(state.timer);
     else
@@ -680,10 +681,9 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
            (a->var == a_current->var) &&
            ((a->exec_cb && a->exec_cb == a_current->exec_cb)
             /*|| (a->custom_exec_cb && a->custom_exec_cb == a_current->custom_exec_cb)*/)) {
-            lv_ll_remove(anim_ll_p, a);
+            anim_unlink(a);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
             lv_free(a);
-            /*Read by `anim_timer`. It need to know if a delete occurred in the linked list*/
             anim_mark_list_change();
 
             del_any = true;
@@ -701,7 +701,23 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
 static void remove_anim(void * a)
 {
     lv_anim_t * anim = a;
-    lv_ll_remove(anim_ll_p, a);
+    anim_unlink(anim);
     if(anim->deleted_cb != NULL) anim->deleted_cb(anim);
     lv_free(a);
 }
+
+/**
+ * Remove an animation from the linked list without freeing it.
+ * Let `anim_timer` know if it affects the animation being executed or the next one.
+ * @param a     pointer to an animation in the list
+ */
+static void anim_unlink(lv_anim_t * a)
+{
+    /*All the running passes need to know about it*/
+    lv_anim_run_t * run;
+    for(run = state.run; run; run = run->parent) {
+        if(a == run->anim_next) run->anim_next = lv_ll_get_next(anim_ll_p, a);
+        if(a == run->anim_exec) run->anim_deleted = true;
+    }
+    lv_ll_remove(anim_ll_p, a);
+}
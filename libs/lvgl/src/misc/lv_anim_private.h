@@ -24,9 +24,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** A pass of the animation timer over the animations.
+ * Nested passes are started if `lv_anim_refr_now()` is called from an animation.*/
+typedef struct lv_anim_run_t {
+    struct lv_anim_run_t * parent;  /**< The pass which started this one or `NULL`*/
+    lv_anim_t * anim_exec;          /**< The animation being executed*/
+    lv_anim_t * anim_next;          /**< The next animation to process. Updated if it's deleted meanwhile*/
+    bool anim_deleted;              /**< The animation being executed was deleted*/
+} lv_anim_run_t;
+
 typedef struct {
-    bool anim_list_changed;
-    bool anim_run_round;
+    lv_anim_run_t * run;        /**< The innermost pass of the animation timer or `NULL` if it's not running*/
     lv_timer_t * timer;
     lv_ll_t anim_ll;
 } lv_anim_state_t;
@@ -45,6 +53,13 @@ void lv_anim_core_init(void);
  */
 void lv_anim_core_deinit(void);
 
+/**
+ * Tell if the animations are being processed now. Can be used to defer
+ * expensive updates triggered by the animations to the end of the frame.
+ * @return  true: the animation timer is running
+ */
+bool lv_anim_is_timer_running(void);
+
 /**********************
  *      MACROS
  **********************/
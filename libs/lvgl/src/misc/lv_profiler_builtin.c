@@ -8,6 +8,7 @@
  *********************/
 
 #include "lv_profiler_builtin_private.h"
+#include "lv_rb_private.h"
 #include "../lvgl.h"
 #include "../core/lv_global.h"
 
@@ -22,6 +23,11 @@
 #define LV_PROFILER_STR_MAX_LEN 128
 #define LV_PROFILER_TICK_PER_SEC_MAX 1000000
 
+/*Size of the buffer used to batch the binary records before calling `flush_bin_cb`*/
+#define LV_PROFILER_BIN_BUF_SIZE 512
+#define LV_PROFILER_BIN_VERSION 1
+#define LV_PROFILER_BIN_STR_ID_MAX 0xFFFF
+
 #if LV_USE_OS
     #define LV_PROFILER_MULTEX_INIT   lv_mutex_init(&profiler_ctx->mutex)
     #define LV_PROFILER_MULTEX_DEINIT lv_mutex_delete(&profiler_ctx->mutex)
@@ -34,6 +40,17 @@
     #define LV_PROFILER_MULTEX_UNLOCK
 #endif
 
+/*The rings are single producer single consumer queues: the producer publishes `head`
+ *and the consumer publishes `tail`. Only these two indices are shared.*/
+#if defined(__GNUC__) || defined(__clang__)
+    #define LV_PROFILER_LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define LV_PROFILER_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+    /*Without compiler support only the compiler reordering is prevented*/
+    #define LV_PROFILER_LOAD_ACQUIRE(p)     (*(volatile uint32_t *)(p))
+    #define LV_PROFILER_STORE_RELEASE(p, v) (*(volatile uint32_t *)(p) = (v))
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -42,26 +59,60 @@
  * @brief Structure representing a built-in profiler item in LVGL
  */
 typedef struct {
-    char tag;          /**< The tag of the profiler item */
-    uint32_t tick;     /**< The tick value of the profiler item */
     const char * func; /**< A pointer to the function associated with the profiler item */
+    uint32_t tick;     /**< The tick value of the profiler item */
+    char tag;          /**< The tag of the profiler item */
 #if LV_USE_OS
-    int tid;           /**< The thread ID of the profiler item */
-    int cpu;         /**< The CPU ID of the profiler item */
+    int cpu;           /**< The CPU ID of the profiler item */
 #endif
 } lv_profiler_builtin_item_t;
 
+/**
+ * @brief Ring buffer of the profiler items written by a single thread
+ */
+typedef struct {
+    lv_profiler_builtin_item_t * item_arr; /**< Pointer to an array of `item_num` profiler items */
+    int tid;                               /**< The thread ID of the writer thread */
+    bool in_use;                           /**< The ring is assigned to the thread `tid` */
+    uint32_t head;                         /**< Free running write index, written only by the writer */
+    uint32_t tail;                         /**< Free running read index, written only by the drain */
+    uint32_t dropped;                      /**< Number of items dropped because the ring was full */
+    uint32_t dropped_reported;             /**< Number of dropped items already reported by the drain */
+} lv_profiler_builtin_ring_t;
+
+/**
+ * @brief Entry of the tree mapping the function names to the IDs of the binary output
+ */
+typedef struct {
+    const char * func; /**< The function name, compared by its address */
+    uint16_t id;       /**< ID of the string record written for the function name */
+} lv_profiler_builtin_str_t;
+
 /**
  * @brief Structure representing a context for the LVGL built-in profiler
  */
 typedef struct lv_profiler_builtin_ctx_t {
-    lv_profiler_builtin_item_t * item_arr; /**< Pointer to an array of profiler items */
-    uint32_t item_num;                     /**< Number of profiler items in the array */
-    uint32_t cur_index;                    /**< Index of the current profiler item */
+    lv_profiler_builtin_ring_t * ring_arr; /**< Pointer to an array of per-thread rings */
+    uint32_t ring_num;                     /**< Number of rings in the array */
+    uint32_t ring_cnt;                     /**< Number of rings ever assigned, the released ones are reused first */
+    uint32_t item_num;                     /**< Number of profiler items in a ring. Power of 2. */
     lv_profiler_builtin_config_t config;   /**< Configuration for the built-in profiler */
     bool enable;                           /**< Whether the built-in profiler is enabled */
+    bool shared_ring;                      /**< All threads write the same ring as they can't be told apart */
+    lv_rb_t str_tree;                      /**< Function names already written to the binary output */
+    uint32_t str_cnt;                      /**< Number of function names in `str_tree` */
+    uint8_t bin_buf[LV_PROFILER_BIN_BUF_SIZE]; /**< Binary records waiting for `flush_bin_cb` */
+    uint32_t bin_len;                      /**< Number of bytes used in `bin_buf` */
+    uint32_t dropped;                      /**< Number of items dropped because no ring was left for the thread */
+    uint32_t dropped_reported;             /**< Number of such dropped items already reported by the drain */
+    bool draining;                         /**< Avoid draining again if the outputs write profiler items */
 #if LV_USE_OS
-    lv_mutex_t mutex;                      /**< Mutex to protect the built-in profiler */
+    lv_mutex_t mutex;                      /**< Mutex to protect assigning the rings and the shared ring */
+    lv_mutex_t drain_mutex;                /**< Mutex to allow only one drain at a time */
+    lv_thread_t drain_thread;              /**< Thread draining the rings in the background */
+    lv_thread_sync_t drain_sync;           /**< Signaled when a ring is half full */
+    bool drain_thread_created;             /**< The drain thread is created only when a ring gets half full */
+    bool drain_exit;                       /**< Tell the drain thread to exit */
 #endif
 } lv_profiler_builtin_ctx_t;
 
@@ -72,7 +123,22 @@ typedef struct lv_profiler_builtin_ctx_t {
 static void default_flush_cb(const char * buf);
 static int default_tid_get_cb(void);
 static int default_cpu_get_cb(void);
-static void flush_no_lock(void);
+static lv_profiler_builtin_ring_t * get_ring(lv_profiler_builtin_ctx_t * ctx);
+static void drain(lv_profiler_builtin_ctx_t * ctx);
+static void write_text(lv_profiler_builtin_ctx_t * ctx, const lv_profiler_builtin_ring_t * ring,
+                       const lv_profiler_builtin_item_t * item);
+static void write_bin(lv_profiler_builtin_ctx_t * ctx, const lv_profiler_builtin_ring_t * ring,
+                      const lv_profiler_builtin_item_t * item);
+static void write_bin_record(lv_profiler_builtin_ctx_t * ctx, char type, uint8_t cpu, uint16_t id, int32_t tid,
+                             uint32_t value);
+static void bin_append(lv_profiler_builtin_ctx_t * ctx, const void * data, uint32_t size);
+static void bin_flush(lv_profiler_builtin_ctx_t * ctx);
+static lv_rb_compare_res_t str_compare_cb(const void * a, const void * b);
+#if LV_USE_OS
+    static lv_profiler_builtin_ring_t * find_ring(lv_profiler_builtin_ctx_t * ctx, int tid);
+    static void drain_thread_signal(lv_profiler_builtin_ctx_t * ctx);
+    static void drain_thread_cb(void * user_data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -96,6 +162,7 @@ void lv_profiler_builtin_config_init(lv_profiler_builtin_config_t * config)
     config->flush_cb = default_flush_cb;
     config->tid_get_cb = default_tid_get_cb;
     config->cpu_get_cb = default_cpu_get_cb;
+    config->thread_max = LV_USE_OS ? 4 : 1;
 }
 
 void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
@@ -103,9 +170,15 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
     LV_ASSERT_NULL(config);
     LV_ASSERT_NULL(config->tick_get_cb);
 
-    uint32_t num = config->buf_size / sizeof(lv_profiler_builtin_item_t);
-    if(num == 0) {
-        LV_LOG_WARN("buf_size must > %d", (int)sizeof(lv_profiler_builtin_item_t));
+    /*Without a real thread ID the threads can't have their own rings*/
+    bool shared_ring = !LV_USE_OS || config->tid_get_cb == NULL || config->tid_get_cb == default_tid_get_cb;
+    uint32_t ring_num = shared_ring ? 1 : LV_MAX(config->thread_max, 1);
+
+    /*Round down to a power of 2 so that the indices can wrap around freely*/
+    uint32_t num = config->buf_size / ring_num / sizeof(lv_profiler_builtin_item_t);
+    while(num & (num - 1)) num &= num - 1;
+    if(num < 2) {
+        LV_LOG_WARN("buf_size must > %d", (int)(2 * ring_num * sizeof(lv_profiler_builtin_item_t)));
         return;
     }
 
@@ -121,19 +194,41 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
 
     profiler_ctx = lv_malloc_zeroed(sizeof(lv_profiler_builtin_ctx_t));
     LV_ASSERT_MALLOC(profiler_ctx);
+    if(profiler_ctx == NULL) {
+        LV_LOG_ERROR("malloc failed for profiler_ctx");
+        return;
+    }
 
-    profiler_ctx->item_arr = lv_malloc(num * sizeof(lv_profiler_builtin_item_t));
-    LV_ASSERT_MALLOC(profiler_ctx->item_arr);
-    if(profiler_ctx->item_arr == NULL) {
+    profiler_ctx->ring_arr = lv_malloc_zeroed(ring_num * sizeof(lv_profiler_builtin_ring_t));
+    LV_ASSERT_MALLOC(profiler_ctx->ring_arr);
+    lv_profiler_builtin_item_t * item_arr = lv_malloc(ring_num * num * sizeof(lv_profiler_builtin_item_t));
+    LV_ASSERT_MALLOC(item_arr);
+    if(profiler_ctx->ring_arr == NULL || item_arr == NULL) {
+        lv_free(profiler_ctx->ring_arr);
+        lv_free(item_arr);
         lv_free(profiler_ctx);
         profiler_ctx = NULL;
         LV_LOG_ERROR("malloc failed for item_arr");
         return;
     }
 
+    uint32_t i;
+    for(i = 0; i < ring_num; i++) {
+        profiler_ctx->ring_arr[i].item_arr = item_arr + i * num;
+    }
+
     LV_PROFILER_MULTEX_INIT;
+    profiler_ctx->ring_num = ring_num;
     profiler_ctx->item_num = num;
     profiler_ctx->config = *config;
+    profiler_ctx->shared_ring = shared_ring;
+    lv_rb_init(&profiler_ctx->str_tree, str_compare_cb, sizeof(lv_profiler_builtin_str_t));
+
+    if(shared_ring) {
+        profiler_ctx->ring_arr[0].tid = 1;
+        profiler_ctx->ring_arr[0].in_use = true;
+        profiler_ctx->ring_cnt = 1;
+    }
 
     if(profiler_ctx->config.flush_cb) {
         /* add profiler header for perfetto */
@@ -141,16 +236,45 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
         profiler_ctx->config.flush_cb("#\n");
     }
 
+    if(profiler_ctx->config.flush_bin_cb) {
+        /*Header: magic, version, reserved, tick_per_sec*/
+        uint16_t version = LV_PROFILER_BIN_VERSION;
+        uint16_t reserved = 0;
+        bin_append(profiler_ctx, "LVPF", 4);
+        bin_append(profiler_ctx, &version, sizeof(version));
+        bin_append(profiler_ctx, &reserved, sizeof(reserved));
+        bin_append(profiler_ctx, &profiler_ctx->config.tick_per_sec, sizeof(uint32_t));
+        bin_flush(profiler_ctx);
+    }
+
+#if LV_USE_OS
+    lv_mutex_init(&profiler_ctx->drain_mutex);
+    lv_thread_sync_init(&profiler_ctx->drain_sync);
+#endif
+
     lv_profiler_builtin_set_enable(true);
 
-    LV_LOG_INFO("init OK, item_num = %d", (int)num);
+    LV_LOG_INFO("init OK, ring_num = %d, item_num = %d", (int)ring_num, (int)num);
 }
 
 void lv_profiler_builtin_uninit(void)
 {
     LV_ASSERT_NULL(profiler_ctx);
+
+#if LV_USE_OS
+    if(profiler_ctx->drain_thread_created) {
+        profiler_ctx->drain_exit = true;
+        lv_thread_sync_signal(&profiler_ctx->drain_sync);
+        lv_thread_delete(&profiler_ctx->drain_thread);
+    }
+    lv_thread_sync_delete(&profiler_ctx->drain_sync);
+    lv_mutex_delete(&profiler_ctx->drain_mutex);
+#endif
+
     LV_PROFILER_MULTEX_DEINIT;
-    lv_free(profiler_ctx->item_arr);
+    lv_rb_destroy(&profiler_ctx->str_tree);
+    lv_free(profiler_ctx->ring_arr[0].item_arr);
+    lv_free(profiler_ctx->ring_arr);
     lv_free(profiler_ctx);
     profiler_ctx = NULL;
 }
@@ -168,9 +292,29 @@ void lv_profiler_builtin_flush(void)
 {
     LV_ASSERT_NULL(profiler_ctx);
 
-    LV_PROFILER_MULTEX_LOCK;
-    flush_no_lock();
-    LV_PROFILER_MULTEX_UNLOCK;
+    drain(profiler_ctx);
+}
+
+void lv_profiler_builtin_release_ring(void)
+{
+    if(!profiler_ctx || profiler_ctx->shared_ring) {
+        return;
+    }
+
+#if LV_USE_OS
+    lv_profiler_builtin_ctx_t * ctx = profiler_ctx;
+    lv_profiler_builtin_ring_t * ring = find_ring(ctx, ctx->config.tid_get_cb());
+    if(ring == NULL) {
+        return;
+    }
+
+    /*Output the remaining items before another thread can get the ring*/
+    drain(ctx);
+
+    lv_mutex_lock(&ctx->mutex);
+    ring->in_use = false;
+    lv_mutex_unlock(&ctx->mutex);
+#endif
 }
 
 void lv_profiler_builtin_write(const char * func, char tag)
@@ -182,26 +326,55 @@ void lv_profiler_builtin_write(const char * func, char tag)
         return;
     }
 
-    LV_PROFILER_MULTEX_LOCK;
+    lv_profiler_builtin_ring_t * ring = get_ring(profiler_ctx);
+    if(ring == NULL) {
+        return;
+    }
+
+    if(profiler_ctx->shared_ring) {
+        LV_PROFILER_MULTEX_LOCK;
+    }
 
-    if(profiler_ctx->cur_index >= profiler_ctx->item_num) {
-        flush_no_lock();
-        profiler_ctx->cur_index = 0;
+    uint32_t head = ring->head;
+    uint32_t used = head - LV_PROFILER_LOAD_ACQUIRE(&ring->tail);
+    if(used >= profiler_ctx->item_num) {
+        if(profiler_ctx->shared_ring && !profiler_ctx->draining) {
+            /*The other threads wait for the mutex anyway, so flush the ring right here*/
+            drain(profiler_ctx);
+            used = 0;
+        }
+        else {
+            /*Never wait for the drain thread of a per-thread ring, just count the lost item*/
+            LV_PROFILER_STORE_RELEASE(&ring->dropped, ring->dropped + 1);
+            if(profiler_ctx->shared_ring) {
+                LV_PROFILER_MULTEX_UNLOCK;
+            }
+            return;
+        }
     }
 
-    lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[profiler_ctx->cur_index];
+    lv_profiler_builtin_item_t * item = &ring->item_arr[head & (profiler_ctx->item_num - 1)];
     item->func = func;
     item->tag = tag;
     item->tick = profiler_ctx->config.tick_get_cb();
 
 #if LV_USE_OS
-    item->tid = profiler_ctx->config.tid_get_cb();
     item->cpu = profiler_ctx->config.cpu_get_cb();
 #endif
 
-    profiler_ctx->cur_index++;
+    LV_PROFILER_STORE_RELEASE(&ring->head, head + 1);
 
-    LV_PROFILER_MULTEX_UNLOCK;
+    if(profiler_ctx->shared_ring) {
+        LV_PROFILER_MULTEX_UNLOCK;
+    }
+
+#if LV_USE_OS
+    /*Wake up the drain thread when the ring is half full. The sync object remembers the signal
+     *so it's enough to send it only once per filling*/
+    if(used + 1 == profiler_ctx->item_num / 2) {
+        drain_thread_signal(profiler_ctx);
+    }
+#endif
 }
 
 /**********************
@@ -223,40 +396,262 @@ static int default_cpu_get_cb(void)
     return 0;
 }
 
-static void flush_no_lock(void)
+static lv_profiler_builtin_ring_t * get_ring(lv_profiler_builtin_ctx_t * ctx)
 {
-    if(!profiler_ctx->config.flush_cb) {
+    if(ctx->shared_ring) {
+        return &ctx->ring_arr[0];
+    }
+
+#if LV_USE_OS
+    int tid = ctx->config.tid_get_cb();
+    lv_profiler_builtin_ring_t * ring = find_ring(ctx, tid);
+    if(ring) return ring;
+
+    /*First item of this thread: assign it a released or a new ring*/
+    lv_mutex_lock(&ctx->mutex);
+    uint32_t i;
+    for(i = 0; i < ctx->ring_cnt; i++) {
+        if(!ctx->ring_arr[i].in_use) {
+            ring = &ctx->ring_arr[i];
+            break;
+        }
+    }
+
+    if(ring == NULL && ctx->ring_cnt < ctx->ring_num) {
+        ring = &ctx->ring_arr[ctx->ring_cnt];
+        LV_PROFILER_STORE_RELEASE(&ctx->ring_cnt, ctx->ring_cnt + 1);
+    }
+
+    if(ring) {
+        ring->tid = tid;
+        ring->in_use = true;
+    }
+    else {
+        /*More threads than `thread_max`: count the lost item*/
+        LV_PROFILER_STORE_RELEASE(&ctx->dropped, ctx->dropped + 1);
+    }
+    lv_mutex_unlock(&ctx->mutex);
+
+    return ring;
+#else
+    return NULL;
+#endif
+}
+
+#if LV_USE_OS
+static lv_profiler_builtin_ring_t * find_ring(lv_profiler_builtin_ctx_t * ctx, int tid)
+{
+    /*A ring is released only by its own thread, so the thread can find its ring without locking*/
+    uint32_t cnt = LV_PROFILER_LOAD_ACQUIRE(&ctx->ring_cnt);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_profiler_builtin_ring_t * ring = &ctx->ring_arr[i];
+        if(ring->in_use && ring->tid == tid) return ring;
+    }
+
+    return NULL;
+}
+#endif
+
+static void drain(lv_profiler_builtin_ctx_t * ctx)
+{
+    /*The writers of the shared ring hold `mutex` when they drain a full ring,
+     *so take it first here too to keep the locking order*/
+    if(ctx->shared_ring) {
+        LV_PROFILER_MULTEX_LOCK;
+    }
+#if LV_USE_OS
+    lv_mutex_lock(&ctx->drain_mutex);
+#endif
+    ctx->draining = true;
+
+    if(!ctx->config.flush_cb && !ctx->config.flush_bin_cb) {
         LV_LOG_WARN("flush_cb is not registered");
-        return;
     }
 
-    uint32_t cur = 0;
+    uint32_t cnt = LV_PROFILER_LOAD_ACQUIRE(&ctx->ring_cnt);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_profiler_builtin_ring_t * ring = &ctx->ring_arr[i];
+        uint32_t head = LV_PROFILER_LOAD_ACQUIRE(&ring->head);
+        uint32_t tail = ring->tail;
+        while(tail != head) {
+            lv_profiler_builtin_item_t * item = &ring->item_arr[tail & (ctx->item_num - 1)];
+            if(ctx->config.flush_cb) write_text(ctx, ring, item);
+            if(ctx->config.flush_bin_cb) write_bin(ctx, ring, item);
+            tail++;
+        }
+
+        /*Give back the space to the writer*/
+        LV_PROFILER_STORE_RELEASE(&ring->tail, tail);
+
+        uint32_t dropped = LV_PROFILER_LOAD_ACQUIRE(&ring->dropped);
+        if(dropped != ring->dropped_reported) {
+            LV_LOG_WARN("%" LV_PRIu32 " items of thread %d were dropped, increase buf_size",
+                        dropped - ring->dropped_reported, ring->tid);
+            if(ctx->config.flush_bin_cb) {
+                write_bin_record(ctx, 'D', 0, 0, ring->tid, dropped - ring->dropped_reported);
+            }
+            ring->dropped_reported = dropped;
+        }
+    }
+
+    uint32_t dropped = LV_PROFILER_LOAD_ACQUIRE(&ctx->dropped);
+    if(dropped != ctx->dropped_reported) {
+        LV_LOG_WARN("%" LV_PRIu32 " items of threads without a ring were dropped, increase thread_max",
+                    dropped - ctx->dropped_reported);
+        if(ctx->config.flush_bin_cb) {
+            write_bin_record(ctx, 'D', 0, 0, -1, dropped - ctx->dropped_reported);
+        }
+        ctx->dropped_reported = dropped;
+    }
+
+    bin_flush(ctx);
+
+    ctx->draining = false;
+#if LV_USE_OS
+    lv_mutex_unlock(&ctx->drain_mutex);
+#endif
+    if(ctx->shared_ring) {
+        LV_PROFILER_MULTEX_UNLOCK;
+    }
+}
+
+static void write_text(lv_profiler_builtin_ctx_t * ctx, const lv_profiler_builtin_ring_t * ring,
+                       const lv_profiler_builtin_item_t * item)
+{
     char buf[LV_PROFILER_STR_MAX_LEN];
-    uint32_t tick_per_sec = profiler_ctx->config.tick_per_sec;
-    while(cur < profiler_ctx->cur_index) {
-        lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[cur++];
-        uint32_t sec = item->tick / tick_per_sec;
-        uint32_t usec = (item->tick % tick_per_sec) * (LV_PROFILER_TICK_PER_SEC_MAX / tick_per_sec);
+    uint32_t tick_per_sec = ctx->config.tick_per_sec;
+    uint32_t sec = item->tick / tick_per_sec;
+    uint32_t usec = (item->tick % tick_per_sec) * (LV_PROFILER_TICK_PER_SEC_MAX / tick_per_sec);
+
+#if LV_USE_OS
+    lv_snprintf(buf, sizeof(buf),
+                "   LVGL-%d [%d] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
+                ring->tid,
+                item->cpu,
+                sec,
+                usec,
+                item->tag,
+                item->func);
+#else
+    LV_UNUSED(ring);
+    lv_snprintf(buf, sizeof(buf),
+                "   LVGL-1 [0] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
+                sec,
+                usec,
+                item->tag,
+                item->func);
+#endif
+    ctx->config.flush_cb(buf);
+}
+
+static void write_bin(lv_profiler_builtin_ctx_t * ctx, const lv_profiler_builtin_ring_t * ring,
+                      const lv_profiler_builtin_item_t * item)
+{
+    /*Write every function name only once and refer to it by ID later*/
+    lv_profiler_builtin_str_t key = {.func = item->func};
+    lv_rb_node_t * node = lv_rb_find(&ctx->str_tree, &key);
+    if(node == NULL) {
+        if(ctx->str_cnt >= LV_PROFILER_BIN_STR_ID_MAX) {
+            LV_LOG_WARN("too many function names, %s is skipped", item->func);
+            return;
+        }
+
+        node = lv_rb_insert(&ctx->str_tree, &key);
+        if(node == NULL) return;
+
+        key.id = (uint16_t)ctx->str_cnt++;
+        lv_memcpy(node->data, &key, sizeof(key));
+
+        uint32_t len = LV_MIN(lv_strlen(item->func), 255);
+        uint8_t rec[4] = {'S', (uint8_t)len, (uint8_t)(key.id & 0xFF), (uint8_t)(key.id >> 8)};
+        bin_append(ctx, rec, sizeof(rec));
+        bin_append(ctx, item->func, len);
+    }
 
+    const lv_profiler_builtin_str_t * str = node->data;
 #if LV_USE_OS
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-%d [%d] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
-                    item->tid,
-                    item->cpu,
-                    sec,
-                    usec,
-                    item->tag,
-                    item->func);
+    uint8_t cpu = (uint8_t)item->cpu;
 #else
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-1 [0] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
-                    sec,
-                    usec,
-                    item->tag,
-                    item->func);
+    uint8_t cpu = 0;
 #endif
-        profiler_ctx->config.flush_cb(buf);
+    write_bin_record(ctx, item->tag, cpu, str->id, ring->tid, item->tick);
+}
+
+static void write_bin_record(lv_profiler_builtin_ctx_t * ctx, char type, uint8_t cpu, uint16_t id, int32_t tid,
+                             uint32_t value)
+{
+    /*type (1 byte), cpu (1 byte), string ID (2 bytes), thread ID (4 bytes), tick or count (4 bytes)*/
+    uint8_t rec[12];
+    rec[0] = (uint8_t)type;
+    rec[1] = cpu;
+    lv_memcpy(&rec[2], &id, sizeof(id));
+    lv_memcpy(&rec[4], &tid, sizeof(tid));
+    lv_memcpy(&rec[8], &value, sizeof(value));
+    bin_append(ctx, rec, sizeof(rec));
+}
+
+static void bin_append(lv_profiler_builtin_ctx_t * ctx, const void * data, uint32_t size)
+{
+    if(ctx->bin_len + size > LV_PROFILER_BIN_BUF_SIZE) {
+        bin_flush(ctx);
     }
+
+    lv_memcpy(ctx->bin_buf + ctx->bin_len, data, size);
+    ctx->bin_len += size;
 }
 
+static void bin_flush(lv_profiler_builtin_ctx_t * ctx)
+{
+    if(ctx->bin_len == 0) return;
+
+    if(ctx->config.flush_bin_cb) {
+        ctx->config.flush_bin_cb(ctx->bin_buf, ctx->bin_len);
+    }
+
+    ctx->bin_len = 0;
+}
+
+static lv_rb_compare_res_t str_compare_cb(const void * a, const void * b)
+{
+    const lv_profiler_builtin_str_t * sa = a;
+    const lv_profiler_builtin_str_t * sb = b;
+    if(sa->func == sb->func) return 0;
+    return (lv_uintptr_t)sa->func < (lv_uintptr_t)sb->func ? -1 : 1;
+}
+
+#if LV_USE_OS
+static void drain_thread_signal(lv_profiler_builtin_ctx_t * ctx)
+{
+    /*Create the drain thread only when a ring gets half full for the first time*/
+    lv_mutex_lock(&ctx->mutex);
+    if(!ctx->drain_thread_created) {
+        lv_result_t res = lv_thread_init(&ctx->drain_thread, LV_THREAD_PRIO_LOW, drain_thread_cb,
+                                         LV_DRAW_THREAD_STACK_SIZE, ctx);
+        ctx->drain_thread_created = res == LV_RESULT_OK;
+    }
+    bool created = ctx->drain_thread_created;
+    lv_mutex_unlock(&ctx->mutex);
+
+    if(created) {
+        lv_thread_sync_signal(&ctx->drain_sync);
+    }
+}
+
+static void drain_thread_cb(void * user_data)
+{
+    lv_profiler_builtin_ctx_t * ctx = user_data;
+
+    while(1) {
+        lv_thread_sync_wait(&ctx->drain_sync);
+        if(ctx->drain_exit) break;
+
+        drain(ctx);
+    }
+
+    lv_mem_thread_cache_flush();
+}
+#endif
+
 #endif /*LV_USE_PROFILER_BUILTIN*/
@@ -65,6 +65,12 @@ void lv_profiler_builtin_set_enable(bool enable);
  */
 void lv_profiler_builtin_flush(void);
 
+/**
+ * @brief Release the buffer of the calling thread so that another thread can use it.
+ *        The threads created by `lv_thread_init` call it automatically when they return.
+ */
+void lv_profiler_builtin_release_ring(void);
+
 /**
  * @brief Write the profiling data for a function with the given tag
  * @param func Name of the function being profiled
@@ -30,12 +30,16 @@ extern "C" {
  * @brief LVGL profiler built-in configuration structure
  */
 struct lv_profiler_builtin_config_t {
-    size_t buf_size;                    /**< The size of the buffer used for profiling data */
+    size_t buf_size;                    /**< The size of the buffer used for profiling data, shared by the threads */
     uint32_t tick_per_sec;              /**< The number of ticks per second */
     uint32_t (*tick_get_cb)(void);      /**< Callback function to get the current tick count */
-    void (*flush_cb)(const char * buf); /**< Callback function to flush the profiling data */
+    void (*flush_cb)(const char * buf); /**< Callback function to flush the profiling data as text */
+    void (*flush_bin_cb)(const void * buf, uint32_t size); /**< Callback function to flush the profiling data in
+                                                                 *   binary format. Can be NULL. */
     int (*tid_get_cb)(void);            /**< Callback function to get the current thread ID */
     int (*cpu_get_cb)(void);            /**< Callback function to get the current CPU */
+    uint32_t thread_max;                /**< Number of threads having their own buffer. Used only if
+                                         *   `tid_get_cb` returns real thread IDs. */
 };
 
 
@@ -250,6 +250,9 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
     if(style->prop_cnt == 0)  return false;
 
+    /*The new array is built without the index*/
+    style->is_frozen = 0;
+
     uint8_t * tmp = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
     uint8_t * old_props = (uint8_t *)tmp;
     uint32_t i;
@@ -314,6 +317,9 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     if(values_and_props == NULL) return;
     style->values_and_props = values_and_props;
 
+    /*The index will be overwritten by the shifted props. Only the sorting remains which doesn't matter*/
+    style->is_frozen = 0;
+
     props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
     /*Shift all props to make place for the value before them*/
     for(i = style->prop_cnt - 1; i >= 0; i--) {
@@ -333,6 +339,55 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     style->has_group |= (uint32_t)1 << group;
 }
 
+void lv_style_freeze(lv_style_t * style)
+{
+    LV_ASSERT_STYLE(style);
+
+    if(lv_style_is_const(style) || style->is_frozen || style->prop_cnt == 0) return;
+
+    uint32_t prop_cnt = style->prop_cnt;
+    size_t index_ofs = prop_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+    index_ofs = (index_ofs + 3) & ~(size_t)3;
+
+    uint8_t * values_and_props = lv_malloc_zeroed(index_ofs + sizeof(lv_style_frozen_index_t));
+    LV_ASSERT_MALLOC(values_and_props);
+    if(values_and_props == NULL) return;
+
+    lv_style_value_t * old_values = (lv_style_value_t *)style->values_and_props;
+    lv_style_prop_t * old_props = (lv_style_prop_t *)style->values_and_props + prop_cnt * sizeof(lv_style_value_t);
+    lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+    lv_style_prop_t * props = values_and_props + prop_cnt * sizeof(lv_style_value_t);
+    lv_style_frozen_index_t * index = (lv_style_frozen_index_t *)(values_and_props + index_ofs);
+
+    /*Insertion sort by property ID. There are only a few properties in a style*/
+    uint32_t i;
+    for(i = 0; i < prop_cnt; i++) {
+        int32_t j = i - 1;
+        while(j >= 0 && props[j] > old_props[i]) {
+            props[j + 1] = props[j];
+            values[j + 1] = values[j];
+            j--;
+        }
+        props[j + 1] = old_props[i];
+        values[j + 1] = old_values[i];
+    }
+
+    for(i = 0; i < prop_cnt; i++) {
+        if(props[i] >= LV_STYLE_NUM_BUILT_IN_PROPS) break;
+        index->bitmap[props[i] >> 5] |= (uint32_t)1 << (props[i] & 0x1F);
+    }
+
+    uint32_t rank = 0;
+    for(i = 0; i < LV_STYLE_FROZEN_BITMAP_WORDS; i++) {
+        index->rank[i] = (uint8_t)rank;
+        rank += lv_style_bit_count(index->bitmap[i]);
+    }
+
+    lv_free(style->values_and_props);
+    style->values_and_props = values_and_props;
+    style->is_frozen = 1;
+}
+
 lv_style_res_t lv_style_get_prop(const lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value)
 {
     return lv_style_get_prop_inlined(style, prop, value);
@@ -68,6 +68,9 @@ LV_EXPORT_CONST_INT(LV_SCALE_NONE);
 
 #define LV_STYLE_CONST_PROPS_END { .prop = LV_STYLE_PROP_INV, .value = { .num = 0 } }
 
+/** Number of 32 bit words needed to store 1 bit for each built-in property*/
+#define LV_STYLE_FROZEN_BITMAP_WORDS ((LV_STYLE_NUM_BUILT_IN_PROPS + 31) / 32)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -374,8 +377,18 @@ typedef struct {
 
     uint32_t has_group;
     uint8_t prop_cnt;   /**< 255 means it's a constant style*/
+    uint8_t is_frozen;  /**< 1: the properties are sorted and indexed. See ::lv_style_freeze*/
 } lv_style_t;
 
+/**
+ * Index stored after the values and properties of a frozen style.
+ * The index of a property's value is the number of set bits before the property's bit.
+ */
+typedef struct {
+    uint32_t bitmap[LV_STYLE_FROZEN_BITMAP_WORDS];  /**< 1 bit for each built-in property*/
+    uint8_t rank[LV_STYLE_FROZEN_BITMAP_WORDS];     /**< Number of set bits in the previous words*/
+} lv_style_frozen_index_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -406,6 +419,25 @@ static inline bool lv_style_is_const(const lv_style_t * style)
     return false;
 }
 
+/**
+ * Sort and index the properties of a style to make getting a property O(1).
+ * Should be called when all the properties are set.
+ * Setting a new property or removing one makes the style a normal style again.
+ * @param style pointer to a style
+ * @note Constant and empty styles are left unchanged
+ */
+void lv_style_freeze(lv_style_t * style);
+
+/**
+ * Check if a style is frozen
+ * @param style     pointer to a style
+ * @return          true: the style is frozen
+ */
+static inline bool lv_style_is_frozen(const lv_style_t * style)
+{
+    return style->is_frozen ? true : false;
+}
+
 /**
  * Register a new style property for custom usage
  * @return a new property ID, or LV_STYLE_PROP_INV if there are no more available.
@@ -484,6 +516,34 @@ void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style
  */
 lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 
+/**
+ * Get the index of a frozen style. It's stored after the values and properties aligned to 4 bytes.
+ * @param style     pointer to a frozen style
+ * @return          pointer to the index
+ */
+static inline const lv_style_frozen_index_t * lv_style_get_frozen_index(const lv_style_t * style)
+{
+    size_t ofs = style->prop_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+    ofs = (ofs + 3) & ~(size_t)3;
+    return (const lv_style_frozen_index_t *)((const uint8_t *)style->values_and_props + ofs);
+}
+
+/**
+ * Count the set bits in a 32 bit value
+ * @param v     the value
+ * @return      the number of 1 bits
+ */
+static inline uint32_t lv_style_bit_count(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcount(v);
+#else
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+#endif
+}
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -508,6 +568,18 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
         }
     }
     else {
+        /*Custom properties are not indexed, but they are sorted to the end so they can be found below*/
+        if(style->is_frozen && prop < LV_STYLE_NUM_BUILT_IN_PROPS) {
+            const lv_style_frozen_index_t * index = lv_style_get_frozen_index(style);
+            uint32_t word = index->bitmap[prop >> 5];
+            uint32_t bit = (uint32_t)1 << (prop & 0x1F);
+            if((word & bit) == 0) return LV_STYLE_RES_NOT_FOUND;
+
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            *value = values[index->rank[prop >> 5] + lv_style_bit_count(word & (bit - 1))];
+            return LV_STYLE_RES_FOUND;
+        }
+
         lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint32_t i;
         for(i = 0; i < style->prop_cnt; i++) {
@@ -12,7 +12,9 @@
 #include "../stdlib/lv_sprintf.h"
 #include "lv_assert.h"
 #include "lv_ll.h"
+#include "lv_math.h"
 #include "lv_profiler.h"
+#include "../others/telemetry/lv_telemetry_private.h"
 
 /*********************
  *      DEFINES
@@ -34,6 +36,11 @@
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+static void timer_update_deadline(lv_timer_t * timer);
+static bool timer_heap_insert(lv_timer_t * timer);
+static void timer_heap_remove(lv_timer_t * timer);
+static void timer_heap_sift_up(uint32_t i);
+static void timer_heap_sift_down(uint32_t i);
 
 /**********************
  *  STATIC VARIABLES
@@ -79,6 +86,7 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
 
     LV_PROFILER_BEGIN;
     lv_lock();
+    LV_TELEMETRY_TIMER_HANDLER_BEGIN();
 
     uint32_t handler_start = lv_tick_get();
 
@@ -90,43 +98,28 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
+    /*Collect the due timers from the top of the heap. They are popped in deadline order*/
+    lv_timer_t ** ready_tail = &state_p->ready_head;
+    while(state_p->heap_cnt > 0 && lv_timer_time_remaining(state_p->heap[0]) == 0) {
+        lv_timer_t * timer_ready = state_p->heap[0];
+        timer_heap_remove(timer_ready);
+        timer_ready->ready = 1;
+        timer_ready->next_ready = NULL;
+        *ready_tail = timer_ready;
+        ready_tail = &timer_ready->next_ready;
+    }
 
-            timer_active = next; /*Load the next timer*/
-        }
-    } while(timer_active);
+    /*Run them. Timers created, deleted or rescheduled meanwhile only change the heap or the ready list
+     *so each timer runs at most once in a call*/
+    while(state_p->ready_head) {
+        lv_timer_t * timer_active = state_p->ready_head;
+        state_p->ready_head = timer_active->next_ready;
+        timer_active->ready = 0;
+        lv_timer_exec(timer_active);
+    }
 
     uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
-        }
-
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
-    }
+    if(state_p->heap_cnt > 0) time_until_next = lv_timer_time_remaining(state_p->heap[0]);
 
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
@@ -141,6 +134,7 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
     state_p->already_running = false; /*Release the mutex*/
 
     LV_TRACE_TIMER("finished (%" LV_PRIu32 " ms until the next timer call)", time_until_next);
+    LV_TELEMETRY_TIMER_HANDLER_END();
     lv_unlock();
 
     LV_PROFILER_END;
@@ -175,11 +169,19 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->timer_cb = timer_xcb;
     new_timer->repeat_count = -1;
     new_timer->paused = 0;
+    new_timer->ready = 0;
+    new_timer->heap_index = -1;
+    new_timer->next_ready = NULL;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    timer_update_deadline(new_timer);
 
-    state.timer_created = true;
+    if(!timer_heap_insert(new_timer)) {
+        lv_ll_remove(timer_ll_p, new_timer);
+        lv_free(new_timer);
+        return NULL;
+    }
 
     lv_timer_handler_resume();
 
@@ -195,7 +197,15 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 void lv_timer_delete(lv_timer_t * timer)
 {
     lv_ll_remove(timer_ll_p, timer);
-    state.timer_deleted = true;
+    if(timer->heap_index >= 0) timer_heap_remove(timer);
+
+    if(timer->ready) {
+        lv_timer_t ** ready_p = &state.ready_head;
+        while(*ready_p != timer) ready_p = &(*ready_p)->next_ready;
+        *ready_p = timer->next_ready;
+    }
+
+    if(timer == state.timer_exec) state.timer_deleted = true;
 
     lv_free(timer);
 }
@@ -204,12 +214,19 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+
+    /*Paused timers are not scheduled so they can't be the next timer to run*/
+    if(timer->heap_index >= 0) timer_heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+
+    /*If it's ready or being executed it will be scheduled again after execution*/
+    if(timer->heap_index < 0 && !timer->ready && timer != state.timer_exec) timer_heap_insert(timer);
+
     lv_timer_handler_resume();
 }
 
@@ -217,18 +234,23 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    timer_update_deadline(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    timer_update_deadline(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     LV_ASSERT_NULL(timer);
     timer->repeat_count = repeat_count;
+
+    /*Make it due to delete or pause it in the next `lv_timer_handler()`*/
+    if(repeat_count == 0) lv_timer_ready(timer);
 }
 
 void lv_timer_set_auto_delete(lv_timer_t * timer, bool auto_delete)
@@ -247,6 +269,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    timer_update_deadline(timer);
     lv_timer_handler_resume();
 }
 
@@ -261,6 +284,12 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+    lv_free(state.heap);
+    state.heap = NULL;
+    state.heap_cnt = 0;
+    state.heap_size = 0;
+    state.ready_head = NULL;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -314,13 +343,16 @@ static bool lv_timer_exec(lv_timer_t * timer)
     if(timer->paused) return false;
 
     bool exec = false;
+    state.timer_deleted = false;
+    state.timer_exec = timer;
     if(lv_timer_time_remaining(timer) == 0) {
         /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
+         * If the timer is deleted `if(timer->repeat_count == 0)` is not executed below
          * but at least the repeat count is zero and the timer can be deleted in the next round*/
         int32_t original_repeat_count = timer->repeat_count;
         if(timer->repeat_count > 0) timer->repeat_count--;
         timer->last_run = lv_tick_get();
+        timer_update_deadline(timer);
         LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
 
         if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
@@ -335,6 +367,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
         LV_ASSERT_MEM_INTEGRITY();
         exec = true;
     }
+    state.timer_exec = NULL;
 
     if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
@@ -347,6 +380,9 @@ static bool lv_timer_exec(lv_timer_t * timer)
                 lv_timer_pause(timer);
             }
         }
+        else if(!timer->paused && timer->heap_index < 0) {
+            timer_heap_insert(timer);
+        }
     }
 
     return exec;
@@ -378,6 +414,118 @@ static void lv_timer_handler_resume(void)
     }
 }
 
+/**
+ * Update the deadline of a timer after its `last_run` or `period` has changed
+ * and restore the order of the heap.
+ * @param timer pointer to lv_timer
+ */
+static void timer_update_deadline(lv_timer_t * timer)
+{
+    /*Limit the period to keep the wrap around safe comparison of the deadlines valid*/
+    uint32_t period = LV_MIN(timer->period, (uint32_t)INT32_MAX);
+    timer->deadline = timer->last_run + period;
+
+    if(timer->heap_index >= 0) {
+        timer_heap_sift_up(timer->heap_index);
+        timer_heap_sift_down(timer->heap_index);
+    }
+}
+
+/**
+ * Compare the deadlines of two timers
+ * @param a     pointer to lv_timer
+ * @param b     pointer to lv_timer
+ * @return      true: `a` should run before `b`
+ */
+static inline bool timer_is_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    return (int32_t)(a->deadline - b->deadline) < 0;
+}
+
+/**
+ * Add a timer to the heap of the scheduled timers
+ * @param timer pointer to lv_timer
+ * @return      true: success; false: out of memory
+ */
+static bool timer_heap_insert(lv_timer_t * timer)
+{
+    if(state.heap_cnt == state.heap_size) {
+        uint32_t new_size = state.heap_size ? state.heap_size * 2 : 16;
+        lv_timer_t ** new_heap = lv_realloc(state.heap, new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) return false;
+        state.heap = new_heap;
+        state.heap_size = new_size;
+    }
+
+    timer->heap_index = state.heap_cnt;
+    state.heap[state.heap_cnt] = timer;
+    state.heap_cnt++;
+    timer_heap_sift_up(timer->heap_index);
+
+    return true;
+}
+
+/**
+ * Remove a timer from the heap of the scheduled timers
+ * @param timer pointer to lv_timer which is in the heap
+ */
+static void timer_heap_remove(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_index;
+    timer->heap_index = -1;
+    state.heap_cnt--;
+    if(i == state.heap_cnt) return;
+
+    /*Move the last timer to the place of the removed one*/
+    lv_timer_t * last = state.heap[state.heap_cnt];
+    state.heap[i] = last;
+    last->heap_index = i;
+    timer_heap_sift_up(i);
+    timer_heap_sift_down(last->heap_index);
+}
+
+/**
+ * Move a timer towards the root of the heap while its deadline is earlier than its parent's
+ * @param i     index of the timer in the heap
+ */
+static void timer_heap_sift_up(uint32_t i)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!timer_is_before(timer, heap[parent])) break;
+        heap[i] = heap[parent];
+        heap[i]->heap_index = i;
+        i = parent;
+    }
+    heap[i] = timer;
+    timer->heap_index = i;
+}
+
+/**
+ * Move a timer towards the leaves of the heap while a child's deadline is earlier
+ * @param i     index of the timer in the heap
+ */
+static void timer_heap_sift_down(uint32_t i)
+{
+    lv_timer_t ** heap = state.heap;
+    uint32_t cnt = state.heap_cnt;
+    lv_timer_t * timer = heap[i];
+    while(1) {
+        uint32_t child = i * 2 + 1;
+        if(child >= cnt) break;
+        if(child + 1 < cnt && timer_is_before(heap[child + 1], heap[child])) child++;
+        if(!timer_is_before(heap[child], timer)) break;
+        heap[i] = heap[child];
+        heap[i]->heap_index = i;
+        i = child;
+    }
+    heap[i] = timer;
+    timer->heap_index = i;
+}
+
 void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data)
 {
     state.resume_cb = cb;
@@ -33,17 +33,25 @@ struct lv_timer_t {
     lv_timer_cb_t timer_cb;    /**< Timer function */
     void * user_data;          /**< Custom user data */
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
+    uint32_t deadline;         /**< `last_run + period`, used to order the timers in the heap */
+    int32_t heap_index;        /**< Index in the heap of scheduled timers or -1 if not scheduled*/
+    lv_timer_t * next_ready;   /**< Next timer in the ready list of the running handler */
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
+    uint32_t ready : 1;        /**< 1: it's in the ready list of the running handler*/
 };
 
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
+    lv_timer_t ** heap;        /**< Binary min-heap of the not paused timers ordered by deadline*/
+    uint32_t heap_cnt;
+    uint32_t heap_size;
+    lv_timer_t * ready_head;   /**< Due timers collected by the running handler*/
 
     bool lv_timer_run;
     uint8_t idle_last;
-    bool timer_deleted;
-    bool timer_created;
+    bool timer_deleted;        /**< The timer being executed was deleted*/
+    lv_timer_t * timer_exec;   /**< The timer being executed*/
     uint32_t timer_time_until_next;
 
     bool already_running;
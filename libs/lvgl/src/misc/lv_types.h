@@ -143,6 +143,8 @@ typedef struct lv_image_decoder_args_t lv_image_decoder_args_t;
 
 typedef struct lv_image_cache_data_t lv_image_cache_data_t;
 
+typedef struct lv_image_cache_compressed_data_t lv_image_cache_compressed_data_t;
+
 typedef struct lv_image_header_cache_data_t lv_image_header_cache_data_t;
 
 typedef struct lv_draw_mask_t lv_draw_mask_t;
@@ -151,6 +153,8 @@ typedef struct lv_grad_t lv_grad_t;
 
 typedef struct lv_draw_label_hint_t lv_draw_label_hint_t;
 
+typedef struct lv_draw_label_layout_t lv_draw_label_layout_t;
+
 typedef struct lv_draw_glyph_dsc_t lv_draw_glyph_dsc_t;
 
 typedef struct lv_draw_image_sup_t lv_draw_image_sup_t;
@@ -161,6 +165,10 @@ typedef struct lv_obj_style_t lv_obj_style_t;
 
 typedef struct lv_obj_style_transition_dsc_t lv_obj_style_transition_dsc_t;
 
+typedef struct lv_obj_style_res_t lv_obj_style_res_t;
+
+typedef struct lv_obj_style_res_cache_t lv_obj_style_res_cache_t;
+
 typedef struct lv_hit_test_info_t lv_hit_test_info_t;
 
 typedef struct lv_cover_check_info_t lv_cover_check_info_t;
@@ -247,6 +255,8 @@ typedef struct lv_tileview_t lv_tileview_t;
 
 typedef struct lv_tileview_tile_t lv_tileview_tile_t;
 
+typedef struct lv_vlist_t lv_vlist_t;
+
 typedef struct lv_win_t lv_win_t;
 
 typedef struct lv_observer_t lv_observer_t;
@@ -20,6 +20,7 @@
 #include "../tick/lv_tick.h"
 #include "../misc/lv_log.h"
 #include "../core/lv_global.h"
+#include "lv_os_private.h"
 
 /*********************
  *      DEFINES
@@ -430,6 +431,9 @@ static void prvRunThread(void * pxArg)
     /* Run the thread routine. */
     pxThread->pvStartRoutine((void *)pxThread->pTaskArg);
 
+    /* Release the per-thread resources of LVGL. */
+    lv_os_thread_exit();
+
     vTaskDelete(NULL);
 }
 
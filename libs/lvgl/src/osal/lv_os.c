@@ -9,6 +9,8 @@
 #include "lv_os.h"
 #include "lv_os_private.h"
 #include "../core/lv_global.h"
+#include "../misc/lv_profiler_builtin.h"
+#include "../stdlib/lv_mem.h"
 
 /*********************
  *      DEFINES
@@ -42,6 +44,15 @@ void lv_os_init(void)
 #endif /*LV_USE_OS != LV_OS_NONE*/
 }
 
+void lv_os_thread_exit(void)
+{
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+    lv_profiler_builtin_release_ring();
+#endif
+
+    lv_mem_thread_cache_flush();
+}
+
 void lv_lock(void)
 {
 #if LV_USE_OS != LV_OS_NONE
@@ -35,6 +35,12 @@ extern "C" {
  */
 void lv_os_init(void);
 
+/**
+ * Release the per-thread resources of the calling thread.
+ * Called by the OS layers when the callback of a thread created by `lv_thread_init` returns.
+ */
+void lv_os_thread_exit(void);
+
 
 /**********************
  *      MACROS
@@ -12,6 +12,7 @@
 
 #include <errno.h>
 #include "../misc/lv_log.h"
+#include "lv_os_private.h"
 
 /*********************
  *      DEFINES
@@ -172,6 +173,7 @@ static void * generic_callback(void * user_data)
 {
     lv_thread_t * thread = user_data;
     thread->callback(thread->user_data);
+    lv_os_thread_exit();
     return NULL;
 }
 
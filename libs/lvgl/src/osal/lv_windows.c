@@ -12,6 +12,7 @@
 #if LV_USE_OS == LV_OS_WINDOWS
 
 #include <process.h>
+#include "lv_os_private.h"
 
 /*********************
  *      DEFINES
@@ -220,6 +221,7 @@ static unsigned __stdcall thread_start_routine(void * parameter)
     lv_thread_init_data_t * init_data = (lv_thread_init_data_t *)(parameter);
     if(init_data) {
         init_data->callback(init_data->user_data);
+        lv_os_thread_exit();
         free(init_data);
     }
 
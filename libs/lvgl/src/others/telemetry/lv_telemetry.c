@@ -0,0 +1,406 @@
+/**
+ * @file lv_telemetry.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_telemetry_private.h"
+
+#if LV_USE_TELEMETRY
+
+#include "../../core/lv_global.h"
+#include "../../display/lv_display_private.h"
+#include "../../draw/lv_draw_private.h"
+#include "../../stdlib/lv_mem.h"
+#include "../../stdlib/lv_string.h"
+#include "../../tick/lv_tick.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define telemetry_ctx ((lv_telemetry_t *)LV_GLOBAL_DEFAULT()->telemetry_context)
+
+/*Frames refreshed in an `lv_timer_handler()` are reported at its end to know its duration*/
+#define PENDING_FRAME_MAX   4
+
+/*Values below 8 have their own bucket, above it every power of 2 range is split into 4 buckets.
+ *So the relative error is at most 25% and 124 buckets cover the whole uint32_t range.*/
+#define EXACT_BUCKET_CNT    8
+#define SUB_BUCKET_CNT      4
+#define BUCKET_CNT          (EXACT_BUCKET_CNT + (32 - 3) * SUB_BUCKET_CNT)
+
+/*An extra histogram for the refreshed pixels after the phases*/
+#define HIST_DIRTY_PX       LV_TELEMETRY_PHASE_CNT
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define MEMORY_BARRIER() __sync_synchronize()
+#else
+    #define MEMORY_BARRIER()
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_display_t * disp;
+    lv_telemetry_frame_t frame;
+} pending_frame_t;
+
+typedef struct {
+    bool enabled;
+    lv_telemetry_time_cb_t time_cb;
+    lv_telemetry_frame_cb_t frame_cb;
+    void * frame_cb_user_data;
+    lv_telemetry_export_t * export_buf;
+
+    /*The frame being measured*/
+    bool frame_active;
+    lv_display_t * disp;
+    lv_telemetry_frame_t frame;
+    uint32_t phase_start[LV_TELEMETRY_PHASE_CNT];
+    uint32_t draw_unit_start[LV_TELEMETRY_DRAW_UNIT_MAX];
+    uint32_t frame_id;
+
+    bool in_timer_handler;
+    uint32_t timer_handler_start;
+    pending_frame_t pending[PENDING_FRAME_MAX];
+    uint32_t pending_cnt;
+
+    /*Statistics since the last reset*/
+    uint32_t frame_cnt;
+    uint32_t hist[LV_TELEMETRY_PHASE_CNT + 1][BUCKET_CNT];
+    uint32_t max[LV_TELEMETRY_PHASE_CNT + 1];
+    uint64_t sum[LV_TELEMETRY_PHASE_CNT + 1];
+} lv_telemetry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static uint32_t default_time_cb(void);
+static void report_frame(lv_display_t * disp, const lv_telemetry_frame_t * frame);
+static void hist_add(uint32_t hist_id, uint32_t value);
+static uint32_t hist_percentile(uint32_t hist_id, uint32_t permille);
+static uint32_t value_to_bucket(uint32_t value);
+static uint32_t bucket_to_value(uint32_t bucket);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_telemetry_init(void)
+{
+    lv_telemetry_t * ctx = lv_malloc_zeroed(sizeof(lv_telemetry_t));
+    LV_ASSERT_MALLOC(ctx);
+    if(ctx == NULL) return;
+
+    ctx->enabled = true;
+    ctx->time_cb = default_time_cb;
+    LV_GLOBAL_DEFAULT()->telemetry_context = ctx;
+}
+
+void lv_telemetry_deinit(void)
+{
+    lv_free(telemetry_ctx);
+    LV_GLOBAL_DEFAULT()->telemetry_context = NULL;
+}
+
+void lv_telemetry_set_enabled(bool en)
+{
+    if(telemetry_ctx == NULL) return;
+
+    telemetry_ctx->enabled = en;
+    if(!en) {
+        telemetry_ctx->frame_active = false;
+        telemetry_ctx->pending_cnt = 0;
+    }
+}
+
+bool lv_telemetry_is_enabled(void)
+{
+    return telemetry_ctx && telemetry_ctx->enabled;
+}
+
+void lv_telemetry_set_time_cb(lv_telemetry_time_cb_t cb)
+{
+    if(telemetry_ctx == NULL) return;
+
+    telemetry_ctx->time_cb = cb ? cb : default_time_cb;
+}
+
+void lv_telemetry_set_frame_cb(lv_telemetry_frame_cb_t cb, void * user_data)
+{
+    if(telemetry_ctx == NULL) return;
+
+    telemetry_ctx->frame_cb = cb;
+    telemetry_ctx->frame_cb_user_data = user_data;
+}
+
+void lv_telemetry_set_export_buffer(lv_telemetry_export_t * buf)
+{
+    if(telemetry_ctx == NULL) return;
+
+    telemetry_ctx->export_buf = buf;
+    if(buf) {
+        buf->seq++;
+        MEMORY_BARRIER();
+        lv_memzero(&buf->last_frame, sizeof(buf->last_frame));
+        lv_telemetry_get_summary(&buf->summary);
+        MEMORY_BARRIER();
+        buf->seq++;
+    }
+}
+
+void lv_telemetry_get_summary(lv_telemetry_summary_t * summary)
+{
+    LV_ASSERT_NULL(summary);
+    lv_memzero(summary, sizeof(lv_telemetry_summary_t));
+
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL || ctx->frame_cnt == 0) return;
+
+    summary->frame_cnt = ctx->frame_cnt;
+
+    uint32_t i;
+    for(i = 0; i < LV_TELEMETRY_PHASE_CNT; i++) {
+        summary->p50[i] = hist_percentile(i, 500);
+        summary->p99[i] = hist_percentile(i, 990);
+        summary->max[i] = ctx->max[i];
+        summary->avg[i] = (uint32_t)(ctx->sum[i] / ctx->frame_cnt);
+    }
+
+    summary->dirty_px_p50 = hist_percentile(HIST_DIRTY_PX, 500);
+    summary->dirty_px_p99 = hist_percentile(HIST_DIRTY_PX, 990);
+    summary->dirty_px_sum = ctx->sum[HIST_DIRTY_PX];
+}
+
+void lv_telemetry_reset(void)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL) return;
+
+    ctx->frame_cnt = 0;
+    lv_memzero(ctx->hist, sizeof(ctx->hist));
+    lv_memzero(ctx->max, sizeof(ctx->max));
+    lv_memzero(ctx->sum, sizeof(ctx->sum));
+}
+
+uint32_t lv_telemetry_get_time(void)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    return ctx ? ctx->time_cb() : 0;
+}
+
+void lv_telemetry_timer_handler_begin(void)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL || !ctx->enabled) return;
+
+    ctx->in_timer_handler = true;
+    ctx->timer_handler_start = ctx->time_cb();
+}
+
+void lv_telemetry_timer_handler_end(void)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL || !ctx->in_timer_handler) return;
+
+    ctx->in_timer_handler = false;
+    uint32_t elaps = ctx->time_cb() - ctx->timer_handler_start;
+
+    uint32_t i;
+    for(i = 0; i < ctx->pending_cnt; i++) {
+        ctx->pending[i].frame.phase_time[LV_TELEMETRY_PHASE_TIMER_HANDLER] = elaps;
+        report_frame(ctx->pending[i].disp, &ctx->pending[i].frame);
+    }
+    ctx->pending_cnt = 0;
+}
+
+void lv_telemetry_frame_begin(lv_display_t * disp)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL || !ctx->enabled) return;
+
+    lv_memzero(&ctx->frame, sizeof(ctx->frame));
+    ctx->frame_active = true;
+    ctx->disp = disp;
+    ctx->frame.timestamp = ctx->time_cb();
+
+    /*The draw units count their busy time continuously, so save where they are now*/
+    uint32_t i = 0;
+    lv_draw_unit_t * u = LV_GLOBAL_DEFAULT()->draw_info.unit_head;
+    while(u && i < LV_TELEMETRY_DRAW_UNIT_MAX) {
+        ctx->draw_unit_start[i] = u->telemetry_busy_time;
+        u = u->next;
+        i++;
+    }
+}
+
+void lv_telemetry_frame_rendered(lv_display_t * disp)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL || !ctx->frame_active || ctx->disp != disp) return;
+
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i] == 0) ctx->frame.dirty_area_cnt++;
+    }
+
+    ctx->frame.dirty_px_cnt = disp->refr_px_cnt;
+}
+
+void lv_telemetry_frame_end(lv_display_t * disp)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL || !ctx->frame_active || ctx->disp != disp) return;
+
+    ctx->frame_active = false;
+
+    /*Nothing was drawn so there is nothing interesting to report*/
+    if(ctx->frame.dirty_area_cnt == 0) return;
+
+    lv_telemetry_frame_t * frame = &ctx->frame;
+    frame->phase_time[LV_TELEMETRY_PHASE_REFR] = ctx->time_cb() - frame->timestamp;
+    frame->frame_id = ctx->frame_id++;
+
+    uint32_t i = 0;
+    lv_draw_unit_t * u = LV_GLOBAL_DEFAULT()->draw_info.unit_head;
+    while(u && i < LV_TELEMETRY_DRAW_UNIT_MAX) {
+        frame->draw_unit_time[i] = u->telemetry_busy_time - ctx->draw_unit_start[i];
+        u = u->next;
+        i++;
+    }
+    frame->draw_unit_cnt = i;
+
+    if(ctx->in_timer_handler && ctx->pending_cnt < PENDING_FRAME_MAX) {
+        ctx->pending[ctx->pending_cnt].disp = disp;
+        ctx->pending[ctx->pending_cnt].frame = *frame;
+        ctx->pending_cnt++;
+    }
+    else {
+        /*Refreshed directly, e.g. by `lv_refr_now()`*/
+        report_frame(disp, frame);
+    }
+}
+
+void lv_telemetry_phase_begin(lv_telemetry_phase_t phase)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL || !ctx->frame_active) return;
+
+    ctx->phase_start[phase] = ctx->time_cb();
+}
+
+void lv_telemetry_phase_end(lv_telemetry_phase_t phase)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL || !ctx->frame_active) return;
+
+    ctx->frame.phase_time[phase] += ctx->time_cb() - ctx->phase_start[phase];
+}
+
+void lv_telemetry_draw_task_added(void)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    if(ctx == NULL || !ctx->frame_active) return;
+
+    ctx->frame.draw_task_cnt++;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t default_time_cb(void)
+{
+    return lv_tick_get() * 1000;
+}
+
+static void report_frame(lv_display_t * disp, const lv_telemetry_frame_t * frame)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+
+    ctx->frame_cnt++;
+    uint32_t i;
+    for(i = 0; i < LV_TELEMETRY_PHASE_CNT; i++) {
+        hist_add(i, frame->phase_time[i]);
+    }
+    hist_add(HIST_DIRTY_PX, frame->dirty_px_cnt);
+
+    lv_telemetry_export_t * buf = ctx->export_buf;
+    if(buf) {
+        /*Let the readers know that the data is being changed*/
+        buf->seq++;
+        MEMORY_BARRIER();
+        buf->last_frame = *frame;
+        lv_telemetry_get_summary(&buf->summary);
+        MEMORY_BARRIER();
+        buf->seq++;
+    }
+
+    if(ctx->frame_cb) ctx->frame_cb(disp, frame, ctx->frame_cb_user_data);
+}
+
+static void hist_add(uint32_t hist_id, uint32_t value)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+    ctx->hist[hist_id][value_to_bucket(value)]++;
+    ctx->sum[hist_id] += value;
+    if(value > ctx->max[hist_id]) ctx->max[hist_id] = value;
+}
+
+static uint32_t hist_percentile(uint32_t hist_id, uint32_t permille)
+{
+    lv_telemetry_t * ctx = telemetry_ctx;
+
+    /*The rank of the searched value, at least the first one*/
+    uint64_t rank = ((uint64_t)ctx->frame_cnt * permille + 999) / 1000;
+    if(rank == 0) rank = 1;
+
+    uint64_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < BUCKET_CNT; i++) {
+        cnt += ctx->hist[hist_id][i];
+        if(cnt >= rank) break;
+    }
+
+    /*Report the upper end of the bucket but not more than the max. value*/
+    if(i >= BUCKET_CNT) return ctx->max[hist_id];
+    return LV_MIN(bucket_to_value(i), ctx->max[hist_id]);
+}
+
+static uint32_t value_to_bucket(uint32_t value)
+{
+    if(value < EXACT_BUCKET_CNT) return value;
+
+    uint32_t msb = 3;
+    while(value >> (msb + 1)) msb++;
+
+    uint32_t sub = (value >> (msb - 2)) & (SUB_BUCKET_CNT - 1);
+    return EXACT_BUCKET_CNT + (msb - 3) * SUB_BUCKET_CNT + sub;
+}
+
+static uint32_t bucket_to_value(uint32_t bucket)
+{
+    if(bucket < EXACT_BUCKET_CNT) return bucket;
+
+    uint32_t msb = 3 + (bucket - EXACT_BUCKET_CNT) / SUB_BUCKET_CNT;
+    uint32_t sub = (bucket - EXACT_BUCKET_CNT) % SUB_BUCKET_CNT;
+    uint64_t upper = ((uint64_t)(SUB_BUCKET_CNT + sub + 1) << (msb - 2)) - 1;
+    return upper > UINT32_MAX ? UINT32_MAX : (uint32_t)upper;
+}
+
+#endif /*LV_USE_TELEMETRY*/
@@ -0,0 +1,153 @@
+/**
+ * @file lv_telemetry.h
+ *
+ */
+
+#ifndef LV_TELEMETRY_H
+#define LV_TELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+
+#if LV_USE_TELEMETRY
+
+#include "../../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Max. number of draw units whose busy time is reported*/
+#define LV_TELEMETRY_DRAW_UNIT_MAX  8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The measured phases of a frame*/
+typedef enum {
+    LV_TELEMETRY_PHASE_TIMER_HANDLER,   /**< The `lv_timer_handler()` call which refreshed the display*/
+    LV_TELEMETRY_PHASE_REFR,            /**< The whole refresh of the display*/
+    LV_TELEMETRY_PHASE_LAYOUT,          /**< Updating the layouts*/
+    LV_TELEMETRY_PHASE_JOIN,            /**< Joining the invalidated areas and syncing the buffers*/
+    LV_TELEMETRY_PHASE_DRAW_CREATE,     /**< Walking the Widgets and creating the draw tasks.
+                                         *   Contains the rendering if the draw units are not in threads.*/
+    LV_TELEMETRY_PHASE_RENDER,          /**< Waiting for the draw units to finish the draw tasks*/
+    LV_TELEMETRY_PHASE_FLUSH,           /**< Calling `flush_cb` and waiting for the flush to be ready*/
+    LV_TELEMETRY_PHASE_CNT,
+} lv_telemetry_phase_t;
+
+/** Measurements of a single frame. The times are in microseconds.*/
+typedef struct {
+    uint32_t frame_id;                                  /**< Incremented for every frame*/
+    uint32_t timestamp;                                 /**< Start of the refresh*/
+    uint32_t phase_time[LV_TELEMETRY_PHASE_CNT];        /**< Time spent in each phase*/
+    uint32_t draw_unit_time[LV_TELEMETRY_DRAW_UNIT_MAX]; /**< Busy time of the draw units in their list order*/
+    uint32_t draw_unit_cnt;                             /**< Number of valid elements in `draw_unit_time`*/
+    uint32_t draw_task_cnt;                             /**< Number of created draw tasks*/
+    uint32_t dirty_area_cnt;                            /**< Number of refreshed areas after joining*/
+    uint32_t dirty_px_cnt;                              /**< Number of refreshed pixels*/
+} lv_telemetry_frame_t;
+
+/** Statistics of the frames since the last reset. The times are in microseconds.*/
+typedef struct {
+    uint32_t frame_cnt;                                 /**< Number of measured frames*/
+    uint32_t p50[LV_TELEMETRY_PHASE_CNT];               /**< Median of the phase times*/
+    uint32_t p99[LV_TELEMETRY_PHASE_CNT];               /**< 99th percentile of the phase times*/
+    uint32_t max[LV_TELEMETRY_PHASE_CNT];               /**< Maximum of the phase times*/
+    uint32_t avg[LV_TELEMETRY_PHASE_CNT];               /**< Average of the phase times*/
+    uint32_t dirty_px_p50;                              /**< Median of the refreshed pixels per frame*/
+    uint32_t dirty_px_p99;                              /**< 99th percentile of the refreshed pixels per frame*/
+    uint64_t dirty_px_sum;                              /**< All the refreshed pixels*/
+} lv_telemetry_summary_t;
+
+/**
+ * Layout of the memory updated after every frame by `lv_telemetry_set_export_buffer()`.
+ * It can be placed in shared memory and read by another process:
+ * read `seq`, copy the data, and read `seq` again. The copy is consistent if both
+ * values are the same even number.
+ */
+typedef struct {
+    volatile uint32_t seq;              /**< Odd while the data is being updated*/
+    lv_telemetry_frame_t last_frame;    /**< The last measured frame*/
+    lv_telemetry_summary_t summary;     /**< Statistics including `last_frame`*/
+} lv_telemetry_export_t;
+
+/**
+ * Called after every measured frame
+ * @param disp          the refreshed display
+ * @param frame         the measurements of the frame
+ * @param user_data     the `user_data` passed to `lv_telemetry_set_frame_cb()`
+ */
+typedef void (*lv_telemetry_frame_cb_t)(lv_display_t * disp, const lv_telemetry_frame_t * frame, void * user_data);
+
+/**
+ * Get the current time in microseconds. Can be called from any thread.
+ */
+typedef uint32_t (*lv_telemetry_time_cb_t)(void);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Enable or disable the collection of the frame measurements. Enabled by default.
+ * @param en    true: enable; false: disable
+ */
+void lv_telemetry_set_enabled(bool en);
+
+/**
+ * Tell if the collection of the frame measurements is enabled
+ * @return      true: enabled
+ */
+bool lv_telemetry_is_enabled(void);
+
+/**
+ * Set a microsecond time source. By default `lv_tick_get() * 1000` is used
+ * which is too coarse to measure the short phases.
+ * @param cb    the callback to get the time or NULL to use the default
+ */
+void lv_telemetry_set_time_cb(lv_telemetry_time_cb_t cb);
+
+/**
+ * Set a callback to call after every measured frame
+ * @param cb            the callback or NULL to remove it
+ * @param user_data     custom data to pass to the callback
+ */
+void lv_telemetry_set_frame_cb(lv_telemetry_frame_cb_t cb, void * user_data);
+
+/**
+ * Set a memory area to keep updated with the last frame and the summary after every frame.
+ * @param buf   pointer to the memory area (e.g. shared memory) or NULL to stop updating it
+ */
+void lv_telemetry_set_export_buffer(lv_telemetry_export_t * buf);
+
+/**
+ * Calculate the statistics of the frames measured since the last reset
+ * @param summary   store the result here
+ */
+void lv_telemetry_get_summary(lv_telemetry_summary_t * summary);
+
+/**
+ * Clear the histograms of the summary
+ */
+void lv_telemetry_reset(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_TELEMETRY*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TELEMETRY_H*/
@@ -0,0 +1,128 @@
+/**
+ * @file lv_telemetry_private.h
+ *
+ */
+
+#ifndef LV_TELEMETRY_PRIVATE_H
+#define LV_TELEMETRY_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_telemetry.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if LV_USE_TELEMETRY
+    #define LV_TELEMETRY_TIMER_HANDLER_BEGIN()  lv_telemetry_timer_handler_begin()
+    #define LV_TELEMETRY_TIMER_HANDLER_END()    lv_telemetry_timer_handler_end()
+    #define LV_TELEMETRY_FRAME_BEGIN(disp)      lv_telemetry_frame_begin(disp)
+    #define LV_TELEMETRY_FRAME_RENDERED(disp)   lv_telemetry_frame_rendered(disp)
+    #define LV_TELEMETRY_FRAME_END(disp)        lv_telemetry_frame_end(disp)
+    #define LV_TELEMETRY_PHASE_BEGIN(phase)     lv_telemetry_phase_begin(phase)
+    #define LV_TELEMETRY_PHASE_END(phase)       lv_telemetry_phase_end(phase)
+    #define LV_TELEMETRY_DRAW_TASK_ADDED()      lv_telemetry_draw_task_added()
+    #define LV_TELEMETRY_DRAW_UNIT_BEGIN(u)     ((u)->telemetry_busy_start = lv_telemetry_get_time())
+    #define LV_TELEMETRY_DRAW_UNIT_END(u)       ((u)->telemetry_busy_time += lv_telemetry_get_time() - (u)->telemetry_busy_start)
+#else
+    #define LV_TELEMETRY_TIMER_HANDLER_BEGIN()
+    #define LV_TELEMETRY_TIMER_HANDLER_END()
+    #define LV_TELEMETRY_FRAME_BEGIN(disp)
+    #define LV_TELEMETRY_FRAME_RENDERED(disp)
+    #define LV_TELEMETRY_FRAME_END(disp)
+    #define LV_TELEMETRY_PHASE_BEGIN(phase)
+    #define LV_TELEMETRY_PHASE_END(phase)
+    #define LV_TELEMETRY_DRAW_TASK_ADDED()
+    #define LV_TELEMETRY_DRAW_UNIT_BEGIN(u)
+    #define LV_TELEMETRY_DRAW_UNIT_END(u)
+#endif
+
+#if LV_USE_TELEMETRY
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the frame telemetry
+ */
+void lv_telemetry_init(void);
+
+/**
+ * Deinitialize the frame telemetry
+ */
+void lv_telemetry_deinit(void);
+
+/**
+ * Get the current time using the time source of the telemetry
+ * @return      the time in microseconds
+ */
+uint32_t lv_telemetry_get_time(void);
+
+/**
+ * Mark the start of an `lv_timer_handler()` call
+ */
+void lv_telemetry_timer_handler_begin(void);
+
+/**
+ * Mark the end of an `lv_timer_handler()` call and report the frames refreshed in it
+ */
+void lv_telemetry_timer_handler_end(void);
+
+/**
+ * Start measuring the refresh of a display
+ * @param disp      the display being refreshed
+ */
+void lv_telemetry_frame_begin(lv_display_t * disp);
+
+/**
+ * Save the number of the refreshed areas and pixels of the display
+ * @param disp      the display being refreshed
+ */
+void lv_telemetry_frame_rendered(lv_display_t * disp);
+
+/**
+ * Finish measuring the refresh of a display. Frames without rendering are not reported.
+ * @param disp      the display being refreshed
+ */
+void lv_telemetry_frame_end(lv_display_t * disp);
+
+/**
+ * Start measuring a phase of the current frame. A phase can be measured several times in a frame.
+ * @param phase     the phase
+ */
+void lv_telemetry_phase_begin(lv_telemetry_phase_t phase);
+
+/**
+ * Finish measuring a phase of the current frame
+ * @param phase     the phase
+ */
+void lv_telemetry_phase_end(lv_telemetry_phase_t phase);
+
+/**
+ * Count a new draw task in the current frame
+ */
+void lv_telemetry_draw_task_added(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_TELEMETRY*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TELEMETRY_PRIVATE_H*/
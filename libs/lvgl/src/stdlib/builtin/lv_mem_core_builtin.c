@@ -38,18 +38,66 @@
 #endif
 #define state LV_GLOBAL_DEFAULT()->tlsf_state
 
+#if LV_USE_MEM_THREAD_CACHE
+    /*The size of every TLSF block is a multiple of the alignment so each class
+     *caches the blocks of exactly one size up to 256 bytes*/
+    #define CACHE_CLASS_STEP        (ALIGN_MASK + 1)
+    #define CACHE_CLASS_CNT         (256 / CACHE_CLASS_STEP)
+    #define CACHE_CLASS_SIZE(id)    ((size_t)((id) + 1) * CACHE_CLASS_STEP)
+
+    /*Max. number of cached blocks in a class. Half of them are moved to or from the heap at once.*/
+    #define CACHE_CLASS_MAX_CNT(id) LV_MAX(LV_MEM_THREAD_CACHE_SIZE / CACHE_CLASS_CNT / CACHE_CLASS_SIZE(id), 2)
+    #define CACHE_CLASS_ID(size)    ((uint32_t)((size) / CACHE_CLASS_STEP - 1))
+
+    #if LV_USE_OS
+        #ifndef LV_MEM_THREAD_LOCAL
+            #ifdef _MSC_VER
+                #define LV_MEM_THREAD_LOCAL __declspec(thread)
+            #else
+                #define LV_MEM_THREAD_LOCAL __thread
+            #endif
+        #endif
+    #else
+        /*There is only one thread*/
+        #undef LV_MEM_THREAD_LOCAL
+        #define LV_MEM_THREAD_LOCAL
+    #endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_MEM_THREAD_CACHE
+struct _lv_mem_thread_cache_t {
+    void * free_head[CACHE_CLASS_CNT];      /**< Cached blocks of each class linked by their first word*/
+    uint16_t free_cnt[CACHE_CLASS_CNT];     /**< Number of cached blocks in each class*/
+    size_t cached_size;                     /**< Size of all cached blocks. Read by `lv_mem_monitor()` too.*/
+    lv_mem_thread_cache_t * next;           /**< Next cache in `thread_cache_head`*/
+};
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+static void free_block(void * p);
+#if LV_USE_MEM_THREAD_CACHE
+    static lv_mem_thread_cache_t * thread_cache_get(void);
+    static size_t thread_cache_block_size(size_t size);
+    static void * thread_cache_malloc(size_t size);
+    static bool thread_cache_free(void * p);
+    static void thread_cache_release(lv_mem_thread_cache_t * cache, uint32_t class_id, uint32_t cnt);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_MEM_THREAD_CACHE
+    /*Incremented in each `lv_mem_init()` to ignore the caches of a previous heap*/
+    static uint32_t mem_generation;
+    static LV_MEM_THREAD_LOCAL lv_mem_thread_cache_t * thread_cache;
+    static LV_MEM_THREAD_LOCAL uint32_t thread_cache_generation;
+#endif
 
 /**********************
  *      MACROS
@@ -96,6 +144,10 @@ void lv_mem_init(void)
 #if LV_MEM_ADD_JUNK
     LV_LOG_WARN("LV_MEM_ADD_JUNK is enabled which makes LVGL much slower");
 #endif
+
+#if LV_USE_MEM_THREAD_CACHE
+    mem_generation++;
+#endif
 }
 
 void lv_mem_deinit(void)
@@ -124,6 +176,9 @@ lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes)
 
 void lv_mem_remove_pool(lv_mem_pool_t pool)
 {
+    /*The pool can be removed only if it's empty*/
+    lv_mem_thread_cache_flush();
+
     lv_pool_t * pool_p;
     LV_LL_READ(&state.pool_ll, pool_p) {
         if(*pool_p == pool) {
@@ -138,6 +193,11 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
 
 void * lv_malloc_core(size_t size)
 {
+#if LV_USE_MEM_THREAD_CACHE
+    void * p_cached = thread_cache_malloc(size);
+    if(p_cached) return p_cached;
+#endif
+
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
@@ -156,6 +216,22 @@ void * lv_malloc_core(size_t size)
 
 void * lv_realloc_core(void * p, size_t new_size)
 {
+#if LV_USE_MEM_THREAD_CACHE
+    /*Resizing a block in place would leave blocks with other sizes in the classes. Move the data instead.*/
+    if(p == NULL) return lv_malloc_core(new_size);
+
+    size_t block_size = lv_tlsf_block_size(p);
+    if(block_size <= CACHE_CLASS_SIZE(CACHE_CLASS_CNT - 1) || new_size <= CACHE_CLASS_SIZE(CACHE_CLASS_CNT - 1)) {
+        if(thread_cache_block_size(new_size) == block_size) return p;
+
+        void * p_new = lv_malloc_core(new_size);
+        if(p_new == NULL) return NULL;
+        lv_memcpy(p_new, p, LV_MIN(block_size, new_size));
+        lv_free_core(p);
+        return p_new;
+    }
+#endif
+
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
@@ -177,6 +253,10 @@ void * lv_realloc_core(void * p, size_t new_size)
 
 void lv_free_core(void * p)
 {
+#if LV_USE_MEM_THREAD_CACHE
+    if(thread_cache_free(p)) return;
+#endif
+
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
@@ -184,18 +264,44 @@ void lv_free_core(void * p)
 #if LV_MEM_ADD_JUNK
     lv_memset(p, 0xbb, lv_tlsf_block_size(data));
 #endif
-    size_t size = lv_tlsf_block_size(p);
-    lv_tlsf_free(state.tlsf, p);
-    if(state.cur_used > size) state.cur_used -= size;
-    else state.cur_used = 0;
+    free_block(p);
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+void lv_mem_thread_cache_flush(void)
+{
+#if LV_USE_MEM_THREAD_CACHE
+    lv_mem_thread_cache_t * cache = thread_cache_get();
+    if(cache == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < CACHE_CLASS_CNT; i++) {
+        thread_cache_release(cache, i, cache->free_cnt[i]);
+    }
 
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    lv_mem_thread_cache_t ** next_p = &state.thread_cache_head;
+    while(*next_p != cache) next_p = &(*next_p)->next;
+    *next_p = cache->next;
+    free_block(cache);
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
 #endif
+
+    thread_cache = NULL;
+#endif
 }
 
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
 {
+    /*Return the blocks of this thread to let them merge with their neighbors*/
+    lv_mem_thread_cache_flush();
+
     /*Init the data*/
     lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
     LV_TRACE_MEM("begin");
@@ -205,6 +311,28 @@ void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
         lv_tlsf_walk_pool(*pool_p, lv_mem_walker, mon_p);
     }
 
+    mon_p->cur_used = state.cur_used;
+
+#if LV_USE_MEM_THREAD_CACHE
+    /*The blocks cached by the other threads are free too, they just can't be merged yet*/
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    lv_mem_thread_cache_t * cache;
+    for(cache = state.thread_cache_head; cache; cache = cache->next) {
+        uint32_t i;
+        for(i = 0; i < CACHE_CLASS_CNT; i++) {
+            mon_p->free_cnt += cache->free_cnt[i];
+            mon_p->used_cnt -= LV_MIN(cache->free_cnt[i], mon_p->used_cnt);
+        }
+        mon_p->free_size += cache->cached_size;
+        mon_p->cur_used -= cache->cached_size;
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+#endif
+
     mon_p->used_pct = 100 - (uint64_t)100U * mon_p->free_size / mon_p->total_size;
     if(mon_p->free_size > 0) {
         mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
@@ -254,6 +382,149 @@ lv_result_t lv_mem_test_core(void)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Return a block to TLSF. The mutex needs to be locked.
+ * @param p     pointer to the block
+ */
+static void free_block(void * p)
+{
+    size_t size = lv_tlsf_block_size(p);
+    lv_tlsf_free(state.tlsf, p);
+    if(state.cur_used > size) state.cur_used -= size;
+    else state.cur_used = 0;
+}
+
+#if LV_USE_MEM_THREAD_CACHE
+
+static lv_mem_thread_cache_t * thread_cache_get(void)
+{
+    /*The cache was created for an already deinitialized heap*/
+    if(thread_cache_generation != mem_generation) return NULL;
+
+    return thread_cache;
+}
+
+/**
+ * Get the size of the block TLSF would return for a request if the rest of the free block can be split
+ * @param size  the requested size
+ * @return      size of the block
+ */
+static size_t thread_cache_block_size(size_t size)
+{
+    size = LV_MAX(size, lv_tlsf_block_size_min());
+    return (size + ALIGN_MASK) & ~(size_t)ALIGN_MASK;
+}
+
+static void * thread_cache_malloc(size_t size)
+{
+    if(size > CACHE_CLASS_SIZE(CACHE_CLASS_CNT - 1)) return NULL;
+
+    uint32_t class_id = CACHE_CLASS_ID(thread_cache_block_size(size));
+
+    lv_mem_thread_cache_t * cache = thread_cache_get();
+    if(cache == NULL || cache->free_head[class_id] == NULL) {
+        /*Allocate a batch of blocks with a single lock*/
+#if LV_USE_OS
+        lv_mutex_lock(&state.mutex);
+#endif
+        if(cache == NULL) {
+            cache = lv_tlsf_malloc(state.tlsf, sizeof(lv_mem_thread_cache_t));
+            if(cache) {
+                state.cur_used += lv_tlsf_block_size(cache);
+                lv_memzero(cache, sizeof(lv_mem_thread_cache_t));
+                cache->next = state.thread_cache_head;
+                state.thread_cache_head = cache;
+                thread_cache = cache;
+                thread_cache_generation = mem_generation;
+            }
+        }
+
+        uint32_t batch_cnt = cache ? CACHE_CLASS_MAX_CNT(class_id) / 2 : 0;
+        while(batch_cnt) {
+            void * p = lv_tlsf_malloc(state.tlsf, CACHE_CLASS_SIZE(class_id));
+            if(p == NULL) break;
+
+            /*TLSF returns a larger block if the rest is too small to be split.
+             *Cache it in the class of its real size.*/
+            size_t block_size = lv_tlsf_block_size(p);
+            state.cur_used += block_size;
+            if(block_size > CACHE_CLASS_SIZE(CACHE_CLASS_CNT - 1)) {
+                free_block(p);
+                break;
+            }
+
+            uint32_t block_class_id = CACHE_CLASS_ID(block_size);
+            *(void **)p = cache->free_head[block_class_id];
+            cache->free_head[block_class_id] = p;
+            cache->free_cnt[block_class_id]++;
+            cache->cached_size += block_size;
+            batch_cnt--;
+        }
+        state.max_used = LV_MAX(state.cur_used, state.max_used);
+
+#if LV_USE_OS
+        lv_mutex_unlock(&state.mutex);
+#endif
+        /*Out of memory or TLSF returned only larger blocks. Let it try to allocate the exact size.*/
+        if(cache == NULL || cache->free_head[class_id] == NULL) return NULL;
+    }
+
+    void * p = cache->free_head[class_id];
+    cache->free_head[class_id] = *(void **)p;
+    cache->free_cnt[class_id]--;
+    cache->cached_size -= lv_tlsf_block_size(p);
+    return p;
+}
+
+static bool thread_cache_free(void * p)
+{
+    lv_mem_thread_cache_t * cache = thread_cache_get();
+    if(cache == NULL) return false;
+
+    size_t block_size = lv_tlsf_block_size(p);
+    if(block_size > CACHE_CLASS_SIZE(CACHE_CLASS_CNT - 1)) return false;
+
+    uint32_t class_id = CACHE_CLASS_ID(block_size);
+
+    if(cache->free_cnt[class_id] >= CACHE_CLASS_MAX_CNT(class_id)) {
+        thread_cache_release(cache, class_id, CACHE_CLASS_MAX_CNT(class_id) / 2);
+    }
+
+    *(void **)p = cache->free_head[class_id];
+    cache->free_head[class_id] = p;
+    cache->free_cnt[class_id]++;
+    cache->cached_size += block_size;
+    return true;
+}
+
+/**
+ * Return cached blocks of a class to TLSF with a single lock
+ * @param cache     the cache of the current thread
+ * @param class_id  index of the size class
+ * @param cnt       number of blocks to return
+ */
+static void thread_cache_release(lv_mem_thread_cache_t * cache, uint32_t class_id, uint32_t cnt)
+{
+    if(cnt == 0) return;
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    while(cnt && cache->free_head[class_id]) {
+        void * p = cache->free_head[class_id];
+        cache->free_head[class_id] = *(void **)p;
+        cache->free_cnt[class_id]--;
+        cache->cached_size -= lv_tlsf_block_size(p);
+        free_block(p);
+        cnt--;
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+#endif /*LV_USE_MEM_THREAD_CACHE*/
+
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
 {
     LV_UNUSED(ptr);
@@ -26,6 +26,8 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef struct _lv_mem_thread_cache_t lv_mem_thread_cache_t;
+
 typedef struct {
 #if LV_USE_OS
     lv_mutex_t mutex;
@@ -34,6 +36,9 @@ typedef struct {
     size_t cur_used;
     size_t max_used;
     lv_ll_t  pool_ll;
+#if LV_USE_MEM_THREAD_CACHE
+    lv_mem_thread_cache_t * thread_cache_head;  /**< Linked list of the caches of the threads */
+#endif
 } lv_tlsf_state_t;
 
 /**********************
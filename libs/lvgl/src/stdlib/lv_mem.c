@@ -163,6 +163,13 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     lv_mem_monitor_core(mon_p);
 }
 
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_BUILTIN
+void lv_mem_thread_cache_flush(void)
+{
+    /*Only the builtin allocator has thread caches*/
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
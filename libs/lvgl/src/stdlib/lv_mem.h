@@ -39,6 +39,7 @@ typedef struct {
     size_t free_biggest_size;
     size_t used_cnt;
     size_t max_used;    /**< Max size of Heap memory used */
+    size_t cur_used;    /**< Size of the allocated blocks. Unlike `free_size` it doesn't depend on the fragmentation */
     uint8_t used_pct;   /**< Percentage used */
     uint8_t frag_pct;   /**< Amount of fragmentation */
 } lv_mem_monitor_t;
@@ -130,6 +131,13 @@ lv_result_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+/**
+ * Return the memory blocks cached by the calling thread to the heap.
+ * The threads created by `lv_thread_init()` call it when they return. Other threads using `lv_malloc()`
+ * should call it before exiting if `LV_USE_MEM_THREAD_CACHE` is enabled.
+ */
+void lv_mem_thread_cache_flush(void);
+
 /**********************
  *      MACROS
  **********************/
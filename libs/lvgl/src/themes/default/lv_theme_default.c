@@ -631,6 +631,13 @@ static void style_init(my_theme_t * theme)
     lv_style_set_arc_width(&theme->styles.scale, LV_DPX(2));
     lv_style_set_length(&theme->styles.scale, LV_DPX(6));
 #endif
+
+    /*The styles are not modified until the next init so index them for faster lookup*/
+    lv_style_t * styles = (lv_style_t *)&theme->styles;
+    uint32_t i;
+    for(i = 0; i < sizeof(theme->styles) / sizeof(lv_style_t); i++) {
+        lv_style_freeze(&styles[i]);
+    }
 }
 
 /**********************
@@ -1183,6 +1190,14 @@ static void theme_apply(lv_theme_t * th, lv_obj_t * obj)
     }
 #endif
 
+#if LV_USE_VLIST
+    else if(lv_obj_check_type(obj, &lv_vlist_class)) {
+        lv_obj_add_style(obj, &theme->styles.card, 0);
+        lv_obj_add_style(obj, &theme->styles.scrollbar, LV_PART_SCROLLBAR);
+        lv_obj_add_style(obj, &theme->styles.scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+    }
+#endif
+
 #if LV_USE_TABVIEW
     else if(lv_obj_check_type(obj, &lv_tabview_class)) {
         lv_obj_add_style(obj, &theme->styles.scr, 0);
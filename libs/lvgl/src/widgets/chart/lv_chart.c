@@ -40,10 +40,17 @@ static void draw_div_lines(lv_obj_t * obj, lv_layer_t * layer);
 static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer);
 static void draw_series_bar(lv_obj_t * obj, lv_layer_t * layer);
 static void draw_series_scatter(lv_obj_t * obj, lv_layer_t * layer);
+static void draw_series_stream(lv_obj_t * obj, lv_layer_t * layer, uint32_t block_size);
 static void draw_cursors(lv_obj_t * obj, lv_layer_t * layer);
 static uint32_t get_index_from_x(lv_obj_t * obj, int32_t x);
 static void invalidate_point(lv_obj_t * obj, uint32_t i);
 static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t cnt, int32_t ** a);
+static uint32_t get_stream_block_size(lv_obj_t * obj);
+static bool update_stream_blocks(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t block_size);
+static void get_block_min_max(lv_chart_series_t * ser, uint32_t start, uint32_t end, int32_t * min, int32_t * max);
+static void add_stream_value(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t block_size);
+static void invalidate_stream_slot(lv_obj_t * obj, uint32_t slot, uint32_t slot_cnt);
+static int32_t get_stream_slot_x(int32_t w, uint32_t slot, uint32_t slot_cnt);
 
 /**********************
  *  STATIC VARIABLES
@@ -122,6 +129,7 @@ void lv_chart_set_point_count(lv_obj_t * obj, uint32_t cnt)
         }
         if(!ser->y_ext_buf_assigned) new_points_alloc(obj, ser, cnt, &ser->y_points);
         ser->start_point = 0;
+        ser->block_size = 0;
     }
 
     chart->point_cnt = cnt;
@@ -172,6 +180,17 @@ void lv_chart_set_update_mode(lv_obj_t * obj, lv_chart_update_mode_t update_mode
     lv_obj_invalidate(obj);
 }
 
+void lv_chart_set_stream_mode(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    if(chart->stream == en) return;
+
+    chart->stream = en;
+    lv_chart_refresh(obj);
+}
+
 void lv_chart_set_div_line_count(lv_obj_t * obj, uint8_t hdiv, uint8_t vdiv)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -201,6 +220,13 @@ uint32_t lv_chart_get_point_count(const lv_obj_t * obj)
     return chart->point_cnt;
 }
 
+bool lv_chart_get_stream_mode(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    return chart->stream;
+}
+
 uint32_t lv_chart_get_x_start_point(const lv_obj_t * obj, lv_chart_series_t * ser)
 {
     LV_ASSERT_NULL(ser);
@@ -274,6 +300,13 @@ void lv_chart_refresh(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The data might have been changed directly in the arrays*/
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    lv_chart_series_t * ser;
+    LV_LL_READ(&chart->series_ll, ser) {
+        ser->block_size = 0;
+    }
+
     lv_obj_invalidate(obj);
 }
 
@@ -351,6 +384,8 @@ void lv_chart_remove_series(lv_obj_t * obj, lv_chart_series_t * series)
     lv_chart_t * chart    = (lv_chart_t *)obj;
     if(!series->y_ext_buf_assigned && series->y_points) lv_free(series->y_points);
     if(!series->x_ext_buf_assigned && series->x_points) lv_free(series->x_points);
+    lv_free(series->block_min);
+    lv_free(series->block_max);
 
     lv_ll_remove(&chart->series_ll, series);
     lv_free(series);
@@ -393,6 +428,7 @@ void lv_chart_set_x_start_point(lv_obj_t * obj, lv_chart_series_t * ser, uint32_
     lv_chart_t * chart  = (lv_chart_t *)obj;
     if(id >= chart->point_cnt) return;
     ser->start_point = id;
+    ser->block_size = 0;
 }
 
 lv_chart_series_t * lv_chart_get_series_next(const lv_obj_t * obj, const lv_chart_series_t * ser)
@@ -481,6 +517,16 @@ void lv_chart_set_next_value(lv_obj_t * obj, lv_chart_series_t * ser, int32_t va
 
     lv_chart_t * chart  = (lv_chart_t *)obj;
     ser->y_points[ser->start_point] = value;
+
+    uint32_t block_size = get_stream_block_size(obj);
+    if(block_size) {
+        add_stream_value(obj, ser, block_size);
+        return;
+    }
+
+    /*The blocks were not updated*/
+    ser->block_size = 0;
+
     invalidate_point(obj, ser->start_point);
     ser->start_point = (ser->start_point + 1) % chart->point_cnt;
     invalidate_point(obj, ser->start_point);
@@ -512,6 +558,15 @@ void lv_chart_set_value_by_id(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t
 
     if(id >= chart->point_cnt) return;
     ser->y_points[id] = value;
+
+    /*Update the block of the point*/
+    if(ser->block_size) {
+        uint32_t block_id = id / ser->block_size;
+        uint32_t start = block_id * ser->block_size;
+        get_block_min_max(ser, start, LV_MIN(start + ser->block_size, chart->point_cnt),
+                          &ser->block_min[block_id], &ser->block_max[block_id]);
+    }
+
     invalidate_point(obj, id);
 }
 
@@ -541,6 +596,7 @@ void lv_chart_set_ext_y_array(lv_obj_t * obj, lv_chart_series_t * ser, int32_t a
     if(!ser->y_ext_buf_assigned && ser->y_points) lv_free(ser->y_points);
     ser->y_ext_buf_assigned = true;
     ser->y_points = array;
+    ser->block_size = 0;
     lv_obj_invalidate(obj);
 }
 
@@ -641,6 +697,8 @@ static void lv_chart_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
         if(!ser->y_ext_buf_assigned) lv_free(ser->y_points);
         if(!ser->x_ext_buf_assigned) lv_free(ser->x_points);
+        lv_free(ser->block_min);
+        lv_free(ser->block_max);
 
         lv_ll_remove(&chart->series_ll, ser);
         lv_free(ser);
@@ -695,7 +753,9 @@ static void lv_chart_event(const lv_obj_class_t * class_p, lv_event_t * e)
         draw_div_lines(obj, layer);
 
         if(lv_ll_is_empty(&chart->series_ll) == false) {
-            if(chart->type == LV_CHART_TYPE_LINE) draw_series_line(obj, layer);
+            uint32_t block_size = get_stream_block_size(obj);
+            if(block_size) draw_series_stream(obj, layer, block_size);
+            else if(chart->type == LV_CHART_TYPE_LINE) draw_series_line(obj, layer);
             else if(chart->type == LV_CHART_TYPE_BAR) draw_series_bar(obj, layer);
             else if(chart->type == LV_CHART_TYPE_SCATTER) draw_series_scatter(obj, layer);
         }
@@ -933,6 +993,127 @@ static void draw_series_line(lv_obj_t * obj, lv_layer_t * layer)
     layer->_clip_area = clip_area_ori;
 }
 
+/**
+ * Draw the line series in streaming mode. Every block of points is drawn as a vertical line
+ * between its minimum and maximum. The minimums and maximums are cached, so only
+ * the block which is being written is calculated from the points.
+ */
+static void draw_series_stream(lv_obj_t * obj, lv_layer_t * layer, uint32_t block_size)
+{
+    lv_area_t clip_area;
+    if(lv_area_intersect(&clip_area, &obj->coords, &layer->_clip_area) == false) return;
+
+    const lv_area_t clip_area_ori = layer->_clip_area;
+    layer->_clip_area = clip_area;
+
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    int32_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    int32_t pad_left = lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + border_width;
+    int32_t pad_top = lv_obj_get_style_pad_top(obj, LV_PART_MAIN) + border_width;
+    int32_t w     = lv_obj_get_content_width(obj);
+    int32_t h     = lv_obj_get_content_height(obj);
+    int32_t x_ofs = obj->coords.x1 + pad_left - lv_obj_get_scroll_left(obj);
+    int32_t y_ofs = obj->coords.y1 + pad_top - lv_obj_get_scroll_top(obj);
+    uint32_t block_cnt = (chart->point_cnt + block_size - 1) / block_size;
+    bool shift = chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT;
+    lv_chart_series_t * ser;
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    lv_obj_init_draw_line_dsc(obj, LV_PART_ITEMS, &line_dsc);
+    if(line_dsc.width == 1) line_dsc.raw_end = 1;
+
+    int32_t x_min = clip_area.x1 - line_dsc.width;
+    int32_t x_max = clip_area.x2 + line_dsc.width;
+
+    line_dsc.base.id1 = lv_ll_get_len(&chart->series_ll) - 1;
+    LV_LL_READ_BACK(&chart->series_ll, ser) {
+        if(ser->hidden || !update_stream_blocks(obj, ser, block_size)) {
+            line_dsc.base.id1--;
+            continue;
+        }
+
+        line_dsc.color = ser->color;
+        int32_t ymin = chart->ymin[ser->y_axis_sec];
+        int32_t ymax = chart->ymax[ser->y_axis_sec];
+        uint32_t act_block = ser->start_point / block_size;
+        int32_t prev_x = 0;
+        int32_t prev_y = LV_CHART_POINT_NONE;
+
+        uint32_t slot;
+        for(slot = 0; slot < block_cnt; slot++) {
+            /* In shift mode the oldest block is being overwritten so it's not shown,
+             * and the already written points of it are shown as the newest block.*/
+            uint32_t block_id;
+            uint32_t start;
+            uint32_t end;
+            if(shift) {
+                block_id = slot == block_cnt - 1 ? act_block : (act_block + 1 + slot) % block_cnt;
+                start = block_id * block_size;
+                end = slot == block_cnt - 1 ? ser->start_point : LV_MIN(start + block_size, chart->point_cnt);
+            }
+            else {
+                block_id = slot;
+                start = block_id * block_size;
+                end = LV_MIN(start + block_size, chart->point_cnt);
+            }
+            if(start >= end) continue;
+
+            int32_t v_min;
+            int32_t v_max;
+            if(block_id == act_block) get_block_min_max(ser, start, end, &v_min, &v_max);
+            else {
+                v_min = ser->block_min[block_id];
+                v_max = ser->block_max[block_id];
+            }
+
+            int32_t x = get_stream_slot_x(w, slot, block_cnt) + x_ofs;
+            if(x > x_max) break;
+
+            if(v_min == LV_CHART_POINT_NONE) {
+                prev_y = LV_CHART_POINT_NONE;
+                continue;
+            }
+
+            int32_t y_top = h - lv_map(v_max, ymin, ymax, 0, h) + y_ofs;
+            int32_t y_bottom = h - lv_map(v_min, ymin, ymax, 0, h) + y_ofs;
+            int32_t v_first = ser->y_points[start];
+            int32_t v_last = ser->y_points[end - 1];
+
+            if(x >= x_min) {
+                line_dsc.base.id2 = slot;
+                if(prev_y != LV_CHART_POINT_NONE) {
+                    /*Connect to the previous block*/
+                    if(x - prev_x > 1 && v_first != LV_CHART_POINT_NONE) {
+                        line_dsc.p1.x = prev_x;
+                        line_dsc.p1.y = prev_y;
+                        line_dsc.p2.x = x;
+                        line_dsc.p2.y = h - lv_map(v_first, ymin, ymax, 0, h) + y_ofs;
+                        lv_draw_line(layer, &line_dsc);
+                    }
+                    else {
+                        y_top = LV_MIN(y_top, prev_y);
+                        y_bottom = LV_MAX(y_bottom, prev_y);
+                    }
+                }
+
+                line_dsc.p1.x = x;
+                line_dsc.p2.x = x;
+                line_dsc.p1.y = y_top;
+                line_dsc.p2.y = y_top == y_bottom ? y_bottom + 1 : y_bottom;
+                lv_draw_line(layer, &line_dsc);
+            }
+
+            prev_x = x;
+            prev_y = v_last == LV_CHART_POINT_NONE ? LV_CHART_POINT_NONE : h - lv_map(v_last, ymin, ymax, 0, h) + y_ofs;
+        }
+
+        line_dsc.base.id1--;
+    }
+
+    layer->_clip_area = clip_area_ori;
+}
+
 static void draw_series_scatter(lv_obj_t * obj, lv_layer_t * layer)
 {
 
@@ -1357,4 +1538,122 @@ static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t c
     }
 }
 
+/**
+ * Get the number of points drawn in one pixel column in streaming mode
+ * @return      the block size or 0 if the series are not drawn in streaming mode
+ */
+static uint32_t get_stream_block_size(lv_obj_t * obj)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    if(!chart->stream || chart->type != LV_CHART_TYPE_LINE) return 0;
+
+    int32_t w = lv_obj_get_content_width(obj);
+    if(w <= 0 || chart->point_cnt <= (uint32_t)w) return 0;
+
+    return (chart->point_cnt + w - 1) / w;
+}
+
+/**
+ * Recalculate the minimum and maximum of all blocks if the block size has changed
+ * @return      false if the blocks couldn't be allocated
+ */
+static bool update_stream_blocks(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t block_size)
+{
+    if(ser->block_size == block_size) return true;
+
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    uint32_t block_cnt = (chart->point_cnt + block_size - 1) / block_size;
+
+    int32_t * block_min = lv_realloc(ser->block_min, block_cnt * sizeof(int32_t));
+    LV_ASSERT_MALLOC(block_min);
+    if(block_min == NULL) return false;
+    ser->block_min = block_min;
+
+    int32_t * block_max = lv_realloc(ser->block_max, block_cnt * sizeof(int32_t));
+    LV_ASSERT_MALLOC(block_max);
+    if(block_max == NULL) return false;
+    ser->block_max = block_max;
+
+    uint32_t i;
+    for(i = 0; i < block_cnt; i++) {
+        uint32_t start = i * block_size;
+        get_block_min_max(ser, start, LV_MIN(start + block_size, chart->point_cnt), &block_min[i], &block_max[i]);
+    }
+
+    ser->block_size = block_size;
+    return true;
+}
+
+static void get_block_min_max(lv_chart_series_t * ser, uint32_t start, uint32_t end, int32_t * min, int32_t * max)
+{
+    int32_t v_min = LV_CHART_POINT_NONE;
+    int32_t v_max = LV_CHART_POINT_NONE;
+    uint32_t i;
+    for(i = start; i < end; i++) {
+        int32_t v = ser->y_points[i];
+        if(v == LV_CHART_POINT_NONE) continue;
+        if(v_min == LV_CHART_POINT_NONE || v < v_min) v_min = v;
+        if(v_max == LV_CHART_POINT_NONE || v > v_max) v_max = v;
+    }
+
+    *min = v_min;
+    *max = v_max;
+}
+
+/**
+ * Handle a new value written to `start_point` in streaming mode.
+ * The cached minimum and maximum of a block is updated when the block is filled.
+ */
+static void add_stream_value(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t block_size)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    uint32_t p = ser->start_point;
+    uint32_t block_id = p / block_size;
+    uint32_t block_end = LV_MIN((block_id + 1) * block_size, chart->point_cnt);
+    uint32_t block_cnt = (chart->point_cnt + block_size - 1) / block_size;
+    bool block_full = p + 1 == block_end;
+
+    ser->start_point = (p + 1) % chart->point_cnt;
+
+    if(block_full && ser->block_size == block_size) {
+        get_block_min_max(ser, block_id * block_size, block_end, &ser->block_min[block_id], &ser->block_max[block_id]);
+    }
+
+    if(ser->hidden) return;
+
+    if(chart->update_mode == LV_CHART_UPDATE_MODE_SHIFT) {
+        /*The chart is scrolled by a block when a block is filled.
+         *Else only the newest block changes.*/
+        if(block_full) lv_obj_invalidate(obj);
+        else invalidate_stream_slot(obj, block_cnt - 1, block_cnt);
+    }
+    else {
+        invalidate_stream_slot(obj, block_id, block_cnt);
+    }
+}
+
+static void invalidate_stream_slot(lv_obj_t * obj, uint32_t slot, uint32_t slot_cnt)
+{
+    int32_t w  = lv_obj_get_content_width(obj);
+    int32_t bwidth = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    int32_t pleft = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
+    int32_t x_ofs = obj->coords.x1 + pleft + bwidth - lv_obj_get_scroll_left(obj);
+    int32_t line_width = lv_obj_get_style_line_width(obj, LV_PART_ITEMS);
+
+    /*The lines connecting the neighbor blocks change too*/
+    lv_area_t coords;
+    lv_area_copy(&coords, &obj->coords);
+    coords.y1 -= line_width;
+    coords.y2 += line_width;
+    coords.x1 = get_stream_slot_x(w, slot > 0 ? slot - 1 : 0, slot_cnt) + x_ofs - line_width;
+    coords.x2 = get_stream_slot_x(w, LV_MIN(slot + 1, slot_cnt - 1), slot_cnt) + x_ofs + line_width;
+    lv_obj_invalidate_area(obj, &coords);
+}
+
+static int32_t get_stream_slot_x(int32_t w, uint32_t slot, uint32_t slot_cnt)
+{
+    if(slot_cnt < 2) return 0;
+    return (int32_t)((w * slot) / (slot_cnt - 1));
+}
+
 #endif
@@ -109,6 +109,18 @@ void lv_chart_set_update_mode(lv_obj_t * obj, lv_chart_update_mode_t update_mode
  */
 void lv_chart_set_div_line_count(lv_obj_t * obj, uint8_t hdiv, uint8_t vdiv);
 
+/**
+ * Enable the streaming mode of line charts. If there are more points than pixels,
+ * the points are grouped into blocks of one pixel column and only the minimum and maximum
+ * of the blocks are drawn. The minimums and maximums are cached and updated when a block is
+ * filled by `lv_chart_set_next_value()`, so the drawing time doesn't depend on the number of points.
+ * In shift mode the chart scrolls by whole blocks, and in circular mode only the written
+ * block is invalidated.
+ * @param obj       pointer to a chart object
+ * @param en        true: enable the streaming mode
+ */
+void lv_chart_set_stream_mode(lv_obj_t * obj, bool en);
+
 /**
  * Get the type of a chart
  * @param obj       pointer to chart object
@@ -123,6 +135,13 @@ lv_chart_type_t lv_chart_get_type(const lv_obj_t * obj);
  */
 uint32_t lv_chart_get_point_count(const lv_obj_t * obj);
 
+/**
+ * Tell if the streaming mode is enabled
+ * @param obj       pointer to chart object
+ * @return          true: the streaming mode is enabled
+ */
+bool lv_chart_get_stream_mode(const lv_obj_t * obj);
+
 /**
  * Get the current index of the x-axis start point in the data array
  * @param obj       pointer to a chart object
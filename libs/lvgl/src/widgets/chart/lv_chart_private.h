@@ -35,6 +35,9 @@ struct lv_chart_series_t {
     int32_t * y_points;
     lv_color_t color;
     uint32_t start_point;
+    int32_t * block_min;        /**< Minimum of the blocks of points in streaming mode*/
+    int32_t * block_max;        /**< Maximum of the blocks of points in streaming mode*/
+    uint32_t block_size;        /**< Number of points in a block. 0 if the blocks need to be recalculated*/
     uint32_t hidden : 1;
     uint32_t x_ext_buf_assigned : 1;
     uint32_t y_ext_buf_assigned : 1;
@@ -65,6 +68,7 @@ struct lv_chart_t {
     uint32_t point_cnt;         /**< Point number in a data line*/
     lv_chart_type_t type  : 3;  /**< Line or column chart*/
     lv_chart_update_mode_t update_mode : 1;
+    uint32_t stream : 1;        /**< 1: decimate the points of line charts to the pixel columns*/
 };
 
 
@@ -41,6 +41,10 @@ struct lv_label_t {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE
+    lv_draw_label_layout_t layout;      /**< Line breaks and letter widths of the text*/
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
@@ -0,0 +1,707 @@
+/**
+ * @file lv_vlist.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_vlist_private.h"
+#include "../../core/lv_obj_private.h"
+#include "../../core/lv_obj_class_private.h"
+#if LV_USE_VLIST != 0
+
+#include "../../layouts/flex/lv_flex.h"
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_math.h"
+#include "../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS (&lv_vlist_class)
+
+/*Refine the window a few times if the measured heights differ from the estimated ones*/
+#define MEASURE_ITERATION_MAX  4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_vlist_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_vlist_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_vlist_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void update_window(lv_obj_t * obj, bool rebind);
+static void bind_row(lv_obj_t * obj, lv_vlist_row_t * r, uint32_t row);
+static lv_vlist_row_t * get_free_row(lv_obj_t * obj);
+static lv_obj_t * default_row_create(lv_obj_t * obj);
+static void delete_pool(lv_obj_t * obj);
+static void prune_pool(lv_obj_t * obj);
+static bool measure_rows(lv_obj_t * obj);
+static int32_t get_row_h(lv_vlist_t * vlist, uint32_t row);
+static uint32_t get_row_at(lv_vlist_t * vlist, int32_t y);
+static void tree_build(int32_t * t, uint32_t n);
+static void tree_unbuild(int32_t * t, uint32_t n);
+static void tree_add(int32_t * t, uint32_t n, uint32_t i, int32_t v);
+static int32_t tree_sum(const int32_t * t, uint32_t i);
+static uint32_t tree_find(const int32_t * t, uint32_t n, int32_t y);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_vlist_class  = {
+    .constructor_cb = lv_vlist_constructor,
+    .destructor_cb = lv_vlist_destructor,
+    .event_cb = lv_vlist_event,
+    .width_def = (LV_DPI_DEF * 3) / 2,
+    .height_def = LV_DPI_DEF * 2,
+    .base_class = &lv_obj_class,
+    .instance_size = sizeof(lv_vlist_t),
+    .name = "vlist",
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_vlist_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+void lv_vlist_set_row_count(lv_obj_t * obj, uint32_t row_cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(vlist->row_cnt == row_cnt) return;
+
+    if(vlist->heights) {
+        /*Keep the measured heights and use the estimated height for the new rows*/
+        tree_unbuild(vlist->heights, vlist->row_cnt);
+        vlist->heights = lv_realloc(vlist->heights, (row_cnt + 1) * sizeof(int32_t));
+        LV_ASSERT_MALLOC(vlist->heights);
+        if(vlist->heights == NULL) {
+            vlist->row_cnt = 0;
+            return;
+        }
+        uint32_t i;
+        for(i = vlist->row_cnt + 1; i <= row_cnt; i++) vlist->heights[i] = vlist->row_h;
+        tree_build(vlist->heights, row_cnt);
+    }
+
+    vlist->row_cnt = row_cnt;
+    lv_obj_refresh_self_size(obj);
+    update_window(obj, true);
+}
+
+void lv_vlist_set_row_height(lv_obj_t * obj, int32_t h)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    lv_free(vlist->heights);
+    vlist->heights = NULL;
+    vlist->row_h = LV_MAX(h, 1);
+
+    lv_obj_refresh_self_size(obj);
+    update_window(obj, true);
+}
+
+void lv_vlist_set_estimated_row_height(lv_obj_t * obj, int32_t h)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    vlist->row_h = LV_MAX(h, 1);
+
+    lv_free(vlist->heights);
+    vlist->heights = lv_malloc((vlist->row_cnt + 1) * sizeof(int32_t));
+    LV_ASSERT_MALLOC(vlist->heights);
+    if(vlist->heights == NULL) {
+        vlist->row_cnt = 0;
+    }
+    else {
+        uint32_t i;
+        for(i = 1; i <= vlist->row_cnt; i++) vlist->heights[i] = vlist->row_h;
+        tree_build(vlist->heights, vlist->row_cnt);
+    }
+
+    lv_obj_refresh_self_size(obj);
+    update_window(obj, true);
+}
+
+void lv_vlist_set_overscan(lv_obj_t * obj, uint32_t cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    vlist->overscan = cnt;
+    update_window(obj, false);
+}
+
+void lv_vlist_set_create_cb(lv_obj_t * obj, lv_vlist_create_cb_t cb)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    vlist->create_cb = cb;
+    delete_pool(obj);
+    update_window(obj, true);
+}
+
+void lv_vlist_set_bind_cb(lv_obj_t * obj, lv_vlist_bind_cb_t cb)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    vlist->bind_cb = cb;
+    update_window(obj, true);
+}
+
+void lv_vlist_set_text_cb(lv_obj_t * obj, lv_vlist_text_cb_t cb)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    vlist->text_cb = cb;
+    update_window(obj, true);
+}
+
+void lv_vlist_set_column_count(lv_obj_t * obj, uint32_t col_cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(vlist->col_cnt == col_cnt) return;
+
+    vlist->col_w = lv_realloc(vlist->col_w, col_cnt * sizeof(int32_t));
+    LV_ASSERT_MALLOC(vlist->col_w);
+    if(vlist->col_w == NULL) {
+        vlist->col_cnt = 0;
+        return;
+    }
+
+    uint32_t i;
+    for(i = vlist->col_cnt; i < col_cnt; i++) vlist->col_w[i] = LV_SIZE_CONTENT;
+    vlist->col_cnt = col_cnt;
+
+    delete_pool(obj);
+    update_window(obj, true);
+}
+
+void lv_vlist_set_column_width(lv_obj_t * obj, uint32_t col_id, int32_t w)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(col_id >= vlist->col_cnt) {
+        LV_LOG_WARN("invalid col_id: %" LV_PRIu32 " (col_cnt: %" LV_PRIu32 ")", col_id, vlist->col_cnt);
+        return;
+    }
+
+    vlist->col_w[col_id] = w;
+    if(vlist->create_cb) return;
+
+    uint32_t i;
+    for(i = 0; i < vlist->pool_size; i++) {
+        lv_obj_t * label = lv_obj_get_child(vlist->pool[i].obj, col_id);
+        if(label == NULL) continue;
+        if(w == LV_SIZE_CONTENT) {
+            lv_obj_set_width(label, 0);
+            lv_obj_set_flex_grow(label, 1);
+        }
+        else {
+            lv_obj_set_flex_grow(label, 0);
+            lv_obj_set_width(label, w);
+        }
+    }
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+uint32_t lv_vlist_get_row_count(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    return vlist->row_cnt;
+}
+
+lv_obj_t * lv_vlist_get_row_obj(lv_obj_t * obj, uint32_t row)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    uint32_t i;
+    for(i = 0; i < vlist->pool_size; i++) {
+        if(vlist->pool[i].row == row) return vlist->pool[i].obj;
+    }
+
+    return NULL;
+}
+
+uint32_t lv_vlist_get_row_index(lv_obj_t * obj, lv_obj_t * row_obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    /*Find the direct child of the list*/
+    while(row_obj && lv_obj_get_parent(row_obj) != obj) row_obj = lv_obj_get_parent(row_obj);
+    if(row_obj == NULL) return LV_VLIST_ROW_NONE;
+
+    uint32_t i;
+    for(i = 0; i < vlist->pool_size; i++) {
+        if(vlist->pool[i].obj == row_obj) return vlist->pool[i].row;
+    }
+
+    return LV_VLIST_ROW_NONE;
+}
+
+uint32_t lv_vlist_get_pool_size(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    return vlist->pool_size;
+}
+
+int32_t lv_vlist_get_row_y(lv_obj_t * obj, uint32_t row)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(row > vlist->row_cnt) row = vlist->row_cnt;
+
+    if(vlist->heights) return tree_sum(vlist->heights, row);
+    else return (int32_t)row * vlist->row_h;
+}
+
+/*=====================
+ * Other functions
+ *====================*/
+
+void lv_vlist_refresh(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    update_window(obj, true);
+}
+
+void lv_vlist_refresh_row(lv_obj_t * obj, uint32_t row)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    uint32_t i;
+    for(i = 0; i < vlist->pool_size; i++) {
+        if(vlist->pool[i].row == row) {
+            vlist->updating = 1;
+            bind_row(obj, &vlist->pool[i], row);
+            vlist->updating = 0;
+            update_window(obj, false);
+            return;
+        }
+    }
+}
+
+void lv_vlist_scroll_to_row(lv_obj_t * obj, uint32_t row, lv_anim_enable_t anim_en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_obj_scroll_to_y(obj, lv_vlist_get_row_y(obj, row), anim_en);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_vlist_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    vlist->row_h = LV_DPI_DEF / 3;
+    vlist->overscan = 2;
+    vlist->col_cnt = 1;
+    vlist->col_w = lv_malloc(sizeof(int32_t));
+    LV_ASSERT_MALLOC(vlist->col_w);
+    if(vlist->col_w) vlist->col_w[0] = LV_SIZE_CONTENT;
+    else vlist->col_cnt = 0;
+
+    lv_obj_set_scroll_dir(obj, LV_DIR_VER);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_vlist_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    /*The children are already deleted*/
+    lv_free(vlist->pool);
+    vlist->pool = NULL;
+    vlist->pool_size = 0;
+    lv_free(vlist->heights);
+    vlist->heights = NULL;
+    lv_free(vlist->col_w);
+    vlist->col_w = NULL;
+}
+
+static void lv_vlist_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_result_t res;
+
+    /*Call the ancestor's event handler*/
+    res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RESULT_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_current_target(e);
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    if(code == LV_EVENT_SCROLL || code == LV_EVENT_SIZE_CHANGED || code == LV_EVENT_STYLE_CHANGED) {
+        update_window(obj, false);
+    }
+    else if(code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t * p = lv_event_get_param(e);
+        p->y = LV_MAX(p->y, lv_vlist_get_row_y(obj, vlist->row_cnt));
+    }
+    else if(code == LV_EVENT_CHILD_CHANGED) {
+        /*A row's height might have changed after its content was laid out*/
+        if(vlist->heights == NULL || vlist->updating) return;
+        lv_obj_t * child = lv_event_get_param(e);
+        if(child == NULL) return;
+        uint32_t row = lv_vlist_get_row_index(obj, child);
+        if(row == LV_VLIST_ROW_NONE) return;
+        int32_t h = lv_obj_get_height(child);
+        int32_t h_ori = get_row_h(vlist, row);
+        if(h != h_ori) {
+            tree_add(vlist->heights, vlist->row_cnt, row, h - h_ori);
+            update_window(obj, false);
+        }
+    }
+    else if(code == LV_EVENT_CHILD_DELETED) {
+        prune_pool(obj);
+    }
+}
+
+/**
+ * Bind the rows in the visible area and recycle the others.
+ * With estimated heights the new rows are measured and the scroll position is corrected
+ * to keep the top visible row in place.
+ * @param obj       pointer to a virtual list
+ * @param rebind    true: bind the already visible rows again too
+ */
+static void update_window(lv_obj_t * obj, bool rebind)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    if(vlist->updating) return;
+
+    vlist->updating = 1;
+
+    uint32_t i;
+    if(rebind) {
+        for(i = 0; i < vlist->pool_size; i++) {
+            vlist->pool[i].row = LV_VLIST_ROW_NONE;
+        }
+    }
+
+    uint32_t iter;
+    for(iter = 0; iter < MEASURE_ITERATION_MAX; iter++) {
+        int32_t scroll_y = lv_obj_get_scroll_y(obj);
+        uint32_t first = 0;
+        uint32_t last = 0;
+        uint32_t anchor = 0;
+        int32_t anchor_ofs = 0;
+        if(vlist->row_cnt) {
+            anchor = get_row_at(vlist, scroll_y);
+            anchor_ofs = scroll_y - lv_vlist_get_row_y(obj, anchor);
+            last = get_row_at(vlist, scroll_y + lv_obj_get_content_height(obj) - 1);
+            first = anchor > vlist->overscan ? anchor - vlist->overscan : 0;
+            last = LV_MIN(last + vlist->overscan, vlist->row_cnt - 1);
+        }
+
+        /*Recycle the rows which are out of the window*/
+        for(i = 0; i < vlist->pool_size; i++) {
+            lv_vlist_row_t * r = &vlist->pool[i];
+            if(r->row != LV_VLIST_ROW_NONE && r->row >= first && r->row <= last) continue;
+            r->row = LV_VLIST_ROW_NONE;
+            lv_obj_add_flag(r->obj, LV_OBJ_FLAG_HIDDEN);
+        }
+
+        /*Bind the rows entering the window*/
+        bool bound = false;
+        if(vlist->row_cnt) {
+            uint32_t row;
+            for(row = first; row <= last; row++) {
+                if(lv_vlist_get_row_obj(obj, row)) continue;
+                lv_vlist_row_t * r = get_free_row(obj);
+                if(r == NULL) break;
+                bind_row(obj, r, row);
+                bound = true;
+            }
+        }
+
+        bool changed = false;
+        if(vlist->heights && bound) changed = measure_rows(obj);
+
+        for(i = 0; i < vlist->pool_size; i++) {
+            lv_vlist_row_t * r = &vlist->pool[i];
+            if(r->row == LV_VLIST_ROW_NONE) continue;
+            lv_obj_set_pos(r->obj, 0, lv_vlist_get_row_y(obj, r->row));
+        }
+
+        if(!changed) break;
+
+        lv_obj_refresh_self_size(obj);
+        int32_t diff = lv_vlist_get_row_y(obj, anchor) + anchor_ofs - scroll_y;
+        if(diff) lv_obj_scroll_by(obj, 0, -diff, LV_ANIM_OFF);
+    }
+
+    vlist->updating = 0;
+}
+
+static void bind_row(lv_obj_t * obj, lv_vlist_row_t * r, uint32_t row)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    r->row = row;
+    lv_obj_remove_flag(r->obj, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_height(r->obj, vlist->heights ? LV_SIZE_CONTENT : vlist->row_h);
+
+    if(vlist->create_cb == NULL && vlist->text_cb) {
+        uint32_t col;
+        for(col = 0; col < vlist->col_cnt; col++) {
+            lv_obj_t * label = lv_obj_get_child(r->obj, col);
+            const char * txt = vlist->text_cb(obj, row, col);
+            lv_label_set_text(label, txt ? txt : "");
+        }
+    }
+
+    if(vlist->bind_cb) vlist->bind_cb(obj, r->obj, row);
+}
+
+static lv_vlist_row_t * get_free_row(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    uint32_t i;
+    for(i = 0; i < vlist->pool_size; i++) {
+        if(vlist->pool[i].row == LV_VLIST_ROW_NONE) return &vlist->pool[i];
+    }
+
+    lv_vlist_row_t * pool = lv_realloc(vlist->pool, (vlist->pool_size + 1) * sizeof(lv_vlist_row_t));
+    LV_ASSERT_MALLOC(pool);
+    if(pool == NULL) return NULL;
+    vlist->pool = pool;
+
+    lv_obj_t * row_obj = vlist->create_cb ? vlist->create_cb(obj) : default_row_create(obj);
+    if(row_obj == NULL) return NULL;
+    LV_ASSERT_MSG(lv_obj_get_parent(row_obj) == obj, "The rows should be the children of the virtual list");
+
+    lv_vlist_row_t * r = &vlist->pool[vlist->pool_size];
+    r->obj = row_obj;
+    r->row = LV_VLIST_ROW_NONE;
+    vlist->pool_size++;
+
+    return r;
+}
+
+static lv_obj_t * default_row_create(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    lv_obj_t * row_obj = lv_obj_create(obj);
+    lv_obj_remove_style_all(row_obj);
+    lv_obj_remove_flag(row_obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(row_obj, LV_OBJ_FLAG_EVENT_BUBBLE);
+    lv_obj_set_width(row_obj, lv_pct(100));
+    lv_obj_set_flex_flow(row_obj, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(row_obj, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+
+    uint32_t col;
+    for(col = 0; col < vlist->col_cnt; col++) {
+        lv_obj_t * label = lv_label_create(row_obj);
+        lv_label_set_text(label, "");
+        if(vlist->heights == NULL) lv_label_set_long_mode(label, LV_LABEL_LONG_CLIP);
+        if(vlist->col_w[col] == LV_SIZE_CONTENT) {
+            lv_obj_set_width(label, 0);
+            lv_obj_set_flex_grow(label, 1);
+        }
+        else {
+            lv_obj_set_width(label, vlist->col_w[col]);
+        }
+    }
+
+    return row_obj;
+}
+
+static void delete_pool(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+
+    /*Empty the pool first to ignore the events of the deleted children*/
+    lv_vlist_row_t * pool = vlist->pool;
+    uint32_t pool_size = vlist->pool_size;
+    vlist->pool = NULL;
+    vlist->pool_size = 0;
+
+    uint32_t i;
+    for(i = 0; i < pool_size; i++) {
+        lv_obj_delete(pool[i].obj);
+    }
+    lv_free(pool);
+}
+
+/**
+ * Remove the rows from the pool which were deleted by the user
+ */
+static void prune_pool(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+
+    uint32_t i = 0;
+    while(i < vlist->pool_size) {
+        bool found = false;
+        uint32_t c;
+        for(c = 0; c < child_cnt; c++) {
+            if(lv_obj_get_child(obj, c) == vlist->pool[i].obj) {
+                found = true;
+                break;
+            }
+        }
+
+        if(found) {
+            i++;
+        }
+        else {
+            vlist->pool_size--;
+            vlist->pool[i] = vlist->pool[vlist->pool_size];
+        }
+    }
+}
+
+/**
+ * Update the stored heights with the heights of the bound rows
+ * @return      true: a height has changed
+ */
+static bool measure_rows(lv_obj_t * obj)
+{
+    lv_vlist_t * vlist = (lv_vlist_t *)obj;
+    lv_obj_update_layout(obj);
+
+    bool changed = false;
+    uint32_t i;
+    for(i = 0; i < vlist->pool_size; i++) {
+        lv_vlist_row_t * r = &vlist->pool[i];
+        if(r->row == LV_VLIST_ROW_NONE) continue;
+        int32_t h = lv_obj_get_height(r->obj);
+        int32_t h_ori = get_row_h(vlist, r->row);
+        if(h != h_ori) {
+            tree_add(vlist->heights, vlist->row_cnt, r->row, h - h_ori);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+static int32_t get_row_h(lv_vlist_t * vlist, uint32_t row)
+{
+    if(vlist->heights == NULL) return vlist->row_h;
+    return tree_sum(vlist->heights, row + 1) - tree_sum(vlist->heights, row);
+}
+
+/**
+ * Get the row at a y coordinate of the content
+ */
+static uint32_t get_row_at(lv_vlist_t * vlist, int32_t y)
+{
+    uint32_t row;
+    if(y < 0) row = 0;
+    else if(vlist->heights) row = tree_find(vlist->heights, vlist->row_cnt, y);
+    else row = y / vlist->row_h;
+
+    return LV_MIN(row, vlist->row_cnt - 1);
+}
+
+/*The row heights are stored in a 1-based Fenwick tree to get the y coordinate
+ *of any row and the row at any y coordinate in O(log n) time*/
+
+static void tree_build(int32_t * t, uint32_t n)
+{
+    uint32_t i;
+    for(i = 1; i <= n; i++) {
+        uint32_t j = i + (i & (~i + 1));
+        if(j <= n) t[j] += t[i];
+    }
+}
+
+static void tree_unbuild(int32_t * t, uint32_t n)
+{
+    uint32_t i;
+    for(i = n; i >= 1; i--) {
+        uint32_t j = i + (i & (~i + 1));
+        if(j <= n) t[j] -= t[i];
+    }
+}
+
+static void tree_add(int32_t * t, uint32_t n, uint32_t i, int32_t v)
+{
+    for(i++; i <= n; i += i & (~i + 1)) t[i] += v;
+}
+
+/**
+ * Sum of the first `i` elements
+ */
+static int32_t tree_sum(const int32_t * t, uint32_t i)
+{
+    int32_t s = 0;
+    for(; i > 0; i -= i & (~i + 1)) s += t[i];
+    return s;
+}
+
+/**
+ * Find the index of the element at `y`, i.e. the number of elements whose sum is <= y
+ */
+static uint32_t tree_find(const int32_t * t, uint32_t n, int32_t y)
+{
+    uint32_t pos = 0;
+    uint32_t step = 1;
+    while(step <= n / 2) step <<= 1;
+
+    for(; step > 0; step >>= 1) {
+        if(pos + step <= n && t[pos + step] <= y) {
+            pos += step;
+            y -= t[pos];
+        }
+    }
+
+    return pos;
+}
+
+#endif
@@ -0,0 +1,228 @@
+/**
+ * @file lv_vlist.h
+ *
+ */
+
+#ifndef LV_VLIST_H
+#define LV_VLIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../label/lv_label.h"
+
+#if LV_USE_VLIST != 0
+
+/*Testing of dependencies*/
+#if LV_USE_LABEL == 0
+#error "lv_vlist: lv_label is required. Enable it in lv_conf.h (LV_USE_LABEL 1)"
+#endif
+
+#if LV_USE_FLEX == 0
+#error "lv_vlist: lv_flex is required. Enable it in lv_conf.h (LV_USE_FLEX 1)"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_VLIST_ROW_NONE 0xFFFFFFFF
+LV_EXPORT_CONST_INT(LV_VLIST_ROW_NONE);
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Create the Widget of a row. Called only when the pool of rows needs to grow.
+ * @param obj       pointer to the virtual list, it should be the parent of the created row
+ * @return          the created row
+ */
+typedef lv_obj_t * (*lv_vlist_create_cb_t)(lv_obj_t * obj);
+
+/**
+ * Fill a row with the data of a row index. Called every time a row becomes visible.
+ * @param obj       pointer to the virtual list
+ * @param row_obj   pointer to the row Widget which is reused for the row
+ * @param row       index of the row [0 .. row_cnt - 1]
+ */
+typedef void (*lv_vlist_bind_cb_t)(lv_obj_t * obj, lv_obj_t * row_obj, uint32_t row);
+
+/**
+ * Get the text of a cell for the default rows.
+ * @param obj       pointer to the virtual list
+ * @param row       index of the row [0 .. row_cnt - 1]
+ * @param col       index of the column [0 .. col_cnt - 1]
+ * @return          the text of the cell. It's copied, so it can be a temporary buffer.
+ */
+typedef const char * (*lv_vlist_text_cb_t)(lv_obj_t * obj, uint32_t row, uint32_t col);
+
+LV_ATTRIBUTE_EXTERN_DATA extern const lv_obj_class_t lv_vlist_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a virtual list object. Only the visible rows have Widgets
+ * which are reused while scrolling.
+ * @param parent        pointer to an object, it will be the parent of the new virtual list
+ * @return              pointer to the created virtual list
+ */
+lv_obj_t * lv_vlist_create(lv_obj_t * parent);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the number of rows. The visible rows are bound again.
+ * @param obj           pointer to a virtual list object
+ * @param row_cnt       number of rows
+ * @note                the measured heights of the existing rows are kept
+ */
+void lv_vlist_set_row_count(lv_obj_t * obj, uint32_t row_cnt);
+
+/**
+ * Use the same fixed height for every row.
+ * @param obj           pointer to a virtual list object
+ * @param h             height of the rows
+ */
+void lv_vlist_set_row_height(lv_obj_t * obj, int32_t h);
+
+/**
+ * Let the rows have their own (`LV_SIZE_CONTENT`) height. The rows which were never visible
+ * are considered to have the estimated height. The heights are measured when the rows become visible.
+ * @param obj           pointer to a virtual list object
+ * @param h             estimated height of the rows
+ * @note                it needs 4 bytes of memory per row
+ */
+void lv_vlist_set_estimated_row_height(lv_obj_t * obj, int32_t h);
+
+/**
+ * Set how many rows to keep bound above and below the visible rows.
+ * @param obj           pointer to a virtual list object
+ * @param cnt           number of extra rows on each side
+ */
+void lv_vlist_set_overscan(lv_obj_t * obj, uint32_t cnt);
+
+/**
+ * Set a callback to create custom row Widgets instead of the default rows with labels.
+ * The existing rows are deleted.
+ * @param obj           pointer to a virtual list object
+ * @param cb            the callback or NULL to use the default rows
+ */
+void lv_vlist_set_create_cb(lv_obj_t * obj, lv_vlist_create_cb_t cb);
+
+/**
+ * Set a callback to fill the rows with data
+ * @param obj           pointer to a virtual list object
+ * @param cb            the callback. It's called after the texts of the default rows are set.
+ */
+void lv_vlist_set_bind_cb(lv_obj_t * obj, lv_vlist_bind_cb_t cb);
+
+/**
+ * Set a callback to get the texts of the cells of the default rows
+ * @param obj           pointer to a virtual list object
+ * @param cb            the callback
+ */
+void lv_vlist_set_text_cb(lv_obj_t * obj, lv_vlist_text_cb_t cb);
+
+/**
+ * Set the number of columns of the default rows. The existing rows are deleted.
+ * @param obj           pointer to a virtual list object
+ * @param col_cnt       number of columns
+ */
+void lv_vlist_set_column_count(lv_obj_t * obj, uint32_t col_cnt);
+
+/**
+ * Set the width of a column of the default rows
+ * @param obj           pointer to a virtual list object
+ * @param col_id        id of the column [0 .. col_cnt - 1]
+ * @param w             width of the column or `LV_SIZE_CONTENT` to share the remaining space
+ */
+void lv_vlist_set_column_width(lv_obj_t * obj, uint32_t col_id, int32_t w);
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the number of rows
+ * @param obj           pointer to a virtual list object
+ * @return              number of rows
+ */
+uint32_t lv_vlist_get_row_count(lv_obj_t * obj);
+
+/**
+ * Get the Widget currently showing a row
+ * @param obj           pointer to a virtual list object
+ * @param row           index of the row
+ * @return              the row Widget or NULL if the row is not bound
+ */
+lv_obj_t * lv_vlist_get_row_obj(lv_obj_t * obj, uint32_t row);
+
+/**
+ * Get the index of the row shown by a row Widget
+ * @param obj           pointer to a virtual list object
+ * @param row_obj       a row Widget or one of its children
+ * @return              index of the row or `LV_VLIST_ROW_NONE`
+ */
+uint32_t lv_vlist_get_row_index(lv_obj_t * obj, lv_obj_t * row_obj);
+
+/**
+ * Get the number of created row Widgets including the currently unused ones
+ * @param obj           pointer to a virtual list object
+ * @return              size of the pool of rows
+ */
+uint32_t lv_vlist_get_pool_size(lv_obj_t * obj);
+
+/**
+ * Get the y coordinate of a row relative to the top of the content
+ * @param obj           pointer to a virtual list object
+ * @param row           index of the row [0 .. row_cnt]
+ * @return              the y coordinate
+ */
+int32_t lv_vlist_get_row_y(lv_obj_t * obj, uint32_t row);
+
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Bind all the visible rows again, e.g. because the data has changed.
+ * The heights are measured again too.
+ * @param obj           pointer to a virtual list object
+ */
+void lv_vlist_refresh(lv_obj_t * obj);
+
+/**
+ * Bind a row again if it's visible
+ * @param obj           pointer to a virtual list object
+ * @param row           index of the row
+ */
+void lv_vlist_refresh_row(lv_obj_t * obj, uint32_t row);
+
+/**
+ * Scroll to a row to show it on the top
+ * @param obj           pointer to a virtual list object
+ * @param row           index of the row
+ * @param anim_en       LV_ANIM_ON: scroll with animation
+ */
+void lv_vlist_scroll_to_row(lv_obj_t * obj, uint32_t row, lv_anim_enable_t anim_en);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_VLIST*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_VLIST_H*/
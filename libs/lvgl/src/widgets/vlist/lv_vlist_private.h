@@ -0,0 +1,67 @@
+/**
+ * @file lv_vlist_private.h
+ *
+ */
+
+#ifndef LV_VLIST_PRIVATE_H
+#define LV_VLIST_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_vlist.h"
+
+#if LV_USE_VLIST != 0
+#include "../../core/lv_obj_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A reusable row Widget */
+typedef struct {
+    lv_obj_t * obj;
+    uint32_t row;       /**< The bound row or LV_VLIST_ROW_NONE if unused*/
+} lv_vlist_row_t;
+
+/** Data of virtual list */
+struct lv_vlist_t {
+    lv_obj_t obj;
+    uint32_t row_cnt;
+    int32_t row_h;              /**< The fixed or estimated row height*/
+    int32_t * heights;          /**< Fenwick tree of the row heights. NULL if the rows have fixed height*/
+    uint32_t overscan;
+    lv_vlist_row_t * pool;
+    uint32_t pool_size;
+    lv_vlist_create_cb_t create_cb;
+    lv_vlist_bind_cb_t bind_cb;
+    lv_vlist_text_cb_t text_cb;
+    int32_t * col_w;
+    uint32_t col_cnt;
+    uint32_t updating : 1;      /**< Ignore the scroll and child change events caused by the update*/
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_VLIST != 0 */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_VLIST_PRIVATE_H*/
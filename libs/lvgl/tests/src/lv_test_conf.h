@@ -30,7 +30,11 @@ extern "C" {
 #define LV_USE_STDLIB_STRING    LV_STDLIB_BUILTIN
 #define LV_USE_STDLIB_SPRINTF   LV_STDLIB_BUILTIN
 #define LV_OBJ_STYLE_CACHE      1
+#define LV_OBJ_STYLE_RES_CACHE_CNT  16
 #define LV_BIN_DECODER_RAM_LOAD 0
+#define LV_CACHE_COMPRESSED_DEF_SIZE    (1024 * 1024)   /* Keep the evicted images compressed */
+#define LV_DRAW_FRAME_ARENA_SIZE        (16 * 1024)     /* Allocate the draw tasks from an arena */
+#define LV_USE_MEM_THREAD_CACHE         1               /* Cache the small blocks in front of TLSF */
 #endif
 
 #ifdef MICROPYTHON
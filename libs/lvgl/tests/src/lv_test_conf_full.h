@@ -45,6 +45,8 @@
 #define LV_FONT_DEFAULT         &lv_font_montserrat_14
 #define LV_FONT_FMT_TXT_LARGE   1
 #define LV_USE_FONT_COMPRESSED  1
+#define LV_FONT_FMT_TXT_LOOKUP  1
+#define LV_FONT_COMPRESSED_CACHE_SIZE   (16 * 1024)
 #define LV_USE_BIDI 1
 #define LV_USE_ARABIC_PERSIAN_CHARS 1
 #define LV_USE_PERF_MONITOR         1
@@ -91,6 +93,7 @@
 #define LV_USE_SYSMON           1
 #define LV_USE_MEM_MONITOR      1
 #define LV_USE_PERF_MONITOR     1
+#define LV_USE_TELEMETRY        1
 #define LV_USE_SNAPSHOT         1
 #define LV_USE_THORVG_INTERNAL  1
 #define LV_USE_LZ4_INTERNAL     1
@@ -117,6 +120,7 @@
 #define LV_USE_OBJ_ID_BUILTIN   1
 
 #define LV_CACHE_DEF_SIZE       (10 * 1024 * 1024)
+#define LV_USE_IMAGE_DECODER_ASYNC      1
 
 #ifndef LV_USE_LINUX_DRM
     #define LV_USE_LINUX_DRM    1
@@ -124,6 +128,8 @@
 
 #ifndef LV_USE_LINUX_FBDEV
     #define LV_USE_LINUX_FBDEV  1
+    #define LV_LINUX_FBDEV_RENDER_MODE  LV_DISPLAY_RENDER_MODE_DIRECT
+    #define LV_LINUX_FBDEV_BUFFER_COUNT 2
 #endif
 
 #ifndef LV_USE_WAYLAND
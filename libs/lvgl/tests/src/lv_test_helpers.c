@@ -1,6 +1,7 @@
 #if LV_BUILD_TEST
 
 #include "lv_test_helpers.h"
+#include <stdlib.h>
 
 void lv_test_wait(uint32_t ms)
 {
@@ -9,4 +10,9 @@ void lv_test_wait(uint32_t ms)
     lv_refr_now(NULL);
 }
 
+bool lv_test_benchmark_enabled(void)
+{
+    return getenv("LV_TEST_BENCHMARK") != NULL;
+}
+
 #endif
@@ -16,7 +16,9 @@ static inline size_t lv_test_get_free_mem(void)
 {
     lv_mem_monitor_t m1;
     lv_mem_monitor(&m1);
-    return m1.free_size;
+    /*Count only the allocated bytes as the free blocks cached by the threads
+     *can't merge with their neighbors and fragment the free size*/
+    return LV_MEM_SIZE - m1.cur_used;
 }
 #endif /* LVGL_CI_USING_SYS_HEAP */
 
@@ -24,4 +26,12 @@ static inline size_t lv_test_get_free_mem(void)
 
 void lv_test_wait(uint32_t ms);
 
+/**
+ * Check if the benchmarks should run with their full workload and report the timings.
+ * Enabled by setting the `LV_TEST_BENCHMARK` environment variable.
+ * Otherwise the benchmarks run only a few iterations to check the results.
+ * @return      true: run the full benchmarks
+ */
+bool lv_test_benchmark_enabled(void);
+
 #endif /*LV_TEST_HELPERS_H*/
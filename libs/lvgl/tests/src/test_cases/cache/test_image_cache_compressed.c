@@ -0,0 +1,165 @@
+#if LV_BUILD_TEST
+
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+LV_IMAGE_DECLARE(test_img_lvgl_logo_png);
+
+/*Enabled only in one of the test configs, so enable it here in the others*/
+#if LV_CACHE_COMPRESSED_DEF_SIZE
+    #define COMPRESSED_SIZE LV_CACHE_COMPRESSED_DEF_SIZE
+#else
+    #define COMPRESSED_SIZE (1024 * 1024)
+#endif
+
+static const void * src = &test_img_lvgl_logo_png;
+static uint32_t img_cache_size;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_image_cache_drop(NULL);
+    img_cache_size = lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_cache, NULL);
+    lv_image_cache_compressed_resize(COMPRESSED_SIZE, false);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_image_cache_resize(img_cache_size, false);
+    lv_image_cache_drop(NULL);
+    lv_image_cache_compressed_resize(LV_CACHE_COMPRESSED_DEF_SIZE, true);
+}
+
+static void open_and_close(void)
+{
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+    lv_image_decoder_close(&dsc);
+}
+
+static void evict_all(void)
+{
+    lv_image_cache_resize(1, true);
+    lv_image_cache_resize(img_cache_size, false);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(LV_GLOBAL_DEFAULT()->img_cache, NULL));
+
+    /*Only queued when evicted*/
+    lv_image_cache_compress_pending();
+}
+
+static size_t get_compressed_size(void)
+{
+    return lv_cache_get_size(LV_GLOBAL_DEFAULT()->img_compressed_cache, NULL);
+}
+
+void test_image_cache_compressed_promote(void)
+{
+    TEST_ASSERT_TRUE(lv_image_cache_compressed_is_enabled());
+
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+    lv_image_header_t header = dsc.decoded->header;
+    uint32_t data_size = dsc.decoded->data_size;
+    uint8_t * ref_data = lv_malloc(data_size);
+    lv_memcpy(ref_data, dsc.decoded->data, data_size);
+    lv_image_decoder_close(&dsc);
+
+    open_and_close();
+    evict_all();
+
+    /*It's compressed to a fraction of its size*/
+    size_t compressed_size = get_compressed_size();
+    TEST_ASSERT_GREATER_THAN(0, compressed_size);
+    TEST_ASSERT_LESS_THAN(data_size, compressed_size);
+
+    /*Decompressed instead of decoded*/
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+    TEST_ASSERT_NOT_NULL(dsc.cache_entry);
+    TEST_ASSERT_EQUAL(data_size, dsc.decoded->data_size);
+    TEST_ASSERT_EQUAL(header.w, dsc.decoded->header.w);
+    TEST_ASSERT_EQUAL(header.h, dsc.decoded->header.h);
+    TEST_ASSERT_EQUAL(header.cf, dsc.decoded->header.cf);
+    TEST_ASSERT_EQUAL(header.stride, dsc.decoded->header.stride);
+    TEST_ASSERT_EQUAL(header.flags, dsc.decoded->header.flags);
+    TEST_ASSERT_EQUAL_MEMORY(ref_data, dsc.decoded->data, data_size);
+    lv_image_decoder_close(&dsc);
+    lv_free(ref_data);
+
+    /*The compressed copy is kept*/
+    TEST_ASSERT_EQUAL(compressed_size, get_compressed_size());
+    evict_all();
+    TEST_ASSERT_EQUAL(compressed_size, get_compressed_size());
+
+    /*Invalidating the image removes it from both caches*/
+    open_and_close();
+    lv_image_cache_drop(src);
+    TEST_ASSERT_EQUAL(0, get_compressed_size());
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(LV_GLOBAL_DEFAULT()->img_cache, NULL));
+}
+
+void test_image_cache_compressed_skips_rarely_used(void)
+{
+    open_and_close();
+    evict_all();
+    TEST_ASSERT_EQUAL(0, get_compressed_size());
+}
+
+void test_image_cache_compressed_drop_all(void)
+{
+    open_and_close();
+    open_and_close();
+    evict_all();
+    TEST_ASSERT_GREATER_THAN(0, get_compressed_size());
+
+    lv_image_cache_drop(NULL);
+    TEST_ASSERT_EQUAL(0, get_compressed_size());
+}
+
+void test_image_cache_compressed_on_refresh(void)
+{
+    open_and_close();
+    open_and_close();
+    lv_image_cache_resize(1, true);
+    lv_image_cache_resize(img_cache_size, false);
+
+    /*Not compressed while evicting*/
+    TEST_ASSERT_EQUAL(0, get_compressed_size());
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN(0, get_compressed_size());
+
+    /*Invalidated images are not compressed later*/
+    lv_image_cache_drop(NULL);
+    open_and_close();
+    open_and_close();
+    lv_image_cache_resize(1, true);
+    lv_image_cache_resize(img_cache_size, false);
+    lv_image_cache_drop(src);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, get_compressed_size());
+}
+
+void test_image_cache_compressed_resize(void)
+{
+    open_and_close();
+    open_and_close();
+    evict_all();
+    TEST_ASSERT_GREATER_THAN(0, get_compressed_size());
+
+    lv_image_cache_compressed_resize(1, true);
+    TEST_ASSERT_EQUAL(0, get_compressed_size());
+    lv_image_cache_compressed_resize(COMPRESSED_SIZE, false);
+
+    /*Not cached if it doesn't fit*/
+    lv_image_cache_compressed_resize(16, false);
+    open_and_close();
+    open_and_close();
+    evict_all();
+    TEST_ASSERT_EQUAL(0, get_compressed_size());
+    lv_image_cache_compressed_resize(COMPRESSED_SIZE, false);
+}
+
+#endif
@@ -0,0 +1,248 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * card;
+static lv_obj_t * card_label;
+static uint32_t draw_cnt;
+static uint8_t screen_saved[800 * 480 * 4];
+
+static void draw_main_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+
+static void screen_save(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_draw_buf_t * draw_buf = lv_display_get_buf_active(NULL);
+    lv_memcpy(screen_saved, draw_buf->data, LV_MIN(sizeof(screen_saved), draw_buf->data_size));
+}
+
+/**
+ * Blending the cached image can have a small rounding error compared to drawing the
+ * widgets directly, so compare to the saved screen with some tolerance.
+ * @param tolerance     the allowed difference of the color channels
+ */
+static bool screen_is_similar_to_saved(int32_t tolerance)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_draw_buf_t * draw_buf = lv_display_get_buf_active(NULL);
+    uint32_t size = LV_MIN(sizeof(screen_saved), draw_buf->data_size);
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(LV_ABS((int32_t)screen_saved[i] - (int32_t)draw_buf->data[i]) > tolerance) return false;
+    }
+    return true;
+}
+
+/**
+ * Create a card with shadow, gradient and some children
+ */
+static lv_obj_t * card_create(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 300, 200);
+    lv_obj_set_pos(obj, 40, 40);
+    lv_obj_set_style_radius(obj, 20, 0);
+    lv_obj_set_style_shadow_width(obj, 40, 0);
+    lv_obj_set_style_shadow_offset_y(obj, 10, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_color(obj, lv_palette_main(LV_PALETTE_PURPLE), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(obj, draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    card_label = lv_label_create(obj);
+    lv_label_set_text(card_label, "Cached card");
+    lv_obj_align(card_label, LV_ALIGN_TOP_LEFT, 0, 0);
+
+    lv_obj_t * btn = lv_button_create(obj);
+    lv_obj_set_size(btn, 120, 50);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+
+    lv_obj_t * arc = lv_arc_create(obj);
+    lv_obj_set_size(arc, 80, 80);
+    lv_obj_align(arc, LV_ALIGN_LEFT_MID, 0, 10);
+
+    return obj;
+}
+
+void setUp(void)
+{
+    card = card_create();
+    draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_bitmap_cache_is_rendered_once(void)
+{
+    screen_save();
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, draw_cnt);
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    draw_cnt = 0;
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/bitmap_cache_1.png");
+    TEST_ASSERT_NOT_NULL(card->spec_attr->bitmap_cache);
+    TEST_ASSERT_TRUE(screen_is_similar_to_saved(4));
+
+    /*The card wasn't changed, only the screen was redrawn*/
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+}
+
+void test_bitmap_cache_moving_keeps_the_cache(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    lv_obj_set_pos(card, 300, 200);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/bitmap_cache_2.png");
+    lv_obj_align(card, LV_ALIGN_BOTTOM_RIGHT, -20, -20);
+    lv_obj_set_style_translate_x(card, -100, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    /*It has to look the same as without cache*/
+    screen_save();
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    TEST_ASSERT_TRUE(screen_is_similar_to_saved(4));
+}
+
+void test_bitmap_cache_fading_keeps_the_cache(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_refr_now(NULL);
+
+    lv_obj_set_style_opa_layered(card, LV_OPA_50, 0);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/bitmap_cache_3.png");
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    screen_save();
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    TEST_ASSERT_TRUE(screen_is_similar_to_saved(4));
+}
+
+void test_bitmap_cache_is_updated_when_a_child_changes(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_refr_now(NULL);
+
+    lv_label_set_text(card_label, "Changed text");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_cnt);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/bitmap_cache_4.png");
+
+    /*Resizing changes the content too*/
+    lv_obj_set_width(card, 400);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/bitmap_cache_5.png");
+    TEST_ASSERT_EQUAL_INT32(400 + 2 * lv_obj_get_ext_draw_size(card), card->spec_attr->bitmap_cache->header.w);
+
+    screen_save();
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    TEST_ASSERT_NULL(card->spec_attr->bitmap_cache);
+    TEST_ASSERT_TRUE(screen_is_similar_to_saved(4));
+}
+
+void test_bitmap_cache_nested_and_transformed(void)
+{
+    lv_obj_t * btn = lv_obj_get_child(card, 1);
+    lv_obj_add_flag(btn, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_set_style_transform_rotation(card, 150, 0);
+    lv_obj_set_style_transform_pivot_x(card, LV_PCT(50), 0);
+    lv_obj_set_style_transform_pivot_y(card, LV_PCT(50), 0);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/bitmap_cache_6.png");
+
+    /*Pressing the button redraws the button and the card*/
+    draw_cnt = 0;
+    lv_obj_add_state(btn, LV_STATE_PRESSED);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+    lv_obj_remove_state(btn, LV_STATE_PRESSED);
+
+    screen_save();
+    lv_obj_remove_flag(btn, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    /*Rotating the cache and the transformed layer is done on different areas*/
+    TEST_ASSERT_TRUE(screen_is_similar_to_saved(8));
+}
+
+void test_bitmap_cache_memory_is_freed(void)
+{
+    lv_refr_now(NULL);
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_refr_now(NULL);
+    lv_obj_invalidate(card);
+    lv_refr_now(NULL);
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_refr_now(NULL);
+
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.free_size, mon_end.free_size);
+
+    /*Freed when the object is deleted too*/
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_invalidate(card);
+    lv_refr_now(NULL);
+    TEST_ASSERT_NOT_NULL(card->spec_attr->bitmap_cache);
+    lv_obj_delete(card);
+}
+
+void test_bitmap_cache_objects_are_counted(void)
+{
+    uint32_t cnt_start = LV_GLOBAL_DEFAULT()->bitmap_cache_obj_cnt;
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    TEST_ASSERT_EQUAL_UINT32(cnt_start + 1, LV_GLOBAL_DEFAULT()->bitmap_cache_obj_cnt);
+
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    TEST_ASSERT_EQUAL_UINT32(cnt_start, LV_GLOBAL_DEFAULT()->bitmap_cache_obj_cnt);
+
+    lv_obj_t * btn = lv_obj_get_child(card, 1);
+    lv_obj_add_flag(btn, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    TEST_ASSERT_EQUAL_UINT32(cnt_start + 2, LV_GLOBAL_DEFAULT()->bitmap_cache_obj_cnt);
+
+    lv_obj_delete(card);
+    TEST_ASSERT_EQUAL_UINT32(cnt_start, LV_GLOBAL_DEFAULT()->bitmap_cache_obj_cnt);
+}
+
+void test_bitmap_cache_overflow_visible_is_not_cached(void)
+{
+    /*A child far out of the card and its shadow*/
+    lv_obj_t * child = lv_obj_create(card);
+    lv_obj_set_size(child, 150, 50);
+    lv_obj_align(child, LV_ALIGN_RIGHT_MID, 200, 0);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    screen_save();
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    draw_cnt = 0;
+    TEST_ASSERT_TRUE(screen_is_similar_to_saved(0));
+    TEST_ASSERT_NULL(card->spec_attr->bitmap_cache);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt);
+
+    /*Cached again when the children are clipped*/
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    lv_obj_invalidate(card);
+    lv_refr_now(NULL);
+    TEST_ASSERT_NOT_NULL(card->spec_attr->bitmap_cache);
+}
+
+#endif
@@ -0,0 +1,209 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_FRAME_ARENA_SIZE
+
+static uint32_t task_cnt;
+static uint32_t task_in_arena_cnt;
+
+void setUp(void)
+{
+    task_cnt = 0;
+    task_in_arena_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static bool is_in_arena(const void * data)
+{
+    lv_display_t * disp = lv_display_get_default();
+    if(disp->frame_arena == NULL) return false;
+
+    return (const uint8_t *)data >= disp->frame_arena &&
+           (const uint8_t *)data < disp->frame_arena + LV_DRAW_FRAME_ARENA_SIZE;
+}
+
+static void draw_task_added_cb(lv_event_t * e)
+{
+    lv_draw_task_t * t = lv_event_get_draw_task(e);
+    task_cnt++;
+    if(is_in_arena(t) && is_in_arena(t->draw_dsc)) task_in_arena_cnt++;
+}
+
+static void buttons_create(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * btn = lv_button_create(lv_screen_active());
+        lv_obj_set_pos(btn, (i % 10) * 75, (i / 10) * 45);
+        lv_obj_set_size(btn, 70, 40);
+        lv_obj_add_event_cb(btn, draw_task_added_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+        lv_obj_add_flag(btn, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "%" LV_PRIu32, i);
+        lv_obj_center(label);
+    }
+}
+
+void test_draw_frame_arena_is_used_while_refreshing(void)
+{
+    buttons_create(5);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(task_cnt, task_in_arena_cnt);
+
+    /*It's reset after the refresh*/
+    TEST_ASSERT_EQUAL_UINT32(0, lv_display_get_default()->frame_arena_used);
+}
+
+void test_draw_frame_arena_falls_back_to_the_heap(void)
+{
+    buttons_create(100);
+    lv_refr_now(NULL);
+
+    /*Don't count the allocation of the arena and the caches filled on the first refresh*/
+    lv_mem_monitor_t mon_start;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_mem_monitor(&mon_start);
+
+    task_cnt = 0;
+    task_in_arena_cnt = 0;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, task_in_arena_cnt);
+    TEST_ASSERT_LESS_THAN_UINT32(task_cnt, task_in_arena_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_display_get_default()->frame_arena_used);
+
+    /*Everything allocated from the heap is freed*/
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.free_size, mon_end.free_size);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/frame_arena_fallback.png");
+}
+
+void test_draw_frame_arena_is_not_used_outside_refresh(void)
+{
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(50, 50, LV_COLOR_FORMAT_XRGB8888, LV_STRIDE_AUTO);
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_hex(0xff0000);
+    lv_area_t a = {0, 0, 49, 49};
+    lv_draw_rect(&layer, &dsc, &a);
+
+    TEST_ASSERT_NOT_NULL(layer.draw_task_head);
+    TEST_ASSERT_FALSE(is_in_arena(layer.draw_task_head));
+
+    lv_canvas_finish_layer(canvas, &layer);
+    lv_color32_t px = lv_canvas_get_px(canvas, 10, 10);
+    TEST_ASSERT_EQUAL_UINT8(0xff, px.red);
+    TEST_ASSERT_EQUAL_UINT8(0x00, px.green);
+    TEST_ASSERT_EQUAL_UINT8(0x00, px.blue);
+
+    lv_obj_delete(canvas);
+    lv_draw_buf_destroy(draw_buf);
+}
+
+static lv_obj_t * user_canvas;
+static lv_layer_t user_canvas_layer;
+
+static void draw_to_user_canvas_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    if(user_canvas_layer.draw_buf) return;
+
+    /*Start drawing to a canvas while refreshing and finish it only later*/
+    lv_canvas_init_layer(user_canvas, &user_canvas_layer);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_hex(0x0000ff);
+    lv_area_t a = {0, 0, 49, 49};
+    lv_draw_rect(&user_canvas_layer, &dsc, &a);
+}
+
+void test_draw_frame_arena_is_kept_for_a_user_layer(void)
+{
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(50, 50, LV_COLOR_FORMAT_XRGB8888, LV_STRIDE_AUTO);
+    user_canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(user_canvas, draw_buf);
+    lv_canvas_fill_bg(user_canvas, lv_color_black(), LV_OPA_COVER);
+    lv_obj_add_flag(user_canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_memzero(&user_canvas_layer, sizeof(user_canvas_layer));
+
+    buttons_create(5);
+    lv_obj_add_event_cb(lv_screen_active(), draw_to_user_canvas_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_refr_now(NULL);
+
+    /*The arena isn't reset while the canvas layer uses it, not even by other refreshes*/
+    TEST_ASSERT_TRUE(is_in_arena(user_canvas_layer.draw_task_head));
+    TEST_ASSERT_NOT_EQUAL_UINT32(0, lv_display_get_default()->frame_arena_used);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_NOT_EQUAL_UINT32(0, lv_display_get_default()->frame_arena_used);
+
+    lv_obj_remove_event_cb(lv_screen_active(), draw_to_user_canvas_cb);
+    lv_canvas_finish_layer(user_canvas, &user_canvas_layer);
+    lv_color32_t px = lv_canvas_get_px(user_canvas, 10, 10);
+    TEST_ASSERT_EQUAL_UINT8(0x00, px.red);
+    TEST_ASSERT_EQUAL_UINT8(0x00, px.green);
+    TEST_ASSERT_EQUAL_UINT8(0xff, px.blue);
+
+    /*Reset after the next refresh*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_display_get_default()->frame_arena_used);
+
+    lv_obj_delete(user_canvas);
+    lv_draw_buf_destroy(draw_buf);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_frame_arena_is_used_while_refreshing(void)
+{
+    TEST_PASS();
+}
+
+void test_draw_frame_arena_falls_back_to_the_heap(void)
+{
+    TEST_PASS();
+}
+
+void test_draw_frame_arena_is_not_used_outside_refresh(void)
+{
+    TEST_PASS();
+}
+
+void test_draw_frame_arena_is_kept_for_a_user_layer(void)
+{
+    TEST_PASS();
+}
+
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void create_cards(void)
+{
+    /*The last two are small enough to be cached with the default LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+    static const int32_t sizes[][2] = {{180, 90}, {180, 90}, {60, 30}, {120, 14}, {40, 120}, {180, 90}, {60, 30}, {40, 40}};
+    static const int32_t radii[] = {12, 12, 8, 40, 20, 0, 2, 0};
+    static const int32_t widths[] = {20, 20, 12, 16, 24, 30, 6, 4};
+    static const int32_t spreads[] = {0, 0, 4, 2, 0, 3, 0, 2};
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(scr, 40, 0);
+    lv_obj_set_style_pad_gap(scr, 50, 0);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(radii) / sizeof(radii[0]); i++) {
+        lv_obj_t * obj = lv_obj_create(scr);
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_size(obj, sizes[i][0], sizes[i][1]);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(obj, lv_palette_lighten(LV_PALETTE_BLUE, 3), 0);
+        lv_obj_set_style_radius(obj, radii[i], 0);
+        lv_obj_set_style_shadow_width(obj, widths[i], 0);
+        lv_obj_set_style_shadow_spread(obj, spreads[i], 0);
+        lv_obj_set_style_shadow_offset_y(obj, 5, 0);
+        lv_obj_set_style_shadow_opa(obj, LV_OPA_70, 0);
+    }
+}
+
+void test_shadow_cache_screenshot(void)
+{
+    create_cards();
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_shadow_cache.png");
+    TEST_ASSERT_NOT_EQUAL(0, lv_cache_get_size(LV_GLOBAL_DEFAULT()->sw_shadow_cache, NULL));
+
+    /*Rendered from the cached corners*/
+    lv_obj_invalidate(lv_screen_active());
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_shadow_cache.png");
+
+    /*Recalculated*/
+    lv_cache_drop_all(LV_GLOBAL_DEFAULT()->sw_shadow_cache, NULL);
+    lv_obj_invalidate(lv_screen_active());
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_shadow_cache.png");
+
+    TEST_ASSERT_LESS_OR_EQUAL(LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE,
+                              lv_cache_get_size(LV_GLOBAL_DEFAULT()->sw_shadow_cache, NULL));
+}
+
+void test_circle_cache_is_kept_between_frames(void)
+{
+    lv_cache_t * cache = LV_GLOBAL_DEFAULT()->sw_circle_cache;
+    lv_cache_drop_all(cache, NULL);
+
+    /*Use a new screen to not inherit the layout of the other tests*/
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_screen_load(scr);
+
+    lv_obj_t * obj = lv_obj_create(scr);
+    lv_obj_set_style_radius(obj, 17, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_NOT_EQUAL(0, lv_cache_get_size(cache, NULL));
+
+    /*The circles don't take more memory than configured.
+     *A circle of radius `r` takes `6 * r + 6` bytes so these need about twice the limit.*/
+    int32_t r = 40;
+    uint32_t circle_size_sum = 0;
+    uint32_t i = 0;
+    while(circle_size_sum < LV_DRAW_SW_CIRCLE_CACHE_SIZE * 2) {
+        obj = lv_obj_create(scr);
+        lv_obj_set_size(obj, 2 * r, 2 * r);
+        lv_obj_set_pos(obj, (i % 8) * 90, (i / 8) * 60);
+        lv_obj_set_style_border_width(obj, 0, 0);
+        lv_obj_set_style_radius(obj, r, 0);
+        circle_size_sum += r * 6 + 6;
+        r++;
+        i++;
+    }
+    lv_refr_now(NULL);
+
+    uint32_t cached_size = lv_cache_get_size(cache, NULL);
+    TEST_ASSERT_LESS_OR_EQUAL(LV_DRAW_SW_CIRCLE_CACHE_SIZE, cached_size);
+
+    /*Only as many circles are dropped as required to fit the new ones*/
+    TEST_ASSERT_GREATER_THAN(LV_DRAW_SW_CIRCLE_CACHE_SIZE - (r * 6 + 6), cached_size);
+}
+
+#endif
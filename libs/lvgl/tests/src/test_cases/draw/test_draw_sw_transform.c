@@ -0,0 +1,200 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define SRC_W   40
+#define SRC_H   28
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_draw_buf_t * create_src(lv_color_format_t cf, int32_t w, int32_t h)
+{
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(w, h, cf, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+
+    int32_t x, y;
+    for(y = 0; y < h; y++) {
+        uint8_t * row = draw_buf->data + y * draw_buf->header.stride;
+        for(x = 0; x < w; x++) {
+            uint8_t r = (uint8_t)(x * 255 / (w - 1));
+            uint8_t g = (uint8_t)(y * 255 / (h - 1));
+            uint8_t b = (uint8_t)(((x / 3) + (y / 3)) & 0x1 ? 0xff : 0x20);
+            /*Transparent frame, opaque and semi-transparent areas*/
+            uint8_t a = (x == 0 || y == h - 1) ? 0 : (x < w / 2 ? 0xff : (uint8_t)(y * 255 / h));
+            switch(cf) {
+                case LV_COLOR_FORMAT_ARGB8888:
+                case LV_COLOR_FORMAT_XRGB8888:
+                    row[x * 4 + 0] = b;
+                    row[x * 4 + 1] = g;
+                    row[x * 4 + 2] = r;
+                    row[x * 4 + 3] = cf == LV_COLOR_FORMAT_ARGB8888 ? a : 0xff;
+                    break;
+                case LV_COLOR_FORMAT_RGB888:
+                    row[x * 3 + 0] = b;
+                    row[x * 3 + 1] = g;
+                    row[x * 3 + 2] = r;
+                    break;
+                case LV_COLOR_FORMAT_RGB565:
+                case LV_COLOR_FORMAT_RGB565A8: {
+                        lv_color_t c = lv_color_make(r, g, b);
+                        ((uint16_t *)row)[x] = lv_color_to_u16(c);
+                        if(cf == LV_COLOR_FORMAT_RGB565A8) {
+                            uint8_t * alpha = draw_buf->data + h * draw_buf->header.stride;
+                            alpha[y * (draw_buf->header.stride / 2) + x] = a;
+                        }
+                        break;
+                    }
+                case LV_COLOR_FORMAT_A8:
+                    row[x] = a;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    return draw_buf;
+}
+
+static void create_images(lv_color_format_t cf, const char * ref_path)
+{
+    static const int32_t scales[][2] = {
+        {64, 64}, {128, 128}, {200, 200}, {300, 300}, {512, 512}, {777, 777},
+        {100, 600}, {600, 100}, {384, 256}, {256, 384},
+    };
+
+    lv_draw_buf_t * src = create_src(cf, SRC_W, SRC_H);
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x4488cc), 0);
+
+    /*The images are scaled from the top left corner in 130x100 cells*/
+    uint32_t idx = 0;
+    uint32_t aa;
+    for(aa = 0; aa < 2; aa++) {
+        uint32_t i;
+        for(i = 0; i < sizeof(scales) / sizeof(scales[0]); i++) {
+            lv_obj_t * img = lv_image_create(scr);
+            lv_image_set_src(img, src);
+            lv_image_set_antialias(img, aa);
+            lv_image_set_pivot(img, 0, 0);
+            lv_image_set_scale_x(img, scales[i][0]);
+            lv_image_set_scale_y(img, scales[i][1]);
+            lv_obj_set_pos(img, 10 + (idx % 6) * 130, 10 + (idx / 6) * 100);
+            idx++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_SCREENSHOT(ref_path);
+
+    lv_obj_clean(scr);
+    lv_image_cache_drop(src);
+    lv_draw_buf_destroy(src);
+}
+
+void test_draw_sw_transform_scale_argb8888(void)
+{
+    create_images(LV_COLOR_FORMAT_ARGB8888, "draw/sw_transform_scale_argb8888.png");
+}
+
+void test_draw_sw_transform_scale_xrgb8888(void)
+{
+    create_images(LV_COLOR_FORMAT_XRGB8888, "draw/sw_transform_scale_xrgb8888.png");
+}
+
+void test_draw_sw_transform_scale_rgb888(void)
+{
+    create_images(LV_COLOR_FORMAT_RGB888, "draw/sw_transform_scale_rgb888.png");
+}
+
+void test_draw_sw_transform_scale_rgb565(void)
+{
+    create_images(LV_COLOR_FORMAT_RGB565, "draw/sw_transform_scale_rgb565.png");
+}
+
+void test_draw_sw_transform_scale_rgb565a8(void)
+{
+    create_images(LV_COLOR_FORMAT_RGB565A8, "draw/sw_transform_scale_rgb565a8.png");
+}
+
+void test_draw_sw_transform_scale_a8(void)
+{
+    create_images(LV_COLOR_FORMAT_A8, "draw/sw_transform_scale_a8.png");
+}
+
+static void transform_to(lv_draw_unit_t * draw_unit, lv_draw_buf_t * src, const lv_draw_image_dsc_t * dsc,
+                         const lv_area_t * dest_area, uint8_t * dest, size_t dest_size)
+{
+    lv_memset(dest, 0xaa, dest_size);
+    lv_draw_sw_transform(draw_unit, dest_area, src->data, src->header.w, src->header.h, src->header.stride, dsc, NULL,
+                         src->header.cf, dest);
+}
+
+void test_draw_sw_transform_scale_same_as_per_pixel(void)
+{
+    const lv_color_format_t cfs[] = {
+        LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_RGB888,
+        LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB565A8, LV_COLOR_FORMAT_A8
+    };
+    static const int32_t scales[][2] = {
+        {64, 64}, {200, 200}, {256, 256}, {300, 300}, {777, 777}, {100, 600}, {600, 100},
+    };
+
+    /*The tables of the scale only path are kept in the draw unit*/
+    lv_draw_sw_unit_t unit;
+    lv_memzero(&unit, sizeof(unit));
+
+    uint32_t c;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        lv_draw_buf_t * src = create_src(cfs[c], SRC_W, SRC_H);
+
+        uint32_t i;
+        for(i = 0; i < sizeof(scales) / sizeof(scales[0]) * 2; i++) {
+            lv_draw_image_dsc_t dsc;
+            lv_draw_image_dsc_init(&dsc);
+            dsc.scale_x = scales[i / 2][0];
+            dsc.scale_y = scales[i / 2][1];
+            dsc.antialias = i & 1;
+
+            /*Cover the edges and some pixels out of the image too*/
+            lv_area_t dest_area;
+            lv_area_set(&dest_area, -3, -2, (SRC_W * dsc.scale_x) / 256 + 2, (SRC_H * dsc.scale_y) / 256 + 3);
+
+            /*Large enough for any destination format with an extra A8 plane*/
+            size_t dest_size = (size_t)lv_area_get_size(&dest_area) * 5;
+            uint8_t * dest_scale = lv_malloc(dest_size);
+            uint8_t * dest_generic = lv_malloc(dest_size);
+            TEST_ASSERT_NOT_NULL(dest_scale);
+            TEST_ASSERT_NOT_NULL(dest_generic);
+
+            /*Without a draw unit every pixel is transformed one by one*/
+            transform_to(&unit.base_unit, src, &dsc, &dest_area, dest_scale, dest_size);
+            transform_to(NULL, src, &dsc, &dest_area, dest_generic, dest_size);
+
+            char msg[64];
+            lv_snprintf(msg, sizeof(msg), "cf: %d, scale: %d x %d, aa: %d", cfs[c], (int)dsc.scale_x, (int)dsc.scale_y,
+                        dsc.antialias);
+            TEST_ASSERT_EQUAL_HEX8_ARRAY_MESSAGE(dest_generic, dest_scale, dest_size, msg);
+
+            lv_free(dest_scale);
+            lv_free(dest_generic);
+        }
+
+        lv_draw_buf_destroy(src);
+    }
+
+    TEST_ASSERT_NOT_NULL(unit.transform_buf);
+    lv_free(unit.transform_buf);
+}
+
+#endif
@@ -0,0 +1,149 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    200
+#define CANVAS_H    200
+
+static lv_obj_t * canvas;
+static lv_draw_buf_t * draw_buf;
+
+void setUp(void)
+{
+    draw_buf = lv_draw_buf_create(CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_XRGB8888, LV_STRIDE_AUTO);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_COVER);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_draw_buf_destroy(draw_buf);
+}
+
+static void draw_rect(lv_layer_t * layer, int32_t x1, int32_t y1, int32_t x2, int32_t y2, lv_color_t color)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = color;
+
+    lv_area_t a = {x1, y1, x2, y2};
+    lv_draw_rect(layer, &dsc, &a);
+}
+
+static void assert_px(int32_t x, int32_t y, lv_color_t color)
+{
+    lv_color32_t px = lv_canvas_get_px(canvas, x, y);
+    TEST_ASSERT_EQUAL_UINT8(color.red, px.red);
+    TEST_ASSERT_EQUAL_UINT8(color.green, px.green);
+    TEST_ASSERT_EQUAL_UINT8(color.blue, px.blue);
+}
+
+void test_draw_task_dependency_ready_queue(void)
+{
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    /*The canvas layer is not dispatched until it's finished so the tasks can be inspected*/
+    draw_rect(&layer, 10, 10, 49, 49, lv_color_hex(0xff0000));
+    lv_draw_task_t * t_a = layer.draw_task_head;
+    draw_rect(&layer, 100, 100, 139, 139, lv_color_hex(0x00ff00));
+    lv_draw_task_t * t_b = t_a->next;
+    draw_rect(&layer, 30, 30, 69, 69, lv_color_hex(0x0000ff));
+    lv_draw_task_t * t_c = t_b->next;
+
+    TEST_ASSERT_NOT_NULL(t_c);
+    TEST_ASSERT_EQUAL_UINT32(0, t_a->dep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, t_b->dep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, t_c->dep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_draw_get_dependent_count(t_a));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_draw_get_dependent_count(t_b));
+
+    /*Only the independent tasks can be taken*/
+    uint8_t unit_id = t_a->preferred_draw_unit_id;
+    TEST_ASSERT_EQUAL_PTR(t_a, lv_draw_get_next_available_task(&layer, NULL, unit_id));
+    TEST_ASSERT_EQUAL_PTR(t_b, lv_draw_get_next_available_task(&layer, t_a, unit_id));
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, t_b, unit_id));
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_NULL(layer.draw_task_head);
+    TEST_ASSERT_NULL(layer.draw_task_ready_head);
+    TEST_ASSERT_NULL(layer.draw_task_ready_tail);
+
+    /*The newer task has to be on top*/
+    assert_px(20, 20, lv_color_hex(0xff0000));
+    assert_px(40, 40, lv_color_hex(0x0000ff));
+    assert_px(120, 120, lv_color_hex(0x00ff00));
+}
+
+void test_draw_task_dependency_unsupported_task_releases_its_dependents(void)
+{
+    /*Only a single draw unit finishes the tasks no draw unit supports*/
+    if(lv_draw_get_unit_count() > 1) return;
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    draw_rect(&layer, 10, 10, 49, 49, lv_color_hex(0xff0000));
+    lv_draw_task_t * t_a = layer.draw_task_head;
+    draw_rect(&layer, 30, 30, 69, 69, lv_color_hex(0x0000ff));
+    lv_draw_task_t * t_b = t_a->next;
+    TEST_ASSERT_EQUAL_UINT32(1, t_b->dep_cnt);
+
+    /*Pretend that the first task is preferred by a draw unit which doesn't exist*/
+    uint8_t unit_id = t_a->preferred_draw_unit_id;
+    t_a->preferred_draw_unit_id = unit_id + 1;
+
+    /*It's finished and the task waiting for it can be taken immediately*/
+    TEST_ASSERT_EQUAL_PTR(t_b, lv_draw_get_next_available_task(&layer, NULL, unit_id));
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_READY, t_a->state);
+    TEST_ASSERT_EQUAL_UINT32(0, t_b->dep_cnt);
+
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_NULL(layer.draw_task_head);
+
+    assert_px(20, 20, lv_color_hex(0x000000));
+    assert_px(40, 40, lv_color_hex(0x0000ff));
+}
+
+void test_draw_task_dependency_many_tasks(void)
+{
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    /*A large task below many small ones and a large one on top of a part of them*/
+    draw_rect(&layer, 0, 0, CANVAS_W - 1, CANVAS_H - 1, lv_color_hex(0x808080));
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < CANVAS_H; y += 4) {
+        for(x = 0; x < CANVAS_W; x += 4) {
+            draw_rect(&layer, x, y, x + 1, y + 1, lv_color_hex(0xff0000));
+        }
+    }
+
+    draw_rect(&layer, 0, 0, CANVAS_W - 1, CANVAS_H / 2 - 1, lv_color_hex(0x0000ff));
+
+    uint32_t task_cnt = 0;
+    lv_draw_task_t * t;
+    for(t = layer.draw_task_head; t; t = t->next) task_cnt++;
+    TEST_ASSERT_EQUAL_UINT32(2 + (CANVAS_W / 4) * (CANVAS_H / 4), task_cnt);
+
+    /*Only the background can be drawn first*/
+    TEST_ASSERT_EQUAL_PTR(layer.draw_task_head, layer.draw_task_ready_head);
+    TEST_ASSERT_EQUAL_PTR(layer.draw_task_head, layer.draw_task_ready_tail);
+
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_NULL(layer.draw_task_head);
+
+    assert_px(0, 0, lv_color_hex(0x0000ff));
+    assert_px(2, 2, lv_color_hex(0x0000ff));
+    assert_px(0, CANVAS_H - 4, lv_color_hex(0xff0000));
+    assert_px(2, CANVAS_H - 2, lv_color_hex(0x808080));
+}
+
+#endif
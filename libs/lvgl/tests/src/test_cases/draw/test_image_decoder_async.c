@@ -0,0 +1,205 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#if LV_USE_IMAGE_DECODER_ASYNC && LV_USE_LODEPNG
+
+#define IMG_SRC "A:src/test_assets/test_img_lvgl_logo.png"
+
+static uint32_t fill_task_cnt;
+static uint32_t image_task_cnt;
+
+void setUp(void)
+{
+    lv_image_cache_drop(NULL);
+    fill_task_cnt = 0;
+    image_task_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_image_decoder_async_enable(false);
+    lv_image_decoder_async_set_placeholder(lv_color_hex(0x808080), LV_OPA_20);
+    lv_obj_clean(lv_screen_active());
+    lv_image_cache_drop(NULL);
+}
+
+static void draw_task_added_cb(lv_event_t * e)
+{
+    lv_draw_task_t * t = lv_event_get_draw_task(e);
+    if(t->type == LV_DRAW_TASK_TYPE_FILL) fill_task_cnt++;
+    else if(t->type == LV_DRAW_TASK_TYPE_IMAGE) image_task_cnt++;
+}
+
+static lv_obj_t * create_image(void)
+{
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, IMG_SRC);
+    lv_obj_center(img);
+    lv_obj_add_flag(img, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_add_event_cb(img, draw_task_added_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+    return img;
+}
+
+static void wait_for_decoding(void)
+{
+    /*Run the timers until the workers finish*/
+    uint32_t i;
+    for(i = 0; i < 100000 && lv_image_decoder_async_is_pending(IMG_SRC); i++) {
+        lv_test_wait(1);
+    }
+    TEST_ASSERT_FALSE(lv_image_decoder_async_is_pending(IMG_SRC));
+
+    /*Let the timer invalidate the Widget and redraw it*/
+    lv_test_wait(20);
+}
+
+void test_image_decoder_async_sync_reference(void)
+{
+    create_image();
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(1, image_task_cnt);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/image_decoder_async.png");
+}
+
+void test_image_decoder_async_placeholder_then_image(void)
+{
+    lv_image_decoder_async_enable(true);
+    lv_image_decoder_async_set_placeholder(lv_color_hex(0xff0000), LV_OPA_COVER);
+    create_image();
+
+    /*Not cached yet so only the placeholder is drawn*/
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, fill_task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, image_task_cnt);
+
+    wait_for_decoding();
+    TEST_ASSERT_TRUE(lv_image_cache_contains(IMG_SRC));
+    TEST_ASSERT_EQUAL_UINT32(1, image_task_cnt);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/image_decoder_async.png");
+}
+
+void test_image_decoder_async_shared_source(void)
+{
+    lv_image_decoder_async_enable(true);
+    lv_obj_t * img1 = create_image();
+    lv_obj_t * img2 = create_image();
+    lv_obj_align(img1, LV_ALIGN_TOP_MID, 0, 0);
+    lv_obj_align(img2, LV_ALIGN_BOTTOM_MID, 0, 0);
+
+    /*The first Widget always waits for the decoding. The second one waits for the same
+     *decoding too unless it finished while the first placeholder was drawn.*/
+    lv_refr_now(NULL);
+    TEST_ASSERT_LESS_THAN_UINT32(2, image_task_cnt);
+
+    /*Only the waiting Widgets are redrawn*/
+    wait_for_decoding();
+    TEST_ASSERT_EQUAL_UINT32(2, image_task_cnt);
+}
+
+void test_image_decoder_async_delete_while_decoding(void)
+{
+    lv_image_decoder_async_enable(true);
+    lv_obj_t * img = create_image();
+    lv_refr_now(NULL);
+
+    /*The deleted Widget is not invalidated when the decoding is finished*/
+    lv_obj_delete(img);
+    wait_for_decoding();
+    TEST_ASSERT_EQUAL_UINT32(0, image_task_cnt);
+
+    /*Disabling with queued images must not leak or crash*/
+    create_image();
+    lv_refr_now(NULL);
+    lv_image_decoder_async_enable(false);
+    TEST_ASSERT_FALSE(lv_image_decoder_async_is_pending(IMG_SRC));
+}
+
+void test_image_decoder_async_uncacheable_is_drawn_synchronously(void)
+{
+    uint32_t img_cache_size = lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_cache, NULL);
+    lv_image_cache_resize(1024, true);
+
+    lv_image_decoder_async_enable(true);
+    lv_obj_t * img = create_image();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, fill_task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, image_task_cnt);
+
+    /*Too large for the cache so it's redrawn synchronously*/
+    wait_for_decoding();
+    TEST_ASSERT_FALSE(lv_image_cache_contains(IMG_SRC));
+    TEST_ASSERT_EQUAL_UINT32(1, image_task_cnt);
+
+    /*And it's not queued again*/
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, fill_task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, image_task_cnt);
+    TEST_ASSERT_FALSE(lv_image_decoder_async_is_pending(IMG_SRC));
+
+    lv_image_cache_resize(img_cache_size, false);
+}
+
+void test_image_decoder_async_plain_images_are_not_deferred(void)
+{
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+
+    lv_image_decoder_async_enable(true);
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, &test_image_cogwheel_argb8888);
+    lv_obj_add_flag(img, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_add_event_cb(img, draw_task_added_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, image_task_cnt);
+    TEST_ASSERT_FALSE(lv_image_decoder_async_is_pending(&test_image_cogwheel_argb8888));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_decoder_async_sync_reference(void)
+{
+    TEST_PASS();
+}
+
+void test_image_decoder_async_placeholder_then_image(void)
+{
+    TEST_PASS();
+}
+
+void test_image_decoder_async_shared_source(void)
+{
+    TEST_PASS();
+}
+
+void test_image_decoder_async_delete_while_decoding(void)
+{
+    TEST_PASS();
+}
+
+void test_image_decoder_async_uncacheable_is_drawn_synchronously(void)
+{
+    TEST_PASS();
+}
+
+void test_image_decoder_async_plain_images_are_not_deferred(void)
+{
+    TEST_PASS();
+}
+
+#endif
+
+#endif
@@ -0,0 +1,177 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#include "../src/libs/lz4/lz4.h"
+
+#define BAND_H  16
+#define BANDED_FILE "A:bin_decoder_banded.bin"
+
+LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+
+static uint8_t * banded_data;
+static lv_image_dsc_t banded_img;
+
+static void write_u32(uint8_t * p, uint32_t v)
+{
+    lv_memcpy(p, &v, sizeof(v));
+}
+
+/*Create an LZ4 compressed image whose every BAND_H rows are compressed independently*/
+static void create_banded_image(const lv_image_dsc_t * src, uint32_t band_h)
+{
+    uint32_t stride = src->header.stride;
+    uint32_t h = src->header.h;
+    uint32_t band_cnt = (h + band_h - 1) / band_h;
+    uint32_t table_size = (band_cnt + 1) * 4;
+    uint32_t band_bound = LZ4_compressBound(band_h * stride);
+
+    banded_data = lv_malloc(12 + table_size + band_cnt * band_bound);
+    uint8_t * bands = banded_data + 12 + table_size;
+    uint32_t offset = 0;
+    uint32_t i;
+    for(i = 0; i < band_cnt; i++) {
+        uint32_t rows = LV_MIN(band_h, h - i * band_h);
+        write_u32(banded_data + 12 + i * 4, offset);
+        offset += LZ4_compress_default((const char *)src->data + i * band_h * stride, (char *)bands + offset,
+                                       rows * stride, band_bound);
+    }
+    write_u32(banded_data + 12 + band_cnt * 4, offset);
+
+    write_u32(banded_data, LV_IMAGE_COMPRESS_LZ4 | (band_h << 4));
+    write_u32(banded_data + 4, table_size + offset);
+    write_u32(banded_data + 8, h * stride);
+
+    banded_img.header = src->header;
+    banded_img.header.flags = LV_IMAGE_FLAGS_COMPRESSED;
+    banded_img.data = banded_data;
+    banded_img.data_size = 12 + table_size + offset;
+}
+
+void setUp(void)
+{
+    create_banded_image(&test_image_cogwheel_argb8888, BAND_H);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_image_cache_drop(NULL);
+    lv_free(banded_data);
+    banded_data = NULL;
+}
+
+static void create_images(const void * src)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 360, 240);
+    lv_obj_center(cont);
+
+    lv_obj_t * img = lv_image_create(cont);
+    lv_image_set_src(img, src);
+    lv_obj_align(img, LV_ALIGN_LEFT_MID, 0, 0);
+
+    /*Rotated images have to be decompressed band by band too*/
+    img = lv_image_create(cont);
+    lv_image_set_src(img, src);
+    lv_image_set_rotation(img, 300);
+    lv_obj_center(img);
+
+    /*Clipped by the container*/
+    img = lv_image_create(cont);
+    lv_image_set_src(img, src);
+    lv_obj_align(img, LV_ALIGN_BOTTOM_RIGHT, 40, 60);
+
+    /*Transformed and clipped, only the visible part is collected*/
+    img = lv_image_create(cont);
+    lv_image_set_src(img, src);
+    lv_image_set_rotation(img, 450);
+    lv_image_set_scale(img, 384);
+    lv_obj_align(img, LV_ALIGN_TOP_RIGHT, 60, -70);
+}
+
+static void write_banded_file(void)
+{
+    /*Files need the magic to be recognized*/
+    lv_image_header_t header = banded_img.header;
+    header.magic = LV_IMAGE_HEADER_MAGIC;
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, BANDED_FILE, LV_FS_MODE_WR));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, &header, sizeof(lv_image_header_t), NULL));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, banded_img.data, banded_img.data_size, NULL));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_close(&f));
+}
+
+void test_bin_decoder_banded_reference(void)
+{
+    create_images(&test_image_cogwheel_argb8888);
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/bin_decoder_banded.png");
+}
+
+void test_bin_decoder_banded_draw(void)
+{
+    create_images(&banded_img);
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/bin_decoder_banded.png");
+}
+
+void test_bin_decoder_banded_draw_file(void)
+{
+    write_banded_file();
+    create_images(BANDED_FILE);
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/bin_decoder_banded.png");
+}
+
+void test_bin_decoder_banded_get_area(void)
+{
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, &banded_img, NULL));
+
+    /*Only decoded on demand*/
+    TEST_ASSERT_NULL(dsc.decoded);
+
+    lv_area_t full_area = {10, 20, 60, 40};
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+
+    /*Rows 20..40 are in the second and third bands*/
+    int32_t y1[] = {16, 32};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_area(&dsc, &full_area, &decoded_area));
+        TEST_ASSERT_EQUAL_INT32(0, decoded_area.x1);
+        TEST_ASSERT_EQUAL_INT32(99, decoded_area.x2);
+        TEST_ASSERT_EQUAL_INT32(y1[i], decoded_area.y1);
+        TEST_ASSERT_EQUAL_INT32(y1[i] + BAND_H - 1, decoded_area.y2);
+        TEST_ASSERT_EQUAL_UINT32(BAND_H, dsc.decoded->header.h);
+
+        /*The band is the same as the original rows*/
+        const uint8_t * ori = test_image_cogwheel_argb8888.data + y1[i] * 400;
+        TEST_ASSERT_EQUAL_MEMORY(ori, dsc.decoded->data, BAND_H * 400);
+    }
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_get_area(&dsc, &full_area, &decoded_area));
+
+    /*The last band is shorter*/
+    full_area.y1 = 98;
+    full_area.y2 = 99;
+    decoded_area.y1 = LV_COORD_MIN;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_area(&dsc, &full_area, &decoded_area));
+    TEST_ASSERT_EQUAL_INT32(96, decoded_area.y1);
+    TEST_ASSERT_EQUAL_INT32(99, decoded_area.y2);
+    TEST_ASSERT_EQUAL_UINT32(4, dsc.decoded->header.h);
+
+    lv_image_decoder_close(&dsc);
+}
+
+void test_bin_decoder_banded_invalid(void)
+{
+    /*Broken offset table*/
+    write_u32(banded_data + 12 + 4, 0xFFFFFF);
+
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_open(&dsc, &banded_img, NULL));
+}
+
+#endif
@@ -91,4 +91,207 @@ void test_anim_delete_custom(void)
     TEST_ASSERT_EQUAL(39, var);
 }
 
+static int32_t var_to_delete;
+
+static void delete_var_completed_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    lv_anim_delete(&var_to_delete, exec_cb);
+}
+
+void test_anim_delete_other_in_completed_cb(void)
+{
+    int32_t var1 = 0;
+    int32_t var2 = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_duration(&a, 100);
+
+    lv_anim_set_var(&a, &var1);
+    lv_anim_start(&a);
+
+    lv_anim_set_var(&a, &var_to_delete);
+    lv_anim_start(&a);
+
+    /*Started as last so it's processed first*/
+    lv_anim_set_var(&a, &var2);
+    lv_anim_set_duration(&a, 10);
+    lv_anim_set_completed_cb(&a, delete_var_completed_cb);
+    lv_anim_start(&a);
+
+    /*The other animations are still processed exactly once after a delete*/
+    lv_test_wait(20);
+    TEST_ASSERT_EQUAL(100, var2);
+    TEST_ASSERT_EQUAL(19, var1);
+    TEST_ASSERT_NULL(lv_anim_get(&var_to_delete, exec_cb));
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+
+    lv_test_wait(20);
+    TEST_ASSERT_EQUAL(39, var1);
+
+    lv_anim_delete(&var1, exec_cb);
+}
+
+static uint32_t style_changed_cnt;
+
+static void style_changed_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    style_changed_cnt++;
+}
+
+static void pad_exec_cb(void * var, int32_t v)
+{
+    lv_obj_set_style_pad_left(var, v, 0);
+}
+
+static void delete_obj_exec_cb(void * var, int32_t v)
+{
+    if(v >= 40) lv_obj_delete(var);
+}
+
+static const lv_style_prop_t trans_props[] = {LV_STYLE_WIDTH, LV_STYLE_HEIGHT, 0};
+
+static lv_obj_t * create_obj_with_size_transition(lv_style_t * style_def, lv_style_t * style_chk,
+                                                  lv_style_transition_dsc_t * trans)
+{
+    lv_style_transition_dsc_init(trans, trans_props, lv_anim_path_linear, 100, 0, NULL);
+
+    lv_style_init(style_def);
+    lv_style_set_size(style_def, 0, 0);
+    lv_style_set_transition(style_def, trans);
+
+    lv_style_init(style_chk);
+    lv_style_set_size(style_chk, 100, 100);
+    lv_style_set_transition(style_chk, trans);
+
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_add_style(obj, style_def, 0);
+    lv_obj_add_style(obj, style_chk, LV_STATE_CHECKED);
+    lv_obj_add_event_cb(obj, style_changed_cb, LV_EVENT_STYLE_CHANGED, NULL);
+    lv_obj_update_layout(obj);
+    return obj;
+}
+
+void test_anim_style_refresh_is_coalesced(void)
+{
+    lv_style_t style_def;
+    lv_style_t style_chk;
+    lv_style_transition_dsc_t trans;
+    lv_obj_t * obj = create_obj_with_size_transition(&style_def, &style_chk, &trans);
+
+    lv_obj_add_state(obj, LV_STATE_CHECKED);
+    lv_anim_refr_now();
+
+    /*The transitions of both properties are refreshed once when the animation timer finishes*/
+    style_changed_cnt = 0;
+    lv_tick_inc(50);
+    lv_anim_refr_now();
+    TEST_ASSERT_EQUAL_UINT32(1, style_changed_cnt);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL_INT32(49, lv_obj_get_width(obj));
+    TEST_ASSERT_EQUAL_INT32(49, lv_obj_get_height(obj));
+
+    /*Other animations changing the style are refreshed immediately*/
+    lv_tick_inc(50);
+    lv_anim_refr_now();
+    TEST_ASSERT_EQUAL_UINT32(0, lv_anim_count_running());
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, obj);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_duration(&a, 100);
+    lv_anim_set_early_apply(&a, false);
+    lv_anim_set_exec_cb(&a, pad_exec_cb);
+    lv_anim_start(&a);
+
+    style_changed_cnt = 0;
+    lv_tick_inc(10);
+    lv_anim_refr_now();
+    TEST_ASSERT_EQUAL_UINT32(1, style_changed_cnt);
+    TEST_ASSERT_EQUAL_INT32(9, lv_obj_get_style_pad_left(obj, 0));
+
+    lv_anim_delete(obj, NULL);
+    lv_obj_delete(obj);
+    lv_style_reset(&style_def);
+    lv_style_reset(&style_chk);
+}
+
+void test_anim_style_refresh_of_deleted_obj_is_dropped(void)
+{
+    lv_style_t style_def;
+    lv_style_t style_chk;
+    lv_style_transition_dsc_t trans;
+    lv_obj_t * obj = create_obj_with_size_transition(&style_def, &style_chk, &trans);
+
+    /*Started before the transitions so it's processed after them*/
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, obj);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_duration(&a, 100);
+    lv_anim_set_exec_cb(&a, delete_obj_exec_cb);
+    lv_anim_start(&a);
+
+    lv_obj_add_state(obj, LV_STATE_CHECKED);
+    lv_anim_refr_now();
+
+    /*The object is deleted after the transitions changed its style in the same pass*/
+    lv_tick_inc(50);
+    lv_anim_refr_now();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(lv_screen_active()));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_anim_count_running());
+
+    lv_style_reset(&style_def);
+    lv_style_reset(&style_chk);
+}
+
+static int32_t nested_var_seen;
+
+static void refr_now_exec_cb(void * var, int32_t v)
+{
+    LV_UNUSED(var);
+    LV_UNUSED(v);
+    lv_anim_refr_now();
+    nested_var_seen = var_to_delete;
+}
+
+void test_anim_refr_now_in_exec_cb(void)
+{
+    var_to_delete = 0;
+    int32_t var = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_duration(&a, 100);
+    lv_anim_set_early_apply(&a, false);
+    lv_anim_set_var(&a, &var_to_delete);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_start(&a);
+
+    /*Started as last so it's processed first. It processes the other animation with a nested call.*/
+    lv_anim_set_var(&a, &var);
+    lv_anim_set_exec_cb(&a, refr_now_exec_cb);
+    lv_anim_start(&a);
+
+    nested_var_seen = -1;
+    lv_tick_inc(30);
+    lv_anim_refr_now();
+    TEST_ASSERT_EQUAL(29, nested_var_seen);
+    TEST_ASSERT_EQUAL(29, var_to_delete);
+    TEST_ASSERT_EQUAL(2, lv_anim_count_running());
+
+    /*Complete the animations while nested calls are running*/
+    lv_tick_inc(100);
+    lv_anim_refr_now();
+    TEST_ASSERT_EQUAL(100, var_to_delete);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
 #endif
@@ -0,0 +1,225 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define HOR_RES     256
+#define VER_RES     128
+#define TILE_SIZE   64
+#define MAX_FLUSH   64
+
+static lv_display_t * disp;
+static lv_display_t * default_disp;
+static uint32_t fb[HOR_RES * VER_RES];
+static lv_area_t flushed_areas[MAX_FLUSH];
+static uint32_t flush_cnt;
+static bool last_flushed;
+
+static uint8_t * flushed_px_maps[MAX_FLUSH];
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    if(flush_cnt < MAX_FLUSH) {
+        flushed_areas[flush_cnt] = *area;
+        flushed_px_maps[flush_cnt] = px_map;
+    }
+    flush_cnt++;
+    last_flushed = lv_display_flush_is_last(d);
+
+    /*The buffer contains only the tile*/
+    int32_t w = lv_area_get_width(area);
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_XRGB8888);
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb[y * HOR_RES + area->x1], px_map, w * 4);
+        px_map += stride;
+    }
+
+    lv_display_flush_ready(d);
+}
+
+void setUp(void)
+{
+    static uint8_t buf[TILE_SIZE * TILE_SIZE * 4 + LV_DRAW_BUF_ALIGN];
+
+    default_disp = lv_display_get_default();
+    disp = lv_display_create(HOR_RES, VER_RES);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);
+    lv_display_set_buffers(disp, lv_draw_buf_align(buf, LV_COLOR_FORMAT_XRGB8888), NULL, TILE_SIZE * TILE_SIZE * 4,
+                           LV_DISPLAY_RENDER_MODE_TILED);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_default(disp);
+
+    /*Render the initial screen*/
+    lv_refr_now(disp);
+    flush_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_display_delete(disp);
+    lv_display_set_default(default_disp);
+}
+
+static void assert_flushed(uint32_t idx, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    TEST_ASSERT_EQUAL_INT32(x1, flushed_areas[idx].x1);
+    TEST_ASSERT_EQUAL_INT32(y1, flushed_areas[idx].y1);
+    TEST_ASSERT_EQUAL_INT32(x2, flushed_areas[idx].x2);
+    TEST_ASSERT_EQUAL_INT32(y2, flushed_areas[idx].y2);
+}
+
+void test_display_tiled_only_dirty_tiles_are_redrawn(void)
+{
+    lv_area_t a = {70, 10, 80, 20};
+    lv_inv_area(disp, &a);
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(1, flush_cnt);
+    assert_flushed(0, 64, 0, 127, 63);
+    TEST_ASSERT_TRUE(last_flushed);
+    TEST_ASSERT_EQUAL_UINT32(TILE_SIZE * TILE_SIZE, lv_display_get_refr_px_count(disp));
+
+    /*Area on 2 tiles*/
+    flush_cnt = 0;
+    lv_area_t b = {60, 70, 70, 80};
+    lv_inv_area(disp, &b);
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(2, flush_cnt);
+    assert_flushed(0, 0, 64, 63, 127);
+    assert_flushed(1, 64, 64, 127, 127);
+    TEST_ASSERT_TRUE(last_flushed);
+}
+
+void test_display_tiled_full_screen(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32((HOR_RES / TILE_SIZE) * (VER_RES / TILE_SIZE), flush_cnt);
+    TEST_ASSERT_EQUAL_UINT32(HOR_RES * VER_RES, lv_display_get_refr_px_count(disp));
+
+    /*Smaller tiles*/
+    flush_cnt = 0;
+    lv_display_set_tile_size(disp, 32, 32);
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32((HOR_RES / 32) * (VER_RES / 32), flush_cnt);
+    assert_flushed(0, 0, 0, 31, 31);
+}
+
+void test_display_tiled_render(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xff0000), 0);
+    lv_obj_set_pos(obj, 60, 60);
+    lv_obj_set_size(obj, 10, 10);
+    lv_refr_now(disp);
+
+    /*The object is on 4 tiles*/
+    TEST_ASSERT_EQUAL_UINT32(4, flush_cnt);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, fb[60 * HOR_RES + 60] & 0xffffff);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, fb[69 * HOR_RES + 69] & 0xffffff);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, fb[64 * HOR_RES + 63] & 0xffffff);
+    TEST_ASSERT_NOT_EQUAL(0xff0000, fb[70 * HOR_RES + 70] & 0xffffff);
+    TEST_ASSERT_NOT_EQUAL(0xff0000, fb[59 * HOR_RES + 65] & 0xffffff);
+}
+
+static uint32_t tile_layer_cnt_max;
+
+static void count_tile_layers_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+
+    /*The tiles are on layers without parent*/
+    uint32_t cnt = 0;
+    lv_layer_t * layer = disp->layer_head;
+    while(layer) {
+        if(layer->parent == NULL) cnt++;
+        layer = layer->next;
+    }
+
+    if(cnt > tile_layer_cnt_max) tile_layer_cnt_max = cnt;
+}
+
+void test_display_tiled_parallel(void)
+{
+    /*Buffer for 4 tiles*/
+    static uint8_t buf4[4 * (TILE_SIZE * TILE_SIZE * 4 + LV_DRAW_BUF_ALIGN)];
+    lv_display_set_buffers(disp, lv_draw_buf_align(buf4, LV_COLOR_FORMAT_XRGB8888), NULL, sizeof(buf4) - LV_DRAW_BUF_ALIGN,
+                           LV_DISPLAY_RENDER_MODE_TILED);
+
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x00ff00), 0);
+    lv_obj_set_pos(obj, 0, 0);
+    lv_obj_set_size(obj, HOR_RES, VER_RES);
+    lv_obj_add_event_cb(obj, count_tile_layers_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    flush_cnt = 0;
+    tile_layer_cnt_max = 0;
+    lv_refr_now(disp);
+
+    /*The tiles of a batch are on their own layers at the same time and in their own buffers*/
+    TEST_ASSERT_EQUAL_UINT32(8, flush_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, tile_layer_cnt_max);
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < 4; i++) {
+        for(j = i + 1; j < 4; j++) {
+            TEST_ASSERT_NOT_EQUAL(flushed_px_maps[i], flushed_px_maps[j]);
+        }
+        TEST_ASSERT_EQUAL_PTR(flushed_px_maps[i], flushed_px_maps[i + 4]);
+    }
+
+    /*Only the display's layer remains*/
+    TEST_ASSERT_NULL(disp->layer_head->next);
+
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, fb[0] & 0xffffff);
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, fb[63 * HOR_RES + HOR_RES - 1] & 0xffffff);
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, fb[70 * HOR_RES + 130] & 0xffffff);
+
+    /*With 2 buffers the next batch is rendered into the other buffer*/
+    static uint8_t buf4_2[sizeof(buf4)];
+    lv_display_set_buffers(disp, lv_draw_buf_align(buf4, LV_COLOR_FORMAT_XRGB8888),
+                           lv_draw_buf_align(buf4_2, LV_COLOR_FORMAT_XRGB8888), sizeof(buf4) - LV_DRAW_BUF_ALIGN,
+                           LV_DISPLAY_RENDER_MODE_TILED);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x0000ff), 0);
+    flush_cnt = 0;
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(8, flush_cnt);
+    TEST_ASSERT_NOT_EQUAL(flushed_px_maps[0], flushed_px_maps[4]);
+    TEST_ASSERT_EQUAL_HEX32(0x0000ff, fb[0] & 0xffffff);
+    TEST_ASSERT_EQUAL_HEX32(0x0000ff, fb[70 * HOR_RES + 130] & 0xffffff);
+}
+
+static void rounder_cb(lv_event_t * e)
+{
+    lv_area_t * a = lv_event_get_param(e);
+    a->x1 = a->x1 & ~0xf;
+    a->x2 = a->x2 | 0xf;
+}
+
+void test_display_tiled_rounded(void)
+{
+    lv_display_add_event_cb(disp, rounder_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_set_tile_size(disp, 40, 32);
+
+    flush_cnt = 0;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+
+    /*The tiles are rounded to 48 px width*/
+    TEST_ASSERT_EQUAL_UINT32(6 * 4, flush_cnt);
+    assert_flushed(0, 0, 0, 47, 31);
+    assert_flushed(1, 48, 0, 95, 31);
+    assert_flushed(5, 240, 0, 255, 31);
+    assert_flushed(6, 0, 32, 47, 63);
+}
+
+#endif
@@ -0,0 +1,221 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#include <time.h>
+
+#define LAST_CP     0x20000
+
+/*A small font with kerning pairs as none of the built-in fonts have them*/
+static const lv_font_fmt_txt_glyph_dsc_t kern_glyph_dsc[] = {
+    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /*id = 0 reserved*/,
+    {.bitmap_index = 0, .adv_w = 160, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 0, .adv_w = 160, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 0, .adv_w = 160, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 0, .adv_w = 160, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},
+};
+
+static const lv_font_fmt_txt_cmap_t kern_cmaps[] = {
+    {
+        .range_start = 'A', .range_length = 4, .glyph_id_start = 1,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    }
+};
+
+static const uint8_t kern_pair_ids_8[] = {1, 2, 1, 4, 2, 1, 3, 3, 4, 1};
+static const uint16_t kern_pair_ids_16[] = {1, 2, 1, 4, 2, 1, 3, 3, 4, 1};
+static const int8_t kern_pair_values[] = {-16, -32, 16, -48, 32};
+
+static lv_font_fmt_txt_kern_pair_t kern_pairs = {
+    .glyph_ids = kern_pair_ids_8,
+    .values = kern_pair_values,
+    .pair_cnt = 5,
+    .glyph_ids_size = 0
+};
+
+static lv_font_fmt_txt_dsc_t kern_font_dsc = {
+    .glyph_dsc = kern_glyph_dsc,
+    .cmaps = kern_cmaps,
+    .kern_dsc = &kern_pairs,
+    .kern_scale = 16,
+    .cmap_num = 1,
+    .bpp = 1,
+    .kern_classes = 0,
+};
+
+static lv_font_t kern_font = {
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,
+    .line_height = 10,
+    .base_line = 0,
+    .dsc = &kern_font_dsc,
+    .kerning = LV_FONT_KERNING_NORMAL,
+};
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static uint32_t glyph_ids[LAST_CP];
+
+static void get_glyph_ids(const lv_font_t * font)
+{
+    lv_font_glyph_dsc_t g;
+    uint32_t cp;
+    for(cp = 0; cp < LAST_CP; cp++) {
+        /*Don't return the fallback's glyphs*/
+        bool found = lv_font_get_glyph_dsc_fmt_txt(font, &g, cp, '\0');
+        glyph_ids[cp] = found ? g.gid.index : 0;
+    }
+}
+
+static void check_font(const lv_font_t * font)
+{
+    get_glyph_ids(font);
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(font));
+
+    lv_font_glyph_dsc_t g;
+    uint32_t cp;
+    for(cp = 0; cp < LAST_CP; cp++) {
+        bool found = lv_font_get_glyph_dsc_fmt_txt(font, &g, cp, '\0');
+        TEST_ASSERT_EQUAL_UINT32(glyph_ids[cp], found ? g.gid.index : 0);
+    }
+
+    lv_font_fmt_txt_lookup_delete(font);
+}
+
+void test_font_fmt_txt_lookup_glyph_ids(void)
+{
+    check_font(&lv_font_montserrat_14);
+    check_font(&lv_font_dejavu_16_persian_hebrew);
+    check_font(&lv_font_simsun_14_cjk);
+    check_font(&lv_font_simsun_16_cjk);
+    check_font(&lv_font_unscii_8);
+}
+
+static void check_kerning(void)
+{
+    static const char letters[] = "ABCD";
+    int32_t widths[4][4];
+    uint32_t l;
+    uint32_t r;
+    for(l = 0; l < 4; l++) {
+        for(r = 0; r < 4; r++) {
+            widths[l][r] = lv_font_get_glyph_width(&kern_font, letters[l], letters[r]);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT32(10 - 1, widths[0][1]);  /*A-B*/
+    TEST_ASSERT_EQUAL_INT32(10 + 2, widths[3][0]);  /*D-A*/
+    TEST_ASSERT_EQUAL_INT32(10 - 3, widths[2][2]);  /*C-C*/
+    TEST_ASSERT_EQUAL_INT32(10, widths[1][3]);      /*B-D: no kerning*/
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(&kern_font));
+    for(l = 0; l < 4; l++) {
+        for(r = 0; r < 4; r++) {
+            TEST_ASSERT_EQUAL_INT32(widths[l][r], lv_font_get_glyph_width(&kern_font, letters[l], letters[r]));
+        }
+    }
+    lv_font_fmt_txt_lookup_delete(&kern_font);
+}
+
+void test_font_fmt_txt_lookup_kerning(void)
+{
+    kern_pairs.glyph_ids = kern_pair_ids_8;
+    kern_pairs.glyph_ids_size = 0;
+    check_kerning();
+
+    kern_pairs.glyph_ids = kern_pair_ids_16;
+    kern_pairs.glyph_ids_size = 1;
+    check_kerning();
+}
+
+/*Check if the lookup tables of a font are in the hash table*/
+static bool lookup_is_indexed(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_lookup_list_t * lookups = &LV_GLOBAL_DEFAULT()->font_fmt_txt_lookups;
+    if(lookups->slots == NULL) return false;
+
+    uint32_t i;
+    for(i = 0; i <= lookups->slot_mask; i++) {
+        if(lookups->slots[i] && lookups->slots[i]->dsc == font->dsc) return true;
+    }
+
+    return false;
+}
+
+void test_font_fmt_txt_lookup_delete(void)
+{
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(&lv_font_simsun_16_cjk));
+    /*Creating again is a no-op*/
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(&lv_font_simsun_16_cjk));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(&lv_font_simsun_14_cjk));
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(&lv_font_montserrat_14));
+
+    /*The remaining fonts are still found after deleting one*/
+    lv_font_fmt_txt_lookup_delete(&lv_font_simsun_16_cjk);
+    TEST_ASSERT_NOT_NULL(LV_GLOBAL_DEFAULT()->font_fmt_txt_lookups.head);
+    TEST_ASSERT_TRUE(lookup_is_indexed(&lv_font_simsun_14_cjk));
+    TEST_ASSERT_TRUE(lookup_is_indexed(&lv_font_montserrat_14));
+    TEST_ASSERT_FALSE(lookup_is_indexed(&lv_font_simsun_16_cjk));
+
+    lv_font_fmt_txt_lookup_delete(&lv_font_montserrat_14);
+    lv_font_fmt_txt_lookup_delete(&lv_font_simsun_14_cjk);
+    TEST_ASSERT_NULL(LV_GLOBAL_DEFAULT()->font_fmt_txt_lookups.head);
+    TEST_ASSERT_FALSE(lookup_is_indexed(&lv_font_simsun_14_cjk));
+
+    /*Deleting a font without tables is a no-op*/
+    lv_font_fmt_txt_lookup_delete(&lv_font_simsun_14_cjk);
+}
+
+static uint32_t lookups_per_sec(const lv_font_t * font)
+{
+    /*Look up all CJK Unified Ideographs*/
+    const uint32_t cp_first = 0x4E00;
+    const uint32_t cp_last = 0x9FFF;
+    const uint32_t rounds = 20;
+    lv_font_glyph_dsc_t g;
+    volatile uint32_t found_cnt = 0;
+
+    clock_t start = clock();
+    uint32_t r;
+    for(r = 0; r < rounds; r++) {
+        uint32_t cp;
+        for(cp = cp_first; cp <= cp_last; cp++) {
+            if(lv_font_get_glyph_dsc_fmt_txt(font, &g, cp, cp + 1)) found_cnt++;
+        }
+    }
+    clock_t elapsed = clock() - start;
+    if(elapsed == 0) elapsed = 1;
+
+    uint64_t lookups = (uint64_t)rounds * (cp_last - cp_first + 1);
+    return (uint32_t)(lookups * CLOCKS_PER_SEC / (uint64_t)elapsed);
+}
+
+void test_font_fmt_txt_lookup_benchmark(void)
+{
+    const lv_font_t * fonts[] = {&lv_font_simsun_14_cjk, &lv_font_simsun_16_cjk};
+    const char * names[] = {"simsun_14_cjk", "simsun_16_cjk"};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        uint32_t bsearch_speed = lookups_per_sec(fonts[i]);
+        lv_font_fmt_txt_lookup_create(fonts[i]);
+        uint32_t lookup_speed = lookups_per_sec(fonts[i]);
+        lv_font_fmt_txt_lookup_delete(fonts[i]);
+
+        TEST_PRINTF("%s: %u lookups/s with binary search, %u lookups/s with lookup tables",
+                    names[i], (unsigned int)bsearch_speed, (unsigned int)lookup_speed);
+    }
+}
+
+#endif
@@ -0,0 +1,136 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    lv_font_fmt_txt_glyph_cache_drop_all();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_draw_buf_t * get_bitmap(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, letter, '\0'));
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(g.box_w, g.box_h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+    lv_draw_buf_clear(draw_buf, NULL);
+    TEST_ASSERT_EQUAL_PTR(draw_buf, lv_font_get_glyph_bitmap(&g, draw_buf));
+
+    return draw_buf;
+}
+
+void test_font_glyph_cache_same_bitmap(void)
+{
+    lv_font_fmt_txt_glyph_cache_stats_t stats;
+    const char * letters = "AgW@";
+    uint32_t i;
+    for(i = 0; letters[i]; i++) {
+        lv_draw_buf_t * plain = get_bitmap(&lv_font_montserrat_28, letters[i]);
+        lv_draw_buf_t * miss = get_bitmap(&lv_font_montserrat_28_compressed, letters[i]);
+        lv_draw_buf_t * hit = get_bitmap(&lv_font_montserrat_28_compressed, letters[i]);
+
+        /*Compare without the stride's padding*/
+        uint32_t y;
+        for(y = 0; y < plain->header.h; y++) {
+            uint32_t ofs = y * plain->header.stride;
+            TEST_ASSERT_EQUAL_MEMORY(plain->data + ofs, miss->data + ofs, plain->header.w);
+            TEST_ASSERT_EQUAL_MEMORY(plain->data + ofs, hit->data + ofs, plain->header.w);
+        }
+
+        lv_draw_buf_destroy(plain);
+        lv_draw_buf_destroy(miss);
+        lv_draw_buf_destroy(hit);
+    }
+
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.hit_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.size);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stats.max_size, stats.size);
+}
+
+void test_font_glyph_cache_label(void)
+{
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+    lv_label_set_text(label, "aaaa");
+    lv_refr_now(NULL);
+
+    /*Decompressed only once*/
+    lv_font_fmt_txt_glyph_cache_stats_t stats;
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.hit_cnt);
+
+    /*Not decompressed again on redraw*/
+    lv_obj_invalidate(label);
+    lv_refr_now(NULL);
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(7, stats.hit_cnt);
+}
+
+void test_font_glyph_cache_budget(void)
+{
+    /*Draw a lot of different glyphs*/
+    uint32_t letter;
+    for(letter = 0x21; letter < 0x7F; letter++) {
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(&lv_font_montserrat_28_compressed, &g, letter, '\0')) continue;
+        lv_draw_buf_t * draw_buf = get_bitmap(&lv_font_montserrat_28_compressed, letter);
+        lv_draw_buf_destroy(draw_buf);
+    }
+
+    lv_font_fmt_txt_glyph_cache_stats_t stats;
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stats.max_size, stats.size);
+
+    lv_font_fmt_txt_glyph_cache_drop_all();
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.miss_cnt);
+}
+
+void test_font_glyph_cache_drop_font(void)
+{
+    /*Another font with the same glyphs but a different descriptor*/
+    static lv_font_fmt_txt_dsc_t other_dsc;
+    static lv_font_t other_font;
+    other_font = lv_font_montserrat_28_compressed;
+    other_dsc = *(const lv_font_fmt_txt_dsc_t *)other_font.dsc;
+    other_font.dsc = &other_dsc;
+
+    lv_draw_buf_destroy(get_bitmap(&lv_font_montserrat_28_compressed, 'A'));
+    lv_draw_buf_destroy(get_bitmap(&other_font, 'A'));
+    lv_draw_buf_destroy(get_bitmap(&other_font, 'W'));
+
+    lv_font_fmt_txt_glyph_cache_stats_t stats;
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.miss_cnt);
+    uint32_t size_all = stats.size;
+
+    /*Only the glyphs of the dropped font are removed*/
+    lv_font_fmt_txt_glyph_cache_drop(&other_font);
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_LESS_THAN_UINT32(size_all, stats.size);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.size);
+
+    lv_draw_buf_destroy(get_bitmap(&lv_font_montserrat_28_compressed, 'A'));
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hit_cnt);
+
+    lv_draw_buf_destroy(get_bitmap(&other_font, 'A'));
+    lv_font_fmt_txt_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.miss_cnt);
+}
+
+#endif
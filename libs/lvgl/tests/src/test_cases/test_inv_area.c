@@ -0,0 +1,99 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static lv_display_t * disp;
+
+void setUp(void)
+{
+    disp = lv_display_get_default();
+    lv_refr_now(disp);
+    lv_inv_area(disp, NULL);
+}
+
+void tearDown(void)
+{
+    lv_inv_area(disp, NULL);
+}
+
+static void inv_area(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_area_t a = {x1, y1, x2, y2};
+    lv_inv_area(disp, &a);
+}
+
+static bool is_saved(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_area_t a = {x1, y1, x2, y2};
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(lv_area_is_in(&a, &disp->inv_areas[i], 0)) return true;
+    }
+    return false;
+}
+
+void test_inv_area_covered_areas_are_removed(void)
+{
+    inv_area(10, 10, 19, 19);
+    inv_area(30, 10, 39, 19);
+    inv_area(200, 200, 209, 209);
+    TEST_ASSERT_EQUAL_UINT32(3, disp->inv_p);
+
+    /*Covers the first two*/
+    inv_area(0, 0, 49, 49);
+    TEST_ASSERT_EQUAL_UINT32(2, disp->inv_p);
+    TEST_ASSERT_TRUE(is_saved(0, 0, 49, 49));
+    TEST_ASSERT_TRUE(is_saved(200, 200, 209, 209));
+
+    /*Already covered*/
+    inv_area(5, 5, 15, 15);
+    TEST_ASSERT_EQUAL_UINT32(2, disp->inv_p);
+}
+
+void test_inv_area_full_buffer_joins_closest_areas(void)
+{
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    uint32_t area_cnt = LV_INV_BUF_SIZE + 8;
+    uint32_t i;
+
+    /*Small areas on a grid which can't be joined without extra pixels*/
+    for(i = 0; i < area_cnt; i++) {
+        int32_t x = (i % 8) * 80;
+        int32_t y = (i / 8) * 80;
+        inv_area(x, y, x + 9, y + 9);
+    }
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_INV_BUF_SIZE, disp->inv_p);
+
+    uint32_t px_cnt = 0;
+    for(i = 0; i < disp->inv_p; i++) {
+        px_cnt += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    TEST_ASSERT_LESS_THAN_UINT32((uint32_t)(hor_res * ver_res) / 4, px_cnt);
+
+    /*Nothing is lost*/
+    for(i = 0; i < area_cnt; i++) {
+        int32_t x = (i % 8) * 80;
+        int32_t y = (i / 8) * 80;
+        TEST_ASSERT_TRUE(is_saved(x, y, x + 9, y + 9));
+    }
+}
+
+void test_inv_area_refr_px_count(void)
+{
+    inv_area(10, 10, 19, 19);
+    inv_area(100, 100, 119, 109);
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(300, lv_display_get_refr_px_count(disp));
+
+    /*Overlapping areas are counted once when they are joined*/
+    inv_area(10, 10, 29, 19);
+    inv_area(20, 10, 39, 19);
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(300, lv_display_get_refr_px_count(disp));
+}
+
+#endif
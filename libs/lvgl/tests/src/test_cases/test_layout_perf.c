@@ -0,0 +1,242 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <time.h>
+
+#define COL_CNT 20
+#define ITEM_CNT_MAX 10000
+
+/*Only the first layout is checked by default, the larger ones are built only for benchmarking*/
+static const uint32_t item_cnts[] = {200, 1000, 5000, ITEM_CNT_MAX};
+
+static uint32_t layout_cnt;
+static lv_obj_t * layout_last;
+
+static void layout_changed_cb(lv_event_t * e)
+{
+    layout_cnt++;
+    layout_last = lv_event_get_target(e);
+}
+
+static lv_obj_t * plain_obj_create(lv_obj_t * parent, int32_t w, int32_t h)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+/**
+ * Create a column of rows with `COL_CNT` children in each row
+ */
+static lv_obj_t * flex_table_create(uint32_t item_cnt, int32_t row_w)
+{
+    lv_obj_t * root = plain_obj_create(lv_screen_active(), 800, 480);
+    lv_obj_set_flex_flow(root, LV_FLEX_FLOW_COLUMN);
+    lv_obj_add_event_cb(root, layout_changed_cb, LV_EVENT_LAYOUT_CHANGED, NULL);
+
+    uint32_t i;
+    for(i = 0; i < item_cnt / COL_CNT; i++) {
+        lv_obj_t * row = plain_obj_create(root, row_w, 20);
+        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+        lv_obj_add_event_cb(row, layout_changed_cb, LV_EVENT_LAYOUT_CHANGED, NULL);
+        uint32_t j;
+        for(j = 0; j < COL_CNT; j++) {
+            plain_obj_create(row, 5, 10);
+        }
+    }
+
+    lv_obj_update_layout(root);
+    layout_cnt = 0;
+    layout_last = NULL;
+    return root;
+}
+
+static uint32_t get_item_cnts_num(void)
+{
+    if(!lv_test_benchmark_enabled()) return 1;
+
+    /*`LV_USE_ASSERT_OBJ` checks all the objects in each call which would dominate with many objects*/
+    return LV_USE_ASSERT_OBJ ? 2 : sizeof(item_cnts) / sizeof(item_cnts[0]);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_layout_perf_only_the_dirty_container_is_updated(void)
+{
+    uint32_t item_cnts_num = get_item_cnts_num();
+    uint32_t i;
+    for(i = 0; i < item_cnts_num; i++) {
+        lv_obj_t * root = flex_table_create(item_cnts[i], 600);
+        uint32_t row_cnt = item_cnts[i] / COL_CNT;
+        lv_obj_t * row = lv_obj_get_child(root, row_cnt / 2);
+
+        clock_t start = clock();
+        lv_obj_set_width(lv_obj_get_child(row, COL_CNT / 2), 10);
+        lv_obj_update_layout(root);
+        clock_t elapsed = clock() - start;
+
+        TEST_ASSERT_EQUAL_UINT32(1, layout_cnt);
+        TEST_ASSERT_EQUAL_PTR(row, layout_last);
+        lv_obj_t * item = lv_obj_get_child(row, COL_CNT / 2 + 1);
+        TEST_ASSERT_EQUAL_INT32(COL_CNT / 2 * 5 + 10, item->coords.x1 - row->coords.x1);
+
+        if(lv_test_benchmark_enabled()) {
+            TEST_PRINTF("%u items: %u us to update a row", (unsigned int)item_cnts[i],
+                        (unsigned int)((uint64_t)elapsed * 1000000 / CLOCKS_PER_SEC));
+        }
+
+        /*Nothing to do if nothing has changed*/
+        lv_obj_update_layout(root);
+        TEST_ASSERT_EQUAL_UINT32(1, layout_cnt);
+
+        lv_obj_delete(root);
+    }
+}
+
+void test_layout_perf_parent_resize_skips_unchanged_containers(void)
+{
+    uint32_t item_cnts_num = get_item_cnts_num();
+    lv_obj_t * outer = plain_obj_create(lv_screen_active(), 800, 480);
+    lv_obj_t * wrapper = plain_obj_create(outer, LV_PCT(100), LV_PCT(100));
+    lv_obj_t * root = flex_table_create(item_cnts[item_cnts_num - 1], 600);
+    lv_obj_set_parent(root, wrapper);
+    lv_obj_set_size(root, LV_PCT(100), LV_PCT(100));
+    lv_obj_update_layout(root);
+
+    /*The root follows the size of the outer object but the size of the rows doesn't depend on it*/
+    layout_cnt = 0;
+    lv_obj_set_size(outer, 700, 400);
+    lv_obj_update_layout(root);
+    TEST_ASSERT_EQUAL_UINT32(1, layout_cnt);
+    TEST_ASSERT_EQUAL_PTR(root, layout_last);
+    TEST_ASSERT_EQUAL_INT32(700, lv_obj_get_width(root));
+
+    /*The rows whose size has changed are updated*/
+    lv_obj_t * row = lv_obj_get_child(root, 5);
+    lv_obj_set_width(row, LV_PCT(50));
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_END, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
+    lv_obj_update_layout(root);
+
+    layout_cnt = 0;
+    lv_obj_set_width(outer, 400);
+    lv_obj_update_layout(root);
+    TEST_ASSERT_EQUAL_UINT32(2, layout_cnt);
+    TEST_ASSERT_EQUAL_INT32(200, lv_obj_get_width(row));
+    lv_obj_t * item = lv_obj_get_child(row, COL_CNT - 1);
+    TEST_ASSERT_EQUAL_INT32(row->coords.x2, item->coords.x2);
+
+    /*A style change of the root updates all the rows*/
+    layout_cnt = 0;
+    lv_obj_set_style_pad_left(root, 10, 0);
+    lv_obj_update_layout(root);
+    TEST_ASSERT_EQUAL_UINT32(lv_obj_get_child_count(root) + 1, layout_cnt);
+    TEST_ASSERT_EQUAL_INT32(root->coords.x1 + 10, row->coords.x1);
+}
+
+void test_layout_perf_flex_grow(void)
+{
+    uint32_t item_cnts_num = get_item_cnts_num();
+    uint32_t i;
+    for(i = 0; i < item_cnts_num; i++) {
+        uint32_t item_cnt = item_cnts[i];
+        lv_obj_t * cont = plain_obj_create(lv_screen_active(), (item_cnt - 1) * 2 + 100, 20);
+        lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW);
+        /*A fixed size item between the grow items*/
+        uint32_t j;
+        for(j = 0; j < item_cnt; j++) {
+            lv_obj_t * item = plain_obj_create(cont, j == item_cnt / 2 ? 100 : 5, 10);
+            if(j != item_cnt / 2) lv_obj_set_flex_grow(item, 1);
+        }
+        lv_obj_update_layout(cont);
+
+        lv_obj_t * first = lv_obj_get_child(cont, 0);
+        lv_obj_t * last = lv_obj_get_child(cont, -1);
+        TEST_ASSERT_EQUAL_INT32(2, lv_obj_get_width(first));
+        TEST_ASSERT_EQUAL_INT32(2, lv_obj_get_width(last));
+        TEST_ASSERT_EQUAL_INT32(100, lv_obj_get_width(lv_obj_get_child(cont, item_cnt / 2)));
+        TEST_ASSERT_EQUAL_INT32(cont->coords.x2 - 1, last->coords.x1);
+
+        lv_obj_delete(cont);
+    }
+}
+
+void test_layout_perf_grid_content_tracks(void)
+{
+    static int32_t col_dsc[COL_CNT + 1];
+    static int32_t row_dsc[ITEM_CNT_MAX / COL_CNT + 1];
+
+    uint32_t i;
+    for(i = 0; i < COL_CNT; i++) col_dsc[i] = 4;
+    col_dsc[COL_CNT] = LV_GRID_TEMPLATE_LAST;
+
+    uint32_t item_cnts_num = get_item_cnts_num();
+    for(i = 0; i < item_cnts_num; i++) {
+        uint32_t row_cnt = item_cnts[i] / COL_CNT;
+        uint32_t r;
+        for(r = 0; r < row_cnt; r++) row_dsc[r] = LV_GRID_CONTENT;
+        row_dsc[row_cnt] = LV_GRID_TEMPLATE_LAST;
+
+        lv_obj_t * cont = plain_obj_create(lv_screen_active(), 800, LV_SIZE_CONTENT);
+        lv_obj_set_grid_dsc_array(cont, col_dsc, row_dsc);
+
+        /*The highest item of each row is in a different column*/
+        for(r = 0; r < row_cnt; r++) {
+            uint32_t c;
+            for(c = 0; c < COL_CNT; c++) {
+                lv_obj_t * item = plain_obj_create(cont, 4, c == r % COL_CNT ? 10 + r % 5 : 3);
+                lv_obj_set_grid_cell(item, LV_GRID_ALIGN_START, c, 1, LV_GRID_ALIGN_START, r, 1);
+            }
+        }
+        lv_obj_update_layout(cont);
+
+        int32_t y = 0;
+        for(r = 0; r < row_cnt; r++) {
+            lv_obj_t * item = lv_obj_get_child(cont, r * COL_CNT);
+            TEST_ASSERT_EQUAL_INT32(y, item->coords.y1 - cont->coords.y1);
+            y += 10 + r % 5;
+        }
+        TEST_ASSERT_EQUAL_INT32(y, lv_obj_get_height(cont));
+
+        lv_obj_delete(cont);
+    }
+}
+
+void test_layout_perf_nested_flex_follows_base_dir(void)
+{
+    lv_obj_t * root = plain_obj_create(lv_screen_active(), 400, 100);
+    lv_obj_set_flex_flow(root, LV_FLEX_FLOW_ROW);
+    lv_obj_t * inner = plain_obj_create(root, 200, 50);
+    lv_obj_set_flex_flow(inner, LV_FLEX_FLOW_ROW);
+    uint32_t i;
+    for(i = 0; i < 3; i++) plain_obj_create(inner, 20, 10);
+    lv_obj_update_layout(root);
+
+    lv_obj_t * first = lv_obj_get_child(inner, 0);
+    TEST_ASSERT_EQUAL_INT32(inner->coords.x1, first->coords.x1);
+
+    /*The size of the inner container doesn't change but its items are mirrored*/
+    lv_obj_set_style_base_dir(root, LV_BASE_DIR_RTL, 0);
+    lv_obj_update_layout(root);
+    TEST_ASSERT_EQUAL_INT32(root->coords.x2, inner->coords.x2);
+    TEST_ASSERT_EQUAL_INT32(inner->coords.x2, first->coords.x2);
+
+    lv_obj_set_style_base_dir(root, LV_BASE_DIR_LTR, 0);
+    lv_obj_update_layout(root);
+    TEST_ASSERT_EQUAL_INT32(root->coords.x1, inner->coords.x1);
+    TEST_ASSERT_EQUAL_INT32(inner->coords.x1, first->coords.x1);
+}
+
+#endif
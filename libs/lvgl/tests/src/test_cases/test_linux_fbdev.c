@@ -0,0 +1,244 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_LINUX_FBDEV && !LV_LINUX_FBDEV_BSD && LV_LINUX_FBDEV_BUFFER_COUNT == 2
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/fb.h>
+
+#define HOR_RES     64
+#define VER_RES     48
+#define STRIDE      (HOR_RES * 4)
+
+/*A memory backed stand-in for a framebuffer device: a file for the video memory and emulated ioctls*/
+static char fb_path[] = "/tmp/lv_test_fbdev_XXXXXX";
+static ino_t fb_ino;
+static struct fb_var_screeninfo fb_vinfo;
+static struct fb_fix_screeninfo fb_finfo;
+static uint32_t pan_cnt;
+static uint32_t force_cnt;
+
+static lv_display_t * disp;
+static lv_display_t * default_disp;
+static lv_draw_buf_align_cb align_pointer_cb_orig;
+
+static bool is_fb(int fd)
+{
+    struct stat st;
+    return fstat(fd, &st) == 0 && st.st_ino == fb_ino;
+}
+
+int ioctl(int fd, unsigned long request, ...)
+{
+    va_list args;
+    va_start(args, request);
+    void * arg = va_arg(args, void *);
+    va_end(args);
+
+    if(!is_fb(fd)) return (int)syscall(SYS_ioctl, fd, request, arg);
+
+    switch(request) {
+        case FBIOGET_FSCREENINFO:
+            lv_memcpy(arg, &fb_finfo, sizeof(fb_finfo));
+            return 0;
+        case FBIOGET_VSCREENINFO:
+            lv_memcpy(arg, &fb_vinfo, sizeof(fb_vinfo));
+            return 0;
+        case FBIOPUT_VSCREENINFO: {
+                const struct fb_var_screeninfo * vinfo = arg;
+                if(vinfo->yres_virtual * fb_finfo.line_length > fb_finfo.smem_len) return -1;
+                if(vinfo->activate & FB_ACTIVATE_FORCE) force_cnt++;
+                fb_vinfo = *vinfo;
+                fb_vinfo.activate = 0;
+                return 0;
+            }
+        case FBIOPAN_DISPLAY: {
+                const struct fb_var_screeninfo * vinfo = arg;
+                if(fb_finfo.ypanstep == 0 || vinfo->yoffset + fb_vinfo.yres > fb_vinfo.yres_virtual) return -1;
+                fb_vinfo.yoffset = vinfo->yoffset;
+                pan_cnt++;
+                return 0;
+            }
+        case FBIOBLANK:
+        case FBIO_WAITFORVSYNC:
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+/*Read a pixel above the performance monitor*/
+static uint32_t get_px(uint32_t yoffset, int32_t x, int32_t y)
+{
+    /*The mapping of the driver is shared so the file has the same content*/
+    int fd = open(fb_path, O_RDONLY);
+    TEST_ASSERT_NOT_EQUAL(-1, fd);
+    uint32_t px = 0;
+    TEST_ASSERT_EQUAL(4, pread(fd, &px, 4, (yoffset + y) * STRIDE + x * 4));
+    close(fd);
+    return px & 0xffffff;
+}
+
+static void * align_pointer_cb(void * buf, lv_color_format_t color_format)
+{
+    LV_UNUSED(color_format);
+    return (void *)LV_ROUND_UP((lv_uintptr_t)buf, 64);
+}
+
+static void fb_create(uint32_t ypanstep)
+{
+    int fd = mkstemp(fb_path);
+    TEST_ASSERT_NOT_EQUAL(-1, fd);
+    TEST_ASSERT_EQUAL(0, ftruncate(fd, STRIDE * VER_RES * 2));
+    struct stat st;
+    fstat(fd, &st);
+    fb_ino = st.st_ino;
+    close(fd);
+
+    lv_memzero(&fb_vinfo, sizeof(fb_vinfo));
+    fb_vinfo.xres = HOR_RES;
+    fb_vinfo.yres = VER_RES;
+    fb_vinfo.xres_virtual = HOR_RES;
+    fb_vinfo.yres_virtual = VER_RES;
+    fb_vinfo.bits_per_pixel = 32;
+
+    lv_memzero(&fb_finfo, sizeof(fb_finfo));
+    fb_finfo.line_length = STRIDE;
+    fb_finfo.smem_len = STRIDE * VER_RES * 2;
+    fb_finfo.ypanstep = ypanstep;
+
+    force_cnt = 0;
+
+    default_disp = lv_display_get_default();
+    disp = lv_linux_fbdev_create();
+    lv_linux_fbdev_set_file(disp, fb_path);
+    lv_display_set_default(disp);
+
+    /*Keep the tick of the tests*/
+    lv_tick_set_cb(NULL);
+
+    /*Count only the pans of the frames*/
+    pan_cnt = 0;
+    lv_obj_set_style_bg_opa(lv_screen_active(), LV_OPA_COVER, 0);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+
+    /*The video memory is page aligned but the tests use an odd alignment for the draw buffers*/
+    lv_draw_buf_handlers_t * handlers = lv_draw_buf_get_handlers();
+    align_pointer_cb_orig = handlers->align_pointer_cb;
+    handlers->align_pointer_cb = align_pointer_cb;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_draw_buf_get_handlers()->align_pointer_cb = align_pointer_cb_orig;
+
+    if(disp) {
+        lv_display_delete(disp);
+        disp = NULL;
+        lv_display_set_default(default_disp);
+    }
+    unlink(fb_path);
+    lv_strcpy(fb_path, "/tmp/lv_test_fbdev_XXXXXX");
+}
+
+void test_linux_fbdev_page_flip(void)
+{
+    fb_create(1);
+
+    /*The virtual screen holds the two frames and LVGL renders into them directly*/
+    TEST_ASSERT_EQUAL_UINT32(VER_RES * 2, fb_vinfo.yres_virtual);
+    TEST_ASSERT_EQUAL_UINT32(0, fb_vinfo.yoffset);
+
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0xff0000), 0);
+    lv_refr_now(disp);
+
+    /*The first frame is rendered into the hidden half and shown*/
+    TEST_ASSERT_EQUAL_UINT32(1, pan_cnt);
+    TEST_ASSERT_EQUAL_UINT32(VER_RES, fb_vinfo.yoffset);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, get_px(VER_RES, 10, 2));
+
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0x0000ff), 0);
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(2, pan_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, fb_vinfo.yoffset);
+    TEST_ASSERT_EQUAL_HEX32(0x0000ff, get_px(0, 10, 2));
+    TEST_ASSERT_EQUAL_UINT32(0, force_cnt);
+
+    /*The original virtual screen is restored*/
+    lv_display_delete(disp);
+    disp = NULL;
+    lv_display_set_default(default_disp);
+    TEST_ASSERT_EQUAL_UINT32(VER_RES, fb_vinfo.yres_virtual);
+    TEST_ASSERT_EQUAL_UINT32(0, fb_vinfo.yoffset);
+}
+
+void test_linux_fbdev_page_flip_force_refresh(void)
+{
+    fb_create(1);
+    lv_linux_fbdev_set_force_refresh(disp, true);
+
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0x00ff00), 0);
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(1, force_cnt);
+    TEST_ASSERT_EQUAL_UINT32(VER_RES, fb_vinfo.yoffset);
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, get_px(VER_RES, 10, 2));
+}
+
+void test_linux_fbdev_copy_without_panning(void)
+{
+    fb_create(0);
+
+    /*The virtual screen is not changed and the frames are copied into the visible area*/
+    TEST_ASSERT_EQUAL_UINT32(VER_RES, fb_vinfo.yres_virtual);
+
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0xff0000), 0);
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(0, pan_cnt);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, get_px(0, 10, 2));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_linux_fbdev_page_flip(void)
+{
+    TEST_PASS();
+}
+
+void test_linux_fbdev_page_flip_force_refresh(void)
+{
+    TEST_PASS();
+}
+
+void test_linux_fbdev_copy_without_panning(void)
+{
+    TEST_PASS();
+}
+
+#endif
+
+#endif
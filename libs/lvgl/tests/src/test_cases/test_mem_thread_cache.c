@@ -0,0 +1,298 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_USE_MEM_THREAD_CACHE
+
+#include <time.h>
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_mem_thread_cache_reuses_the_freed_blocks(void)
+{
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    /*The same size class*/
+    void * p1 = lv_malloc(26);
+    lv_free(p1);
+    void * p2 = lv_malloc(30);
+    TEST_ASSERT_EQUAL_PTR(p1, p2);
+    lv_free(p2);
+
+    /*More blocks than what can be cached*/
+    static void * p_arr[300];
+    uint32_t i;
+    for(i = 0; i < 300; i++) {
+        p_arr[i] = lv_malloc(1 + i % 300);
+        TEST_ASSERT_NOT_NULL(p_arr[i]);
+        lv_memset(p_arr[i], 0xaa, 1 + i % 300);
+    }
+    for(i = 0; i < 300; i++) {
+        lv_free(p_arr[i]);
+    }
+
+    /*The monitor returns the cached blocks to the heap*/
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.free_size, mon_end.free_size);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.free_cnt, mon_end.free_cnt);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+}
+
+void test_mem_thread_cache_realloc(void)
+{
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    char * p = lv_malloc(20);
+    lv_memcpy(p, "0123456789", 11);
+    p = lv_realloc(p, 100);
+    TEST_ASSERT_EQUAL_STRING("0123456789", p);
+    p = lv_realloc(p, 2000);
+    TEST_ASSERT_EQUAL_STRING("0123456789", p);
+    lv_free(p);
+
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.free_size, mon_end.free_size);
+}
+
+#define BENCH_THREAD_CNT    4
+#define BENCH_OP_CNT        20000
+#define BENCH_LIVE_CNT      64
+#define BENCH_POOL_SIZE     (1024 * 1024)
+
+typedef struct {
+    lv_tlsf_t tlsf;         /*NULL: use LVGL's heap*/
+    lv_mutex_t * lock;
+    uint32_t seed;
+    uint32_t fail_cnt;
+    uint32_t corrupt_cnt;
+    void * kept[BENCH_LIVE_CNT];
+} bench_thread_t;
+
+static void * bench_malloc(bench_thread_t * t, size_t size)
+{
+    /*Measure the allocator without the logging of `lv_malloc()`*/
+    if(t->tlsf == NULL) return lv_malloc_core(size);
+
+    lv_mutex_lock(t->lock);
+    void * p = lv_tlsf_malloc(t->tlsf, size);
+    lv_mutex_unlock(t->lock);
+    return p;
+}
+
+static void bench_free(bench_thread_t * t, void * p)
+{
+    if(p == NULL) return;
+
+    if(t->tlsf == NULL) {
+        lv_free_core(p);
+        return;
+    }
+
+    lv_mutex_lock(t->lock);
+    lv_tlsf_free(t->tlsf, p);
+    lv_mutex_unlock(t->lock);
+}
+
+static void bench_thread_cb(void * user_data)
+{
+    bench_thread_t * t = user_data;
+    void * live[BENCH_LIVE_CNT] = {NULL};
+    size_t live_size[BENCH_LIVE_CNT] = {0};
+    uint8_t live_fill[BENCH_LIVE_CNT] = {0};
+
+    /*Replace random blocks with new ones of random size, like the draw tasks and descriptors*/
+    uint32_t i;
+    for(i = 0; i < BENCH_OP_CNT; i++) {
+        t->seed = t->seed * 1103515245 + 12345;
+        uint32_t slot = (t->seed >> 8) % BENCH_LIVE_CNT;
+        size_t size = 8 + (t->seed >> 16) % 249;
+
+        /*No other thread may have written into the block*/
+        if(live[slot]) {
+            const uint8_t * data = live[slot];
+            size_t j;
+            for(j = 0; j < live_size[slot]; j++) {
+                if(data[j] != live_fill[slot]) {
+                    t->corrupt_cnt++;
+                    break;
+                }
+            }
+        }
+
+        bench_free(t, live[slot]);
+        live[slot] = bench_malloc(t, size);
+        if(live[slot]) {
+            live_size[slot] = size;
+            live_fill[slot] = (uint8_t)i;
+            lv_memset(live[slot], live_fill[slot], size);
+        }
+        else {
+            t->fail_cnt++;
+        }
+    }
+
+    /*Keep every 4th block to see the fragmentation*/
+    for(i = 0; i < BENCH_LIVE_CNT; i++) {
+        if(i % 4 == 0) t->kept[i] = live[i];
+        else bench_free(t, live[i]);
+    }
+}
+
+static void frag_walker(void * ptr, size_t size, int used, void * user)
+{
+    LV_UNUSED(ptr);
+    lv_mem_monitor_t * mon = user;
+    if(used) return;
+
+    mon->free_cnt++;
+    mon->free_size += size;
+    if(size > mon->free_biggest_size) mon->free_biggest_size = size;
+}
+
+/**
+ * Run the threads and return the number of allocations per ms.
+ * Measure the heap while some blocks are kept by the threads.
+ * Without an OS the threads are run one after the other.
+ */
+static uint32_t bench_run(lv_tlsf_t tlsf, lv_mutex_t * lock, lv_mem_monitor_t * mon)
+{
+    static bench_thread_t threads[BENCH_THREAD_CNT];
+#if LV_USE_OS
+    lv_thread_t thread_ids[BENCH_THREAD_CNT];
+#endif
+    lv_memzero(threads, sizeof(threads));
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    struct timespec ts_start;
+    clock_gettime(CLOCK_MONOTONIC, &ts_start);
+
+    uint32_t i;
+    for(i = 0; i < BENCH_THREAD_CNT; i++) {
+        threads[i].tlsf = tlsf;
+        threads[i].lock = lock;
+        threads[i].seed = i + 1;
+#if LV_USE_OS
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_thread_init(&thread_ids[i], LV_THREAD_PRIO_MID, bench_thread_cb,
+                                                       16 * 1024, &threads[i]));
+#else
+        bench_thread_cb(&threads[i]);
+#endif
+    }
+#if LV_USE_OS
+    for(i = 0; i < BENCH_THREAD_CNT; i++) {
+        lv_thread_delete(&thread_ids[i]);
+    }
+#endif
+
+    struct timespec ts_end;
+    clock_gettime(CLOCK_MONOTONIC, &ts_end);
+    uint64_t elapsed_us = (uint64_t)(ts_end.tv_sec - ts_start.tv_sec) * 1000000 +
+                          (ts_end.tv_nsec - ts_start.tv_nsec) / 1000;
+
+    lv_memzero(mon, sizeof(lv_mem_monitor_t));
+    if(tlsf) lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), frag_walker, mon);
+    else lv_mem_monitor(mon);
+
+    uint32_t j;
+    size_t kept_size = 0;
+    for(i = 0; i < BENCH_THREAD_CNT; i++) {
+        TEST_ASSERT_EQUAL_UINT32(0, threads[i].fail_cnt);
+        TEST_ASSERT_EQUAL_UINT32(0, threads[i].corrupt_cnt);
+        for(j = 0; j < BENCH_LIVE_CNT; j++) {
+            if(threads[i].kept[j]) kept_size += lv_tlsf_block_size(threads[i].kept[j]);
+        }
+    }
+
+    /*Only the kept blocks are in use, the caches of the exited threads were returned*/
+    if(tlsf == NULL) TEST_ASSERT_EQUAL_UINT32(mon_start.cur_used + kept_size, mon->cur_used);
+
+    for(i = 0; i < BENCH_THREAD_CNT; i++) {
+        for(j = 0; j < BENCH_LIVE_CNT; j++) bench_free(&threads[i], threads[i].kept[j]);
+    }
+
+    return (uint32_t)((uint64_t)BENCH_THREAD_CNT * BENCH_OP_CNT * 1000 / LV_MAX(elapsed_us, 1));
+}
+
+void test_mem_thread_cache_benchmark(void)
+{
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_mem_monitor_t mon_cached;
+    uint32_t ops_cached = bench_run(NULL, NULL, &mon_cached);
+
+    /*The same with a plain TLSF heap protected by a mutex*/
+    void * pool = lv_malloc(BENCH_POOL_SIZE);
+    TEST_ASSERT_NOT_NULL(pool);
+    lv_tlsf_t tlsf = lv_tlsf_create_with_pool(pool, BENCH_POOL_SIZE);
+    lv_mutex_t lock;
+    lv_mutex_init(&lock);
+
+    lv_mem_monitor_t mon_plain;
+    uint32_t ops_plain = bench_run(tlsf, &lock, &mon_plain);
+
+    lv_mutex_delete(&lock);
+    lv_tlsf_destroy(tlsf);
+    lv_free(pool);
+
+    TEST_PRINTF("thread cache: %" LV_PRIu32 " alloc/ms, %" LV_PRId32 " new free blocks while measuring",
+                ops_cached, (int32_t)mon_cached.free_cnt - (int32_t)mon_start.free_cnt);
+    TEST_PRINTF("plain TLSF:   %" LV_PRIu32 " alloc/ms, %" LV_PRId32 " new free blocks while measuring",
+                ops_plain, (int32_t)mon_plain.free_cnt - 1);
+
+    /*Everything is returned to the heap*/
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.free_size, mon_end.free_size);
+
+    /*The timing is too noisy on a loaded CI machine to compare it in every run*/
+    if(lv_test_benchmark_enabled()) {
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(ops_plain, ops_cached);
+    }
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_mem_thread_cache_reuses_the_freed_blocks(void)
+{
+    TEST_PASS();
+}
+
+void test_mem_thread_cache_realloc(void)
+{
+    TEST_PASS();
+}
+
+void test_mem_thread_cache_benchmark(void)
+{
+    TEST_PASS();
+}
+
+#endif
+
+#endif
@@ -5,12 +5,20 @@
 #include "unity/unity.h"
 #include <string.h>
 
+#if LV_USE_OS == LV_OS_PTHREAD
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
 #define OUTPUT_LINE_MAX 8
 #define OUTPUT_BUF_MAX 128
 
 static uint32_t profiler_tick = 0;
 static int output_line = 0;
 static char output_buf[OUTPUT_LINE_MAX][OUTPUT_BUF_MAX];
+static uint8_t output_bin[256];
+static uint32_t output_bin_size = 0;
+static uint32_t output_line_cnt = 0;
 
 static uint32_t get_tick_cb(void)
 {
@@ -26,8 +34,23 @@ static void flush_cb(const char * buf)
     output_line++;
 }
 
+static void flush_bin_cb(const void * buf, uint32_t size)
+{
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(output_bin), output_bin_size + size);
+    lv_memcpy(output_bin + output_bin_size, buf, size);
+    output_bin_size += size;
+}
+
+static void count_flush_cb(const char * buf)
+{
+    LV_UNUSED(buf);
+    output_line_cnt++;
+}
+
 void setUp(void)
 {
+    output_line = 0;
+
     lv_profiler_builtin_config_t config;
     lv_profiler_builtin_config_init(&config);
     config.buf_size = 1024;
@@ -98,4 +121,181 @@ void test_profiler_disable(void)
     TEST_ASSERT_EQUAL_CHAR(output_buf[4][0], '\0');
 }
 
+void test_profiler_binary(void)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = 1024;
+    config.tick_per_sec = 1000;
+    config.tick_get_cb = get_tick_cb;
+    config.flush_cb = NULL;
+    config.flush_bin_cb = flush_bin_cb;
+
+    output_bin_size = 0;
+    profiler_tick = 0;
+    lv_profiler_builtin_init(&config);
+
+    /* header: magic, version, reserved, tick_per_sec */
+    static const uint8_t header[] = {'L', 'V', 'P', 'F', 1, 0, 0, 0, 0xE8, 0x03, 0, 0};
+    TEST_ASSERT_EQUAL_UINT32(sizeof(header), output_bin_size);
+    TEST_ASSERT_EQUAL_MEMORY(header, output_bin, sizeof(header));
+
+    LV_PROFILER_BEGIN_TAG("tag_a");
+    LV_PROFILER_END_TAG("tag_a");
+    LV_PROFILER_BEGIN_TAG("tag_a");
+    lv_profiler_builtin_flush();
+
+    /* the string is written only once, the events refer to it by ID */
+    static const uint8_t records[] = {
+        'S', 5, 0, 0, 't', 'a', 'g', '_', 'a',
+        'B', 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
+        'E', 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
+        'B', 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0,
+    };
+    TEST_ASSERT_EQUAL_UINT32(sizeof(header) + sizeof(records), output_bin_size);
+    TEST_ASSERT_EQUAL_MEMORY(records, output_bin + sizeof(header), sizeof(records));
+}
+
+void test_profiler_shared_ring_flush_on_full(void)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = 256; /* Only a few items */
+    config.flush_cb = count_flush_cb;
+    lv_profiler_builtin_init(&config);
+
+    /* the full shared ring is flushed instead of dropping the items */
+    output_line_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < 50; i++) {
+        LV_PROFILER_BEGIN_TAG("shared");
+        LV_PROFILER_END_TAG("shared");
+    }
+
+    lv_profiler_builtin_flush();
+
+    TEST_ASSERT_EQUAL_UINT32(100, output_line_cnt);
+}
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+#define THREAD_NUM 3
+#define THREAD_EVENT_PAIRS 100
+
+static int gettid_cb(void)
+{
+    return (int)syscall(SYS_gettid);
+}
+
+static void writer_thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+    uint32_t i;
+    for(i = 0; i < THREAD_EVENT_PAIRS; i++) {
+        LV_PROFILER_BEGIN_TAG("writer");
+        LV_PROFILER_END_TAG("writer");
+    }
+}
+
+void test_profiler_threads(void)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.tid_get_cb = gettid_cb;
+    config.thread_max = THREAD_NUM + 1;
+    config.buf_size = THREAD_NUM * 2048 * sizeof(void *);
+    config.flush_cb = count_flush_cb;
+    lv_profiler_builtin_init(&config);
+
+    /* every thread writes its own ring, nothing is lost */
+    output_line_cnt = 0;
+    lv_thread_t threads[THREAD_NUM];
+    uint32_t i;
+    for(i = 0; i < THREAD_NUM; i++) {
+        lv_thread_init(&threads[i], LV_THREAD_PRIO_MID, writer_thread_cb, 8 * 1024, NULL);
+    }
+
+    for(i = 0; i < THREAD_NUM; i++) {
+        lv_thread_delete(&threads[i]);
+    }
+
+    lv_profiler_builtin_flush();
+
+    TEST_ASSERT_EQUAL_UINT32(THREAD_NUM * THREAD_EVENT_PAIRS * 2, output_line_cnt);
+}
+
+void test_profiler_threads_reuse_rings(void)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.tid_get_cb = gettid_cb;
+    config.thread_max = 1;
+    config.buf_size = 2048 * sizeof(void *);
+    config.flush_cb = count_flush_cb;
+    lv_profiler_builtin_init(&config);
+
+    /* the ring of a finished thread is given to the next one */
+    output_line_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < THREAD_NUM; i++) {
+        lv_thread_t thread;
+        lv_thread_init(&thread, LV_THREAD_PRIO_MID, writer_thread_cb, 8 * 1024, NULL);
+        lv_thread_delete(&thread);
+    }
+
+    lv_profiler_builtin_flush();
+
+    TEST_ASSERT_EQUAL_UINT32(THREAD_NUM * THREAD_EVENT_PAIRS * 2, output_line_cnt);
+}
+
+void test_profiler_threads_dropped_without_ring(void)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.tid_get_cb = gettid_cb;
+    config.thread_max = 1;
+    config.tick_get_cb = get_tick_cb;
+    config.flush_cb = NULL;
+    config.flush_bin_cb = flush_bin_cb;
+
+    output_bin_size = 0;
+    profiler_tick = 0;
+    lv_profiler_builtin_init(&config);
+
+    /* the only ring is taken by this thread */
+    LV_PROFILER_BEGIN_TAG("tag_a");
+
+    lv_thread_t thread;
+    lv_thread_init(&thread, LV_THREAD_PRIO_MID, writer_thread_cb, 8 * 1024, NULL);
+    lv_thread_delete(&thread);
+
+    lv_profiler_builtin_flush();
+
+    /* the events of the other thread are reported as dropped with thread ID -1 */
+    static const uint8_t dropped[] = {
+        'D', 0, 0, 0, 0xFF, 0xFF, 0xFF, 0xFF, THREAD_EVENT_PAIRS * 2, 0, 0, 0,
+    };
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(sizeof(dropped), output_bin_size);
+    TEST_ASSERT_EQUAL_MEMORY(dropped, output_bin + output_bin_size - sizeof(dropped), sizeof(dropped));
+}
+
+#else
+
+void test_profiler_threads(void)
+{
+    TEST_PASS();
+}
+
+void test_profiler_threads_reuse_rings(void)
+{
+    TEST_PASS();
+}
+
+void test_profiler_threads_dropped_without_ring(void)
+{
+    TEST_PASS();
+}
+
+#endif
+
 #endif
@@ -3,7 +3,9 @@
 #include "../../lvgl_private.h"
 
 #include "unity/unity.h"
+#include "lv_test_helpers.h"
 #include <unistd.h>
+#include <time.h>
 
 static void obj_set_height_helper(void * obj, int32_t height)
 {
@@ -141,4 +143,225 @@ void test_style_has_prop(void)
     lv_style_reset(&style);
 }
 
+void test_style_prop_is_updated_after_change(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_bg_color(&style, lv_color_hex(0xff0000));
+
+    lv_style_t style_pr;
+    lv_style_init(&style_pr);
+    lv_style_set_bg_color(&style_pr, lv_color_hex(0x00ff00));
+
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    lv_obj_add_style(obj, &style_pr, LV_PART_MAIN | LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Changing the style*/
+    lv_style_set_bg_color(&style, lv_color_hex(0x0000ff));
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Changing the state*/
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    lv_obj_remove_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Local style on an other part*/
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x123456), LV_PART_SCROLLBAR);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_bg_color(obj, LV_PART_SCROLLBAR));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Removing the style*/
+    lv_obj_remove_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_style_prop_get_default(LV_STYLE_BG_COLOR).color,
+                            lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    lv_obj_delete(obj);
+    lv_style_reset(&style);
+    lv_style_reset(&style_pr);
+}
+
+void test_style_inherited_prop_is_updated_after_change(void)
+{
+    lv_obj_t * parent1 = lv_obj_create(lv_screen_active());
+    lv_obj_t * parent2 = lv_obj_create(lv_screen_active());
+    lv_obj_t * child = lv_obj_create(parent1);
+    lv_obj_remove_style_all(child);
+
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0xff0000), 0);
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0x00ff00), LV_STATE_CHECKED);
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x0000ff), 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*The state of the parent changes*/
+    lv_obj_add_state(parent1, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*The style of the parent changes*/
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0x808080), LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x808080), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*The parent changes*/
+    lv_obj_set_parent(child, parent2);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    lv_obj_delete(parent1);
+    lv_obj_delete(parent2);
+}
+
+void test_style_freeze(void)
+{
+    lv_style_prop_t custom_prop = lv_style_register_prop(LV_STYLE_PROP_FLAG_NONE);
+    lv_style_value_t v;
+
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_text_color(&style, lv_color_hex(0x112233));
+    lv_style_set_prop(&style, custom_prop, (lv_style_value_t) {
+        .num = 42
+    });
+    lv_style_set_width(&style, 10);
+    lv_style_set_grid_cell_y_align(&style, LV_GRID_ALIGN_END);
+    lv_style_set_bg_opa(&style, LV_OPA_50);
+
+    lv_style_freeze(&style);
+    TEST_ASSERT_TRUE(lv_style_is_frozen(&style));
+    TEST_ASSERT_EQUAL_UINT8(5, style.prop_cnt);
+
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_WIDTH, &v));
+    TEST_ASSERT_EQUAL_INT32(10, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_BG_OPA, &v));
+    TEST_ASSERT_EQUAL_INT32(LV_OPA_50, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_TEXT_COLOR, &v));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x112233), v.color);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_GRID_CELL_Y_ALIGN, &v));
+    TEST_ASSERT_EQUAL_INT32(LV_GRID_ALIGN_END, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, custom_prop, &v));
+    TEST_ASSERT_EQUAL_INT32(42, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_HEIGHT, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_BG_COLOR, &v));
+
+    /*Works on objects too*/
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_INT32(10, lv_obj_get_style_width(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x112233), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Modifying an existing property keeps the style frozen*/
+    lv_style_set_width(&style, 20);
+    TEST_ASSERT_TRUE(lv_style_is_frozen(&style));
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_style_width(obj, LV_PART_MAIN));
+
+    /*Adding a new property makes it a normal style*/
+    lv_style_set_height(&style, 30);
+    TEST_ASSERT_FALSE(lv_style_is_frozen(&style));
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL_INT32(30, lv_obj_get_style_height(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_style_width(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL_INT32(LV_OPA_50, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    /*Removing a property too*/
+    lv_style_freeze(&style);
+    TEST_ASSERT_TRUE(lv_style_is_frozen(&style));
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_WIDTH));
+    TEST_ASSERT_FALSE(lv_style_is_frozen(&style));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_WIDTH, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_HEIGHT, &v));
+    TEST_ASSERT_EQUAL_INT32(30, v.num);
+
+    lv_obj_delete(obj);
+    lv_style_reset(&style);
+}
+
+
+#define BENCH_OBJ_CNT   32
+
+static const lv_style_prop_t bench_props[] = {
+    LV_STYLE_BG_COLOR, LV_STYLE_BG_OPA, LV_STYLE_BORDER_WIDTH, LV_STYLE_RADIUS, LV_STYLE_PAD_TOP,
+    LV_STYLE_SHADOW_WIDTH, LV_STYLE_OPA, LV_STYLE_TEXT_COLOR, LV_STYLE_TEXT_FONT, LV_STYLE_TEXT_LETTER_SPACE,
+};
+
+#define BENCH_PROP_CNT  (sizeof(bench_props) / sizeof(bench_props[0]))
+
+static bool bench_value_eq(lv_style_prop_t prop, lv_style_value_t v1, lv_style_value_t v2)
+{
+    if(prop == LV_STYLE_BG_COLOR || prop == LV_STYLE_TEXT_COLOR) return lv_color_eq(v1.color, v2.color);
+    if(prop == LV_STYLE_TEXT_FONT) return v1.ptr == v2.ptr;
+    return v1.num == v2.num;
+}
+
+/**
+ * Get the properties of all objects `round_cnt` times and compare them with the expected values.
+ * @param invalidate    true: invalidate the resolved values cached in the objects before each round
+ * @return              the elapsed time in clock ticks
+ */
+static clock_t get_bench_props(lv_obj_t ** objs, lv_style_value_t expected[][BENCH_PROP_CNT], uint32_t round_cnt,
+                               bool invalidate)
+{
+    uint32_t mismatch_cnt = 0;
+    clock_t start = clock();
+    uint32_t r;
+    for(r = 0; r < round_cnt; r++) {
+        uint32_t i;
+        for(i = 0; i < BENCH_OBJ_CNT; i++) {
+            /*Use a non-inherited property to invalidate only the object itself*/
+            if(invalidate) lv_obj_style_invalidate_res_cache(objs[i], LV_STYLE_BG_COLOR);
+            uint32_t p;
+            for(p = 0; p < BENCH_PROP_CNT; p++) {
+                lv_style_value_t v = lv_obj_get_style_prop(objs[i], LV_PART_MAIN, bench_props[p]);
+                if(!bench_value_eq(bench_props[p], v, expected[i][p])) mismatch_cnt++;
+            }
+        }
+    }
+    clock_t elapsed = clock() - start;
+
+    TEST_ASSERT_EQUAL_UINT32(0, mismatch_cnt);
+    return elapsed;
+}
+
+void test_style_res_cache_benchmark(void)
+{
+    uint32_t round_cnt = lv_test_benchmark_enabled() ? 20000 : 10;
+
+    /*Nested containers and buttons with the default theme's styles
+     *and inherited text properties set on the outermost container*/
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_t * objs[BENCH_OBJ_CNT];
+    lv_obj_t * parent = scr;
+    uint32_t i;
+    for(i = 0; i < BENCH_OBJ_CNT; i++) {
+        objs[i] = (i % 4 == 0) ? lv_obj_create(parent) : lv_button_create(parent);
+        if(i % 4 == 0) parent = objs[i];
+    }
+    lv_obj_set_style_text_color(objs[0], lv_color_hex(0x123456), 0);
+    lv_obj_set_style_text_letter_space(objs[0], 3, 0);
+    lv_obj_add_state(objs[BENCH_OBJ_CNT - 1], LV_STATE_PRESSED);
+
+    static lv_style_value_t expected[BENCH_OBJ_CNT][BENCH_PROP_CNT];
+    for(i = 0; i < BENCH_OBJ_CNT; i++) {
+        uint32_t p;
+        for(p = 0; p < BENCH_PROP_CNT; p++) {
+            lv_obj_style_invalidate_res_cache(objs[i], LV_STYLE_BG_COLOR);
+            expected[i][p] = lv_obj_get_style_prop(objs[i], LV_PART_MAIN, bench_props[p]);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT32(3, expected[BENCH_OBJ_CNT - 1][BENCH_PROP_CNT - 1].num);
+
+    clock_t uncached = get_bench_props(objs, expected, round_cnt, true);
+    clock_t cached = get_bench_props(objs, expected, round_cnt, false);
+
+    if(lv_test_benchmark_enabled()) {
+        TEST_PRINTF("%u style property lookups: %u ms without cache, %u ms with cache",
+                    (unsigned int)(round_cnt * BENCH_OBJ_CNT * BENCH_PROP_CNT),
+                    (unsigned int)(uncached * 1000 / CLOCKS_PER_SEC), (unsigned int)(cached * 1000 / CLOCKS_PER_SEC));
+    }
+
+    lv_obj_delete(scr);
+}
+
 #endif
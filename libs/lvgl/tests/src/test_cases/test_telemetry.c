@@ -0,0 +1,231 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#if LV_USE_TELEMETRY
+
+static uint32_t fake_time;
+static uint32_t frame_cnt;
+static lv_telemetry_frame_t last_frame;
+static lv_display_t * last_disp;
+static lv_area_t last_inv_area;
+
+static uint32_t time_cb(void)
+{
+    /*Called by the draw unit threads too*/
+    return __atomic_add_fetch(&fake_time, 1, __ATOMIC_RELAXED);
+}
+
+static void frame_cb(lv_display_t * disp, const lv_telemetry_frame_t * frame, void * user_data)
+{
+    TEST_ASSERT_EQUAL_PTR(&frame_cnt, user_data);
+    last_disp = disp;
+    last_frame = *frame;
+    frame_cnt++;
+}
+
+static void invalidate_area_cb(lv_event_t * e)
+{
+    lv_area_t * area = lv_event_get_param(e);
+    last_inv_area = *area;
+}
+
+static lv_obj_t * create_obj(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_pos(obj, 10, 20);
+    lv_obj_set_size(obj, 100, 50);
+    return obj;
+}
+
+void setUp(void)
+{
+    lv_refr_now(NULL);
+    frame_cnt = 0;
+    lv_memzero(&last_frame, sizeof(last_frame));
+    lv_telemetry_set_time_cb(time_cb);
+    lv_telemetry_set_frame_cb(frame_cb, &frame_cnt);
+    lv_telemetry_reset();
+    lv_display_add_event_cb(lv_display_get_default(), invalidate_area_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+}
+
+void tearDown(void)
+{
+    lv_display_remove_event_cb_with_user_data(lv_display_get_default(), invalidate_area_cb, NULL);
+    lv_telemetry_set_enabled(true);
+    lv_telemetry_set_time_cb(NULL);
+    lv_telemetry_set_frame_cb(NULL, NULL);
+    lv_telemetry_set_export_buffer(NULL);
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_telemetry_frame(void)
+{
+    lv_obj_t * obj = create_obj();
+    lv_refr_now(NULL);
+    frame_cnt = 0;
+
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(1, frame_cnt);
+    TEST_ASSERT_EQUAL_PTR(lv_display_get_default(), last_disp);
+    TEST_ASSERT_EQUAL_UINT32(1, last_frame.dirty_area_cnt);
+    TEST_ASSERT_EQUAL_UINT32(lv_area_get_size(&last_inv_area), last_frame.dirty_px_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, last_frame.draw_task_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, last_frame.draw_unit_cnt);
+
+    /*Not called from `lv_timer_handler()`*/
+    TEST_ASSERT_EQUAL_UINT32(0, last_frame.phase_time[LV_TELEMETRY_PHASE_TIMER_HANDLER]);
+
+    /*The phases are parts of the refresh*/
+    uint32_t sum = 0;
+    uint32_t i;
+    for(i = LV_TELEMETRY_PHASE_LAYOUT; i < LV_TELEMETRY_PHASE_CNT; i++) {
+        TEST_ASSERT_GREATER_THAN_UINT32(0, last_frame.phase_time[i]);
+        sum += last_frame.phase_time[i];
+    }
+    TEST_ASSERT_LESS_THAN_UINT32(last_frame.phase_time[LV_TELEMETRY_PHASE_REFR], sum);
+
+    /*Frames without rendering are not reported*/
+    uint32_t frame_id = last_frame.frame_id;
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, frame_cnt);
+
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(frame_id + 1, last_frame.frame_id);
+}
+
+void test_telemetry_timer_handler(void)
+{
+    lv_obj_t * obj = create_obj();
+    lv_refr_now(NULL);
+    frame_cnt = 0;
+
+    lv_obj_invalidate(obj);
+    lv_test_wait(LV_DEF_REFR_PERIOD);
+
+    TEST_ASSERT_EQUAL_UINT32(1, frame_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(last_frame.phase_time[LV_TELEMETRY_PHASE_REFR],
+                                    last_frame.phase_time[LV_TELEMETRY_PHASE_TIMER_HANDLER]);
+}
+
+void test_telemetry_summary(void)
+{
+    lv_obj_t * obj = create_obj();
+    lv_refr_now(NULL);
+    lv_telemetry_reset();
+
+    lv_telemetry_summary_t summary;
+    lv_telemetry_get_summary(&summary);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.frame_cnt);
+
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_invalidate(obj);
+        lv_refr_now(NULL);
+    }
+
+    lv_telemetry_get_summary(&summary);
+    TEST_ASSERT_EQUAL_UINT32(20, summary.frame_cnt);
+    uint32_t px_cnt = lv_area_get_size(&last_inv_area);
+    TEST_ASSERT_EQUAL_UINT32(px_cnt, summary.dirty_px_p50);
+    TEST_ASSERT_EQUAL_UINT32(px_cnt, summary.dirty_px_p99);
+    TEST_ASSERT_EQUAL_UINT64(20 * px_cnt, summary.dirty_px_sum);
+
+    uint32_t p;
+    for(p = LV_TELEMETRY_PHASE_REFR; p < LV_TELEMETRY_PHASE_CNT; p++) {
+        TEST_ASSERT_GREATER_THAN_UINT32(0, summary.p50[p]);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(summary.p99[p], summary.p50[p]);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(summary.max[p], summary.p99[p]);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(summary.max[p], summary.avg[p]);
+    }
+
+    lv_telemetry_reset();
+    lv_telemetry_get_summary(&summary);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.max[LV_TELEMETRY_PHASE_REFR]);
+}
+
+void test_telemetry_export_buffer(void)
+{
+    static lv_telemetry_export_t export_buf;
+    lv_telemetry_set_export_buffer(&export_buf);
+    TEST_ASSERT_EQUAL_UINT32(0, export_buf.seq % 2);
+
+    lv_obj_t * obj = create_obj();
+    lv_refr_now(NULL);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+
+    /*Not being updated, and the same as what the callback got*/
+    TEST_ASSERT_EQUAL_UINT32(0, export_buf.seq % 2);
+    TEST_ASSERT_EQUAL_MEMORY(&last_frame, &export_buf.last_frame, sizeof(last_frame));
+    TEST_ASSERT_EQUAL_UINT32(frame_cnt, export_buf.summary.frame_cnt);
+
+    /*Not updated after removing it*/
+    uint32_t seq = export_buf.seq;
+    lv_telemetry_set_export_buffer(NULL);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(seq, export_buf.seq);
+}
+
+void test_telemetry_disable(void)
+{
+    lv_obj_t * obj = create_obj();
+    lv_refr_now(NULL);
+    frame_cnt = 0;
+
+    lv_telemetry_set_enabled(false);
+    TEST_ASSERT_FALSE(lv_telemetry_is_enabled());
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, frame_cnt);
+
+    lv_telemetry_set_enabled(true);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, frame_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_telemetry_frame(void)
+{
+}
+
+void test_telemetry_timer_handler(void)
+{
+}
+
+void test_telemetry_summary(void)
+{
+}
+
+void test_telemetry_export_buffer(void)
+{
+}
+
+void test_telemetry_disable(void)
+{
+}
+
+#endif
+
+#endif
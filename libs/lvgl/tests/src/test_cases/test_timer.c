@@ -0,0 +1,161 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define MAX_TIMERS  8
+
+static lv_timer_t * paused_timers[MAX_TIMERS];
+static uint32_t paused_cnt;
+static lv_timer_t * run_order[64];
+static uint32_t run_cnt;
+
+static void timer_cb(lv_timer_t * t)
+{
+    if(run_cnt < 64) run_order[run_cnt] = t;
+    run_cnt++;
+}
+
+void setUp(void)
+{
+    /*Pause the timers of LVGL to see only the timers of the test*/
+    paused_cnt = 0;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(!lv_timer_get_paused(t) && paused_cnt < MAX_TIMERS) {
+            lv_timer_pause(t);
+            paused_timers[paused_cnt] = t;
+            paused_cnt++;
+        }
+        t = lv_timer_get_next(t);
+    }
+
+    run_cnt = 0;
+}
+
+void tearDown(void)
+{
+    uint32_t i;
+    for(i = 0; i < paused_cnt; i++) {
+        lv_timer_resume(paused_timers[i]);
+    }
+}
+
+void test_timer_runs_in_deadline_order(void)
+{
+    lv_timer_t * t1 = lv_timer_create(timer_cb, 30, NULL);
+    lv_timer_t * t2 = lv_timer_create(timer_cb, 10, NULL);
+    lv_timer_t * t3 = lv_timer_create(timer_cb, 20, NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(10, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt);
+
+    lv_tick_inc(35);
+    TEST_ASSERT_EQUAL_UINT32(10, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(3, run_cnt);
+    TEST_ASSERT_EQUAL_PTR(t2, run_order[0]);
+    TEST_ASSERT_EQUAL_PTR(t3, run_order[1]);
+    TEST_ASSERT_EQUAL_PTR(t1, run_order[2]);
+
+    /*Each timer runs only once in a call*/
+    lv_timer_set_period(t2, 0);
+    run_cnt = 0;
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t2);
+    lv_timer_delete(t3);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_handler());
+}
+
+void test_timer_pause_and_period_change(void)
+{
+    lv_timer_t * t1 = lv_timer_create(timer_cb, 10, NULL);
+    lv_timer_t * t2 = lv_timer_create(timer_cb, 50, NULL);
+
+    lv_timer_pause(t1);
+    TEST_ASSERT_EQUAL_UINT32(50, lv_timer_handler());
+
+    lv_timer_resume(t1);
+    TEST_ASSERT_EQUAL_UINT32(10, lv_timer_handler());
+
+    lv_timer_set_period(t1, 100);
+    TEST_ASSERT_EQUAL_UINT32(50, lv_timer_handler());
+
+    lv_timer_ready(t1);
+    TEST_ASSERT_EQUAL_UINT32(50, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_EQUAL_PTR(t1, run_order[0]);
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t2);
+}
+
+static lv_timer_t * timer_to_delete;
+
+static void delete_cb(lv_timer_t * t)
+{
+    timer_cb(t);
+    if(timer_to_delete) {
+        lv_timer_delete(timer_to_delete);
+        timer_to_delete = NULL;
+    }
+}
+
+void test_timer_delete_in_callback(void)
+{
+    lv_timer_t * t1 = lv_timer_create(delete_cb, 10, NULL);
+    lv_timer_t * t2 = lv_timer_create(timer_cb, 20, NULL);
+    lv_timer_t * t3 = lv_timer_create(timer_cb, 30, NULL);
+
+    /*t1 deletes t2 which is already due*/
+    timer_to_delete = t2;
+    lv_tick_inc(30);
+    TEST_ASSERT_EQUAL_UINT32(10, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+    TEST_ASSERT_EQUAL_PTR(t1, run_order[0]);
+    TEST_ASSERT_EQUAL_PTR(t3, run_order[1]);
+
+    /*t1 deletes itself*/
+    timer_to_delete = t1;
+    run_cnt = 0;
+    lv_tick_inc(10);
+    TEST_ASSERT_EQUAL_UINT32(20, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+
+    lv_timer_delete(t3);
+}
+
+void test_timer_repeat_count(void)
+{
+    lv_timer_t * t1 = lv_timer_create(timer_cb, 10, NULL);
+    lv_timer_set_repeat_count(t1, 2);
+
+    lv_timer_t * t2 = lv_timer_create(timer_cb, 10, NULL);
+    lv_timer_set_repeat_count(t2, 1);
+    lv_timer_set_auto_delete(t2, false);
+
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_TRUE(lv_timer_get_paused(t2));
+
+    lv_tick_inc(10);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(3, run_cnt);
+
+    /*t1 is deleted so only t2 remains*/
+    uint32_t cnt = 0;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(t == t2) cnt++;
+        TEST_ASSERT_NOT_EQUAL(t1, t);
+        t = lv_timer_get_next(t);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, cnt);
+
+    lv_timer_delete(t2);
+}
+
+#endif
@@ -193,4 +193,147 @@ void test_draw_task_hooking(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("widgets/chart_bar_draw_hook.png");
 }
 
+static int32_t stream_value(uint32_t i)
+{
+    /*A slow sine with some noise*/
+    return 50 + lv_trigo_sin((int16_t)((i / 50) % 360)) * 40 / LV_TRIGO_SIN_MAX + (int32_t)(i * 7919 % 11) - 5;
+}
+
+static uint32_t stream_line_cnt;
+static lv_area_t stream_inv_area;
+
+static void stream_draw_task_cb(lv_event_t * e)
+{
+    lv_draw_task_t * draw_task = lv_event_get_param(e);
+    if(draw_task->type == LV_DRAW_TASK_TYPE_LINE) stream_line_cnt++;
+}
+
+static void stream_line_area_cb(lv_event_t * e)
+{
+    lv_draw_task_t * draw_task = lv_event_get_param(e);
+    if(draw_task->type != LV_DRAW_TASK_TYPE_LINE) return;
+
+    lv_draw_line_dsc_t * line_dsc = draw_task->draw_dsc;
+    int32_t y1 = (int32_t)line_dsc->p1.y;
+    int32_t y2 = (int32_t)line_dsc->p2.y;
+    lv_area_t a;
+    lv_area_set(&a, (int32_t)line_dsc->p1.x, LV_MIN(y1, y2), (int32_t)line_dsc->p2.x, LV_MAX(y1, y2));
+    if(stream_inv_area.x1 > stream_inv_area.x2) stream_inv_area = a;
+    else lv_area_join(&stream_inv_area, &stream_inv_area, &a);
+}
+
+static void stream_invalidate_cb(lv_event_t * e)
+{
+    const lv_area_t * area = lv_event_get_param(e);
+    if(stream_inv_area.x1 > stream_inv_area.x2) stream_inv_area = *area;
+    else lv_area_join(&stream_inv_area, &stream_inv_area, area);
+}
+
+static lv_chart_series_t * create_stream_chart(uint32_t point_cnt, lv_chart_update_mode_t mode)
+{
+    lv_obj_set_size(chart, 400, 200);
+    lv_obj_center(chart);
+    lv_chart_set_point_count(chart, point_cnt);
+    lv_chart_set_update_mode(chart, mode);
+    lv_chart_set_stream_mode(chart, true);
+    return lv_chart_add_series(chart, red_color, LV_CHART_AXIS_PRIMARY_Y);
+}
+
+void test_chart_stream_mode(void)
+{
+    lv_chart_series_t * ser = create_stream_chart(100000, LV_CHART_UPDATE_MODE_SHIFT);
+    TEST_ASSERT_TRUE(lv_chart_get_stream_mode(chart));
+
+    /*Fill the series and add some more to scroll it*/
+    uint32_t i;
+    for(i = 0; i < 130000; i++) {
+        lv_chart_set_next_value(chart, ser, stream_value(i));
+        /*Refresh a few times while streaming to use and update the cached blocks*/
+        if(i % 40000 == 0) lv_refr_now(NULL);
+    }
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/chart_stream_shift.png");
+
+    /*The cached blocks should be the same as the recalculated ones*/
+    lv_chart_refresh(chart);
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/chart_stream_shift.png");
+
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/chart_stream_circular.png");
+}
+
+void test_chart_stream_mode_draws_pixel_columns(void)
+{
+    lv_chart_series_t * ser = create_stream_chart(100000, LV_CHART_UPDATE_MODE_SHIFT);
+    uint32_t i;
+    for(i = 0; i < 100000; i++) lv_chart_set_next_value(chart, ser, stream_value(i));
+
+    lv_obj_add_flag(chart, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_add_event_cb(chart, stream_draw_task_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+    stream_line_cnt = 0;
+    lv_obj_invalidate(chart);
+    lv_refr_now(NULL);
+
+    /*One vertical line per pixel column besides the division lines*/
+    int32_t w = lv_obj_get_content_width(chart);
+    TEST_ASSERT_GREATER_THAN_UINT32(w / 2, stream_line_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(w + 20, stream_line_cnt);
+}
+
+void test_chart_stream_mode_clamps_out_of_range_values(void)
+{
+    lv_chart_series_t * ser = create_stream_chart(10000, LV_CHART_UPDATE_MODE_SHIFT);
+    lv_chart_set_div_line_count(chart, 0, 0);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+
+    /*Huge values used to overflow while mapping them to the content area*/
+    uint32_t i;
+    for(i = 0; i < 10000; i++) lv_chart_set_next_value(chart, ser, i % 2 ? 1000000000 : -1000000000);
+
+    lv_obj_add_flag(chart, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_add_event_cb(chart, stream_line_area_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+    lv_area_set(&stream_inv_area, 0, 0, -1, -1);
+    lv_obj_invalidate(chart);
+    lv_refr_now(NULL);
+
+    lv_area_t content;
+    lv_obj_get_content_coords(chart, &content);
+    TEST_ASSERT_EQUAL_INT32(content.y1, stream_inv_area.y1);
+    TEST_ASSERT_LESS_OR_EQUAL_INT32(content.y2 + 1, stream_inv_area.y2);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT32(content.y2, stream_inv_area.y2);
+}
+
+void test_chart_stream_mode_invalidation(void)
+{
+    lv_chart_series_t * ser = create_stream_chart(100000, LV_CHART_UPDATE_MODE_SHIFT);
+    lv_display_add_event_cb(lv_display_get_default(), stream_invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_refr_now(NULL);
+
+    int32_t w = lv_obj_get_content_width(chart);
+    uint32_t block_size = (100000 + w - 1) / w;
+
+    /*Only the newest column is invalidated until a block is filled*/
+    lv_area_set(&stream_inv_area, 0, 0, -1, -1);
+    lv_chart_set_next_value(chart, ser, 10);
+    TEST_ASSERT_LESS_THAN_INT32(10, lv_area_get_width(&stream_inv_area));
+    TEST_ASSERT_GREATER_OR_EQUAL_INT32(chart->coords.x2 - 20, stream_inv_area.x1);
+
+    /*The chart scrolls when the block is filled*/
+    uint32_t i;
+    for(i = 1; i < block_size - 1; i++) lv_chart_set_next_value(chart, ser, 10);
+    lv_refr_now(NULL);
+    lv_area_set(&stream_inv_area, 0, 0, -1, -1);
+    lv_chart_set_next_value(chart, ser, 10);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT32(lv_area_get_width(&chart->coords), lv_area_get_width(&stream_inv_area));
+    lv_refr_now(NULL);
+
+    /*In circular mode only the written column is invalidated*/
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    lv_refr_now(NULL);
+    for(i = 0; i < block_size * 2; i++) {
+        lv_area_set(&stream_inv_area, 0, 0, -1, -1);
+        lv_chart_set_next_value(chart, ser, 10);
+        TEST_ASSERT_LESS_THAN_INT32(10, lv_area_get_width(&stream_inv_area));
+    }
+}
+
 #endif
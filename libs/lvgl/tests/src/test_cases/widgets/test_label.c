@@ -615,4 +615,53 @@ void test_label_max_width(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("widgets/label_max_width.png");
 }
 
+void test_label_layout_cache(void)
+{
+#if LV_LABEL_LAYOUT_CACHE
+    lv_label_t * lbl = (lv_label_t *)long_label_multiline;
+    lv_obj_set_width(long_label_multiline, 150);
+    lv_refr_now(NULL);
+
+    const lv_font_t * font = lv_obj_get_style_text_font(long_label_multiline, LV_PART_MAIN);
+    int32_t letter_space = lv_obj_get_style_text_letter_space(long_label_multiline, LV_PART_MAIN);
+    int32_t line_space = lv_obj_get_style_text_line_space(long_label_multiline, LV_PART_MAIN);
+    int32_t w = lv_obj_get_content_width(long_label_multiline);
+    TEST_ASSERT_TRUE(lv_draw_label_layout_is_valid(&lbl->layout, lbl->text, font, letter_space, w, LV_TEXT_FLAG_NONE));
+
+    /*The layout gives the same result as measuring the text*/
+    lv_point_t size_layout;
+    lv_point_t size_text;
+    lv_draw_label_layout_get_size(&lbl->layout, line_space, &size_layout);
+    lv_text_get_size(&size_text, lbl->text, font, letter_space, line_space, w, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL_INT32(size_text.x, size_layout.x);
+    TEST_ASSERT_EQUAL_INT32(size_text.y, size_layout.y);
+
+#if LV_USE_BIDI == 0
+    /*The glyphs are looked up only once*/
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(font, &g, (uint32_t)lbl->text[0], '\0');
+    TEST_ASSERT_NOT_NULL(lbl->layout.glyphs);
+    TEST_ASSERT_EQUAL_PTR(font, lbl->layout.glyphs[0].dsc.resolved_font);
+    TEST_ASSERT_EQUAL_UINT32(g.gid.index, lbl->layout.glyphs[0].dsc.gid.index);
+#endif
+
+    /*Setting a new text lays it out right away, not while drawing*/
+    lv_label_set_text(long_label_multiline, long_text);
+    TEST_ASSERT_TRUE(lv_draw_label_layout_is_valid(&lbl->layout, lbl->text, font, letter_space, w, LV_TEXT_FLAG_NONE));
+
+    /*A static text modified in place is laid out again when it's set*/
+    static char static_text[] = "Short text";
+    lv_label_set_text_static(long_label_multiline, static_text);
+    lv_draw_label_layout_get_size(&lbl->layout, line_space, &size_layout);
+    static_text[0] = '\n';
+    lv_label_set_text_static(long_label_multiline, static_text);
+    lv_draw_label_layout_get_size(&lbl->layout, line_space, &size_text);
+    TEST_ASSERT_GREATER_THAN_INT32(size_layout.y, size_text.y);
+
+    /*A different width doesn't match the layout*/
+    TEST_ASSERT_FALSE(lv_draw_label_layout_is_valid(&lbl->layout, lbl->text, font, letter_space, w + 10,
+                                                    LV_TEXT_FLAG_NONE));
+#endif
+}
+
 #endif
@@ -0,0 +1,198 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * vlist = NULL;
+static uint32_t bind_cnt;
+static char text_buf[32];
+
+static const char * text_cb(lv_obj_t * obj, uint32_t row, uint32_t col)
+{
+    LV_UNUSED(obj);
+    lv_snprintf(text_buf, sizeof(text_buf), "%" LV_PRIu32 ":%" LV_PRIu32, row, col);
+    return text_buf;
+}
+
+static const char * multiline_text_cb(lv_obj_t * obj, uint32_t row, uint32_t col)
+{
+    LV_UNUSED(obj);
+    LV_UNUSED(col);
+    /*Every third row has 3 lines*/
+    return row % 3 == 0 ? "a\nb\nc" : "a";
+}
+
+static void bind_cb(lv_obj_t * obj, lv_obj_t * row_obj, uint32_t row)
+{
+    TEST_ASSERT_EQUAL_UINT32(row, lv_vlist_get_row_index(obj, row_obj));
+    bind_cnt++;
+}
+
+void setUp(void)
+{
+    bind_cnt = 0;
+    vlist = lv_vlist_create(lv_screen_active());
+    lv_obj_set_size(vlist, 300, 200);
+    lv_obj_set_style_pad_all(vlist, 0, 0);
+    lv_obj_set_style_border_width(vlist, 0, 0);
+    lv_vlist_set_text_cb(vlist, text_cb);
+    lv_vlist_set_bind_cb(vlist, bind_cb);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_vlist_pool_covers_only_the_visible_rows(void)
+{
+    lv_vlist_set_row_height(vlist, 20);
+    lv_vlist_set_overscan(vlist, 2);
+    lv_vlist_set_row_count(vlist, 20000);
+    lv_obj_update_layout(vlist);
+
+    /*10 visible rows and 2 below them*/
+    TEST_ASSERT_EQUAL_UINT32(12, lv_vlist_get_pool_size(vlist));
+    TEST_ASSERT_EQUAL_INT32(20000 * 20, lv_vlist_get_row_y(vlist, 20000));
+    TEST_ASSERT_EQUAL_INT32(20000 * 20, lv_obj_get_scroll_bottom(vlist) + 200);
+
+    lv_obj_t * row_obj = lv_vlist_get_row_obj(vlist, 3);
+    TEST_ASSERT_NOT_NULL(row_obj);
+    TEST_ASSERT_EQUAL_STRING("3:0", lv_label_get_text(lv_obj_get_child(row_obj, 0)));
+    TEST_ASSERT_EQUAL_INT32(60, lv_obj_get_y(row_obj));
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_height(row_obj));
+    TEST_ASSERT_NULL(lv_vlist_get_row_obj(vlist, 12));
+}
+
+void test_vlist_rows_are_recycled_on_scroll(void)
+{
+    lv_vlist_set_row_height(vlist, 20);
+    lv_vlist_set_row_count(vlist, 20000);
+
+    lv_vlist_scroll_to_row(vlist, 10000, LV_ANIM_OFF);
+    lv_obj_update_layout(vlist);
+
+    TEST_ASSERT_EQUAL_INT32(10000 * 20, lv_obj_get_scroll_y(vlist));
+    TEST_ASSERT_EQUAL_UINT32(14, lv_vlist_get_pool_size(vlist));
+    TEST_ASSERT_NULL(lv_vlist_get_row_obj(vlist, 0));
+
+    lv_obj_t * row_obj = lv_vlist_get_row_obj(vlist, 10000);
+    TEST_ASSERT_NOT_NULL(row_obj);
+    TEST_ASSERT_EQUAL_STRING("10000:0", lv_label_get_text(lv_obj_get_child(row_obj, 0)));
+    TEST_ASSERT_EQUAL_INT32(vlist->coords.y1, row_obj->coords.y1);
+    TEST_ASSERT_NOT_NULL(lv_vlist_get_row_obj(vlist, 9998));
+    TEST_ASSERT_NOT_NULL(lv_vlist_get_row_obj(vlist, 10011));
+    TEST_ASSERT_NULL(lv_vlist_get_row_obj(vlist, 10012));
+
+    /*Scroll by a few pixels. Only the new row is bound.*/
+    bind_cnt = 0;
+    lv_obj_scroll_by(vlist, 0, -20, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(1, bind_cnt);
+    TEST_ASSERT_NOT_NULL(lv_vlist_get_row_obj(vlist, 10012));
+    TEST_ASSERT_NULL(lv_vlist_get_row_obj(vlist, 9998));
+    TEST_ASSERT_EQUAL_UINT32(14, lv_vlist_get_pool_size(vlist));
+}
+
+void test_vlist_columns(void)
+{
+    lv_vlist_set_column_count(vlist, 3);
+    lv_vlist_set_column_width(vlist, 0, 50);
+    lv_vlist_set_row_count(vlist, 100);
+    lv_obj_update_layout(vlist);
+
+    lv_obj_t * row_obj = lv_vlist_get_row_obj(vlist, 1);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_obj_get_child_count(row_obj));
+    TEST_ASSERT_EQUAL_STRING("1:2", lv_label_get_text(lv_obj_get_child(row_obj, 2)));
+    TEST_ASSERT_EQUAL_INT32(50, lv_obj_get_width(lv_obj_get_child(row_obj, 0)));
+    TEST_ASSERT_EQUAL_INT32(125, lv_obj_get_width(lv_obj_get_child(row_obj, 1)));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_vlist_get_row_index(vlist, lv_obj_get_child(row_obj, 1)));
+}
+
+void test_vlist_estimated_row_height(void)
+{
+    lv_vlist_set_text_cb(vlist, multiline_text_cb);
+    lv_vlist_set_estimated_row_height(vlist, 30);
+    lv_vlist_set_row_count(vlist, 1000);
+    lv_obj_update_layout(vlist);
+
+    int32_t line_h = lv_font_get_line_height(lv_obj_get_style_text_font(vlist, 0));
+    int32_t big_h = 3 * line_h + 2 * lv_obj_get_style_text_line_space(vlist, 0);
+
+    /*The visible rows are measured, the others are estimated*/
+    TEST_ASSERT_EQUAL_INT32(big_h, lv_obj_get_height(lv_vlist_get_row_obj(vlist, 0)));
+    TEST_ASSERT_EQUAL_INT32(line_h, lv_obj_get_height(lv_vlist_get_row_obj(vlist, 1)));
+    TEST_ASSERT_EQUAL_INT32(big_h + 2 * line_h, lv_vlist_get_row_y(vlist, 3));
+    TEST_ASSERT_EQUAL_INT32(big_h + 2 * line_h, lv_obj_get_y(lv_vlist_get_row_obj(vlist, 3)));
+    TEST_ASSERT_EQUAL_INT32(30 * 900, lv_vlist_get_row_y(vlist, 1000) - lv_vlist_get_row_y(vlist, 100));
+
+    /*The rows are sized to fill the viewport and the overscan*/
+    uint32_t visible_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        if(lv_vlist_get_row_y(vlist, i) < 200) visible_cnt++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(visible_cnt + 2, lv_vlist_get_pool_size(vlist));
+
+    /*The measured heights are kept when the row count changes*/
+    int32_t y_100 = lv_vlist_get_row_y(vlist, 100);
+    lv_vlist_set_row_count(vlist, 2000);
+    TEST_ASSERT_EQUAL_INT32(y_100, lv_vlist_get_row_y(vlist, 100));
+    TEST_ASSERT_EQUAL_INT32(y_100 + 1900 * 30, lv_vlist_get_row_y(vlist, 2000));
+
+    /*The top visible row stays in place when the rows above it are measured*/
+    lv_vlist_scroll_to_row(vlist, 500, LV_ANIM_OFF);
+    lv_obj_scroll_by(vlist, 0, -300, LV_ANIM_OFF);
+    lv_obj_update_layout(vlist);
+    lv_obj_t * row_obj = NULL;
+    for(i = 0; i < 2000; i++) {
+        if(lv_vlist_get_row_y(vlist, i + 1) > lv_obj_get_scroll_y(vlist)) {
+            row_obj = lv_vlist_get_row_obj(vlist, i);
+            break;
+        }
+    }
+    TEST_ASSERT_NOT_NULL(row_obj);
+    int32_t y_ori = row_obj->coords.y1;
+    lv_obj_scroll_by(vlist, 0, 1, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_INT32(y_ori + 1, row_obj->coords.y1);
+}
+
+void test_vlist_custom_rows(void)
+{
+    lv_vlist_set_row_height(vlist, 40);
+    lv_vlist_set_row_count(vlist, 50);
+    lv_vlist_set_create_cb(vlist, lv_button_create);
+    lv_obj_update_layout(vlist);
+
+    lv_obj_t * row_obj = lv_vlist_get_row_obj(vlist, 2);
+    TEST_ASSERT_TRUE(lv_obj_check_type(row_obj, &lv_button_class));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_vlist_get_row_index(vlist, row_obj));
+    TEST_ASSERT_EQUAL_INT32(80, lv_obj_get_y(row_obj));
+
+    /*Deleted rows are removed from the pool*/
+    uint32_t pool_size = lv_vlist_get_pool_size(vlist);
+    lv_obj_delete(row_obj);
+    TEST_ASSERT_EQUAL_UINT32(pool_size - 1, lv_vlist_get_pool_size(vlist));
+    lv_vlist_refresh(vlist);
+    TEST_ASSERT_EQUAL_UINT32(pool_size, lv_vlist_get_pool_size(vlist));
+    TEST_ASSERT_NOT_NULL(lv_vlist_get_row_obj(vlist, 2));
+}
+
+void test_vlist_render(void)
+{
+    lv_obj_set_size(vlist, 300, 400);
+    lv_obj_center(vlist);
+    lv_obj_set_style_pad_all(vlist, 10, 0);
+    lv_obj_set_style_border_width(vlist, 2, 0);
+    lv_vlist_set_column_count(vlist, 2);
+    lv_vlist_set_column_width(vlist, 0, 100);
+    lv_vlist_set_row_height(vlist, 30);
+    lv_vlist_set_row_count(vlist, 100000);
+    lv_obj_update_layout(vlist);
+    lv_vlist_scroll_to_row(vlist, 50000, LV_ANIM_OFF);
+    lv_obj_scroll_by(vlist, 0, -15, LV_ANIM_OFF);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/vlist_1.png");
+}
+
+#endif